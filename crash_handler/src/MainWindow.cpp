@@ -20,15 +20,21 @@
 #include "ui_MainWindow.h"
 #include "Utility.h"
 #include "SymbolsUnpacker.h"
+#include "SymbolsCache.h"
 #include <VersionInfo.h>
 #include <quentier/utility/VersionInfo.h>
 #include <QDir>
-#include <QDesktopServices>
 #include <QThreadPool>
+#include <QTextCursor>
+#include <QScrollBar>
+#include <QTimerEvent>
+#include <algorithm>
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
-#include <QStandardPaths>
-#endif
+// The max total size of the unpacked symbols kept in the cache between the runs of the crash handler
+#define SYMBOLS_CACHE_MAX_SIZE (qint64(4) * 1024 * 1024 * 1024)
+
+// The stackwalk output is accumulated and appended to the displayed text no more often than this
+#define OUTPUT_FLUSH_TIMER_MSEC (100)
 
 #if (QT_VERSION < QT_VERSION_CHECK(5, 0, 0)) || (defined(_MSC_VER) && (_MSC_VER <= 1600))
 #define QNSIGNAL(className, methodName, ...) SIGNAL(methodName(__VA_ARGS__))
@@ -50,8 +56,12 @@ MainWindow::MainWindow(const QString & quentierSymbolsFileLocation,
     m_stackwalkBinary(),
     m_unpackedSymbolsRootPath(),
     m_symbolsUnpackingErrors(),
+    m_unpackedSymbolsPaths(),
     m_output(),
-    m_error()
+    m_error(),
+    m_numDisplayedOutputChars(0),
+    m_crashedThreadOutputEndIndex(-1),
+    m_outputFlushTimer()
 {
     m_pUi->setupUi(this);
     setWindowTitle(tr("Quentier crashed"));
@@ -72,22 +82,12 @@ MainWindow::MainWindow(const QString & quentierSymbolsFileLocation,
         return;
     }
 
-#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
-    QString tmpDirPath = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
-#else
-    QString tmpDirPath = QDesktopServices::storageLocation(QDesktopServices::TempLocation);
-#endif
-
-    m_unpackedSymbolsRootPath = tmpDirPath + QString::fromUtf8("/Quentier_debugging_symbols/symbols");
-    bool res = removeDir(m_unpackedSymbolsRootPath);
-    if (Q_UNLIKELY(!res)) {
-        m_pUi->stackTracePlainTextEdit->setPlainText(tr("Error: the directory containing the unpacked debugging symbols already exists and can't be removed") +
-                                                     QString::fromUtf8(": ") + QDir::toNativeSeparators(m_unpackedSymbolsRootPath));
-        return;
-    }
+    // NOTE: the unpacked symbols are not removed between the runs, they are kept in the persistent cache
+    // so that the repeated crashes of the same build don't require unpacking the same symbols over again
+    m_unpackedSymbolsRootPath = symbolsCacheRootPath();
 
     QDir unpackRootDir(m_unpackedSymbolsRootPath);
-    res = unpackRootDir.mkpath(m_unpackedSymbolsRootPath);
+    bool res = unpackRootDir.mkpath(m_unpackedSymbolsRootPath);
     if (!res) {
         m_pUi->stackTracePlainTextEdit->setPlainText(tr("Error: the directory for the unpacked debugging symbols can't be created") +
                                                      QString::fromUtf8(": ") + QDir::toNativeSeparators(m_unpackedSymbolsRootPath));
@@ -103,14 +103,14 @@ MainWindow::MainWindow(const QString & quentierSymbolsFileLocation,
 
     SymbolsUnpacker * pQuentierSymbolsUnpacker = new SymbolsUnpacker(quentierSymbolsFileLocation,
                                                                      m_unpackedSymbolsRootPath);
-    QObject::connect(pQuentierSymbolsUnpacker, QNSIGNAL(SymbolsUnpacker,finished,bool,QString),
-                     this, QNSLOT(MainWindow,onSymbolsUnpackerFinished,bool,QString));
+    QObject::connect(pQuentierSymbolsUnpacker, QNSIGNAL(SymbolsUnpacker,finished,bool,QString,QString),
+                     this, QNSLOT(MainWindow,onSymbolsUnpackerFinished,bool,QString,QString));
     ++m_numPendingSymbolsUnpackers;
 
     SymbolsUnpacker * pLibquentierSymbolsUnpacker = new SymbolsUnpacker(libquentierSymbolsFileLocation,
                                                                         m_unpackedSymbolsRootPath);
-    QObject::connect(pLibquentierSymbolsUnpacker, QNSIGNAL(SymbolsUnpacker,finished,bool,QString),
-                     this, QNSLOT(MainWindow,onSymbolsUnpackerFinished,bool,QString));
+    QObject::connect(pLibquentierSymbolsUnpacker, QNSIGNAL(SymbolsUnpacker,finished,bool,QString,QString),
+                     this, QNSLOT(MainWindow,onSymbolsUnpackerFinished,bool,QString,QString));
     ++m_numPendingSymbolsUnpackers;
 
     QThreadPool::globalInstance()->start(pQuentierSymbolsUnpacker);
@@ -132,15 +132,9 @@ void MainWindow::onMinidumpStackwalkReadyReadStandardOutput()
 
     m_output += readData(*pStackwalkProcess, /* from stdout = */ true);
 
-    QString output;
-
-    if (!m_symbolsUnpackingErrors.isEmpty()) {
-        output = m_symbolsUnpackingErrors;
+    if (!m_outputFlushTimer.isActive()) {
+        m_outputFlushTimer.start(OUTPUT_FLUSH_TIMER_MSEC, this);
     }
-
-    output += m_output;
-
-    m_pUi->stackTracePlainTextEdit->setPlainText(output);
 }
 
 void MainWindow::onMinidumpStackwalkReadyReadStandardError()
@@ -158,25 +152,23 @@ void MainWindow::onMinidumpStackwalkProcessFinished(int exitCode, QProcess::Exit
 {
     Q_UNUSED(exitStatus)
 
-    QString output;
+    m_outputFlushTimer.stop();
+    flushPendingOutput(/* stackwalk finished = */ true);
 
-    if (!m_symbolsUnpackingErrors.isEmpty()) {
-        output = m_symbolsUnpackingErrors;
-        output += QString::fromUtf8("\n");
-    }
+    m_pUi->stackTraceLabel->setText(tr("Crash info:"));
 
-    output += QString::fromUtf8("Version info:\n\n");
-    output += versionInfos();
-    output += QString::fromUtf8("\n\n");
-    output += tr("Stacktrace extraction finished, exit code") + QString::fromUtf8(": ") + QString::number(exitCode) + QString::fromUtf8("\n");
-    output += m_output;
-    output += QString::fromUtf8("\n\n");
-    output += m_error;
+    QString output = QString::fromUtf8("\n\n");
+    output += tr("Stacktrace extraction finished, exit code") + QString::fromUtf8(": ") + QString::number(exitCode);
 
-    m_pUi->stackTracePlainTextEdit->setPlainText(output);
+    if (!m_error.isEmpty()) {
+        output += QString::fromUtf8("\n\n");
+        output += m_error;
+    }
+
+    appendText(output);
 }
 
-void MainWindow::onSymbolsUnpackerFinished(bool status, QString errorDescription)
+void MainWindow::onSymbolsUnpackerFinished(bool status, QString errorDescription, QString symbolsPath)
 {
     if (m_numPendingSymbolsUnpackers != 0) {
         --m_numPendingSymbolsUnpackers;
@@ -191,11 +183,17 @@ void MainWindow::onSymbolsUnpackerFinished(bool status, QString errorDescription
         m_symbolsUnpackingErrors += errorDescription;
         m_symbolsUnpackingErrors += QString::fromUtf8("\n");
     }
+    else if (!symbolsPath.isEmpty())
+    {
+        m_unpackedSymbolsPaths << symbolsPath;
+    }
 
     if (m_numPendingSymbolsUnpackers != 0) {
         return;
     }
 
+    evictSymbolsCacheEntries(m_unpackedSymbolsRootPath, SYMBOLS_CACHE_MAX_SIZE, m_unpackedSymbolsPaths);
+
     QProcess * pStackwalkProcess = new QProcess(this);
     QObject::connect(pStackwalkProcess, QNSIGNAL(QProcess,readyReadStandardOutput),
                      this, QNSLOT(MainWindow,onMinidumpStackwalkReadyReadStandardOutput));
@@ -205,9 +203,27 @@ void MainWindow::onSymbolsUnpackerFinished(bool status, QString errorDescription
                      this, SLOT(onMinidumpStackwalkProcessFinished(int,QProcess::ExitStatus)));
 
     QStringList stackwalkArgs;
-    stackwalkArgs.reserve(2);
+    stackwalkArgs.reserve(1 + m_unpackedSymbolsPaths.size());
     stackwalkArgs << QDir::fromNativeSeparators(m_minidumpLocation);
-    stackwalkArgs << m_unpackedSymbolsRootPath;
+    stackwalkArgs << m_unpackedSymbolsPaths;
+
+    // The stackwalk output is appended to the displayed text as it comes, so setting the text preceding it right away
+    QString output;
+
+    if (!m_symbolsUnpackingErrors.isEmpty()) {
+        output = m_symbolsUnpackingErrors;
+        output += QString::fromUtf8("\n");
+    }
+
+    output += QString::fromUtf8("Version info:\n\n");
+    output += versionInfos();
+    output += QString::fromUtf8("\n\n");
+    m_pUi->stackTracePlainTextEdit->setPlainText(output);
+
+    m_output.clear();
+    m_error.clear();
+    m_numDisplayedOutputChars = 0;
+    m_crashedThreadOutputEndIndex = -1;
 
     pStackwalkProcess->start(m_stackwalkBinary, stackwalkArgs, QIODevice::ReadOnly);
 }
@@ -220,6 +236,88 @@ QString MainWindow::readData(QProcess & process, const bool fromStdout)
     return QString::fromUtf8(output);
 }
 
+void MainWindow::flushPendingOutput(const bool stackwalkFinished)
+{
+    int endIndex = m_output.size();
+
+    if (!stackwalkFinished && m_pUi->crashedThreadFirstCheckBox->isChecked())
+    {
+        int crashedThreadEndIndex = crashedThreadOutputEndIndex();
+        if (crashedThreadEndIndex >= 0) {
+            endIndex = crashedThreadEndIndex;
+            m_pUi->stackTraceLabel->setText(tr("Crash info (other threads are shown when the stack trace extraction finishes):"));
+        }
+    }
+
+    if (endIndex <= m_numDisplayedOutputChars) {
+        return;
+    }
+
+    appendText(m_output.mid(m_numDisplayedOutputChars, endIndex - m_numDisplayedOutputChars));
+    m_numDisplayedOutputChars = endIndex;
+}
+
+int MainWindow::crashedThreadOutputEndIndex()
+{
+    if (m_crashedThreadOutputEndIndex >= 0) {
+        return m_crashedThreadOutputEndIndex;
+    }
+
+    // NOTE: minidump_stackwalk prints the stack trace of the crashed thread before the ones of other threads,
+    // the section of each thread starts with "Thread <number>" line, the crashed one's line ends with "(crashed)";
+    // the list of loaded modules follows the threads
+    int crashedThreadIndex = m_output.indexOf(QString::fromUtf8("(crashed)"));
+    if (crashedThreadIndex < 0) {
+        return -1;
+    }
+
+    int nextThreadIndex = m_output.indexOf(QString::fromUtf8("\nThread "), crashedThreadIndex);
+    int loadedModulesIndex = m_output.indexOf(QString::fromUtf8("\nLoaded modules:"), crashedThreadIndex);
+
+    if ((nextThreadIndex >= 0) && (loadedModulesIndex >= 0)) {
+        m_crashedThreadOutputEndIndex = std::min(nextThreadIndex, loadedModulesIndex);
+    }
+    else if (nextThreadIndex >= 0) {
+        m_crashedThreadOutputEndIndex = nextThreadIndex;
+    }
+    else if (loadedModulesIndex >= 0) {
+        m_crashedThreadOutputEndIndex = loadedModulesIndex;
+    }
+
+    return m_crashedThreadOutputEndIndex;
+}
+
+void MainWindow::appendText(const QString & text)
+{
+    // NOTE: appending through the cursor instead of re-setting the whole text to keep the cost of each update
+    // proportional to the size of the appended portion rather than to the size of the whole text
+    QScrollBar * pScrollBar = m_pUi->stackTracePlainTextEdit->verticalScrollBar();
+    int scrollBarValue = (pScrollBar ? pScrollBar->value() : 0);
+
+    QTextCursor cursor(m_pUi->stackTracePlainTextEdit->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(text);
+
+    if (pScrollBar) {
+        pScrollBar->setValue(scrollBarValue);
+    }
+}
+
+void MainWindow::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_outputFlushTimer.timerId()) {
+        m_outputFlushTimer.stop();
+        flushPendingOutput(/* stackwalk finished = */ false);
+        return;
+    }
+
+    QMainWindow::timerEvent(pEvent);
+}
+
 QString MainWindow::versionInfos() const
 {
     QString result = QString::fromUtf8("libquentier: ");
@@ -22,6 +22,8 @@
 #include <QMainWindow>
 #include <QString>
 #include <QProcess>
+#include <QStringList>
+#include <QBasicTimer>
 
 namespace Ui {
 class MainWindow;
@@ -43,12 +45,23 @@ private Q_SLOTS:
     void onMinidumpStackwalkReadyReadStandardError();
     void onMinidumpStackwalkProcessFinished(int exitCode, QProcess::ExitStatus ExitStatus);
 
-    void onSymbolsUnpackerFinished(bool status, QString errorDescription);
+    void onSymbolsUnpackerFinished(bool status, QString errorDescription, QString symbolsPath);
 
 private:
     QString readData(QProcess & process, const bool fromStdout);
     QString versionInfos() const;
 
+    /**
+     * Appends the portion of stackwalk output accumulated since the previous call to the displayed text;
+     * if the crashed thread is to be shown first, the output following the crashed thread's stack trace
+     * is held until the stackwalk process finishes
+     */
+    void flushPendingOutput(const bool stackwalkFinished);
+    int crashedThreadOutputEndIndex();
+    void appendText(const QString & text);
+
+    virtual void timerEvent(QTimerEvent * pEvent) Q_DECL_OVERRIDE;
+
 private:
     Ui::MainWindow *    m_pUi;
     int                 m_numPendingSymbolsUnpackers;
@@ -56,8 +69,13 @@ private:
     QString             m_stackwalkBinary;
     QString             m_unpackedSymbolsRootPath;
     QString             m_symbolsUnpackingErrors;
+    QStringList         m_unpackedSymbolsPaths;
     QString             m_output;
     QString             m_error;
+
+    int                 m_numDisplayedOutputChars;
+    int                 m_crashedThreadOutputEndIndex;
+    QBasicTimer         m_outputFlushTimer;
 };
 
 #endif // QUENTIER_CRASH_HANDLER_MAINWINDOW_H
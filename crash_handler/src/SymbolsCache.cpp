@@ -0,0 +1,151 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SymbolsCache.h"
+#include "Utility.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QDateTime>
+#include <QVector>
+#include <algorithm>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+#include <QStandardPaths>
+#else
+#include <QDesktopServices>
+#endif
+
+#define SYMBOLS_CACHE_ENTRY_LAST_USED_FILE_NAME "lastUsed"
+
+namespace {
+
+struct SymbolsCacheEntryInfo
+{
+    QString     m_path;
+    qint64      m_size;
+    qint64      m_lastUsedTimestamp;
+};
+
+bool lessByLastUsedTimestamp(const SymbolsCacheEntryInfo & lhs, const SymbolsCacheEntryInfo & rhs)
+{
+    return lhs.m_lastUsedTimestamp < rhs.m_lastUsedTimestamp;
+}
+
+qint64 entrySize(const QString & entryPath)
+{
+    qint64 size = 0;
+    QDirIterator it(entryPath, QDir::Files | QDir::Hidden | QDir::System, QDirIterator::Subdirectories);
+    while(it.hasNext()) {
+        Q_UNUSED(it.next())
+        size += it.fileInfo().size();
+    }
+
+    return size;
+}
+
+qint64 entryLastUsedTimestamp(const QString & entryPath)
+{
+    QFile lastUsedFile(entryPath + QString::fromUtf8("/" SYMBOLS_CACHE_ENTRY_LAST_USED_FILE_NAME));
+    if (!lastUsedFile.open(QIODevice::ReadOnly)) {
+        // Entries without the marker are considered to be the least recently used ones
+        return 0;
+    }
+
+    bool conversionResult = false;
+    qint64 timestamp = lastUsedFile.readAll().trimmed().toLongLong(&conversionResult);
+    if (!conversionResult) {
+        return 0;
+    }
+
+    return timestamp;
+}
+
+} // namespace
+
+QString symbolsCacheRootPath()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    QString cacheDirPath = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+#else
+    QString cacheDirPath = QDesktopServices::storageLocation(QDesktopServices::CacheLocation);
+#endif
+
+    return cacheDirPath + QString::fromUtf8("/Quentier_debugging_symbols/symbols_cache");
+}
+
+void markSymbolsCacheEntryUsed(const QString & entryPath)
+{
+    QFile lastUsedFile(entryPath + QString::fromUtf8("/" SYMBOLS_CACHE_ENTRY_LAST_USED_FILE_NAME));
+    if (!lastUsedFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return;
+    }
+
+    lastUsedFile.write(QByteArray::number(QDateTime::currentMSecsSinceEpoch()));
+    lastUsedFile.close();
+}
+
+void evictSymbolsCacheEntries(const QString & cacheRootPath, const qint64 maxTotalSize,
+                              const QStringList & keptEntryPaths)
+{
+    QDir cacheRootDir(cacheRootPath);
+    if (!cacheRootDir.exists()) {
+        return;
+    }
+
+    QStringList keptEntryAbsolutePaths;
+    keptEntryAbsolutePaths.reserve(keptEntryPaths.size());
+    for(auto it = keptEntryPaths.constBegin(), end = keptEntryPaths.constEnd(); it != end; ++it) {
+        keptEntryAbsolutePaths << QFileInfo(*it).absoluteFilePath();
+    }
+
+    QVector<SymbolsCacheEntryInfo> evictableEntries;
+    qint64 totalSize = 0;
+
+    QFileInfoList entries = cacheRootDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for(auto it = entries.constBegin(), end = entries.constEnd(); it != end; ++it)
+    {
+        SymbolsCacheEntryInfo entryInfo;
+        entryInfo.m_path = it->absoluteFilePath();
+        entryInfo.m_size = entrySize(entryInfo.m_path);
+        totalSize += entryInfo.m_size;
+
+        if (keptEntryAbsolutePaths.contains(entryInfo.m_path)) {
+            continue;
+        }
+
+        entryInfo.m_lastUsedTimestamp = entryLastUsedTimestamp(entryInfo.m_path);
+        evictableEntries << entryInfo;
+    }
+
+    if (totalSize <= maxTotalSize) {
+        return;
+    }
+
+    std::sort(evictableEntries.begin(), evictableEntries.end(), lessByLastUsedTimestamp);
+
+    for(auto it = evictableEntries.constBegin(), end = evictableEntries.constEnd();
+        (it != end) && (totalSize > maxTotalSize); ++it)
+    {
+        if (removeDir(it->m_path)) {
+            totalSize -= it->m_size;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_CRASH_HANDLER_SYMBOLS_CACHE_H
+#define QUENTIER_CRASH_HANDLER_SYMBOLS_CACHE_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * The unpacked symbols are kept between the runs of the crash handler in a persistent cache.
+ * Each entry of the cache is a directory named after the module id from the MODULE line of the symbols file;
+ * within it the symbols are laid out the way minidump_stackwalk expects them, so each entry's path
+ * can be passed to minidump_stackwalk as is.
+ */
+
+/**
+ * @return the path to the root directory of the persistent unpacked symbols cache
+ */
+QString symbolsCacheRootPath();
+
+/**
+ * Records the current time as the last usage time of the cache entry; the least recently used entries
+ * are evicted first
+ */
+void markSymbolsCacheEntryUsed(const QString & entryPath);
+
+/**
+ * Removes the least recently used entries from the cache until the total size of the remaining ones
+ * is not greater than maxTotalSize; the entries listed in keptEntryPaths are never removed
+ */
+void evictSymbolsCacheEntries(const QString & cacheRootPath, const qint64 maxTotalSize,
+                              const QStringList & keptEntryPaths);
+
+#endif // QUENTIER_CRASH_HANDLER_SYMBOLS_CACHE_H
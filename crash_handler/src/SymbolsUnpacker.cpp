@@ -18,15 +18,34 @@
 
 #include "SymbolsUnpacker.h"
 #include "Utility.h"
+#include "SymbolsCache.h"
+#include <CompressedSymbolsFormat.h>
 #include <VersionInfo.h>
 #include <QFileInfo>
 #include <QFile>
-#include <QTemporaryFile>
+#include <QThreadPool>
 #include <QDir>
 #include <QRegExp>
-#include <iostream>
-#include <fstream>
-#include <cstring>
+#include <QDataStream>
+#include <algorithm>
+
+class BlockUncompressor: public QRunnable
+{
+public:
+    BlockUncompressor(const QByteArray & input, QByteArray * pOutput) :
+        m_input(input),
+        m_pOutput(pOutput)
+    {}
+
+    virtual void run()
+    {
+        *m_pOutput = qUncompress(m_input);
+    }
+
+private:
+    QByteArray      m_input;
+    QByteArray *    m_pOutput;
+};
 
 SymbolsUnpacker::SymbolsUnpacker(const QString & compressedSymbolsFilePath,
                                  const QString & unpackedSymbolsRootPath,
@@ -49,7 +68,7 @@ void SymbolsUnpacker::run()
         if (!unpackedSymbolsRootDir.mkpath(unpackedSymbolsRootPath)) {
             QString errorDescription = tr("Error: can't create the directory for the unpacked symbols file") +
                                        QString::fromUtf8(": ") + QDir::toNativeSeparators(unpackedSymbolsRootPath);
-            emit finished(/* status = */ false, errorDescription);
+            emit finished(/* status = */ false, errorDescription, QString());
             return;
         }
     }
@@ -57,18 +76,18 @@ void SymbolsUnpacker::run()
     {
         QString errorDescription = tr("Error: the path to the directory for the unpacked symbols file doesn't really point to a directory") +
                                        QString::fromUtf8(": ") + QDir::toNativeSeparators(unpackedSymbolsRootPath);
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
     else if (Q_UNLIKELY(!unpackedSymbolsRootDirInfo.isWritable()))
     {
         QString errorDescription = tr("Error: the directory for the unpacked symbols is not writable") +
             QString::fromUtf8(": ") + QDir::toNativeSeparators(unpackedSymbolsRootPath);
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
-    // 2) Read the data from the compressed symbols file
+    // 2) Open the compressed symbols file
 
     QString compressedSymbolsFilePath = nativePathToUnixPath(m_compressedSymbolsFilePath);
     QFileInfo compressedSymbolsFileInfo(compressedSymbolsFilePath);
@@ -76,14 +95,14 @@ void SymbolsUnpacker::run()
     if (Q_UNLIKELY(!compressedSymbolsFileInfo.exists())) {
         QString errorDescription = tr("Error: compressed symbols file doesn't exist") + QString::fromUtf8(": ") +
                                    QDir::toNativeSeparators(compressedSymbolsFilePath);
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
     if (Q_UNLIKELY(!compressedSymbolsFileInfo.isFile())) {
         QString errorDescription = tr("Error: the path to symbols file doesn't really point to a file") +
                                    QString::fromUtf8(": ") + QDir::toNativeSeparators(compressedSymbolsFilePath);
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
@@ -91,48 +110,46 @@ void SymbolsUnpacker::run()
     if (!compressedSymbolsFile.open(QIODevice::ReadOnly)) {
         QString errorDescription = tr("Error: can't open the compressed symbols file for reading") +
                                    QString::fromUtf8(": ") + QDir::toNativeSeparators(compressedSymbolsFilePath);
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
-    QByteArray symbolsUncompressedData = compressedSymbolsFile.readAll();
-    compressedSymbolsFile.close();
+    // 3) Uncompress the first block of the symbols data: the first line of the symbols file
+    // is used to identify the name of the symbols source as well as its id
 
-    // 3) Uncompress the symbols data and write them into a temporary file
-
-    QTemporaryFile uncompressedSymbolsFile;
-    if (!uncompressedSymbolsFile.open()) {
-        QString errorDescription = tr("Error: can't create the temporary file to store the uncompressed symbols read from the compressed file");
-        emit finished(/* status = */ false, errorDescription);
+    QVector<CompressedSymbolsBlockInfo> index;
+    QString unpackingErrorDescription;
+    if (Q_UNLIKELY(!readBlocksIndex(compressedSymbolsFile, index, unpackingErrorDescription))) {
+        emit finished(/* status = */ false, unpackingErrorDescription, QString());
         return;
     }
 
-    uncompressedSymbolsFile.setAutoRemove(true);
-
-    symbolsUncompressedData = qUncompress(symbolsUncompressedData);
-    uncompressedSymbolsFile.write(symbolsUncompressedData);
-
-    // 4) Read the first line from the uncompressed symbols file and use that data
-    // to identify the name of the symbols source as well as its id
-
-    QFileInfo uncompressedSymbolsFileInfo(uncompressedSymbolsFile);
-
-    // NOTE: all attempts to read the first line from the symbols file using QFile's API result in crash for unknown reason;
-    // maybe it doesn't like what it finds within the file, I have no idea.
-    // Working around this crap by using C++ standard library's API.
-    std::ifstream symbolsFileStream;
-    symbolsFileStream.open(QDir::toNativeSeparators(uncompressedSymbolsFileInfo.absoluteFilePath()).toLocal8Bit().constData(), std::ifstream::in);
-    if (Q_UNLIKELY(!symbolsFileStream.good())) {
-        QString errorDescription = tr("Error: can't open the temporary uncompressed symbols file for reading") +
-                                   QString::fromUtf8(": ") + QDir::toNativeSeparators(uncompressedSymbolsFileInfo.absoluteFilePath());
-        emit finished(/* status = */ false, errorDescription);
-        return;
+    QByteArray symbolsUncompressedData;
+    if (index.isEmpty())
+    {
+        // Legacy format: the whole symbols file was compressed at once so it can only be uncompressed at once
+        symbolsUncompressedData = qUncompress(compressedSymbolsFile.readAll());
     }
+    else
+    {
+        QByteArray compressedBlock;
+        if (Q_UNLIKELY(!readBlock(compressedSymbolsFile, index[0], compressedBlock, unpackingErrorDescription))) {
+            emit finished(/* status = */ false, unpackingErrorDescription, QString());
+            return;
+        }
 
-    char buf[1024];
-    symbolsFileStream.getline(buf, 1024);
+        symbolsUncompressedData = qUncompress(compressedBlock);
+        if (Q_UNLIKELY(static_cast<quint32>(symbolsUncompressedData.size()) != index[0].m_uncompressedSize)) {
+            unpackingErrorDescription = tr("Error: failed to uncompress the block of the compressed symbols file");
+            emit finished(/* status = */ false, unpackingErrorDescription, QString());
+            return;
+        }
+    }
 
-    QByteArray symbolsFirstLineBytes(buf, 1024);
+    int firstLineBreakIndex = symbolsUncompressedData.indexOf('\n');
+    QByteArray symbolsFirstLineBytes = symbolsUncompressedData.left(((firstLineBreakIndex >= 0) && (firstLineBreakIndex < 1024))
+                                                                    ? firstLineBreakIndex
+                                                                    : 1024);
     QString symbolsFirstLine = QString::fromUtf8(symbolsFirstLineBytes);
     QString symbolsSourceName = compressedSymbolsFileInfo.fileName();
     int suffixIndex = symbolsSourceName.indexOf(QString::fromUtf8(".syms.compressed"));
@@ -152,8 +169,8 @@ void SymbolsUnpacker::run()
         QString errorDescription = tr("Error: can't find the symbols source name hint") +
                                    QString::fromUtf8(" \"") + symbolsSourceName + QString::fromUtf8("\" ") +
                                    tr("within the first 1024 bytes read from the symbols file") +
-                                   QString::fromUtf8(": ") + QString::fromLocal8Bit(buf, 1024);
-        emit finished(/* status = */ false, errorDescription);
+                                   QString::fromUtf8(": ") + QString::fromLocal8Bit(symbolsFirstLineBytes);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
@@ -165,7 +182,7 @@ void SymbolsUnpacker::run()
     if (symbolsFirstLineTokens.size() != 5) {
         QString errorDescription = tr("Error: unexpected number of tokens at the first line of the symbols file") +
                                    QString::fromUtf8(": ") + symbolsFirstLineTokens.join(QString::fromUtf8(", "));
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
@@ -173,7 +190,7 @@ void SymbolsUnpacker::run()
     if (Q_UNLIKELY(symbolsId.isEmpty())) {
         QString errorDescription = tr("Error: symbol id is empty, first line of the minidump file") +
                                    QString::fromUtf8(": ") + symbolsFirstLineTokens.join(QString::fromUtf8(", "));
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
@@ -181,7 +198,7 @@ void SymbolsUnpacker::run()
     if (Q_UNLIKELY(symbolsSourceName.isEmpty())) {
         QString errorDescription = tr("Error: minidump's application name is empty, first line of the minidump file") +
                                    QString::fromUtf8(": ") + symbolsFirstLineTokens.join(QString::fromUtf8(", "));
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
@@ -198,47 +215,56 @@ void SymbolsUnpacker::run()
     }
 #endif
 
-    QString unpackDirPath = unpackedSymbolsRootPath + QString::fromUtf8("/") +
-                            symbolsSourceName + QString::fromUtf8("/") + symbolsId;
+    // The cache entry is keyed by the module id from the MODULE line as it is in the symbols file,
+    // before the id is possibly adjusted above to match the one within the minidump
+    QString cacheEntryPath = unpackedSymbolsRootPath + QString::fromUtf8("/") + symbolsFirstLineTokens.at(3);
+    QString unpackDirPath = cacheEntryPath + QString::fromUtf8("/") + symbolsSourceName + QString::fromUtf8("/") + symbolsId;
 
-    bool res = removeDir(unpackDirPath);
+#ifdef _MSC_VER
+    int pdbIndex = symbolsSourceName.indexOf(QString::fromUtf8(".pdb"));
+    if (pdbIndex > 0) {
+        symbolsSourceName.truncate(pdbIndex);
+    }
+#endif
+
+    QString newSymbolsFilePath = unpackDirPath + QString::fromUtf8("/") + symbolsSourceName + QString::fromUtf8(".sym");
+
+    // The unpacked symbols file appears under its final name only after it has been completely written,
+    // so its presence means the symbols for this module were already unpacked during some previous run
+    if (QFileInfo(newSymbolsFilePath).isFile()) {
+        markSymbolsCacheEntryUsed(cacheEntryPath);
+        emit finished(/* status = */ true, QString(), cacheEntryPath);
+        return;
+    }
+
+    bool res = removeDir(cacheEntryPath);
     if (Q_UNLIKELY(!res)) {
-        QString errorDescription = tr("Error: the temporary directory for unpacked symbols already exists and it can't be removed") +
-                                   QString::fromUtf8(":\n") + QDir::toNativeSeparators(unpackDirPath);
-        emit finished(/* status = */ false, errorDescription);
+        QString errorDescription = tr("Error: the incomplete cache entry for unpacked symbols already exists and it can't be removed") +
+                                   QString::fromUtf8(":\n") + QDir::toNativeSeparators(cacheEntryPath);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
     QDir unpackDir(unpackDirPath);
     res = unpackDir.mkpath(unpackDirPath);
     if (Q_UNLIKELY(!res)) {
-        QString errorDescription = tr("Error: failed to create the temporary directory for unpacking the symbols") +
+        QString errorDescription = tr("Error: failed to create the directory for unpacking the symbols") +
                                    QString::fromUtf8(":\n") + QDir::toNativeSeparators(unpackDirPath);
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
-#ifdef _MSC_VER
-    int pdbIndex = symbolsSourceName.indexOf(QString::fromUtf8(".pdb"));
-    if (pdbIndex > 0) {
-        symbolsSourceName.truncate(pdbIndex);
-    }
-#endif
-
-    QString newSymbolsFilePath = unpackDirPath + QString::fromUtf8("/") + symbolsSourceName + QString::fromUtf8(".sym");
-
-    QFile newSymbolsFile(newSymbolsFilePath);
+    QFile newSymbolsFile(newSymbolsFilePath + QString::fromUtf8(".part"));
     res = newSymbolsFile.open(QIODevice::WriteOnly);
     if (Q_UNLIKELY(!res)) {
-        QString errorDescription = tr("Error: failed to open the temporary file for unpacked symbols for writing") +
+        QString errorDescription = tr("Error: failed to open the file for unpacked symbols for writing") +
                                    QString::fromUtf8(":\n") + QDir::toNativeSeparators(unpackDirPath);
-        emit finished(/* status = */ false, errorDescription);
+        emit finished(/* status = */ false, errorDescription, QString());
         return;
     }
 
 #ifndef _MSC_VER
     // Need to replace the first line within the uncompressed data to ensure the proper names used
-    int firstLineBreakIndex = symbolsUncompressedData.indexOf('\n');
     if (firstLineBreakIndex > 0) {
         QString replacementFirstLine = QString::fromUtf8("MODULE ");
         replacementFirstLine += symbolsFirstLineTokens[1];
@@ -254,7 +280,158 @@ void SymbolsUnpacker::run()
 #endif
 
     newSymbolsFile.write(symbolsUncompressedData);
+    symbolsUncompressedData.clear();
+
+    if (!index.isEmpty() &&
+        Q_UNLIKELY(!unpackRemainingBlocks(compressedSymbolsFile, index, newSymbolsFile, unpackingErrorDescription)))
+    {
+        compressedSymbolsFile.close();
+        Q_UNUSED(newSymbolsFile.remove())
+        emit finished(/* status = */ false, unpackingErrorDescription, QString());
+        return;
+    }
+
+    compressedSymbolsFile.close();
     newSymbolsFile.close();
 
-    emit finished(/* status = */ true, QString());
+    if (Q_UNLIKELY(!newSymbolsFile.rename(newSymbolsFilePath))) {
+        Q_UNUSED(newSymbolsFile.remove())
+        QString errorDescription = tr("Error: failed to rename the unpacked symbols file") +
+                                   QString::fromUtf8(":\n") + QDir::toNativeSeparators(newSymbolsFilePath);
+        emit finished(/* status = */ false, errorDescription, QString());
+        return;
+    }
+
+    markSymbolsCacheEntryUsed(cacheEntryPath);
+    emit finished(/* status = */ true, QString(), cacheEntryPath);
+}
+
+bool SymbolsUnpacker::readBlocksIndex(QFile & compressedSymbolsFile, QVector<CompressedSymbolsBlockInfo> & index,
+                                      QString & errorDescription) const
+{
+    index.clear();
+
+    const QByteArray magic(COMPRESSED_SYMBOLS_FORMAT_MAGIC, COMPRESSED_SYMBOLS_FORMAT_MAGIC_SIZE);
+    QByteArray fileStart = compressedSymbolsFile.read(COMPRESSED_SYMBOLS_FORMAT_MAGIC_SIZE);
+    if (fileStart != magic) {
+        // Legacy format, there's no index
+        return compressedSymbolsFile.seek(0);
+    }
+
+    qint64 fileSize = compressedSymbolsFile.size();
+    if (Q_UNLIKELY(fileSize < (COMPRESSED_SYMBOLS_FORMAT_HEADER_SIZE + COMPRESSED_SYMBOLS_FORMAT_TRAILER_SIZE))) {
+        errorDescription = tr("Error: the compressed symbols file is truncated");
+        return false;
+    }
+
+    if (Q_UNLIKELY(!compressedSymbolsFile.seek(fileSize - COMPRESSED_SYMBOLS_FORMAT_TRAILER_SIZE))) {
+        errorDescription = tr("Error: failed to read the index of the compressed symbols file");
+        return false;
+    }
+
+    QByteArray trailer = compressedSymbolsFile.read(COMPRESSED_SYMBOLS_FORMAT_TRAILER_SIZE);
+    if (Q_UNLIKELY(!trailer.endsWith(magic))) {
+        errorDescription = tr("Error: the compressed symbols file is truncated");
+        return false;
+    }
+
+    QDataStream trailerStream(trailer);
+    quint64 indexOffset = 0;
+    quint32 numBlocks = 0;
+    trailerStream >> indexOffset >> numBlocks;
+
+    quint64 indexSize = static_cast<quint64>(numBlocks) * COMPRESSED_SYMBOLS_FORMAT_INDEX_ENTRY_SIZE;
+    if (Q_UNLIKELY((numBlocks == 0) ||
+                   (indexOffset + indexSize + COMPRESSED_SYMBOLS_FORMAT_TRAILER_SIZE != static_cast<quint64>(fileSize)) ||
+                   !compressedSymbolsFile.seek(static_cast<qint64>(indexOffset))))
+    {
+        errorDescription = tr("Error: the index of the compressed symbols file is corrupted");
+        return false;
+    }
+
+    QByteArray indexData = compressedSymbolsFile.read(static_cast<qint64>(indexSize));
+    QDataStream indexStream(indexData);
+
+    index.reserve(static_cast<int>(numBlocks));
+    for(quint32 i = 0; i < numBlocks; ++i)
+    {
+        CompressedSymbolsBlockInfo blockInfo;
+        indexStream >> blockInfo.m_offset >> blockInfo.m_compressedSize >> blockInfo.m_uncompressedSize;
+
+        if (Q_UNLIKELY((indexStream.status() != QDataStream::Ok) ||
+                       (blockInfo.m_offset + blockInfo.m_compressedSize > indexOffset)))
+        {
+            errorDescription = tr("Error: the index of the compressed symbols file is corrupted");
+            index.clear();
+            return false;
+        }
+
+        index << blockInfo;
+    }
+
+    return true;
+}
+
+bool SymbolsUnpacker::readBlock(QFile & compressedSymbolsFile, const CompressedSymbolsBlockInfo & blockInfo,
+                                QByteArray & compressedBlock, QString & errorDescription) const
+{
+    if (Q_UNLIKELY(!compressedSymbolsFile.seek(static_cast<qint64>(blockInfo.m_offset)))) {
+        errorDescription = tr("Error: failed to read the block of the compressed symbols file");
+        return false;
+    }
+
+    compressedBlock = compressedSymbolsFile.read(static_cast<qint64>(blockInfo.m_compressedSize));
+    if (Q_UNLIKELY(static_cast<quint32>(compressedBlock.size()) != blockInfo.m_compressedSize)) {
+        errorDescription = tr("Error: failed to read the block of the compressed symbols file");
+        return false;
+    }
+
+    return true;
+}
+
+bool SymbolsUnpacker::unpackRemainingBlocks(QFile & compressedSymbolsFile, const QVector<CompressedSymbolsBlockInfo> & index,
+                                            QFile & newSymbolsFile, QString & errorDescription) const
+{
+    // NOTE: using the local thread pool since this runnable itself may occupy a thread from the global one
+    QThreadPool threadPool;
+
+    // The number of blocks being uncompressed at once is limited to keep the memory consumption bounded
+    const int batchSize = std::max(threadPool.maxThreadCount(), 1) * 2;
+    QVector<QByteArray> uncompressedBlocks(batchSize);
+
+    for(int batchStart = 1, numBlocks = index.size(); batchStart < numBlocks; batchStart += batchSize)
+    {
+        int batchEnd = std::min(batchStart + batchSize, numBlocks);
+
+        for(int i = batchStart; i < batchEnd; ++i)
+        {
+            QByteArray compressedBlock;
+            if (Q_UNLIKELY(!readBlock(compressedSymbolsFile, index[i], compressedBlock, errorDescription))) {
+                threadPool.waitForDone();
+                return false;
+            }
+
+            threadPool.start(new BlockUncompressor(compressedBlock, &uncompressedBlocks[i - batchStart]));
+        }
+
+        threadPool.waitForDone();
+
+        for(int i = batchStart; i < batchEnd; ++i)
+        {
+            QByteArray & uncompressedBlock = uncompressedBlocks[i - batchStart];
+            if (Q_UNLIKELY(static_cast<quint32>(uncompressedBlock.size()) != index[i].m_uncompressedSize)) {
+                errorDescription = tr("Error: failed to uncompress the block of the compressed symbols file");
+                return false;
+            }
+
+            if (Q_UNLIKELY(newSymbolsFile.write(uncompressedBlock) != static_cast<qint64>(uncompressedBlock.size()))) {
+                errorDescription = tr("Error: failed to write the unpacked symbols to the file");
+                return false;
+            }
+
+            uncompressedBlock.clear();
+        }
+    }
+
+    return true;
 }
@@ -23,6 +23,11 @@
 #include <QRunnable>
 #include <QString>
 #include <QByteArray>
+#include <QVector>
+
+QT_FORWARD_DECLARE_CLASS(QFile)
+
+struct CompressedSymbolsBlockInfo;
 
 class SymbolsUnpacker: public QObject,
                        public QRunnable
@@ -36,7 +41,31 @@ public:
     virtual void run();
 
 Q_SIGNALS:
-    void finished(bool status, QString errorDescription);
+    /**
+     * @param status                The status of unpacking
+     * @param errorDescription      The description of the error if status is false
+     * @param symbolsPath           The path to the directory with the unpacked symbols which should be passed
+     *                              to minidump_stackwalk, empty if status is false
+     */
+    void finished(bool status, QString errorDescription, QString symbolsPath);
+
+private:
+    /**
+     * Reads the index of blocks from the compressed symbols file; if the file is in the legacy format
+     * (the whole symbols file compressed at once), the index is left empty
+     */
+    bool readBlocksIndex(QFile & compressedSymbolsFile, QVector<CompressedSymbolsBlockInfo> & index,
+                         QString & errorDescription) const;
+
+    bool readBlock(QFile & compressedSymbolsFile, const CompressedSymbolsBlockInfo & blockInfo,
+                   QByteArray & compressedBlock, QString & errorDescription) const;
+
+    /**
+     * Uncompresses the blocks starting from the second one in parallel, in batches of limited size,
+     * and appends them to the unpacked symbols file in the original order
+     */
+    bool unpackRemainingBlocks(QFile & compressedSymbolsFile, const QVector<CompressedSymbolsBlockInfo> & index,
+                               QFile & newSymbolsFile, QString & errorDescription) const;
 
 private:
     QString     m_compressedSymbolsFilePath;
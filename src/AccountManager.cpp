@@ -25,14 +25,61 @@
 #include <quentier/utility/Utility.h>
 #include <quentier/logging/QuentierLogger.h>
 #include <QXmlStreamWriter>
+#include <QFileInfo>
+#include <QDateTime>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+#include <QSaveFile>
+#endif
 
 // NOTE: Workaround a bug in Qt4 which may prevent building with some boost versions
 #ifndef Q_MOC_RUN
 #include <boost/scope_exit.hpp>
 #endif
 
+// The index of available accounts which saves the account manager from examining each account's dir at startup;
+// the index is considered valid only as long as the dirs containing the accounts' dirs and the accounts' info files
+// remain unmodified
+#define ACCOUNTS_INDEX_FILE_NAME "accountsIndex.txt"
+#define ACCOUNTS_INDEX_VERSION (2)
+
+// The coarsest modification time granularity among the file systems the app's data might reside on (FAT has
+// two seconds): the file modified within this interval before the index was written might be modified again
+// without changing its modification time, so the index isn't trusted for such files
+#define ACCOUNTS_INDEX_TIMESTAMP_GRANULARITY_MSEC (2000)
+
 namespace quentier {
 
+static qint64 modificationTimestamp(const QString & path)
+{
+    QFileInfo fileInfo(path);
+    if (!fileInfo.exists()) {
+        return -1;
+    }
+
+    return fileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+static qint64 fileSize(const QString & filePath)
+{
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists()) {
+        return -1;
+    }
+
+    return fileInfo.size();
+}
+
+static QString accountInfoFilePath(const Account & account)
+{
+    return accountPersistentStoragePath(account) + QStringLiteral("/accountInfo.txt");
+}
+
+static bool modifiedTooCloseToIndexTimestamp(const qint64 timestamp, const qint64 indexTimestamp)
+{
+    return (timestamp >= 0) && (timestamp + ACCOUNTS_INDEX_TIMESTAMP_GRANULARITY_MSEC > indexTimestamp);
+}
+
 AccountManager::AccountManager(QObject * parent) :
     QObject(parent),
     m_availableAccounts()
@@ -40,6 +87,11 @@ AccountManager::AccountManager(QObject * parent) :
     detectAvailableAccounts();
 }
 
+AccountManager::AccountManager(const QVector<Account> & availableAccounts, QObject * parent) :
+    QObject(parent),
+    m_availableAccounts(availableAccounts)
+{}
+
 Account AccountManager::currentAccount(bool * pCreatedDefaultAccount)
 {
     QNDEBUG(QStringLiteral("AccountManager::currentAccount"));
@@ -145,6 +197,7 @@ void AccountManager::switchAccount(const Account & account)
         }
 
         m_availableAccounts << account;
+        updateAccountsIndex();
         Q_EMIT accountAdded(account);
     }
     else
@@ -223,6 +276,7 @@ void AccountManager::onAccountDisplayNameChanged(Account account)
     }
 
     m_availableAccounts[index].setDisplayName(account.displayName());
+    updateAccountsIndex();
     Q_EMIT accountUpdated(account);
 }
 
@@ -230,6 +284,11 @@ void AccountManager::detectAvailableAccounts()
 {
     QNDEBUG(QStringLiteral("AccountManager::detectAvailableAccounts"));
 
+    if (readAccountsIndex()) {
+        QNDEBUG(QStringLiteral("Read ") << m_availableAccounts.size() << QStringLiteral(" available accounts from the accounts index"));
+        return;
+    }
+
     QString appPersistenceStoragePath = applicationPersistentStoragePath();
 
     QString localAccountsStoragePath = appPersistenceStoragePath + QStringLiteral("/LocalAccounts");
@@ -322,6 +381,232 @@ void AccountManager::detectAvailableAccounts()
                 << availableAccount.evernoteAccountType() << QStringLiteral(", Evernote host = ")
                 << availableAccount.evernoteHost() << QStringLiteral(", dir ") << accountDirInfo.absoluteFilePath());
     }
+
+    updateAccountsIndex();
+}
+
+bool AccountManager::readAccountsIndex()
+{
+    QNDEBUG(QStringLiteral("AccountManager::readAccountsIndex"));
+
+    QString appPersistenceStoragePath = applicationPersistentStoragePath();
+
+    QFile accountsIndex(appPersistenceStoragePath + QStringLiteral("/" ACCOUNTS_INDEX_FILE_NAME));
+    if (!accountsIndex.exists()) {
+        QNDEBUG(QStringLiteral("The accounts index doesn't exist yet"));
+        return false;
+    }
+
+    bool open = accountsIndex.open(QIODevice::ReadOnly);
+    if (Q_UNLIKELY(!open)) {
+        QNWARNING(QStringLiteral("Can't open the accounts index for reading: ") << accountsIndex.errorString());
+        return false;
+    }
+
+    QXmlStreamReader reader(&accountsIndex);
+    if (!reader.readNextStartElement() || (reader.name() != QStringLiteral("accountsIndex"))) {
+        QNWARNING(QStringLiteral("Can't read the accounts index: no root element found"));
+        return false;
+    }
+
+    QXmlStreamAttributes indexAttributes = reader.attributes();
+
+    bool conversionResult = false;
+    int version = indexAttributes.value(QStringLiteral("version")).toString().toInt(&conversionResult);
+    if (!conversionResult || (version != ACCOUNTS_INDEX_VERSION)) {
+        QNDEBUG(QStringLiteral("The accounts index has unsupported version"));
+        return false;
+    }
+
+    qint64 indexTimestamp = indexAttributes.value(QStringLiteral("timestamp")).toString().toLongLong(&conversionResult);
+    if (!conversionResult) {
+        QNWARNING(QStringLiteral("Can't read the accounts index: no valid timestamp of the index found"));
+        return false;
+    }
+
+    // Any account dir created, renamed or removed changes the modification time of the dir containing it
+    qint64 localAccountsDirTimestamp = indexAttributes.value(QStringLiteral("localAccountsDirTimestamp")).toString().toLongLong(&conversionResult);
+    if (!conversionResult ||
+        (localAccountsDirTimestamp != modificationTimestamp(appPersistenceStoragePath + QStringLiteral("/LocalAccounts"))) ||
+        modifiedTooCloseToIndexTimestamp(localAccountsDirTimestamp, indexTimestamp))
+    {
+        QNDEBUG(QStringLiteral("The accounts index is outdated: the local accounts' dirs have changed"));
+        return false;
+    }
+
+    qint64 evernoteAccountsDirTimestamp = indexAttributes.value(QStringLiteral("evernoteAccountsDirTimestamp")).toString().toLongLong(&conversionResult);
+    if (!conversionResult ||
+        (evernoteAccountsDirTimestamp != modificationTimestamp(appPersistenceStoragePath + QStringLiteral("/EvernoteAccounts"))) ||
+        modifiedTooCloseToIndexTimestamp(evernoteAccountsDirTimestamp, indexTimestamp))
+    {
+        QNDEBUG(QStringLiteral("The accounts index is outdated: the Evernote accounts' dirs have changed"));
+        return false;
+    }
+
+    QVector<Account> availableAccounts;
+    while(reader.readNextStartElement())
+    {
+        if (reader.name() != QStringLiteral("account")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        QXmlStreamAttributes attributes = reader.attributes();
+        reader.skipCurrentElement();
+
+        QString name = attributes.value(QStringLiteral("name")).toString();
+        if (Q_UNLIKELY(name.isEmpty())) {
+            QNWARNING(QStringLiteral("Found account without name within the accounts index"));
+            return false;
+        }
+
+        bool isLocal = (attributes.value(QStringLiteral("type")) == QStringLiteral("Local"));
+
+        qevercloud::UserID userId = -1;
+        Account::EvernoteAccountType::type evernoteAccountType = Account::EvernoteAccountType::Free;
+        if (!isLocal)
+        {
+            userId = static_cast<qevercloud::UserID>(attributes.value(QStringLiteral("userId")).toString().toInt(&conversionResult));
+            if (Q_UNLIKELY(!conversionResult)) {
+                QNWARNING(QStringLiteral("Can't convert the user id of Evernote account within the accounts index to int"));
+                return false;
+            }
+
+            QString evernoteAccountTypeStr = attributes.value(QStringLiteral("evernoteAccountType")).toString();
+            if (evernoteAccountTypeStr == QStringLiteral("Plus")) {
+                evernoteAccountType = Account::EvernoteAccountType::Plus;
+            }
+            else if (evernoteAccountTypeStr == QStringLiteral("Premium")) {
+                evernoteAccountType = Account::EvernoteAccountType::Premium;
+            }
+            else if (evernoteAccountTypeStr == QStringLiteral("Business")) {
+                evernoteAccountType = Account::EvernoteAccountType::Business;
+            }
+        }
+
+        Account availableAccount(name, (isLocal ? Account::Type::Local : Account::Type::Evernote), userId,
+                                 evernoteAccountType, attributes.value(QStringLiteral("evernoteHost")).toString(),
+                                 attributes.value(QStringLiteral("shardId")).toString());
+        availableAccount.setDisplayName(attributes.value(QStringLiteral("displayName")).toString());
+
+        // The account's info file edited since the index was written might contain the info different from the index
+        QString infoFilePath = accountInfoFilePath(availableAccount);
+
+        qint64 infoFileTimestamp = attributes.value(QStringLiteral("infoFileTimestamp")).toString().toLongLong(&conversionResult);
+        if (!conversionResult || (infoFileTimestamp != modificationTimestamp(infoFilePath)) ||
+            modifiedTooCloseToIndexTimestamp(infoFileTimestamp, indexTimestamp))
+        {
+            QNDEBUG(QStringLiteral("The accounts index is outdated: the info file of account ") << name
+                    << QStringLiteral(" has changed"));
+            return false;
+        }
+
+        qint64 infoFileSize = attributes.value(QStringLiteral("infoFileSize")).toString().toLongLong(&conversionResult);
+        if (!conversionResult || (infoFileSize != fileSize(infoFilePath))) {
+            QNDEBUG(QStringLiteral("The accounts index is outdated: the size of the info file of account ") << name
+                    << QStringLiteral(" has changed"));
+            return false;
+        }
+
+        availableAccounts << availableAccount;
+    }
+
+    if (reader.hasError()) {
+        QNWARNING(QStringLiteral("Can't read the accounts index, error reading XML: ") << reader.errorString());
+        return false;
+    }
+
+    m_availableAccounts = availableAccounts;
+    return true;
+}
+
+void AccountManager::updateAccountsIndex()
+{
+    QNDEBUG(QStringLiteral("AccountManager::updateAccountsIndex"));
+
+    QString appPersistenceStoragePath = applicationPersistentStoragePath();
+    QString accountsIndexFilePath = appPersistenceStoragePath + QStringLiteral("/" ACCOUNTS_INDEX_FILE_NAME);
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+    QSaveFile accountsIndex(accountsIndexFilePath);
+#else
+    QFile accountsIndex(accountsIndexFilePath + QStringLiteral(".tmp"));
+#endif
+
+    bool open = accountsIndex.open(QIODevice::WriteOnly);
+    if (Q_UNLIKELY(!open)) {
+        QNWARNING(QStringLiteral("Can't open the accounts index for writing: ") << accountsIndex.errorString());
+        // The previous index, if any, no longer lists all the available accounts
+        Q_UNUSED(QFile::remove(accountsIndexFilePath))
+        return;
+    }
+
+    QXmlStreamWriter writer(&accountsIndex);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+
+    writer.writeStartElement(QStringLiteral("accountsIndex"));
+    writer.writeAttribute(QStringLiteral("version"), QString::number(ACCOUNTS_INDEX_VERSION));
+    writer.writeAttribute(QStringLiteral("timestamp"), QString::number(QDateTime::currentMSecsSinceEpoch()));
+    writer.writeAttribute(QStringLiteral("localAccountsDirTimestamp"),
+                          QString::number(modificationTimestamp(appPersistenceStoragePath + QStringLiteral("/LocalAccounts"))));
+    writer.writeAttribute(QStringLiteral("evernoteAccountsDirTimestamp"),
+                          QString::number(modificationTimestamp(appPersistenceStoragePath + QStringLiteral("/EvernoteAccounts"))));
+
+    for(auto it = m_availableAccounts.constBegin(), end = m_availableAccounts.constEnd(); it != end; ++it)
+    {
+        const Account & account = *it;
+        bool isLocal = (account.type() == Account::Type::Local);
+
+        writer.writeStartElement(QStringLiteral("account"));
+        writer.writeAttribute(QStringLiteral("name"), account.name());
+        writer.writeAttribute(QStringLiteral("displayName"), account.displayName());
+        writer.writeAttribute(QStringLiteral("type"), (isLocal ? QStringLiteral("Local") : QStringLiteral("Evernote")));
+
+        if (!isLocal) {
+            writer.writeAttribute(QStringLiteral("userId"), QString::number(account.id()));
+            writer.writeAttribute(QStringLiteral("evernoteAccountType"), evernoteAccountTypeToString(account.evernoteAccountType()));
+            writer.writeAttribute(QStringLiteral("evernoteHost"), account.evernoteHost());
+            writer.writeAttribute(QStringLiteral("shardId"), account.shardId());
+        }
+
+        QString infoFilePath = accountInfoFilePath(account);
+        writer.writeAttribute(QStringLiteral("infoFileTimestamp"), QString::number(modificationTimestamp(infoFilePath)));
+        writer.writeAttribute(QStringLiteral("infoFileSize"), QString::number(fileSize(infoFilePath)));
+
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+
+    bool res = !writer.hasError();
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 1, 0)
+    if (res) {
+        res = accountsIndex.commit();
+    }
+    else {
+        accountsIndex.cancelWriting();
+    }
+#else
+    accountsIndex.close();
+    if (res) {
+        Q_UNUSED(QFile::remove(accountsIndexFilePath))
+        res = accountsIndex.rename(accountsIndexFilePath);
+    }
+    else {
+        Q_UNUSED(accountsIndex.remove())
+    }
+#endif
+
+    if (Q_UNLIKELY(!res)) {
+        QNWARNING(QStringLiteral("Failed to write the accounts index: ") << accountsIndex.errorString());
+        Q_UNUSED(QFile::remove(accountsIndexFilePath))
+        return;
+    }
+
+    QNTRACE(QStringLiteral("Wrote the index of ") << m_availableAccounts.size() << QStringLiteral(" available accounts"));
 }
 
 QSharedPointer<Account> AccountManager::createDefaultAccount(ErrorString & errorDescription, bool * pCreatedDefaultAccount)
@@ -376,6 +661,7 @@ QSharedPointer<Account> AccountManager::createLocalAccount(const QString & name,
     Account availableAccount(name, Account::Type::Local, qevercloud::UserID(-1));
     availableAccount.setDisplayName(displayName);
     m_availableAccounts << availableAccount;
+    updateAccountsIndex();
 
     QSharedPointer<Account> result(new Account(name, Account::Type::Local));
     return result;
@@ -46,6 +46,12 @@ public:
 public:
     AccountManager(QObject * parent = Q_NULLPTR);
 
+    /**
+     * Creates the account manager from the accounts detected in advance, i.e. during the startup
+     * by another thread, instead of scanning the persistent storage for them
+     */
+    AccountManager(const QVector<Account> & availableAccounts, QObject * parent = Q_NULLPTR);
+
     const QVector<Account> & availableAccounts() const
     { return m_availableAccounts; }
 
@@ -78,6 +84,15 @@ private Q_SLOTS:
 private:
     void detectAvailableAccounts();
 
+    // Tries to read the available accounts from the accounts index file; returns false if the index doesn't exist,
+    // can't be read or is outdated, i.e. the accounts' dirs or info files were changed since the index was written
+    // or too shortly before that for the modification times to tell
+    bool readAccountsIndex();
+
+    // Writes the index of currently available accounts; the index is written to a temporary file first
+    // and then replaces the previous index so that it is never left partially written
+    void updateAccountsIndex();
+
     QSharedPointer<Account> createDefaultAccount(ErrorString & errorDescription, bool * pCreatedDefaultAccount);
     QSharedPointer<Account> createLocalAccount(const QString & name, const QString & displayName,
                                                ErrorString & errorDescription);
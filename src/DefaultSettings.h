@@ -40,6 +40,9 @@
 
 #define DEFAULT_RUN_SYNC_EACH_NUM_MINUTES (15)
 
+#define DEFAULT_NUM_INACTIVE_ACCOUNTS_WITH_WARM_MODELS (1)
+#define DEFAULT_MAX_NUM_NOTES_IN_WARM_MODELS (50000)
+
 #define DEFAULT_MAIN_WINDOW_BORDER_COLOR QStringLiteral("#626262")
 #define DEFAULT_SHOW_MAIN_WINDOW_BORDER_OPTION (MainWindowSideBorderOption::ShowOnlyWhenMaximized)
 #define DEFAULT_MAIN_WINDOW_BORDER_SIZE (4)
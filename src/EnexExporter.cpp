@@ -20,6 +20,8 @@ EnexExporter::EnexExporter(LocalStorageManagerAsync & localStorageManagerAsync,
     m_pTagModel(&tagModel),
     m_noteLocalUids(),
     m_findNoteRequestIds(),
+    m_noteLocalUidsPendingSave(),
+    m_noteLocalUidsBySavingNoteEditorWidgets(),
     m_notesByLocalUid(),
     m_includeTags(),
     m_connectedToLocalStorage(false)
@@ -68,8 +70,8 @@ bool EnexExporter::isInProgress() const
         return false;
     }
 
-    if (m_findNoteRequestIds.isEmpty()) {
-        QNDEBUG(QStringLiteral("No pending requests to find notes in the local storage"));
+    if (m_findNoteRequestIds.isEmpty() && m_noteLocalUidsPendingSave.isEmpty()) {
+        QNDEBUG(QStringLiteral("No pending requests to find notes in the local storage or to save notes in editors"));
         return false;
     }
 
@@ -95,6 +97,8 @@ void EnexExporter::start()
     }
 
     m_findNoteRequestIds.clear();
+    m_noteLocalUidsPendingSave.clear();
+    m_noteLocalUidsBySavingNoteEditorWidgets.clear();
     m_notesByLocalUid.clear();
 
     for(auto it = m_noteLocalUids.constBegin(), end = m_noteLocalUids.constEnd(); it != end; ++it)
@@ -126,33 +130,36 @@ void EnexExporter::start()
 
         QNTRACE(QStringLiteral("The note within the editor was modified, saving it"));
 
-        ErrorString noteSavingError;
-        NoteEditorWidget::NoteSaveStatus::type saveStatus = pNoteEditorWidget->checkAndSaveModifiedNote(noteSavingError);
-        if (saveStatus != NoteEditorWidget::NoteSaveStatus::Ok) {
-            QNWARNING(QStringLiteral("Could not save the note loaded into the editor: status = ")
-                      << saveStatus << QStringLiteral(", error: ") << noteSavingError
-                      << QStringLiteral("; will try to find the note in the local storage"));
-            findNoteInLocalStorage(noteLocalUid);
+        QObject::connect(pNoteEditorWidget, QNSIGNAL(NoteEditorWidget,noteSaveFinished,QString,
+                                                     NoteEditorWidget::NoteSaveStatus::type,ErrorString),
+                         this, QNSLOT(EnexExporter,onNoteSaveFinished,QString,
+                                      NoteEditorWidget::NoteSaveStatus::type,ErrorString),
+                         Qt::UniqueConnection);
+
+        if (!pNoteEditorWidget->checkAndSaveModifiedNote()) {
+            QNTRACE(QStringLiteral("The note within the editor turned out to need no saving: ") << noteLocalUid);
+            QObject::disconnect(pNoteEditorWidget, QNSIGNAL(NoteEditorWidget,noteSaveFinished,QString,
+                                                            NoteEditorWidget::NoteSaveStatus::type,ErrorString),
+                                this, QNSLOT(EnexExporter,onNoteSaveFinished,QString,
+                                             NoteEditorWidget::NoteSaveStatus::type,ErrorString));
+            m_notesByLocalUid[noteLocalUid] = *pNote;
             continue;
         }
 
-        pNote = pNoteEditorWidget->currentNote();
-        if (Q_UNLIKELY(!pNote)) {
-            QNWARNING(QStringLiteral("Note editor's current note has unexpectedly become nullptr "
-                                     "after the note has been saved; will try to find the note "
-                                     "in the local storage"));
-            findNoteInLocalStorage(noteLocalUid);
-            continue;
-        }
+        // The destroyed editor would not report the result of saving
+        QObject::connect(pNoteEditorWidget, QNSIGNAL(QObject,destroyed,QObject*),
+                         this, QNSLOT(EnexExporter,onNoteEditorWidgetDestroyed,QObject*),
+                         Qt::UniqueConnection);
+        m_noteLocalUidsBySavingNoteEditorWidgets[pNoteEditorWidget] = noteLocalUid;
 
-        QNTRACE(QStringLiteral("Fetched the modified & saved note from editor: ") << noteLocalUid);
-        m_notesByLocalUid[noteLocalUid] = *pNote;
+        Q_UNUSED(m_noteLocalUidsPendingSave.insert(noteLocalUid))
     }
 
-    if (!m_findNoteRequestIds.isEmpty()) {
+    if (!m_findNoteRequestIds.isEmpty() || !m_noteLocalUidsPendingSave.isEmpty()) {
         QNDEBUG(QStringLiteral("Not all requested notes were found loaded into the editors, "
                                "currently pending ") << m_findNoteRequestIds.size()
-                << QStringLiteral(" find note in local storage requests "));
+                << QStringLiteral(" find note in local storage requests and ") << m_noteLocalUidsPendingSave.size()
+                << QStringLiteral(" note saves in editors"));
         return;
     }
 
@@ -181,6 +188,8 @@ void EnexExporter::clear()
     m_targetEnexFilePath.clear();
     m_noteLocalUids.clear();
     m_findNoteRequestIds.clear();
+    m_noteLocalUidsPendingSave.clear();
+    m_noteLocalUidsBySavingNoteEditorWidgets.clear();
     m_notesByLocalUid.clear();
 
     disconnectFromLocalStorage();
@@ -203,36 +212,7 @@ void EnexExporter::onFindNoteComplete(Note note, bool withResourceMetadata, bool
     m_notesByLocalUid[note.localUid()] = note;
     m_findNoteRequestIds.erase(it);
 
-    if (!m_findNoteRequestIds.isEmpty()) {
-        QNDEBUG(QStringLiteral("Still pending  ") << m_findNoteRequestIds.size()
-                << QStringLiteral(" find note in local storage requests "));
-        return;
-    }
-
-    if (m_includeTags)
-    {
-        if (Q_UNLIKELY(m_pTagModel.isNull())) {
-            ErrorString errorDescription(QT_TR_NOOP("Can't export note(s) to ENEX: the tag model has expired"));
-            QNWARNING(errorDescription);
-            clear();
-            Q_EMIT failedToExportNotesToEnex(errorDescription);
-            return;
-        }
-
-        if (!m_pTagModel->allTagsListed()) {
-            QNDEBUG(QStringLiteral("Not all tags were listed within the tag model yet"));
-            return;
-        }
-    }
-
-    ErrorString errorDescription;
-    QString enex = convertNotesToEnex(errorDescription);
-    if (enex.isEmpty()) {
-        Q_EMIT failedToExportNotesToEnex(errorDescription);
-        return;
-    }
-
-    Q_EMIT notesExportedToEnex(enex);
+    checkAndCompleteExport();
 }
 
 void EnexExporter::onFindNoteFailed(Note note, bool withResourceMetadata, bool withResourceBinaryData,
@@ -272,12 +252,102 @@ void EnexExporter::onAllTagsListed()
         return;
     }
 
-    if (!m_findNoteRequestIds.isEmpty()) {
-        QNDEBUG(QStringLiteral("Still pending  ") << m_findNoteRequestIds.size()
-                << QStringLiteral(" find note in local storage requests "));
+    checkAndCompleteExport();
+}
+
+void EnexExporter::onNoteSaveFinished(QString noteLocalUid, NoteEditorWidget::NoteSaveStatus::type status,
+                                      ErrorString errorDescription)
+{
+    NoteEditorWidget * pNoteEditorWidget = qobject_cast<NoteEditorWidget*>(sender());
+    if (pNoteEditorWidget) {
+        QObject::disconnect(pNoteEditorWidget, QNSIGNAL(NoteEditorWidget,noteSaveFinished,QString,
+                                                        NoteEditorWidget::NoteSaveStatus::type,ErrorString),
+                            this, QNSLOT(EnexExporter,onNoteSaveFinished,QString,
+                                         NoteEditorWidget::NoteSaveStatus::type,ErrorString));
+        QObject::disconnect(pNoteEditorWidget, QNSIGNAL(QObject,destroyed,QObject*),
+                            this, QNSLOT(EnexExporter,onNoteEditorWidgetDestroyed,QObject*));
+        Q_UNUSED(m_noteLocalUidsBySavingNoteEditorWidgets.remove(pNoteEditorWidget))
+    }
+
+    auto it = m_noteLocalUidsPendingSave.find(noteLocalUid);
+    if (it == m_noteLocalUidsPendingSave.end()) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("EnexExporter::onNoteSaveFinished: note local uid = ") << noteLocalUid
+            << QStringLiteral(", status = ") << status << QStringLiteral(", error description: ") << errorDescription);
+
+    m_noteLocalUidsPendingSave.erase(it);
+
+    const Note * pNote = Q_NULLPTR;
+    if (pNoteEditorWidget && (status == NoteEditorWidget::NoteSaveStatus::Ok)) {
+        pNote = pNoteEditorWidget->currentNote();
+    }
+
+    if (pNote && (pNote->localUid() == noteLocalUid)) {
+        QNTRACE(QStringLiteral("Fetched the modified & saved note from editor: ") << noteLocalUid);
+        m_notesByLocalUid[noteLocalUid] = *pNote;
+    }
+    else {
+        QNWARNING(QStringLiteral("Could not get the saved note from the editor: status = ") << status
+                  << QStringLiteral(", error: ") << errorDescription
+                  << QStringLiteral("; will try to find the note in the local storage"));
+        findNoteInLocalStorage(noteLocalUid);
+        return;
+    }
+
+    checkAndCompleteExport();
+}
+
+void EnexExporter::onNoteEditorWidgetDestroyed(QObject * pNoteEditorWidget)
+{
+    auto widgetIt = m_noteLocalUidsBySavingNoteEditorWidgets.find(pNoteEditorWidget);
+    if (widgetIt == m_noteLocalUidsBySavingNoteEditorWidgets.end()) {
         return;
     }
 
+    QString noteLocalUid = widgetIt.value();
+    Q_UNUSED(m_noteLocalUidsBySavingNoteEditorWidgets.erase(widgetIt))
+
+    auto it = m_noteLocalUidsPendingSave.find(noteLocalUid);
+    if (it == m_noteLocalUidsPendingSave.end()) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("EnexExporter::onNoteEditorWidgetDestroyed: note local uid = ") << noteLocalUid);
+
+    m_noteLocalUidsPendingSave.erase(it);
+
+    QNWARNING(QStringLiteral("The note editor was destroyed before the note was saved, will try to find the note "
+                             "in the local storage: ") << noteLocalUid);
+    findNoteInLocalStorage(noteLocalUid);
+}
+
+void EnexExporter::checkAndCompleteExport()
+{
+    if (!m_findNoteRequestIds.isEmpty() || !m_noteLocalUidsPendingSave.isEmpty()) {
+        QNDEBUG(QStringLiteral("Still pending ") << m_findNoteRequestIds.size()
+                << QStringLiteral(" find note in local storage requests and ") << m_noteLocalUidsPendingSave.size()
+                << QStringLiteral(" note saves in editors"));
+        return;
+    }
+
+    if (m_includeTags)
+    {
+        if (Q_UNLIKELY(m_pTagModel.isNull())) {
+            ErrorString errorDescription(QT_TR_NOOP("Can't export note(s) to ENEX: the tag model has expired"));
+            QNWARNING(errorDescription);
+            clear();
+            Q_EMIT failedToExportNotesToEnex(errorDescription);
+            return;
+        }
+
+        if (!m_pTagModel->allTagsListed()) {
+            QNDEBUG(QStringLiteral("Not all tags were listed within the tag model yet"));
+            return;
+        }
+    }
+
     ErrorString errorDescription;
     QString enex = convertNotesToEnex(errorDescription);
     if (enex.isEmpty()) {
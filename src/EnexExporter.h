@@ -1,6 +1,7 @@
 #ifndef QUENTIER_ENEX_EXPORTER_H
 #define QUENTIER_ENEX_EXPORTER_H
 
+#include "widgets/NoteEditorWidget.h"
 #include <quentier/utility/Macros.h>
 #include <quentier/types/ErrorString.h>
 #include <quentier/types/Note.h>
@@ -53,8 +54,16 @@ private Q_SLOTS:
 
     void onAllTagsListed();
 
+    void onNoteSaveFinished(QString noteLocalUid, NoteEditorWidget::NoteSaveStatus::type status,
+                            ErrorString errorDescription);
+    void onNoteEditorWidgetDestroyed(QObject * pNoteEditorWidget);
+
 private:
     void findNoteInLocalStorage(const QString & noteLocalUid);
+
+    // Converts the gathered notes to ENEX and reports the result unless some notes or tags are still pending
+    void checkAndCompleteExport();
+
     QString convertNotesToEnex(ErrorString & errorDescription);
 
     void connectToLocalStorage();
@@ -67,6 +76,8 @@ private:
     QString                                 m_targetEnexFilePath;
     QStringList                             m_noteLocalUids;
     QSet<QUuid>                             m_findNoteRequestIds;
+    QSet<QString>                           m_noteLocalUidsPendingSave;
+    QHash<QObject*, QString>                m_noteLocalUidsBySavingNoteEditorWidgets;
     QHash<QString, Note>                    m_notesByLocalUid;
     bool                                    m_includeTags;
     bool                                    m_connectedToLocalStorage;
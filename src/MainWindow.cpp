@@ -24,6 +24,7 @@
 #include "SystemTrayIconManager.h"
 #include "ActionsInfo.h"
 #include "EditNoteDialogsManager.h"
+#include "NotePrefetcher.h"
 #include "NoteFiltersManager.h"
 #include "EnexExporter.h"
 #include "EnexImporter.h"
@@ -47,10 +48,14 @@
 #include "dialogs/EnexExportDialog.h"
 #include "dialogs/EnexImportDialog.h"
 #include "dialogs/FirstShutdownDialog.h"
+#include "dialogs/ModelInstrumentationDialog.h"
 #include "dialogs/PreferencesDialog.h"
 #include "dialogs/WelcomeToQuentierDialog.h"
 #include "initialization/DefaultAccountFirstNotebookAndNoteCreator.h"
+#include "initialization/StartupTracer.h"
+#include "initialization/StartupTasks.h"
 #include "models/ColumnChangeRerouter.h"
+#include "models/ModelInstrumentation.h"
 #include "views/ItemView.h"
 #include "views/DeletedNoteItemView.h"
 #include "views/NotebookItemView.h"
@@ -142,11 +147,22 @@ using quentier::LogViewerWidget;
 #define MAIN_WINDOW_SAVED_SEARCHES_VIEW_HEIGHT QStringLiteral("SavedSearchesViewHeight")
 #define MAIN_WINDOW_DELETED_NOTES_VIEW_HEIGHT QStringLiteral("DeletedNotesViewHeight")
 
+// The names of the asynchronous startup phases corresponding to the initial listing of models' items
+#define NOTE_MODEL_LISTING_STARTUP_PHASE "NoteModel: list notes"
+#define FAVORITES_MODEL_LISTING_STARTUP_PHASE "FavoritesModel: list favorited items"
+#define NOTEBOOK_MODEL_LISTING_STARTUP_PHASE "NotebookModel: list notebooks"
+#define TAG_MODEL_LISTING_STARTUP_PHASE "TagModel: list tags"
+#define SAVED_SEARCH_MODEL_LISTING_STARTUP_PHASE "SavedSearchModel: list saved searches"
+#define DELETED_NOTES_MODEL_LISTING_STARTUP_PHASE "NoteModel: list deleted notes"
+
 #define PERSIST_GEOMETRY_AND_STATE_DELAY (500)
 #define RESTORE_SPLITTER_SIZES_DELAY (200)
 #define CREATE_SIDE_BORDERS_CONTROLLER_DELAY (200)
 #define NOTIFY_SIDE_BORDERS_CONTROLLER_DELAY (200)
 
+// The maximum time to wait for the note editors to save the modified notes before starting the sync
+#define PENDING_NOTE_SAVES_BEFORE_SYNC_TIMEOUT_MSEC (5000)
+
 using namespace quentier;
 
 MainWindow::MainWindow(QWidget * pParentWidget) :
@@ -157,7 +173,7 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
     m_nativeIconThemeName(),
     m_pAvailableAccountsActionGroup(new QActionGroup(this)),
     m_pAvailableAccountsSubMenu(Q_NULLPTR),
-    m_pAccountManager(new AccountManager(this)),
+    m_pAccountManager(createAccountManager(this)),
     m_pAccount(),
     m_pSystemTrayIconManager(Q_NULLPTR),
     m_pLocalStorageManagerThread(Q_NULLPTR),
@@ -178,6 +194,9 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
     m_syncApiRateLimitExceeded(false),
     m_animatedSyncButtonIcon(QStringLiteral(":/sync/sync.gif")),
     m_runSyncPeriodicallyTimerId(0),
+    m_pendingNoteSavesBeforeSyncTimerId(0),
+    m_syncProgressTracker(),
+    m_syncProgressRenderingTimerId(0),
     m_pSideBordersController(Q_NULLPTR),
     m_notebookCache(),
     m_tagCache(),
@@ -197,6 +216,7 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
                                                                    FavoritesModel::Columns::DisplayName, this)),
     m_pDeletedNotesModel(Q_NULLPTR),
     m_pFavoritesModel(Q_NULLPTR),
+    m_warmAccountModels(),
     m_blankModel(),
     m_pNoteFilterModel(Q_NULLPTR),
     m_pNoteFiltersManager(Q_NULLPTR),
@@ -204,8 +224,11 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
     m_defaultAccountFirstNoteLocalUid(),
     m_pNoteEditorTabsAndWindowsCoordinator(Q_NULLPTR),
     m_pEditNoteDialogsManager(Q_NULLPTR),
+    m_pNotePrefetcher(Q_NULLPTR),
     m_pUndoStack(new QUndoStack(this)),
     m_styleSheetInfo(),
+    m_currentPanelStyleSheetPropertiesKey(),
+    m_themeIconsByThemeName(),
     m_currentPanelStyle(),
     m_shortcutManager(this),
     m_pendingGreeterDialog(false),
@@ -231,6 +254,9 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
         setOnceDisplayedGreeterScreen();
     }
 
+    // Opening the local storage database overlaps with the setup of the UI
+    startLocalStorageManagerThread();
+
     restoreNetworkProxySettingsForAccount(*m_pAccount);
 
     m_pSystemTrayIconManager = new SystemTrayIconManager(*m_pAccountManager, this);
@@ -238,7 +264,11 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
 
     setupThemeIcons();
 
-    m_pUI->setupUi(this);
+    {
+        StartupTracer::Phase startupPhase("MainWindow::setupUi");
+        m_pUI->setupUi(this);
+    }
+
     setupAccountSpecificUiElements();
 
     if (m_nativeIconThemeName.isEmpty()) {
@@ -261,6 +291,12 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
 
     setWindowTitleForAccount(*m_pAccount);
 
+    // The instrumentation needs to be enabled before the models are set up in order to catch the initial listing
+    QByteArray modelInstrumentation = qgetenv(MODEL_INSTRUMENTATION_ENV_VAR);
+    if (!modelInstrumentation.isEmpty() && (modelInstrumentation != QByteArray("0"))) {
+        ModelInstrumentation::setEnabled(true);
+    }
+
     setupLocalStorageManager();
     setupModels();
     setupViews();
@@ -482,6 +518,8 @@ void MainWindow::connectActionsToSlots()
                      this, QNSLOT(MainWindow,onShowNoteSource));
     QObject::connect(m_pUI->ActionViewLogs, QNSIGNAL(QAction,triggered),
                      this, QNSLOT(MainWindow,onViewLogsActionTriggered));
+    QObject::connect(m_pUI->ActionShowModelInstrumentation, QNSIGNAL(QAction,triggered),
+                     this, QNSLOT(MainWindow,onShowModelInstrumentationActionTriggered));
     QObject::connect(m_pUI->ActionAbout, QNSIGNAL(QAction,triggered),
                      this, QNSLOT(MainWindow,onShowInfoAboutQuentierActionTriggered));
 }
@@ -1081,6 +1119,9 @@ void MainWindow::refreshChildWidgetsThemeIcons()
 {
     QNDEBUG(QStringLiteral("MainWindow::refreshChildWidgetsThemeIcons"));
 
+    bool updatesEnabled = this->updatesEnabled();
+    setUpdatesEnabled(false);
+
     refreshThemeIcons<QAction>();
     refreshThemeIcons<QPushButton>();
     refreshThemeIcons<QCheckBox>();
@@ -1088,6 +1129,29 @@ void MainWindow::refreshChildWidgetsThemeIcons()
     refreshThemeIcons<InsertTableToolButton>();
 
     refreshNoteEditorWidgetsSpecialIcons();
+
+    setUpdatesEnabled(updatesEnabled);
+}
+
+QIcon MainWindow::themeIcon(const QString & iconName)
+{
+    QHash<QString, QIcon> & themeIcons = m_themeIconsByThemeName[QIcon::themeName()];
+
+    auto it = themeIcons.find(iconName);
+    if (it != themeIcons.end()) {
+        return it.value();
+    }
+
+    QIcon icon;
+    if (QIcon::hasThemeIcon(iconName)) {
+        icon = QIcon::fromTheme(iconName);
+    }
+    else {
+        icon.addFile(QStringLiteral("."), QSize(), QIcon::Normal, QIcon::Off);
+    }
+
+    Q_UNUSED(themeIcons.insert(iconName, icon))
+    return icon;
 }
 
 void MainWindow::refreshNoteEditorWidgetsSpecialIcons()
@@ -1186,6 +1250,8 @@ void MainWindow::collectBaseStyleSheets()
 {
     QNDEBUG(QStringLiteral("MainWindow::collectBaseStyleSheets"));
 
+    StartupTracer::Phase startupPhase("MainWindow::collectBaseStyleSheets");
+
     QList<QWidget*> childWidgets = findChildren<QWidget*>();
     for(auto it = childWidgets.constBegin(), end = childWidgets.constEnd(); it != end; ++it)
     {
@@ -1194,6 +1260,11 @@ void MainWindow::collectBaseStyleSheets()
             continue;
         }
 
+        // Only the panels' stylesheets are ever altered
+        if (!widget->objectName().contains(QStringLiteral("Panel"))) {
+            continue;
+        }
+
         QString styleSheet = widget->styleSheet();
         if (styleSheet.isEmpty()) {
             continue;
@@ -1209,6 +1280,8 @@ void MainWindow::setupPanelOverlayStyleSheets()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupPanelOverlayStyleSheets"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupPanelOverlayStyleSheets");
+
     ApplicationSettings appSettings(*m_pAccount, QUENTIER_UI_SETTINGS);
     appSettings.beginGroup(LOOK_AND_FEEL_SETTINGS_GROUP_NAME);
     QString panelStyle = appSettings.value(PANELS_STYLE_SETTINGS_KEY).toString();
@@ -1302,6 +1375,19 @@ void MainWindow::getPanelStyleSheetProperties(const QString & panelStyleOption,
 
 void MainWindow::setPanelsOverlayStyleSheet(const StyleSheetProperties & properties)
 {
+    QString propertiesKey = panelStyleSheetPropertiesKey(properties);
+    if (propertiesKey == m_currentPanelStyleSheetPropertiesKey) {
+        QNDEBUG(QStringLiteral("The panels already have the overlay stylesheet with the same properties"));
+        return;
+    }
+
+    m_currentPanelStyleSheetPropertiesKey = propertiesKey;
+
+    // Each setStyleSheet call re-polishes the widget's subtree; disabling the updates at least coalesces
+    // the repaints of all the altered panels into one
+    bool updatesEnabled = this->updatesEnabled();
+    setUpdatesEnabled(false);
+
     for(auto it = m_styleSheetInfo.begin(); it != m_styleSheetInfo.end(); )
     {
         StyleSheetInfo & info = it.value();
@@ -1314,24 +1400,48 @@ void MainWindow::setPanelsOverlayStyleSheet(const StyleSheetProperties & propert
 
         ++it;
 
-        QString widgetName = widget->objectName();
-        if (!widgetName.contains(QStringLiteral("Panel"))) {
-            continue;
-        }
+        QString styleSheet = info.m_baseStyleSheet;
+        if (!properties.isEmpty())
+        {
+            auto overlayIt = info.m_overlayStyleSheetsByPropertiesKey.find(propertiesKey);
+            if (overlayIt == info.m_overlayStyleSheetsByPropertiesKey.end())
+            {
+                QString overlayStyleSheet = alterStyleSheet(info.m_baseStyleSheet, properties);
+                if (Q_UNLIKELY(overlayStyleSheet.isEmpty())) {
+                    overlayStyleSheet = info.m_baseStyleSheet;
+                }
 
-        if (properties.isEmpty()) {
-            widget->setStyleSheet(info.m_baseStyleSheet);
-            continue;
+                overlayIt = info.m_overlayStyleSheetsByPropertiesKey.insert(propertiesKey, overlayStyleSheet);
+            }
+
+            styleSheet = overlayIt.value();
         }
 
-        QString overlayStyleSheet = alterStyleSheet(info.m_baseStyleSheet, properties);
-        if (Q_UNLIKELY(overlayStyleSheet.isEmpty())) {
-            widget->setStyleSheet(info.m_baseStyleSheet);
+        if (widget->styleSheet() == styleSheet) {
             continue;
         }
 
-        widget->setStyleSheet(overlayStyleSheet);
+        widget->setStyleSheet(styleSheet);
+    }
+
+    setUpdatesEnabled(updatesEnabled);
+}
+
+QString MainWindow::panelStyleSheetPropertiesKey(const StyleSheetProperties & properties) const
+{
+    QString key;
+    for(auto it = properties.constBegin(), end = properties.constEnd(); it != end; ++it)
+    {
+        const StyleSheetProperty & property = *it;
+        key += QString::number(property.m_targetType);
+        key += QStringLiteral(":");
+        key += QString::fromUtf8(property.m_name);
+        key += QStringLiteral("=");
+        key += property.m_value;
+        key += QStringLiteral(";");
     }
+
+    return key;
 }
 
 QString MainWindow::alterStyleSheet(const QString & originalStyleSheet,
@@ -1666,6 +1776,9 @@ void MainWindow::fixupQt4StyleSheets()
 
 void MainWindow::onSetStatusBarText(QString message, const int duration)
 {
+    // Whatever is set to the status bar now supersedes the sync progress pending for rendering
+    m_syncProgressTracker.cancelPendingRendering();
+
     QStatusBar * pStatusBar = m_pUI->statusBar;
 
     pStatusBar->clearMessage();
@@ -1801,6 +1914,7 @@ void MainWindow::onSynchronizationStarted()
 {
     QNDEBUG(QStringLiteral("MainWindow::onSynchronizationStarted"));
 
+    m_syncProgressTracker.clear();
     onSetStatusBarText(tr("Starting the synchronization") + QStringLiteral("..."));
     m_syncApiRateLimitExceeded = false;
     m_syncInProgress = true;
@@ -1811,6 +1925,7 @@ void MainWindow::onSynchronizationStopped()
 {
     QNINFO(QStringLiteral("MainWindow::onSynchronizationStopped"));
 
+    m_syncProgressTracker.clear();
     onSetStatusBarText(tr("Synchronization was stopped"), SEC_TO_MSEC(30));
     m_syncApiRateLimitExceeded = false;
     m_syncInProgress = false;
@@ -1828,6 +1943,8 @@ void MainWindow::onSynchronizationFinished(Account account, bool somethingDownlo
 {
     QNINFO(QStringLiteral("MainWindow::onSynchronizationFinished: ") << account.name());
 
+    m_syncProgressTracker.clear();
+
     if (somethingDownloaded || somethingSent) {
         onSetStatusBarText(tr("Synchronization finished!"), SEC_TO_MSEC(5));
     }
@@ -1962,10 +2079,9 @@ void MainWindow::onSyncChunksDownloadProgress(qint32 highestDownloadedUsn, qint3
     double denominator = highestServerUsn - lastPreviousUsn;
 
     double percentage = numerator / denominator * 100.0;
-    percentage = std::min(percentage, 100.0);
 
-    onSetStatusBarText(tr("Downloading sync chunks") + QStringLiteral(": ") +
-                       QString::number(percentage) + QStringLiteral("%"));
+    m_syncProgressTracker.setPercentageProgress(tr("Downloading sync chunks"), percentage);
+    scheduleSyncProgressRendering();
 }
 
 void MainWindow::onSyncChunksDownloaded()
@@ -1981,8 +2097,8 @@ void MainWindow::onNotesDownloadProgress(quint32 notesDownloaded, quint32 totalN
             << notesDownloaded << QStringLiteral(", total notes to download = ")
             << totalNotesToDownload);
 
-    onSetStatusBarText(tr("Downloading notes") + QStringLiteral(": ") + QString::number(notesDownloaded) +
-                       QStringLiteral(" ") + tr("of") + QStringLiteral(" ") + QString::number(totalNotesToDownload));
+    m_syncProgressTracker.setItemsProgress(tr("Downloading notes"), notesDownloaded, totalNotesToDownload);
+    scheduleSyncProgressRendering();
 }
 
 void MainWindow::onResourcesDownloadProgress(quint32 resourcesDownloaded, quint32 totalResourcesToDownload)
@@ -1991,8 +2107,8 @@ void MainWindow::onResourcesDownloadProgress(quint32 resourcesDownloaded, quint3
             << resourcesDownloaded << QStringLiteral(", total resources to download = ")
             << totalResourcesToDownload);
 
-    onSetStatusBarText(tr("Downloading attachments") + QStringLiteral(": ") + QString::number(resourcesDownloaded) +
-                       QStringLiteral(" ") + tr("of") + QStringLiteral(" ") + QString::number(totalResourcesToDownload));
+    m_syncProgressTracker.setItemsProgress(tr("Downloading attachments"), resourcesDownloaded, totalResourcesToDownload);
+    scheduleSyncProgressRendering();
 }
 
 void MainWindow::onLinkedNotebookSyncChunksDownloadProgress(qint32 highestDownloadedUsn, qint32 highestServerUsn,
@@ -2011,8 +2127,10 @@ void MainWindow::onLinkedNotebookSyncChunksDownloadProgress(qint32 highestDownlo
         return;
     }
 
-    double percentage = (highestDownloadedUsn - lastPreviousUsn) / (highestServerUsn - lastPreviousUsn) * 100.0;
-    percentage = std::min(percentage, 100.0);
+    double numerator = highestDownloadedUsn - lastPreviousUsn;
+    double denominator = highestServerUsn - lastPreviousUsn;
+
+    double percentage = numerator / denominator * 100.0;
 
     QString message = tr("Downloading sync chunks from linked notebook");
 
@@ -2024,8 +2142,8 @@ void MainWindow::onLinkedNotebookSyncChunksDownloadProgress(qint32 highestDownlo
         message += QStringLiteral(" (") + linkedNotebook.username() + QStringLiteral(")");
     }
 
-    message += QStringLiteral(": ") + QString::number(percentage) + QStringLiteral("%");
-    onSetStatusBarText(message);
+    m_syncProgressTracker.setPercentageProgress(message, percentage);
+    scheduleSyncProgressRendering();
 }
 
 void MainWindow::onLinkedNotebooksSyncChunksDownloaded()
@@ -2040,8 +2158,8 @@ void MainWindow::onLinkedNotebooksNotesDownloadProgress(quint32 notesDownloaded,
             << notesDownloaded << QStringLiteral(", total notes to download = ")
             << totalNotesToDownload);
 
-    onSetStatusBarText(tr("Downloading notes from linked notebooks") + QStringLiteral(": ") + QString::number(notesDownloaded) +
-                       QStringLiteral(" ") + tr("of") + QStringLiteral(" ") + QString::number(totalNotesToDownload));
+    m_syncProgressTracker.setItemsProgress(tr("Downloading notes from linked notebooks"), notesDownloaded, totalNotesToDownload);
+    scheduleSyncProgressRendering();
 }
 
 void MainWindow::onRemoteToLocalSyncStopped()
@@ -2499,6 +2617,8 @@ void MainWindow::onNoteModelAllNotesListed()
 {
     QNDEBUG(QStringLiteral("MainWindow::onNoteModelAllNotesListed"));
 
+    StartupTracer::endAsyncPhase(NOTE_MODEL_LISTING_STARTUP_PHASE);
+
     // NOTE: the task of this slot is to ensure that the note selected within the note list view
     // is the same as the one in the current note editor tab
 
@@ -2515,6 +2635,51 @@ void MainWindow::onNoteModelAllNotesListed()
     m_pUI->noteListView->setCurrentNoteByLocalUid(noteLocalUid);
 }
 
+void MainWindow::onFavoritesModelAllItemsListed()
+{
+    QNDEBUG(QStringLiteral("MainWindow::onFavoritesModelAllItemsListed"));
+
+    QObject::disconnect(m_pFavoritesModel, QNSIGNAL(FavoritesModel,notifyAllItemsListed),
+                        this, QNSLOT(MainWindow,onFavoritesModelAllItemsListed));
+    StartupTracer::endAsyncPhase(FAVORITES_MODEL_LISTING_STARTUP_PHASE);
+}
+
+void MainWindow::onNotebookModelAllNotebooksListed()
+{
+    QNDEBUG(QStringLiteral("MainWindow::onNotebookModelAllNotebooksListed"));
+
+    QObject::disconnect(m_pNotebookModel, QNSIGNAL(NotebookModel,notifyAllNotebooksListed),
+                        this, QNSLOT(MainWindow,onNotebookModelAllNotebooksListed));
+    StartupTracer::endAsyncPhase(NOTEBOOK_MODEL_LISTING_STARTUP_PHASE);
+}
+
+void MainWindow::onTagModelAllTagsListed()
+{
+    QNDEBUG(QStringLiteral("MainWindow::onTagModelAllTagsListed"));
+
+    QObject::disconnect(m_pTagModel, QNSIGNAL(TagModel,notifyAllTagsListed),
+                        this, QNSLOT(MainWindow,onTagModelAllTagsListed));
+    StartupTracer::endAsyncPhase(TAG_MODEL_LISTING_STARTUP_PHASE);
+}
+
+void MainWindow::onSavedSearchModelAllSavedSearchesListed()
+{
+    QNDEBUG(QStringLiteral("MainWindow::onSavedSearchModelAllSavedSearchesListed"));
+
+    QObject::disconnect(m_pSavedSearchModel, QNSIGNAL(SavedSearchModel,notifyAllSavedSearchesListed),
+                        this, QNSLOT(MainWindow,onSavedSearchModelAllSavedSearchesListed));
+    StartupTracer::endAsyncPhase(SAVED_SEARCH_MODEL_LISTING_STARTUP_PHASE);
+}
+
+void MainWindow::onDeletedNotesModelAllNotesListed()
+{
+    QNDEBUG(QStringLiteral("MainWindow::onDeletedNotesModelAllNotesListed"));
+
+    QObject::disconnect(m_pDeletedNotesModel, QNSIGNAL(NoteModel,notifyAllNotesListed),
+                        this, QNSLOT(MainWindow,onDeletedNotesModelAllNotesListed));
+    StartupTracer::endAsyncPhase(DELETED_NOTES_MODEL_LISTING_STARTUP_PHASE);
+}
+
 void MainWindow::onCurrentNoteInListChanged(QString noteLocalUid)
 {
     QNDEBUG(QStringLiteral("MainWindow::onCurrentNoteInListChanged: ") << noteLocalUid);
@@ -2917,6 +3082,21 @@ void MainWindow::onViewLogsActionTriggered()
     pLogViewerWidget->show();
 }
 
+void MainWindow::onShowModelInstrumentationActionTriggered()
+{
+    QNDEBUG(QStringLiteral("MainWindow::onShowModelInstrumentationActionTriggered"));
+
+    ModelInstrumentationDialog * pDialog = findChild<ModelInstrumentationDialog*>();
+    if (pDialog) {
+        pDialog->raise();
+        return;
+    }
+
+    pDialog = new ModelInstrumentationDialog(this);
+    pDialog->setAttribute(Qt::WA_DeleteOnClose);
+    pDialog->show();
+}
+
 void MainWindow::onShowInfoAboutQuentierActionTriggered()
 {
     QNDEBUG(QStringLiteral("MainWindow::onShowInfoAboutQuentierActionTriggered"));
@@ -3468,10 +3648,18 @@ void MainWindow::onLocalStorageSwitchUserRequestComplete(Account account, QUuid
         return;
     }
 
-    m_notebookCache.clear();
-    m_tagCache.clear();
-    m_savedSearchCache.clear();
-    m_noteCache.clear();
+    // NOTE: the caches are shared by all models including the ones kept warm; local uids are unique across
+    // all accounts so the cached items of different accounts don't conflict with each other
+    if (!keepCurrentAccountModelsWarm()) {
+        m_notebookCache.clear();
+        m_tagCache.clear();
+        m_savedSearchCache.clear();
+        m_noteCache.clear();
+    }
+
+    if (m_pNotePrefetcher) {
+        m_pNotePrefetcher->cancel();
+    }
 
     if (m_geometryAndStatePersistingDelayTimerId != 0) {
         killTimer(m_geometryAndStatePersistingDelayTimerId);
@@ -3543,6 +3731,11 @@ void MainWindow::onLocalStorageSwitchUserRequestComplete(Account account, QUuid
     setupViews();
     setupAccountSpecificUiElements();
 
+    // The note model restored from the warm ones has listed all notes before and won't notify about it again
+    if (m_pNoteModel && m_pNoteModel->allNotesListed()) {
+        onNoteModelAllNotesListed();
+    }
+
     // FIXME: this can be done more lightweight: just set the current account in the already filled list
     updateSubMenuWithAvailableAccounts();
 
@@ -3658,17 +3851,39 @@ void MainWindow::onSyncButtonPressed()
         return;
     }
 
-    if (m_pNoteEditorTabsAndWindowsCoordinator) {
-        m_pNoteEditorTabsAndWindowsCoordinator->saveAllNoteEditorsContents();
-    }
-
     if (m_syncInProgress) {
         QNDEBUG(QStringLiteral("The synchronization is in progress, will stop it"));
         Q_EMIT stopSynchronization();
+        return;
     }
-    else {
-        Q_EMIT synchronize();
+
+    if (m_pendingNoteSavesBeforeSyncTimerId != 0) {
+        QNDEBUG(QStringLiteral("The synchronization is already pending the note saves to finish"));
+        return;
     }
+
+    if (m_pNoteEditorTabsAndWindowsCoordinator)
+    {
+        // The saves are asynchronous so the sync needs to wait for them, otherwise it could miss the recent edits
+        m_pNoteEditorTabsAndWindowsCoordinator->saveAllNoteEditorsContents();
+
+        if (m_pNoteEditorTabsAndWindowsCoordinator->hasPendingNoteSaves()) {
+            QNDEBUG(QStringLiteral("Postponing the synchronization until the modified notes are saved"));
+            QObject::connect(m_pNoteEditorTabsAndWindowsCoordinator,
+                             QNSIGNAL(NoteEditorTabsAndWindowsCoordinator,pendingNoteSavesFinished),
+                             this, QNSLOT(MainWindow,onPendingNoteSavesFinishedBeforeSync), Qt::UniqueConnection);
+            m_pendingNoteSavesBeforeSyncTimerId = startTimer(PENDING_NOTE_SAVES_BEFORE_SYNC_TIMEOUT_MSEC);
+            return;
+        }
+    }
+
+    Q_EMIT synchronize();
+}
+
+void MainWindow::onPendingNoteSavesFinishedBeforeSync()
+{
+    QNDEBUG(QStringLiteral("MainWindow::onPendingNoteSavesFinishedBeforeSync"));
+    synchronizeAfterPendingNoteSaves();
 }
 
 void MainWindow::onAnimatedSyncIconFrameChanged(int frame)
@@ -3746,9 +3961,18 @@ void MainWindow::onQuitAction()
 {
     QNDEBUG(QStringLiteral("MainWindow::onQuitAction"));
 
-    if (m_pNoteEditorTabsAndWindowsCoordinator) {
-        // That would save the modified notes
+    if (m_pNoteEditorTabsAndWindowsCoordinator)
+    {
+        // That would start saving the modified notes
         m_pNoteEditorTabsAndWindowsCoordinator->clear();
+
+        if (m_pNoteEditorTabsAndWindowsCoordinator->hasPendingNoteSaves()) {
+            QNINFO(QStringLiteral("Postponing the quit until the modified notes are saved"));
+            QObject::connect(m_pNoteEditorTabsAndWindowsCoordinator,
+                             QNSIGNAL(NoteEditorTabsAndWindowsCoordinator,pendingNoteSavesFinished),
+                             qApp, QNSLOT(QCoreApplication,quit), Qt::UniqueConnection);
+            return;
+        }
     }
 
     qApp->quit();
@@ -3919,6 +4143,11 @@ void MainWindow::timerEvent(QTimerEvent * pTimerEvent)
         killTimer(m_sideBordersControllerMainWindowStateUpdateDelayTimerId);
         m_sideBordersControllerMainWindowStateUpdateDelayTimerId = 0;
     }
+    else if (pTimerEvent->timerId() == m_pendingNoteSavesBeforeSyncTimerId)
+    {
+        QNWARNING(QStringLiteral("The modified notes were not saved in time, starting the synchronization anyway"));
+        synchronizeAfterPendingNoteSaves();
+    }
     else if (pTimerEvent->timerId() == m_runSyncPeriodicallyTimerId)
     {
         if (Q_UNLIKELY(!m_pAccount ||
@@ -3951,6 +4180,17 @@ void MainWindow::timerEvent(QTimerEvent * pTimerEvent)
         QNDEBUG(QStringLiteral("Starting the periodically run sync"));
         Q_EMIT synchronize();
     }
+    else if (pTimerEvent->timerId() == m_syncProgressRenderingTimerId)
+    {
+        if (!m_syncProgressTracker.takePendingRendering()) {
+            // No progress came during the last interval so the next one can be rendered right away
+            killTimer(m_syncProgressRenderingTimerId);
+            m_syncProgressRenderingTimerId = 0;
+            return;
+        }
+
+        onSetStatusBarText(m_syncProgressTracker.toString());
+    }
     else if (pTimerEvent->timerId() == m_setDefaultAccountsFirstNoteAsCurrentDelayTimerId)
     {
         QNDEBUG(QStringLiteral("Executing postponed setting of defaut account's first note as the current note"));
@@ -4086,6 +4326,8 @@ void MainWindow::setupThemeIcons()
 {
     QNTRACE(QStringLiteral("MainWindow::setupThemeIcons"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupThemeIcons");
+
     m_nativeIconThemeName = QIcon::themeName();
     QNDEBUG(QStringLiteral("Native icon theme name: ") << m_nativeIconThemeName);
 
@@ -4115,6 +4357,8 @@ void MainWindow::setupAccountManager()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupAccountManager"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupAccountManager");
+
     QObject::connect(m_pAccountManager, QNSIGNAL(AccountManager,evernoteAccountAuthenticationRequested,QString,QNetworkProxy),
                      this, QNSLOT(MainWindow,onEvernoteAccountAuthenticationRequested,QString,QNetworkProxy));
     QObject::connect(m_pAccountManager, QNSIGNAL(AccountManager,switchedAccount,Account),
@@ -4127,19 +4371,46 @@ void MainWindow::setupAccountManager()
                      this, QNSLOT(MainWindow,onAccountManagerError,ErrorString));
 }
 
-void MainWindow::setupLocalStorageManager()
+void MainWindow::startLocalStorageManagerThread()
 {
-    QNDEBUG(QStringLiteral("MainWindow::setupLocalStorageManager"));
+    QNDEBUG(QStringLiteral("MainWindow::startLocalStorageManagerThread"));
 
     m_pLocalStorageManagerThread = new QThread;
     QObject::connect(m_pLocalStorageManagerThread, QNSIGNAL(QThread,finished),
                      m_pLocalStorageManagerThread, QNSLOT(QThread,deleteLater));
     m_pLocalStorageManagerThread->start();
 
-    m_pLocalStorageManagerAsync = new LocalStorageManagerAsync(*m_pAccount, /* start from scratch = */ false,
-                                                               /* override lock = */ false);
-    m_pLocalStorageManagerAsync->init();
-    m_pLocalStorageManagerAsync->moveToThread(m_pLocalStorageManagerThread);
+    StartupTaskGraph * pStartupTaskGraph = StartupTaskGraph::instance();
+    if (pStartupTaskGraph) {
+        pStartupTaskGraph->addTask(OPEN_LOCAL_STORAGE_STARTUP_TASK,
+                                   new OpenLocalStorageTask(*m_pAccount, m_pLocalStorageManagerThread));
+    }
+}
+
+void MainWindow::setupLocalStorageManager()
+{
+    QNDEBUG(QStringLiteral("MainWindow::setupLocalStorageManager"));
+
+    StartupTracer::Phase startupPhase("MainWindow::setupLocalStorageManager");
+
+    // NOTE: the join rethrows the exception thrown from the local storage initialization, if any
+    OpenLocalStorageTask * pOpenLocalStorageTask = Q_NULLPTR;
+    StartupTaskGraph * pStartupTaskGraph = StartupTaskGraph::instance();
+    if (pStartupTaskGraph) {
+        pOpenLocalStorageTask = static_cast<OpenLocalStorageTask*>(pStartupTaskGraph->join(OPEN_LOCAL_STORAGE_STARTUP_TASK));
+    }
+
+    if (pOpenLocalStorageTask)
+    {
+        m_pLocalStorageManagerAsync = pOpenLocalStorageTask->takeLocalStorageManagerAsync();
+    }
+    else
+    {
+        m_pLocalStorageManagerAsync = new LocalStorageManagerAsync(*m_pAccount, /* start from scratch = */ false,
+                                                                   /* override lock = */ false);
+        m_pLocalStorageManagerAsync->init();
+        m_pLocalStorageManagerAsync->moveToThread(m_pLocalStorageManagerThread);
+    }
 
     QObject::connect(this, QNSIGNAL(MainWindow,localStorageSwitchUserRequest,Account,bool,QUuid),
                      m_pLocalStorageManagerAsync, QNSLOT(LocalStorageManagerAsync,onSwitchUserRequest,Account,bool,QUuid));
@@ -4153,6 +4424,8 @@ void MainWindow::setupDefaultAccount()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupDefaultAccount"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupDefaultAccount");
+
     DefaultAccountFirstNotebookAndNoteCreator * pDefaultAccountFirstNotebookAndNoteCreator =
         new DefaultAccountFirstNotebookAndNoteCreator(*m_pLocalStorageManagerAsync, this);
     QObject::connect(pDefaultAccountFirstNotebookAndNoteCreator, QNSIGNAL(DefaultAccountFirstNotebookAndNoteCreator,finished,QString),
@@ -4166,25 +4439,53 @@ void MainWindow::setupModels()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupModels"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupModels");
+
     clearModels();
 
-    NoteModel::NoteSortingModes::type noteSortingMode = restoreNoteSortingMode();
-    if (noteSortingMode == NoteModel::NoteSortingModes::None) {
-        noteSortingMode = NoteModel::NoteSortingModes::ModifiedDescending;
-    }
+    if (!restoreWarmAccountModels())
+    {
+        NoteModel::NoteSortingModes::type noteSortingMode = restoreNoteSortingMode();
+        if (noteSortingMode == NoteModel::NoteSortingModes::None) {
+            noteSortingMode = NoteModel::NoteSortingModes::ModifiedDescending;
+        }
 
-    m_pNoteModel = new NoteModel(*m_pAccount, *m_pLocalStorageManagerAsync, m_noteCache,
-                                 m_notebookCache, this, NoteModel::IncludedNotes::NonDeleted,
-                                 noteSortingMode);
-    m_pFavoritesModel = new FavoritesModel(*m_pAccount, *m_pNoteModel, *m_pLocalStorageManagerAsync, m_noteCache,
-                                           m_notebookCache, m_tagCache, m_savedSearchCache, this);
-    m_pNotebookModel = new NotebookModel(*m_pAccount, *m_pNoteModel, *m_pLocalStorageManagerAsync,
-                                         m_notebookCache, this);
-    m_pTagModel = new TagModel(*m_pAccount, *m_pLocalStorageManagerAsync, m_tagCache, this);
-    m_pSavedSearchModel = new SavedSearchModel(*m_pAccount, *m_pLocalStorageManagerAsync,
-                                               m_savedSearchCache, this);
-    m_pDeletedNotesModel = new NoteModel(*m_pAccount, *m_pLocalStorageManagerAsync, m_noteCache,
-                                         m_notebookCache, this, NoteModel::IncludedNotes::Deleted);
+        // The initial listing of each model's items is traced as the asynchronous startup phase; the tracer
+        // ignores these phases once the startup is finished, i.e. when the models are re-created on account switch
+        StartupTracer::beginAsyncPhase(NOTE_MODEL_LISTING_STARTUP_PHASE);
+        m_pNoteModel = new NoteModel(*m_pAccount, *m_pLocalStorageManagerAsync, m_noteCache,
+                                     m_notebookCache, this, NoteModel::IncludedNotes::NonDeleted,
+                                     noteSortingMode);
+
+        StartupTracer::beginAsyncPhase(FAVORITES_MODEL_LISTING_STARTUP_PHASE);
+        m_pFavoritesModel = new FavoritesModel(*m_pAccount, *m_pNoteModel, *m_pLocalStorageManagerAsync, m_noteCache,
+                                               m_notebookCache, m_tagCache, m_savedSearchCache, this);
+        QObject::connect(m_pFavoritesModel, QNSIGNAL(FavoritesModel,notifyAllItemsListed),
+                         this, QNSLOT(MainWindow,onFavoritesModelAllItemsListed));
+
+        StartupTracer::beginAsyncPhase(NOTEBOOK_MODEL_LISTING_STARTUP_PHASE);
+        m_pNotebookModel = new NotebookModel(*m_pAccount, *m_pNoteModel, *m_pLocalStorageManagerAsync,
+                                             m_notebookCache, this);
+        QObject::connect(m_pNotebookModel, QNSIGNAL(NotebookModel,notifyAllNotebooksListed),
+                         this, QNSLOT(MainWindow,onNotebookModelAllNotebooksListed));
+
+        StartupTracer::beginAsyncPhase(TAG_MODEL_LISTING_STARTUP_PHASE);
+        m_pTagModel = new TagModel(*m_pAccount, *m_pLocalStorageManagerAsync, m_tagCache, this);
+        QObject::connect(m_pTagModel, QNSIGNAL(TagModel,notifyAllTagsListed),
+                         this, QNSLOT(MainWindow,onTagModelAllTagsListed));
+
+        StartupTracer::beginAsyncPhase(SAVED_SEARCH_MODEL_LISTING_STARTUP_PHASE);
+        m_pSavedSearchModel = new SavedSearchModel(*m_pAccount, *m_pLocalStorageManagerAsync,
+                                                   m_savedSearchCache, this);
+        QObject::connect(m_pSavedSearchModel, QNSIGNAL(SavedSearchModel,notifyAllSavedSearchesListed),
+                         this, QNSLOT(MainWindow,onSavedSearchModelAllSavedSearchesListed));
+
+        StartupTracer::beginAsyncPhase(DELETED_NOTES_MODEL_LISTING_STARTUP_PHASE);
+        m_pDeletedNotesModel = new NoteModel(*m_pAccount, *m_pLocalStorageManagerAsync, m_noteCache,
+                                             m_notebookCache, this, NoteModel::IncludedNotes::Deleted);
+        QObject::connect(m_pDeletedNotesModel, QNSIGNAL(NoteModel,notifyAllNotesListed),
+                         this, QNSLOT(MainWindow,onDeletedNotesModelAllNotesListed));
+    }
 
     m_pNoteFilterModel = new NoteFilterModel(this);
     m_pNoteFilterModel->setSourceModel(m_pNoteModel);
@@ -4250,6 +4551,169 @@ void MainWindow::clearModels()
     }
 }
 
+bool MainWindow::keepCurrentAccountModelsWarm()
+{
+    QNDEBUG(QStringLiteral("MainWindow::keepCurrentAccountModelsWarm"));
+
+    if (!m_pAccount || !m_pNotebookModel || !m_pTagModel || !m_pSavedSearchModel ||
+        !m_pNoteModel || !m_pDeletedNotesModel || !m_pFavoritesModel)
+    {
+        QNDEBUG(QStringLiteral("No account or models"));
+        return false;
+    }
+
+    ApplicationSettings appSettings;
+    appSettings.beginGroup(ACCOUNT_SETTINGS_GROUP);
+    QVariant numAccountsData = appSettings.value(NUM_INACTIVE_ACCOUNTS_WITH_WARM_MODELS,
+                                                 DEFAULT_NUM_INACTIVE_ACCOUNTS_WITH_WARM_MODELS);
+    QVariant maxNumNotesData = appSettings.value(MAX_NUM_NOTES_IN_WARM_MODELS,
+                                                 DEFAULT_MAX_NUM_NOTES_IN_WARM_MODELS);
+    appSettings.endGroup();
+
+    bool conversionResult = false;
+    int numAccounts = numAccountsData.toInt(&conversionResult);
+    if (!conversionResult) {
+        numAccounts = DEFAULT_NUM_INACTIVE_ACCOUNTS_WITH_WARM_MODELS;
+    }
+
+    int maxNumNotes = maxNumNotesData.toInt(&conversionResult);
+    if (!conversionResult) {
+        maxNumNotes = DEFAULT_MAX_NUM_NOTES_IN_WARM_MODELS;
+    }
+
+    if (numAccounts <= 0) {
+        QNDEBUG(QStringLiteral("Keeping the models of inactive accounts is disabled"));
+        evictWarmAccountModels(0, 0);
+        return false;
+    }
+
+    // The models which haven't finished listing the items yet would need to continue talking
+    // to the local storage which is about to serve another account, so such models can't be kept
+    if (!m_pNoteModel->allNotesListed() || !m_pDeletedNotesModel->allNotesListed() ||
+        !m_pNotebookModel->allNotebooksListed() || !m_pTagModel->allTagsListed() ||
+        !m_pSavedSearchModel->allItemsListed() || !m_pFavoritesModel->allItemsListed())
+    {
+        QNDEBUG(QStringLiteral("Not all models of the current account have listed their items yet, "
+                               "won't keep them warm"));
+        return false;
+    }
+
+    // Same for the models which still await the responses to their other requests: once disconnected
+    // from the local storage, they would never receive these responses and would remain stale
+    // or stuck waiting for them after the switch back to their account
+    if (m_pNoteModel->hasPendingRequests() || m_pDeletedNotesModel->hasPendingRequests() ||
+        m_pNotebookModel->hasPendingRequests() || m_pTagModel->hasPendingRequests() ||
+        m_pSavedSearchModel->hasPendingRequests() || m_pFavoritesModel->hasPendingRequests())
+    {
+        QNDEBUG(QStringLiteral("Some models of the current account have pending local storage requests, "
+                               "won't keep them warm"));
+        return false;
+    }
+
+    clearViews();
+
+    m_pNotebookModel->disconnectFromLocalStorage(*m_pLocalStorageManagerAsync);
+    m_pTagModel->disconnectFromLocalStorage(*m_pLocalStorageManagerAsync);
+    m_pSavedSearchModel->disconnectFromLocalStorage(*m_pLocalStorageManagerAsync);
+    m_pNoteModel->disconnectFromLocalStorage(*m_pLocalStorageManagerAsync);
+    m_pDeletedNotesModel->disconnectFromLocalStorage(*m_pLocalStorageManagerAsync);
+    m_pFavoritesModel->disconnectFromLocalStorage(*m_pLocalStorageManagerAsync);
+
+    WarmAccountModels models(*m_pAccount);
+    models.m_pNotebookModel = m_pNotebookModel;
+    models.m_pTagModel = m_pTagModel;
+    models.m_pSavedSearchModel = m_pSavedSearchModel;
+    models.m_pNoteModel = m_pNoteModel;
+    models.m_pDeletedNotesModel = m_pDeletedNotesModel;
+    models.m_pFavoritesModel = m_pFavoritesModel;
+    m_warmAccountModels.prepend(models);
+
+    m_pNotebookModel = Q_NULLPTR;
+    m_pTagModel = Q_NULLPTR;
+    m_pSavedSearchModel = Q_NULLPTR;
+    m_pNoteModel = Q_NULLPTR;
+    m_pDeletedNotesModel = Q_NULLPTR;
+    m_pFavoritesModel = Q_NULLPTR;
+
+    QNDEBUG(QStringLiteral("Keeping the models of account ") << models.m_account.name() << QStringLiteral(" warm"));
+    evictWarmAccountModels(numAccounts, maxNumNotes);
+    return true;
+}
+
+bool MainWindow::restoreWarmAccountModels()
+{
+    QNDEBUG(QStringLiteral("MainWindow::restoreWarmAccountModels"));
+
+    if (Q_UNLIKELY(!m_pAccount)) {
+        return false;
+    }
+
+    for(int i = 0, size = m_warmAccountModels.size(); i < size; ++i)
+    {
+        if (!(m_warmAccountModels[i].m_account == *m_pAccount)) {
+            continue;
+        }
+
+        WarmAccountModels models = m_warmAccountModels.takeAt(i);
+
+        m_pNotebookModel = models.m_pNotebookModel;
+        m_pTagModel = models.m_pTagModel;
+        m_pSavedSearchModel = models.m_pSavedSearchModel;
+        m_pNoteModel = models.m_pNoteModel;
+        m_pDeletedNotesModel = models.m_pDeletedNotesModel;
+        m_pFavoritesModel = models.m_pFavoritesModel;
+
+        // The models were detached only when they had no local storage requests in flight, and the local
+        // storage of the account is only modified while the account is the current one (only the current
+        // account is synchronized), so once reconnected, the models are up to date and just continue to track
+        // the changes incrementally as usual
+        m_pNoteModel->connectToLocalStorage(*m_pLocalStorageManagerAsync);
+        m_pDeletedNotesModel->connectToLocalStorage(*m_pLocalStorageManagerAsync);
+        m_pNotebookModel->connectToLocalStorage(*m_pNoteModel, *m_pLocalStorageManagerAsync);
+        m_pTagModel->connectToLocalStorage(*m_pLocalStorageManagerAsync);
+        m_pSavedSearchModel->connectToLocalStorage(*m_pLocalStorageManagerAsync);
+        m_pFavoritesModel->connectToLocalStorage(*m_pNoteModel, *m_pLocalStorageManagerAsync);
+
+        QNDEBUG(QStringLiteral("Restored the warm models of account ") << models.m_account.name());
+        return true;
+    }
+
+    return false;
+}
+
+void MainWindow::evictWarmAccountModels(const int maxNumAccounts, const int maxNumNotes)
+{
+    QNDEBUG(QStringLiteral("MainWindow::evictWarmAccountModels: max num accounts = ") << maxNumAccounts
+            << QStringLiteral(", max num notes = ") << maxNumNotes);
+
+    // The notes are what takes the most of the memory consumed by the models so their number
+    // serves as the measure of the memory kept by the warm models
+    int numNotes = 0;
+    for(int i = 0; i < m_warmAccountModels.size(); )
+    {
+        const WarmAccountModels & models = m_warmAccountModels[i];
+        int numAccountNotes = models.m_pNoteModel->rowCount(QModelIndex()) +
+                              models.m_pDeletedNotesModel->rowCount(QModelIndex());
+        if ((i < maxNumAccounts) && (numNotes + numAccountNotes <= maxNumNotes)) {
+            numNotes += numAccountNotes;
+            ++i;
+            continue;
+        }
+
+        QNDEBUG(QStringLiteral("Deleting the warm models of account ") << models.m_account.name()
+                << QStringLiteral(", num notes = ") << numAccountNotes);
+
+        delete models.m_pNotebookModel;
+        delete models.m_pTagModel;
+        delete models.m_pSavedSearchModel;
+        delete models.m_pNoteModel;
+        delete models.m_pDeletedNotesModel;
+        delete models.m_pFavoritesModel;
+
+        m_warmAccountModels.removeAt(i);
+    }
+}
+
 void MainWindow::setupShowHideStartupSettings()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupShowHideStartupSettings"));
@@ -4291,6 +4755,8 @@ void MainWindow::setupViews()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupViews"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupViews");
+
     // NOTE: only a few columns would be shown for each view because otherwise there are problems finding space for everything
     // TODO: in future should implement the persistent setting of which columns to show or not to show
 
@@ -4495,6 +4961,7 @@ void MainWindow::setupViews()
     }
 
     pNoteListView->setNotebookItemView(pNotebooksTreeView);
+    pNoteListView->setTagItemView(m_pUI->tagsTreeView);
 #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
     QObject::connect(m_pNoteModelColumnChangeRerouter, &ColumnChangeRerouter::dataChanged,
                      pNoteListView, &NoteListView::dataChanged, Qt::UniqueConnection);
@@ -4601,6 +5068,14 @@ void MainWindow::setupViews()
                          Qt::UniqueConnection);
     }
 
+    if (!m_pNotePrefetcher)
+    {
+        m_pNotePrefetcher = new NotePrefetcher(*m_pLocalStorageManagerAsync, m_noteCache, this);
+        QObject::connect(pNoteListView, QNSIGNAL(NoteListView,adjacentNotesChanged,QStringList),
+                         m_pNotePrefetcher, QNSLOT(NotePrefetcher,onAdjacentNotesChanged,QStringList),
+                         Qt::UniqueConnection);
+    }
+
     Account::Type::type currentAccountType = Account::Type::Local;
     if (m_pAccount) {
         currentAccountType = m_pAccount->type();
@@ -4731,6 +5206,11 @@ void MainWindow::setupNoteFilters()
                                                    *m_pUI->searchQueryLineEdit,
                                                    *m_pLocalStorageManagerAsync, this);
 
+    if (m_pFavoritesModel) {
+        QObject::connect(m_pNoteFiltersManager, QNSIGNAL(NoteFiltersManager,savedSearchNoteCountChanged,QString,int),
+                         m_pFavoritesModel, QNSLOT(FavoritesModel,setSavedSearchNoteCount,QString,int));
+    }
+
     ApplicationSettings appSettings(*m_pAccount, QUENTIER_UI_SETTINGS);
     appSettings.beginGroup(QStringLiteral("FiltersView"));
     m_filtersViewExpanded = appSettings.value(FILTERS_VIEW_STATUS_KEY).toBool();
@@ -4747,6 +5227,14 @@ void MainWindow::setupNoteEditorTabWidgetsCoordinator()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupNoteEditorTabWidgetsCoordinator"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupNoteEditorTabWidgetsCoordinator");
+
+    // The sync postponed until the previous account's notes are saved should not start for the new account
+    if (m_pendingNoteSavesBeforeSyncTimerId != 0) {
+        killTimer(m_pendingNoteSavesBeforeSyncTimerId);
+        m_pendingNoteSavesBeforeSyncTimerId = 0;
+    }
+
     delete m_pNoteEditorTabsAndWindowsCoordinator;
     m_pNoteEditorTabsAndWindowsCoordinator = new NoteEditorTabsAndWindowsCoordinator(*m_pAccount, *m_pLocalStorageManagerAsync,
                                                                                      m_noteCache, m_notebookCache,
@@ -4787,6 +5275,8 @@ void MainWindow::setupSynchronizationManager(const SetAccountOption::type setAcc
     QNDEBUG(QStringLiteral("MainWindow::setupSynchronizationManager: set account option = ")
             << setAccountOption);
 
+    StartupTracer::Phase startupPhase("MainWindow::setupSynchronizationManager");
+
     clearSynchronizationManager();
 
     if (m_synchronizationManagerHost.isEmpty())
@@ -4990,10 +5480,52 @@ void MainWindow::setupRunSyncPeriodicallyTimer()
     onRunSyncEachNumMinitesPreferenceChanged(runSyncEachNumMinutes);
 }
 
+void MainWindow::scheduleSyncProgressRendering()
+{
+    if (m_syncProgressTracker.checkRenderingNow()) {
+        onSetStatusBarText(m_syncProgressTracker.toString());
+    }
+
+    // The timer renders the progress coalesced within the rendering interval, if any
+    if (m_syncProgressRenderingTimerId == 0) {
+        m_syncProgressRenderingTimerId = startTimer(SyncProgressTracker::renderingIntervalMsec());
+    }
+}
+
+void MainWindow::synchronizeAfterPendingNoteSaves()
+{
+    QNDEBUG(QStringLiteral("MainWindow::synchronizeAfterPendingNoteSaves"));
+
+    if (m_pNoteEditorTabsAndWindowsCoordinator) {
+        QObject::disconnect(m_pNoteEditorTabsAndWindowsCoordinator,
+                            QNSIGNAL(NoteEditorTabsAndWindowsCoordinator,pendingNoteSavesFinished),
+                            this, QNSLOT(MainWindow,onPendingNoteSavesFinishedBeforeSync));
+    }
+
+    if (m_pendingNoteSavesBeforeSyncTimerId != 0) {
+        killTimer(m_pendingNoteSavesBeforeSyncTimerId);
+        m_pendingNoteSavesBeforeSyncTimerId = 0;
+    }
+
+    if (Q_UNLIKELY(!m_pAccount || (m_pAccount->type() == Account::Type::Local))) {
+        QNDEBUG(QStringLiteral("The current account can no longer be synchronized"));
+        return;
+    }
+
+    if (m_syncInProgress) {
+        QNDEBUG(QStringLiteral("The synchronization has already been started"));
+        return;
+    }
+
+    Q_EMIT synchronize();
+}
+
 void MainWindow::setupDefaultShortcuts()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupDefaultShortcuts"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupDefaultShortcuts");
+
     using quentier::ShortcutManager;
 
 #define PROCESS_ACTION_SHORTCUT(action, key, context) \
@@ -5043,6 +5575,8 @@ void MainWindow::setupUserShortcuts()
 {
     QNDEBUG(QStringLiteral("MainWindow::setupUserShortcuts"));
 
+    StartupTracer::Phase startupPhase("MainWindow::setupUserShortcuts");
+
 #define PROCESS_ACTION_SHORTCUT(action, key, ...) \
     { \
         QKeySequence shortcut = m_shortcutManager.shortcut(key, *m_pAccount, QStringLiteral("" __VA_ARGS__)); \
@@ -5293,6 +5827,8 @@ void MainWindow::restoreGeometryAndState()
 {
     QNDEBUG(QStringLiteral("MainWindow::restoreGeometryAndState"));
 
+    StartupTracer::Phase startupPhase("MainWindow::restoreGeometryAndState");
+
     ApplicationSettings appSettings(*m_pAccount, QUENTIER_UI_SETTINGS);
     appSettings.beginGroup(QStringLiteral("MainWindow"));
     QByteArray savedGeometry = appSettings.value(MAIN_WINDOW_GEOMETRY_KEY).toByteArray();
@@ -5648,12 +6184,9 @@ void MainWindow::refreshThemeIcons()
             continue;
         }
 
-        QIcon newIcon;
-        if (QIcon::hasThemeIcon(iconName)) {
-            newIcon = QIcon::fromTheme(iconName);
-        }
-        else {
-            newIcon.addFile(QStringLiteral("."), QSize(), QIcon::Normal, QIcon::Off);
+        QIcon newIcon = themeIcon(iconName);
+        if (newIcon.cacheKey() == icon.cacheKey()) {
+            continue;
         }
 
         object->setIcon(newIcon);
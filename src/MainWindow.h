@@ -21,6 +21,7 @@
 
 #include "AccountManager.h"
 #include "NoteEditorTabsAndWindowsCoordinator.h"
+#include "SyncProgressTracker.h"
 #include "models/NotebookCache.h"
 #include "models/TagCache.h"
 #include "models/SavedSearchCache.h"
@@ -55,6 +56,7 @@
 #include <QStandardItemModel>
 #include <QStringList>
 #include <QMovie>
+#include <QIcon>
 #include <QNetworkProxy>
 
 namespace Ui {
@@ -72,6 +74,7 @@ QT_FORWARD_DECLARE_CLASS(NoteEditor)
 QT_FORWARD_DECLARE_CLASS(NoteFilterModel)
 QT_FORWARD_DECLARE_CLASS(NoteFiltersManager)
 QT_FORWARD_DECLARE_CLASS(EditNoteDialogsManager)
+QT_FORWARD_DECLARE_CLASS(NotePrefetcher)
 QT_FORWARD_DECLARE_CLASS(SystemTrayIconManager)
 QT_FORWARD_DECLARE_CLASS(MainWindowSideBordersController)
 }
@@ -237,6 +240,11 @@ private Q_SLOTS:
     void onToggleThumbnailsPreference(QString noteLocalUid);
 
     void onNoteModelAllNotesListed();
+    void onFavoritesModelAllItemsListed();
+    void onNotebookModelAllNotebooksListed();
+    void onTagModelAllTagsListed();
+    void onSavedSearchModelAllSavedSearchesListed();
+    void onDeletedNotesModelAllNotesListed();
 
     void onCurrentNoteInListChanged(QString noteLocalUid);
     void onOpenNoteInSeparateWindow(QString noteLocalUid);
@@ -272,6 +280,7 @@ private Q_SLOTS:
     void onSystemTrayIconManagerError(ErrorString errorDescription);
 
     void onViewLogsActionTriggered();
+    void onShowModelInstrumentationActionTriggered();
     void onShowInfoAboutQuentierActionTriggered();
 
     void onNoteEditorError(ErrorString error);
@@ -291,6 +300,7 @@ private Q_SLOTS:
     void onSidePanelSplittedHandleMoved(int pos, int index);
 
     void onSyncButtonPressed();
+    void onPendingNoteSavesFinishedBeforeSync();
     void onAnimatedSyncIconFrameChanged(int frame);
     void onAnimatedSyncIconFrameChangedPendingFinish(int frame);
     void onSyncIconAnimationFinished();
@@ -325,6 +335,7 @@ private:
 
     void setupThemeIcons();
     void setupAccountManager();
+    void startLocalStorageManagerThread();
     void setupLocalStorageManager();
 
     void setupDefaultAccount();
@@ -332,6 +343,12 @@ private:
     void setupModels();
     void clearModels();
 
+    // Detaches the models of the current account from the views and the local storage and keeps them
+    // for the case of switching back to this account; returns false if the models should be deleted instead
+    bool keepCurrentAccountModelsWarm();
+    bool restoreWarmAccountModels();
+    void evictWarmAccountModels(const int maxNumAccounts, const int maxNumNotes);
+
     void setupShowHideStartupSettings();
     void setupViews();
     void clearViews();
@@ -359,6 +376,11 @@ private:
     void checkAndLaunchPendingSync();
     void setupRunSyncPeriodicallyTimer();
 
+    // Renders the sync progress right away unless it was rendered recently, in which case the rendering
+    // is postponed until the end of the current rendering interval
+    void scheduleSyncProgressRendering();
+    void synchronizeAfterPendingNoteSaves();
+
     void setupDefaultShortcuts();
     void setupUserShortcuts();
     void startListeningForShortcutChanges();
@@ -414,6 +436,9 @@ private:
     template <class T>
     void refreshThemeIcons();
 
+    // Returns the icon from the current icon theme, the icons are resolved once per theme
+    QIcon themeIcon(const QString & iconName);
+
     void showHideViewColumnsForAccountType(const Account::Type::type accountType);
 
     void expandFiltersView();
@@ -454,6 +479,7 @@ private:
     void setupPanelOverlayStyleSheets();
     void getPanelStyleSheetProperties(const QString & panelStyleOption, StyleSheetProperties & properties) const;
     void setPanelsOverlayStyleSheet(const StyleSheetProperties & properties);
+    QString panelStyleSheetPropertiesKey(const StyleSheetProperties & properties) const;
 
     // This method performs a nasty hack - it searches for some properties within
     // the passed in stylesheet and alters some of these; the whole workflow is based
@@ -527,6 +553,15 @@ private:
     QMovie                      m_animatedSyncButtonIcon;
     int                         m_runSyncPeriodicallyTimerId;
 
+    // The sync requested via the sync button is postponed until the note editors finish saving the modified notes
+    // but no longer than until this timer fires
+    int                         m_pendingNoteSavesBeforeSyncTimerId;
+
+    // The sync progress notifications are aggregated by the tracker and rendered into the status bar
+    // no more often than once per the tracker's rendering interval
+    SyncProgressTracker         m_syncProgressTracker;
+    int                         m_syncProgressRenderingTimerId;
+
     MainWindowSideBordersController *   m_pSideBordersController;
 
     NotebookCache           m_notebookCache;
@@ -547,6 +582,30 @@ private:
     NoteModel *             m_pDeletedNotesModel;
     FavoritesModel *        m_pFavoritesModel;
 
+    struct WarmAccountModels
+    {
+        explicit WarmAccountModels(const Account & account) :
+            m_account(account),
+            m_pNotebookModel(Q_NULLPTR),
+            m_pTagModel(Q_NULLPTR),
+            m_pSavedSearchModel(Q_NULLPTR),
+            m_pNoteModel(Q_NULLPTR),
+            m_pDeletedNotesModel(Q_NULLPTR),
+            m_pFavoritesModel(Q_NULLPTR)
+        {}
+
+        Account                 m_account;
+        NotebookModel *         m_pNotebookModel;
+        TagModel *              m_pTagModel;
+        SavedSearchModel *      m_pSavedSearchModel;
+        NoteModel *             m_pNoteModel;
+        NoteModel *             m_pDeletedNotesModel;
+        FavoritesModel *        m_pFavoritesModel;
+    };
+
+    // The models of recently used accounts, the most recently used one goes first
+    QList<WarmAccountModels>    m_warmAccountModels;
+
     QStandardItemModel      m_blankModel;
 
     NoteFilterModel *       m_pNoteFilterModel;
@@ -557,6 +616,7 @@ private:
 
     NoteEditorTabsAndWindowsCoordinator *   m_pNoteEditorTabsAndWindowsCoordinator;
     EditNoteDialogsManager *                m_pEditNoteDialogsManager;
+    NotePrefetcher *                        m_pNotePrefetcher;
 
     QUndoStack *            m_pUndoStack;
 
@@ -564,10 +624,16 @@ private:
     {
         QPointer<QWidget>   m_targetWidget;
         QString             m_baseStyleSheet;
-        QString             m_overlayStyleSheet;
+
+        // The overlay stylesheets computed from the base one, by the key of stylesheet properties
+        QHash<QString, QString>     m_overlayStyleSheetsByPropertiesKey;
     };
 
     QHash<QWidget*, StyleSheetInfo>    m_styleSheetInfo;
+    QString                            m_currentPanelStyleSheetPropertiesKey;
+
+    // Resolved theme icons by icon name, by icon theme name
+    QHash<QString, QHash<QString, QIcon> >  m_themeIconsByThemeName;
 
     QString                     m_currentPanelStyle;
 
@@ -57,6 +57,11 @@
 
 #define PERSIST_NOTE_EDITOR_WINDOW_GEOMETRY_DELAY (3000)
 
+// Each note editor widget contains the web page based editor which is quite heavy in terms of memory,
+// so the number of idle pre-initialized widgets is limited regardless of the max number of note tabs
+#define MAX_NOTE_EDITOR_WIDGETS_POOL_SIZE (3)
+#define NOTE_EDITOR_WIDGETS_POOL_WARM_UP_DELAY (500)
+
 namespace quentier {
 
 NoteEditorTabsAndWindowsCoordinator::NoteEditorTabsAndWindowsCoordinator(const Account & account, LocalStorageManagerAsync & localStorageManagerAsync,
@@ -87,6 +92,11 @@ NoteEditorTabsAndWindowsCoordinator::NoteEditorTabsAndWindowsCoordinator(const A
     m_pTabBarContextMenu(Q_NULLPTR),
     m_localUidOfNoteToBeExpunged(),
     m_pExpungeNoteDeadlineTimer(Q_NULLPTR),
+    m_noteEditorWidgetsPool(),
+    m_noteEditorWidgetsPoolWarmUpTimerId(0),
+    m_noteOpeningTimersByNoteLocalUid(),
+    m_noteLocalUidsBySavingNoteEditorWidgets(),
+    m_noteEditorWidgetsToDeleteWhenNoteSaved(),
     m_trackingCurrentTab(true)
 {
     ApplicationSettings appSettings(m_currentAccount, QUENTIER_UI_SETTINGS);
@@ -112,13 +122,7 @@ NoteEditorTabsAndWindowsCoordinator::NoteEditorTabsAndWindowsCoordinator(const A
     setupFileIO();
     setupSpellChecker();
 
-    QUndoStack * pUndoStack = new QUndoStack;
-    m_pBlankNoteEditor = new NoteEditorWidget(m_currentAccount, m_localStorageManagerAsync,
-                                              *m_pFileIOProcessorAsync, *m_pSpellChecker,
-                                              m_noteCache, m_notebookCache, m_tagCache,
-                                              *m_pTagModel, pUndoStack, m_pTabWidget);
-    pUndoStack->setParent(m_pBlankNoteEditor);
-
+    m_pBlankNoteEditor = createNoteEditorWidget();
     Q_UNUSED(m_pTabWidget->addTab(m_pBlankNoteEditor, BLANK_NOTE_KEY))
 
     QTabBar * pTabBar = m_pTabWidget->tabBar();
@@ -128,6 +132,7 @@ NoteEditorTabsAndWindowsCoordinator::NoteEditorTabsAndWindowsCoordinator(const A
                      this, QNSLOT(NoteEditorTabsAndWindowsCoordinator,onTabContextMenuRequested,QPoint));
 
     restoreLastOpenNotes();
+    scheduleNoteEditorWidgetsPoolWarmUp();
 
     QObject::connect(m_pTabWidget, QNSIGNAL(TabWidget,tabCloseRequested,int),
                      this, QNSLOT(NoteEditorTabsAndWindowsCoordinator,onNoteEditorTabCloseRequested,int));
@@ -185,18 +190,10 @@ void NoteEditorTabsAndWindowsCoordinator::clear()
         QString noteLocalUid = pNoteEditorWidget->noteLocalUid();
         QNTRACE(QStringLiteral("Safely closing note editor tab: ") << noteLocalUid);
 
-        ErrorString errorDescription;
-        NoteEditorWidget::NoteSaveStatus::type res = pNoteEditorWidget->checkAndSaveModifiedNote(errorDescription);
-        if (Q_UNLIKELY(res != NoteEditorWidget::NoteSaveStatus::Ok)) {
-            QNINFO(QStringLiteral("Could not save note: ") << pNoteEditorWidget->noteLocalUid()
-                   << QStringLiteral(", status: ") << res << QStringLiteral(", error: ") << errorDescription);
-        }
-
         m_pTabWidget->removeTab(0);
 
-        pNoteEditorWidget->removeEventFilter(this);
-        pNoteEditorWidget->hide();
-        pNoteEditorWidget->deleteLater();
+        // The notes from all the closed editors are saved concurrently, not one after another
+        deleteNoteEditorWidgetWhenNoteSaved(pNoteEditorWidget);
 
         QNTRACE(QStringLiteral("Removed note editor tab: ") << noteLocalUid);
     }
@@ -214,16 +211,7 @@ void NoteEditorTabsAndWindowsCoordinator::clear()
         QString noteLocalUid = pNoteEditorWidget->noteLocalUid();
         QNTRACE(QStringLiteral("Safely closing note editor window: ") << noteLocalUid);
 
-        ErrorString errorDescription;
-        NoteEditorWidget::NoteSaveStatus::type res = pNoteEditorWidget->checkAndSaveModifiedNote(errorDescription);
-        if (Q_UNLIKELY(res != NoteEditorWidget::NoteSaveStatus::Ok)) {
-            QNINFO(QStringLiteral("Could not save note: ") << pNoteEditorWidget->noteLocalUid()
-                   << QStringLiteral(", status: ") << res << QStringLiteral(", error: ") << errorDescription);
-        }
-
-        pNoteEditorWidget->removeEventFilter(this);
-        pNoteEditorWidget->hide();
-        pNoteEditorWidget->deleteLater();
+        deleteNoteEditorWidgetWhenNoteSaved(pNoteEditorWidget);
         Q_UNUSED(m_noteEditorWindowsByNoteLocalUid.erase(it))
 
         QNTRACE(QStringLiteral("Closed note editor window: ") << noteLocalUid);
@@ -246,6 +234,10 @@ void NoteEditorTabsAndWindowsCoordinator::clear()
     m_inAppNoteLinkFindNoteRequestIds.clear();
 
     m_localUidOfNoteToBeExpunged.clear();
+
+    // The pooled note editor widgets are bound to the current account and tag model
+    clearNoteEditorWidgetsPool();
+    m_noteOpeningTimersByNoteLocalUid.clear();
 }
 
 void NoteEditorTabsAndWindowsCoordinator::switchAccount(const Account & account, TagModel & tagModel)
@@ -263,6 +255,7 @@ void NoteEditorTabsAndWindowsCoordinator::switchAccount(const Account & account,
     m_currentAccount = account;
 
     restoreLastOpenNotes();
+    scheduleNoteEditorWidgetsPoolWarmUp();
 }
 
 void NoteEditorTabsAndWindowsCoordinator::setMaxNumNotesInTabs(const int maxNumNotesInTabs)
@@ -277,6 +270,7 @@ void NoteEditorTabsAndWindowsCoordinator::setMaxNumNotesInTabs(const int maxNumN
     if (m_maxNumNotesInTabs < maxNumNotesInTabs) {
         m_maxNumNotesInTabs = maxNumNotesInTabs;
         QNDEBUG(QStringLiteral("Max number of notes in tabs has been increased to ") << maxNumNotesInTabs);
+        scheduleNoteEditorWidgetsPoolWarmUp();
         return;
     }
 
@@ -285,6 +279,15 @@ void NoteEditorTabsAndWindowsCoordinator::setMaxNumNotesInTabs(const int maxNumN
     m_maxNumNotesInTabs = maxNumNotesInTabs;
     QNDEBUG(QStringLiteral("Max number of notes in tabs has been decreased to ") << maxNumNotesInTabs);
 
+    int poolCapacity = noteEditorWidgetsPoolCapacity();
+    while(m_noteEditorWidgetsPool.size() > poolCapacity)
+    {
+        QPointer<NoteEditorWidget> pNoteEditorWidget = m_noteEditorWidgetsPool.takeLast();
+        if (!pNoteEditorWidget.isNull()) {
+            pNoteEditorWidget->deleteLater();
+        }
+    }
+
     if (currentNumNotesInTabs <= maxNumNotesInTabs) {
         return;
     }
@@ -403,6 +406,9 @@ void NoteEditorTabsAndWindowsCoordinator::addNote(const QString & noteLocalUid,
 
     // If we got here, the note with specified local uid was not found within already open windows or tabs
 
+    QElapsedTimer & noteOpeningTimer = m_noteOpeningTimersByNoteLocalUid[noteLocalUid];
+    noteOpeningTimer.start();
+
     if ((noteEditorMode != NoteEditorMode::Window) && m_pBlankNoteEditor)
     {
         QNDEBUG(QStringLiteral("Currently only the blank note tab is displayed, "
@@ -426,14 +432,12 @@ void NoteEditorTabsAndWindowsCoordinator::addNote(const QString & noteLocalUid,
         return;
     }
 
-    QUndoStack * pUndoStack = new QUndoStack;
-    NoteEditorWidget * pNoteEditorWidget = new NoteEditorWidget(m_currentAccount, m_localStorageManagerAsync,
-                                                                *m_pFileIOProcessorAsync, *m_pSpellChecker,
-                                                                m_noteCache, m_notebookCache, m_tagCache,
-                                                                *m_pTagModel, pUndoStack, m_pTabWidget);
-    pUndoStack->setParent(pNoteEditorWidget);
+    NoteEditorWidget * pNoteEditorWidget = acquireNoteEditorWidget();
     pNoteEditorWidget->setNoteLocalUid(noteLocalUid, isNewNote);
     insertNoteEditorWidget(pNoteEditorWidget, noteEditorMode);
+
+    // Replenish the pool for the next note to be opened
+    scheduleNoteEditorWidgetsPoolWarmUp();
 }
 
 void NoteEditorTabsAndWindowsCoordinator::createNewNote(const QString & notebookLocalUid,
@@ -505,6 +509,14 @@ void NoteEditorTabsAndWindowsCoordinator::setUseLimitedFonts(const bool flag)
 
         pNoteEditorWidget->onSetUseLimitedFonts(flag);
     }
+
+    for(auto it = m_noteEditorWidgetsPool.begin(), end = m_noteEditorWidgetsPool.end(); it != end; ++it)
+    {
+        const QPointer<NoteEditorWidget> & pNoteEditorWidget = *it;
+        if (!pNoteEditorWidget.isNull()) {
+            pNoteEditorWidget->onSetUseLimitedFonts(flag);
+        }
+    }
 }
 
 void NoteEditorTabsAndWindowsCoordinator::refreshNoteEditorWidgetsSpecialIcons()
@@ -533,13 +545,20 @@ void NoteEditorTabsAndWindowsCoordinator::refreshNoteEditorWidgetsSpecialIcons()
 
         pNoteEditorWidget->refreshSpecialIcons();
     }
+
+    for(auto it = m_noteEditorWidgetsPool.begin(), end = m_noteEditorWidgetsPool.end(); it != end; ++it)
+    {
+        const QPointer<NoteEditorWidget> & pNoteEditorWidget = *it;
+        if (!pNoteEditorWidget.isNull()) {
+            pNoteEditorWidget->refreshSpecialIcons();
+        }
+    }
 }
 
 void NoteEditorTabsAndWindowsCoordinator::saveAllNoteEditorsContents()
 {
     QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::saveAllNoteEditorsContents"));
 
-    ErrorString errorDescription;
     QList<NoteEditorWidget*> noteEditorWidgets = m_pTabWidget->findChildren<NoteEditorWidget*>();
     for(auto it = noteEditorWidgets.begin(), end = noteEditorWidgets.end(); it != end; ++it)
     {
@@ -548,13 +567,15 @@ void NoteEditorTabsAndWindowsCoordinator::saveAllNoteEditorsContents()
             continue;
         }
 
-        NoteEditorWidget::NoteSaveStatus::type status = pNoteEditorWidget->checkAndSaveModifiedNote(errorDescription);
-        if (status != NoteEditorWidget::NoteSaveStatus::Ok) {
-            Q_EMIT notifyError(errorDescription);
-        }
+        Q_UNUSED(startSavingNoteInEditor(pNoteEditorWidget))
     }
 }
 
+bool NoteEditorTabsAndWindowsCoordinator::hasPendingNoteSaves() const
+{
+    return !m_noteLocalUidsBySavingNoteEditorWidgets.isEmpty();
+}
+
 bool NoteEditorTabsAndWindowsCoordinator::eventFilter(QObject * pWatched, QEvent * pEvent)
 {
     if (Q_UNLIKELY(!pEvent)) {
@@ -581,10 +602,10 @@ bool NoteEditorTabsAndWindowsCoordinator::eventFilter(QObject * pWatched, QEvent
 
                 if (pNoteEditorWidget->isModified())
                 {
-                    ErrorString errorDescription;
-                    NoteEditorWidget::NoteSaveStatus::type status = pNoteEditorWidget->checkAndSaveModifiedNote(errorDescription);
-                    QNDEBUG(QStringLiteral("Check and save modified note, status: ") << status
-                            << QStringLiteral(", error description: ") << errorDescription);
+                    // The widget would postpone its own close until the note is saved
+                    bool savingNote = startSavingNoteInEditor(pNoteEditorWidget);
+                    QNDEBUG(QStringLiteral("Check and save modified note, saving note: ")
+                            << (savingNote ? QStringLiteral("true") : QStringLiteral("false")));
                 }
                 else
                 {
@@ -619,13 +640,8 @@ bool NoteEditorTabsAndWindowsCoordinator::eventFilter(QObject * pWatched, QEvent
         if (pNoteEditorWidget)
         {
             QString noteLocalUid = pNoteEditorWidget->noteLocalUid();
-            if (!noteLocalUid.isEmpty())
-            {
-                ErrorString errorDescription;
-                NoteEditorWidget::NoteSaveStatus::type noteSaveStatus = pNoteEditorWidget->checkAndSaveModifiedNote(errorDescription);
-                if (noteSaveStatus != NoteEditorWidget::NoteSaveStatus::Ok) {
-                    Q_EMIT notifyError(errorDescription);
-                }
+            if (!noteLocalUid.isEmpty()) {
+                Q_UNUSED(startSavingNoteInEditor(pNoteEditorWidget))
             }
         }
     }
@@ -795,6 +811,20 @@ void NoteEditorTabsAndWindowsCoordinator::onInAppNoteLinkClicked(QString userId,
 void NoteEditorTabsAndWindowsCoordinator::onNoteLoadedInEditor()
 {
     QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::onNoteLoadedInEditor"));
+
+    NoteEditorWidget * pNoteEditorWidget = qobject_cast<NoteEditorWidget*>(sender());
+    if (Q_UNLIKELY(!pNoteEditorWidget)) {
+        return;
+    }
+
+    auto it = m_noteOpeningTimersByNoteLocalUid.find(pNoteEditorWidget->noteLocalUid());
+    if (it == m_noteOpeningTimersByNoteLocalUid.end()) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("Note ") << it.key() << QStringLiteral(" became interactive within the note editor in ")
+            << it.value().elapsed() << QStringLiteral(" msec since the request to open it"));
+    Q_UNUSED(m_noteOpeningTimersByNoteLocalUid.erase(it))
 }
 
 void NoteEditorTabsAndWindowsCoordinator::onNoteEditorError(ErrorString errorDescription)
@@ -828,6 +858,75 @@ void NoteEditorTabsAndWindowsCoordinator::onNoteEditorError(ErrorString errorDes
     Q_EMIT notifyError(error);
 }
 
+void NoteEditorTabsAndWindowsCoordinator::onNoteEditorWidgetNoteSaveFinished(QString noteLocalUid,
+                                                                             NoteEditorWidget::NoteSaveStatus::type status,
+                                                                             ErrorString errorDescription)
+{
+    QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::onNoteEditorWidgetNoteSaveFinished: note local uid = ")
+            << noteLocalUid << QStringLiteral(", status = ") << status << QStringLiteral(", error description: ")
+            << errorDescription);
+
+    NoteEditorWidget * pNoteEditorWidget = qobject_cast<NoteEditorWidget*>(sender());
+    if (Q_UNLIKELY(!pNoteEditorWidget)) {
+        QNWARNING(QStringLiteral("Received note save finish from note editor but can't cast the sender to NoteEditorWidget"));
+        return;
+    }
+
+    QObject::disconnect(pNoteEditorWidget, QNSIGNAL(NoteEditorWidget,noteSaveFinished,QString,
+                                                    NoteEditorWidget::NoteSaveStatus::type,ErrorString),
+                        this, QNSLOT(NoteEditorTabsAndWindowsCoordinator,onNoteEditorWidgetNoteSaveFinished,QString,
+                                     NoteEditorWidget::NoteSaveStatus::type,ErrorString));
+    QObject::disconnect(pNoteEditorWidget, QNSIGNAL(QObject,destroyed,QObject*),
+                        this, QNSLOT(NoteEditorTabsAndWindowsCoordinator,onNoteEditorWidgetSavingNoteDestroyed,QObject*));
+
+    if (Q_UNLIKELY(status != NoteEditorWidget::NoteSaveStatus::Ok))
+    {
+        ErrorString error(QT_TR_NOOP("Couldn't save the note"));
+        error.appendBase(errorDescription.base());
+        error.appendBase(errorDescription.additionalBases());
+        error.details() = errorDescription.details();
+        QNWARNING(error << QStringLiteral(", note local uid = ") << noteLocalUid << QStringLiteral(", status = ") << status);
+        Q_EMIT notifyError(error);
+    }
+
+    Q_UNUSED(m_noteLocalUidsBySavingNoteEditorWidgets.remove(pNoteEditorWidget))
+
+    if (m_noteEditorWidgetsToDeleteWhenNoteSaved.remove(pNoteEditorWidget)) {
+        QNTRACE(QStringLiteral("Deleting the closed note editor widget which has finished saving its note"));
+        pNoteEditorWidget->deleteLater();
+    }
+
+    if (m_noteLocalUidsBySavingNoteEditorWidgets.isEmpty()) {
+        QNDEBUG(QStringLiteral("No more note editors are saving notes"));
+        Q_EMIT pendingNoteSavesFinished();
+    }
+}
+
+void NoteEditorTabsAndWindowsCoordinator::onNoteEditorWidgetSavingNoteDestroyed(QObject * pNoteEditorWidget)
+{
+    auto it = m_noteLocalUidsBySavingNoteEditorWidgets.find(pNoteEditorWidget);
+    if (it == m_noteLocalUidsBySavingNoteEditorWidgets.end()) {
+        return;
+    }
+
+    QString noteLocalUid = it.value();
+    QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::onNoteEditorWidgetSavingNoteDestroyed: note local uid = ")
+            << noteLocalUid);
+
+    Q_UNUSED(m_noteLocalUidsBySavingNoteEditorWidgets.erase(it))
+    Q_UNUSED(m_noteEditorWidgetsToDeleteWhenNoteSaved.remove(pNoteEditorWidget))
+
+    // The editor won't report the result of saving anymore so the save is considered failed
+    ErrorString error(QT_TR_NOOP("Couldn't save the note: the note editor was destroyed before the note was saved"));
+    QNWARNING(error << QStringLiteral(", note local uid = ") << noteLocalUid);
+    Q_EMIT notifyError(error);
+
+    if (m_noteLocalUidsBySavingNoteEditorWidgets.isEmpty()) {
+        QNDEBUG(QStringLiteral("No more note editors are saving notes"));
+        Q_EMIT pendingNoteSavesFinished();
+    }
+}
+
 void NoteEditorTabsAndWindowsCoordinator::onAddNoteComplete(Note note, QUuid requestId)
 {
     auto it = m_noteEditorModeByCreateNoteRequestIds.find(requestId);
@@ -1145,18 +1244,7 @@ void NoteEditorTabsAndWindowsCoordinator::onTabContextMenuSaveNoteAction()
             return;
         }
 
-        ErrorString errorDescription;
-        NoteEditorWidget::NoteSaveStatus::type res = pNoteEditorWidget->checkAndSaveModifiedNote(errorDescription);
-        if (Q_UNLIKELY(res != NoteEditorWidget::NoteSaveStatus::Ok))
-        {
-            ErrorString error(QT_TR_NOOP("Couldn't save the note"));
-            error.appendBase(errorDescription.base());
-            error.appendBase(errorDescription.additionalBases());
-            error.details() = errorDescription.details();
-            QNWARNING(error << QStringLiteral(", note local uid = ") << noteLocalUid);
-            Q_EMIT notifyError(error);
-        }
-
+        Q_UNUSED(startSavingNoteInEditor(pNoteEditorWidget))
         return;
     }
 
@@ -1227,6 +1315,11 @@ void NoteEditorTabsAndWindowsCoordinator::timerEvent(QTimerEvent * pTimerEvent)
     }
 
     int timerId = pTimerEvent->timerId();
+    if (timerId == m_noteEditorWidgetsPoolWarmUpTimerId) {
+        warmUpNoteEditorWidgetsPool();
+        return;
+    }
+
     auto it = m_saveNoteEditorWindowGeometryPostponeTimerIdToNoteLocalUidBimap.right.find(timerId);
     if (it != m_saveNoteEditorWindowGeometryPostponeTimerIdToNoteLocalUidBimap.right.end())
     {
@@ -1334,12 +1427,13 @@ void NoteEditorTabsAndWindowsCoordinator::removeNoteEditorTab(int tabIndex, cons
 
     bool expungeFlag = false;
 
+    bool savingNote = false;
+
     if (pNoteEditorWidget->isModified())
     {
-        ErrorString errorDescription;
-        NoteEditorWidget::NoteSaveStatus::type status = pNoteEditorWidget->checkAndSaveModifiedNote(errorDescription);
-        QNDEBUG(QStringLiteral("Check and save modified note, status: ") << status
-                << QStringLiteral(", error description: ") << errorDescription);
+        savingNote = startSavingNoteInEditor(pNoteEditorWidget);
+        QNDEBUG(QStringLiteral("Check and save modified note, saving note: ")
+                << (savingNote ? QStringLiteral("true") : QStringLiteral("false")));
     }
     else
     {
@@ -1369,6 +1463,21 @@ void NoteEditorTabsAndWindowsCoordinator::removeNoteEditorTab(int tabIndex, cons
         Q_EMIT currentNoteChanged(QString());
     }
 
+    if ((m_pTabWidget->count() == 1) && closeEditor && savingNote)
+    {
+        // Removing the note from the editor would abort the saving of the note, so the blank editor
+        // replaces this one which is deleted once the note is saved
+        m_pBlankNoteEditor = acquireNoteEditorWidget();
+        Q_UNUSED(m_pTabWidget->addTab(m_pBlankNoteEditor, BLANK_NOTE_KEY))
+        m_pTabWidget->removeTab(tabIndex);
+        m_pTabWidget->tabBar()->hide();
+        m_pTabWidget->setTabsClosable(false);
+
+        Q_UNUSED(m_noteOpeningTimersByNoteLocalUid.remove(noteLocalUid))
+        deleteNoteEditorWidgetWhenNoteSaved(pNoteEditorWidget);
+        return;
+    }
+
     if (m_pTabWidget->count() == 1)
     {
         // That should remove the note from the editor (if any)
@@ -1389,8 +1498,7 @@ void NoteEditorTabsAndWindowsCoordinator::removeNoteEditorTab(int tabIndex, cons
     m_pTabWidget->removeTab(tabIndex);
 
     if (closeEditor) {
-        pNoteEditorWidget->hide();
-        pNoteEditorWidget->deleteLater();
+        releaseNoteEditorWidget(pNoteEditorWidget);
         pNoteEditorWidget = Q_NULLPTR;
     }
 
@@ -1421,8 +1529,8 @@ void NoteEditorTabsAndWindowsCoordinator::checkAndCloseOlderNoteEditorTabs()
         auto it = std::find(m_localUidsOfNotesInTabbedEditors.begin(), m_localUidsOfNotesInTabbedEditors.end(), noteLocalUid);
         if (it == m_localUidsOfNotesInTabbedEditors.end()) {
             m_pTabWidget->removeTab(i);
-            pNoteEditorWidget->hide();
-            pNoteEditorWidget->deleteLater();
+            releaseNoteEditorWidget(pNoteEditorWidget);
+            --i;
         }
     }
 
@@ -1436,6 +1544,46 @@ void NoteEditorTabsAndWindowsCoordinator::checkAndCloseOlderNoteEditorTabs()
     }
 }
 
+bool NoteEditorTabsAndWindowsCoordinator::startSavingNoteInEditor(NoteEditorWidget * pNoteEditorWidget)
+{
+    QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::startSavingNoteInEditor: note local uid = ")
+            << pNoteEditorWidget->noteLocalUid());
+
+    if (!pNoteEditorWidget->checkAndSaveModifiedNote()) {
+        return false;
+    }
+
+    QObject::connect(pNoteEditorWidget, QNSIGNAL(NoteEditorWidget,noteSaveFinished,QString,
+                                                 NoteEditorWidget::NoteSaveStatus::type,ErrorString),
+                     this, QNSLOT(NoteEditorTabsAndWindowsCoordinator,onNoteEditorWidgetNoteSaveFinished,QString,
+                                  NoteEditorWidget::NoteSaveStatus::type,ErrorString),
+                     Qt::UniqueConnection);
+    QObject::connect(pNoteEditorWidget, QNSIGNAL(QObject,destroyed,QObject*),
+                     this, QNSLOT(NoteEditorTabsAndWindowsCoordinator,onNoteEditorWidgetSavingNoteDestroyed,QObject*),
+                     Qt::UniqueConnection);
+    m_noteLocalUidsBySavingNoteEditorWidgets[pNoteEditorWidget] = pNoteEditorWidget->noteLocalUid();
+    return true;
+}
+
+void NoteEditorTabsAndWindowsCoordinator::deleteNoteEditorWidgetWhenNoteSaved(NoteEditorWidget * pNoteEditorWidget)
+{
+    QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::deleteNoteEditorWidgetWhenNoteSaved: note local uid = ")
+            << pNoteEditorWidget->noteLocalUid());
+
+    pNoteEditorWidget->removeEventFilter(this);
+    pNoteEditorWidget->hide();
+
+    // The closed editor should no longer affect the tabs and windows, it is only waited for to finish saving its note
+    QObject::disconnect(pNoteEditorWidget, Q_NULLPTR, this, Q_NULLPTR);
+
+    if (!startSavingNoteInEditor(pNoteEditorWidget)) {
+        pNoteEditorWidget->deleteLater();
+        return;
+    }
+
+    Q_UNUSED(m_noteEditorWidgetsToDeleteWhenNoteSaved.insert(pNoteEditorWidget))
+}
+
 void NoteEditorTabsAndWindowsCoordinator::setCurrentNoteEditorWidgetTab(const QString & noteLocalUid)
 {
     QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::setCurrentNoteEditorWidgetTab: ") << noteLocalUid);
@@ -1570,6 +1718,149 @@ void NoteEditorTabsAndWindowsCoordinator::restoreNoteEditorWindowGeometry(const
     QNTRACE(QStringLiteral("Restored the geometry for note editor window with note local uid ") << noteLocalUid);
 }
 
+NoteEditorWidget * NoteEditorTabsAndWindowsCoordinator::createNoteEditorWidget()
+{
+    QUndoStack * pUndoStack = new QUndoStack;
+    NoteEditorWidget * pNoteEditorWidget = new NoteEditorWidget(m_currentAccount, m_localStorageManagerAsync,
+                                                                *m_pFileIOProcessorAsync, *m_pSpellChecker,
+                                                                m_noteCache, m_notebookCache, m_tagCache,
+                                                                *m_pTagModel, pUndoStack, m_pTabWidget);
+    pUndoStack->setParent(pNoteEditorWidget);
+    return pNoteEditorWidget;
+}
+
+NoteEditorWidget * NoteEditorTabsAndWindowsCoordinator::acquireNoteEditorWidget()
+{
+    while(!m_noteEditorWidgetsPool.isEmpty())
+    {
+        QPointer<NoteEditorWidget> pNoteEditorWidget = m_noteEditorWidgetsPool.takeFirst();
+        if (Q_UNLIKELY(pNoteEditorWidget.isNull())) {
+            continue;
+        }
+
+        QNDEBUG(QStringLiteral("Using the pre-initialized note editor widget from the pool, ")
+                << m_noteEditorWidgetsPool.size() << QStringLiteral(" more remain there"));
+        return pNoteEditorWidget.data();
+    }
+
+    QNDEBUG(QStringLiteral("The pool of note editor widgets is empty, creating the new note editor widget"));
+    return createNoteEditorWidget();
+}
+
+void NoteEditorTabsAndWindowsCoordinator::releaseNoteEditorWidget(NoteEditorWidget * pNoteEditorWidget)
+{
+    QString noteLocalUid = pNoteEditorWidget->noteLocalUid();
+    QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::releaseNoteEditorWidget: ") << noteLocalUid);
+
+    pNoteEditorWidget->removeEventFilter(this);
+    pNoteEditorWidget->hide();
+
+    Q_UNUSED(m_noteOpeningTimersByNoteLocalUid.remove(noteLocalUid))
+
+    // The widget still saving its note can't be reset and reused, otherwise the saving would be aborted
+    if (startSavingNoteInEditor(pNoteEditorWidget)) {
+        QNDEBUG(QStringLiteral("The released note editor widget is saving the note, it would be deleted once the note is saved"));
+        deleteNoteEditorWidgetWhenNoteSaved(pNoteEditorWidget);
+        return;
+    }
+
+    if (m_noteEditorWidgetsPool.size() >= noteEditorWidgetsPoolCapacity()) {
+        QNDEBUG(QStringLiteral("The pool of note editor widgets is full, deleting the released widget"));
+        pNoteEditorWidget->deleteLater();
+        return;
+    }
+
+    // The connections would be re-established once the widget is taken from the pool and inserted again
+    QObject::disconnect(pNoteEditorWidget, Q_NULLPTR, this, Q_NULLPTR);
+
+    // That should remove the note from the editor and bring it to the blank state
+    pNoteEditorWidget->setNoteLocalUid(QString());
+
+    QUndoStack * pUndoStack = pNoteEditorWidget->findChild<QUndoStack*>();
+    if (pUndoStack) {
+        pUndoStack->clear();
+    }
+
+    m_noteEditorWidgetsPool << QPointer<NoteEditorWidget>(pNoteEditorWidget);
+    QNDEBUG(QStringLiteral("Put the released note editor widget back to the pool, pool size = ")
+            << m_noteEditorWidgetsPool.size());
+}
+
+int NoteEditorTabsAndWindowsCoordinator::noteEditorWidgetsPoolCapacity() const
+{
+    // Keep as many widgets as needed to fill the note editor tabs up to the max allowed number
+    // but at least one so that the note opened within a separate window can also use the pool
+    int numFreeTabs = m_maxNumNotesInTabs - numNotesInTabs();
+    return std::min(std::max(numFreeTabs, 1), MAX_NOTE_EDITOR_WIDGETS_POOL_SIZE);
+}
+
+void NoteEditorTabsAndWindowsCoordinator::scheduleNoteEditorWidgetsPoolWarmUp()
+{
+    if (m_noteEditorWidgetsPoolWarmUpTimerId != 0) {
+        return;
+    }
+
+    m_noteEditorWidgetsPoolWarmUpTimerId = startTimer(NOTE_EDITOR_WIDGETS_POOL_WARM_UP_DELAY);
+    QNTRACE(QStringLiteral("Scheduled the warm up of note editor widgets pool, timer id = ")
+            << m_noteEditorWidgetsPoolWarmUpTimerId);
+}
+
+void NoteEditorTabsAndWindowsCoordinator::warmUpNoteEditorWidgetsPool()
+{
+    QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::warmUpNoteEditorWidgetsPool: pool size = ")
+            << m_noteEditorWidgetsPool.size());
+
+    int numValidWidgets = 0;
+    for(auto it = m_noteEditorWidgetsPool.begin(); it != m_noteEditorWidgetsPool.end(); )
+    {
+        if (it->isNull()) {
+            it = m_noteEditorWidgetsPool.erase(it);
+        }
+        else {
+            ++numValidWidgets;
+            ++it;
+        }
+    }
+
+    // Creating the note editor widget is expensive, so only a single widget is created per timer event
+    // in order to not block the event loop for too long
+    if (numValidWidgets < noteEditorWidgetsPoolCapacity())
+    {
+        NoteEditorWidget * pNoteEditorWidget = createNoteEditorWidget();
+        pNoteEditorWidget->hide();
+        m_noteEditorWidgetsPool << QPointer<NoteEditorWidget>(pNoteEditorWidget);
+        ++numValidWidgets;
+        QNDEBUG(QStringLiteral("Added the pre-initialized note editor widget to the pool, pool size = ")
+                << numValidWidgets);
+    }
+
+    if (numValidWidgets >= noteEditorWidgetsPoolCapacity()) {
+        killTimer(m_noteEditorWidgetsPoolWarmUpTimerId);
+        m_noteEditorWidgetsPoolWarmUpTimerId = 0;
+    }
+}
+
+void NoteEditorTabsAndWindowsCoordinator::clearNoteEditorWidgetsPool()
+{
+    QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::clearNoteEditorWidgetsPool: pool size = ")
+            << m_noteEditorWidgetsPool.size());
+
+    if (m_noteEditorWidgetsPoolWarmUpTimerId != 0) {
+        killTimer(m_noteEditorWidgetsPoolWarmUpTimerId);
+        m_noteEditorWidgetsPoolWarmUpTimerId = 0;
+    }
+
+    for(auto it = m_noteEditorWidgetsPool.begin(), end = m_noteEditorWidgetsPool.end(); it != end; ++it)
+    {
+        const QPointer<NoteEditorWidget> & pNoteEditorWidget = *it;
+        if (!pNoteEditorWidget.isNull()) {
+            pNoteEditorWidget->deleteLater();
+        }
+    }
+
+    m_noteEditorWidgetsPool.clear();
+}
+
 void NoteEditorTabsAndWindowsCoordinator::connectToLocalStorage()
 {
     QNDEBUG(QStringLiteral("NoteEditorTabsAndWindowsCoordinator::connectToLocalStorage"));
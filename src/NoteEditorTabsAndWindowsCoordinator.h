@@ -22,6 +22,7 @@
 #include "models/NoteCache.h"
 #include "models/NotebookCache.h"
 #include "models/TagCache.h"
+#include "widgets/NoteEditorWidget.h"
 #include <quentier/types/Account.h>
 #include <quentier/utility/LRUCache.hpp>
 #include <quentier/types/Note.h>
@@ -31,6 +32,8 @@
 #include <QMap>
 #include <QPointer>
 #include <QUuid>
+#include <QList>
+#include <QElapsedTimer>
 
 // NOTE: Workaround a bug in Qt4 which may prevent building with some boost versions
 #ifndef Q_MOC_RUN
@@ -47,7 +50,6 @@ namespace quentier {
 QT_FORWARD_DECLARE_CLASS(TagModel)
 QT_FORWARD_DECLARE_CLASS(LocalStorageManagerAsync)
 QT_FORWARD_DECLARE_CLASS(Note)
-QT_FORWARD_DECLARE_CLASS(NoteEditorWidget)
 QT_FORWARD_DECLARE_CLASS(TabWidget)
 QT_FORWARD_DECLARE_CLASS(FileIOProcessorAsync)
 QT_FORWARD_DECLARE_CLASS(SpellChecker)
@@ -96,11 +98,17 @@ public:
 
     void saveAllNoteEditorsContents();
 
+    // Returns true if some note editors, including the already closed ones, are still saving their notes;
+    // pendingNoteSavesFinished signal is emitted once all of them are done
+    bool hasPendingNoteSaves() const;
+
 Q_SIGNALS:
     void notifyError(ErrorString error);
 
     void currentNoteChanged(QString noteLocalUid);
 
+    void pendingNoteSavesFinished();
+
     // private signals
     void requestAddNote(Note note, QUuid requestId);
     void requestExpungeNote(Note note, QUuid requestId);
@@ -119,6 +127,9 @@ private Q_SLOTS:
 
     void onNoteLoadedInEditor();
     void onNoteEditorError(ErrorString errorDescription);
+    void onNoteEditorWidgetNoteSaveFinished(QString noteLocalUid, NoteEditorWidget::NoteSaveStatus::type status,
+                                            ErrorString errorDescription);
+    void onNoteEditorWidgetSavingNoteDestroyed(QObject * pNoteEditorWidget);
 
     void onAddNoteComplete(Note note, QUuid requestId);
     void onAddNoteFailed(Note note, ErrorString errorDescription, QUuid requestId);
@@ -148,6 +159,13 @@ private:
 
     void removeNoteEditorTab(int tabIndex, const bool closeEditor);
     void checkAndCloseOlderNoteEditorTabs();
+
+    // Starts saving the note within the editor if it is modified; returns true if the note is being saved,
+    // the errors of saving are reported via notifyError signal
+    bool startSavingNoteInEditor(NoteEditorWidget * pNoteEditorWidget);
+
+    // Deletes the note editor widget right away if it has nothing to save or once its note is saved otherwise
+    void deleteNoteEditorWidgetWhenNoteSaved(NoteEditorWidget * pNoteEditorWidget);
     void setCurrentNoteEditorWidgetTab(const QString & noteLocalUid);
 
     void scheduleNoteEditorWindowGeometrySave(const QString & noteLocalUid);
@@ -155,6 +173,21 @@ private:
     void clearPersistedNoteEditorWindowGeometry(const QString & noteLocalUid);
     void restoreNoteEditorWindowGeometry(const QString & noteLocalUid);
 
+private:
+    NoteEditorWidget * createNoteEditorWidget();
+
+    // Takes a pre-initialized note editor widget from the pool or creates the new one if the pool is empty
+    NoteEditorWidget * acquireNoteEditorWidget();
+
+    // Resets the note editor widget which is no longer needed and puts it back to the pool; deletes it
+    // if the pool is full already
+    void releaseNoteEditorWidget(NoteEditorWidget * pNoteEditorWidget);
+
+    int noteEditorWidgetsPoolCapacity() const;
+    void scheduleNoteEditorWidgetsPoolWarmUp();
+    void warmUpNoteEditorWidgetsPool();
+    void clearNoteEditorWidgetsPool();
+
 private:
     void connectToLocalStorage();
     void disconnectFromLocalStorage();
@@ -214,6 +247,15 @@ private:
     QString                             m_localUidOfNoteToBeExpunged;
     QTimer *                            m_pExpungeNoteDeadlineTimer;
 
+    QList<QPointer<NoteEditorWidget> >  m_noteEditorWidgetsPool;
+    int                                 m_noteEditorWidgetsPoolWarmUpTimerId;
+
+    QHash<QString, QElapsedTimer>       m_noteOpeningTimersByNoteLocalUid;
+
+    // The note editor widgets are tracked as QObjects so that they can be looked up once destroyed
+    QHash<QObject*, QString>            m_noteLocalUidsBySavingNoteEditorWidgets;
+    QSet<QObject*>                      m_noteEditorWidgetsToDeleteWhenNoteSaved;
+
     bool                                m_trackingCurrentTab;
 };
 
@@ -31,12 +31,20 @@
 #include <QComboBox>
 #include <QLineEdit>
 #include <QToolTip>
+#include <QTimerEvent>
 
 namespace quentier {
 
 #define NOTE_SEARCH_STRING_GROUP_KEY QStringLiteral("NoteSearchStringFilter")
 #define NOTE_SEARCH_STRING_KEY QStringLiteral("SearchString")
 
+// The delay since the last edit of the search string before running the search as you type:
+// coalesces the keystrokes so that the local storage doesn't run a query per each of them
+#define SEARCH_STRING_EDIT_DELAY_MSEC (300)
+
+// The max number of note search queries (search strings and saved searches' queries) the results of which are cached
+#define NOTE_SEARCH_QUERY_CACHE_MAX_SIZE (32)
+
 NoteFiltersManager::NoteFiltersManager(const Account & account,
                                        FilterByTagWidget & filterByTagWidget,
                                        FilterByNotebookWidget & filterByNotebookWidget,
@@ -55,8 +63,16 @@ NoteFiltersManager::NoteFiltersManager(const Account & account,
     m_localStorageManagerAsync(localStorageManagerAsync),
     m_filteredSavedSearchLocalUid(),
     m_lastSearchString(),
+    m_searchStringInFilter(),
+    m_searchStringEditDelayTimer(),
+    m_searchStringQueryRunner(localStorageManagerAsync),
     m_findNoteLocalUidsForSearchStringRequestId(),
     m_findNoteLocalUidsForSavedSearchQueryRequestId(),
+    m_noteSearchQueryCache(NOTE_SEARCH_QUERY_CACHE_MAX_SIZE),
+    m_savedSearchResultSets(localStorageManagerAsync),
+    m_searchStringQueryCacheGeneration(0),
+    m_savedSearchQueryCacheGeneration(0),
+    m_savedSearchQueryString(),
     m_noteSearchQueryValidated(false),
     m_isReady(false)
 {
@@ -318,8 +334,14 @@ void NoteFiltersManager::onSearchStringEdited(const QString & text)
     bool wasEmpty = m_lastSearchString.isEmpty();
     m_lastSearchString = text;
     if (!wasEmpty && m_lastSearchString.isEmpty()) {
+        m_searchStringEditDelayTimer.stop();
         persistSearchString();
         evaluate();
+        return;
+    }
+
+    if (!m_lastSearchString.isEmpty()) {
+        m_searchStringEditDelayTimer.start(SEARCH_STRING_EDIT_DELAY_MSEC, this);
     }
 }
 
@@ -327,23 +349,107 @@ void NoteFiltersManager::onSearchStringChanged()
 {
     QNDEBUG(QStringLiteral("NoteFiltersManager::onSearchStringChanged"));
 
+    m_searchStringEditDelayTimer.stop();
+
     if (m_lastSearchString.isEmpty() && m_searchLineEdit.text().isEmpty()) {
         QNDEBUG(QStringLiteral("Skipping the evaluation as the search string is empty => evaluation should have already occurred"));
         return;
     }
 
+    if (isFilterBySearchStringActive() && (m_searchLineEdit.text() == m_searchStringInFilter)) {
+        QNDEBUG(QStringLiteral("Skipping the evaluation as the filter already corresponds to the search string"));
+        persistSearchString();
+        return;
+    }
+
     persistSearchString();
     evaluate();
 }
 
+void NoteFiltersManager::onSearchStringQueryCompleted(QStringList noteLocalUids, NoteSearchQuery noteSearchQuery,
+                                                      QUuid requestId)
+{
+    if (requestId != m_findNoteLocalUidsForSearchStringRequestId) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("NoteFiltersManager::onSearchStringQueryCompleted: note local uids: ")
+            << noteLocalUids.join(QStringLiteral(", ")) << QStringLiteral(", note search query: ")
+            << noteSearchQuery << QStringLiteral("\nRequest id = ") << requestId);
+
+    m_noteSearchQueryCache.put(m_searchStringInFilter, noteSearchQuery, noteLocalUids,
+                               m_searchStringQueryCacheGeneration);
+
+    m_noteFilterModel.setNoteLocalUids(noteLocalUids);
+}
+
+void NoteFiltersManager::onSearchStringQueryFailed(NoteSearchQuery noteSearchQuery, ErrorString errorDescription,
+                                                   QUuid requestId)
+{
+    if (requestId != m_findNoteLocalUidsForSearchStringRequestId) {
+        return;
+    }
+
+    QNWARNING(QStringLiteral("NoteFiltersManager::onSearchStringQueryFailed: request id = ")
+              << requestId << QStringLiteral(", note search query = ") << noteSearchQuery
+              << QStringLiteral("\nError description: ") << errorDescription);
+
+    m_findNoteLocalUidsForSearchStringRequestId = QUuid();
+    m_searchStringInFilter.clear();
+
+    ErrorString error(QT_TR_NOOP("Can't set the search string to note filter"));
+    error.appendBase(errorDescription.base());
+    error.appendBase(errorDescription.additionalBases());
+    error.details() = errorDescription.details();
+    QNDEBUG(error);
+    Q_EMIT notifyError(error);
+
+    m_filterBySavedSearchWidget.setEnabled(true);
+
+    bool res = setFilterBySavedSearch();
+    if (res) {
+        Q_EMIT filterChanged();
+        return;
+    }
+
+    m_noteFilterModel.beginUpdateFilter();
+
+    setFilterByNotebooks();
+    setFilterByTags();
+
+    m_noteFilterModel.endUpdateFilter();
+
+    Q_EMIT filterChanged();
+}
+
+void NoteFiltersManager::onSavedSearchNoteLocalUidsChanged(QString savedSearchLocalUid, int noteCount)
+{
+    QNTRACE(QStringLiteral("NoteFiltersManager::onSavedSearchNoteLocalUidsChanged: saved search local uid = ")
+            << savedSearchLocalUid << QStringLiteral(", note count = ") << noteCount);
+
+    Q_EMIT savedSearchNoteCountChanged(savedSearchLocalUid, noteCount);
+
+    if ((savedSearchLocalUid != m_filteredSavedSearchLocalUid) || !m_filterBySavedSearchWidget.isEnabled()) {
+        return;
+    }
+
+    QStringList noteLocalUids;
+    if (!m_savedSearchResultSets.noteLocalUids(savedSearchLocalUid, noteLocalUids)) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("The results of the saved search within the filter have changed"));
+
+    // The up to date results supersede the ones of the request in flight, if any
+    m_findNoteLocalUidsForSavedSearchQueryRequestId = QUuid();
+    m_noteFilterModel.setNoteLocalUids(noteLocalUids);
+}
+
 void NoteFiltersManager::onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids,
                                                                      NoteSearchQuery noteSearchQuery,
                                                                      QUuid requestId)
 {
-    bool isRequestForSearchString = (requestId == m_findNoteLocalUidsForSearchStringRequestId);
-    bool isRequestForSavedSearch = !isRequestForSearchString && (requestId == m_findNoteLocalUidsForSavedSearchQueryRequestId);
-
-    if (!isRequestForSearchString && !isRequestForSavedSearch) {
+    if (requestId != m_findNoteLocalUidsForSavedSearchQueryRequestId) {
         return;
     }
 
@@ -351,7 +457,10 @@ void NoteFiltersManager::onFindNoteLocalUidsWithSearchQueryCompleted(QStringList
             << noteLocalUids.join(QStringLiteral(", ")) << QStringLiteral(", note search query: ")
             << noteSearchQuery << QStringLiteral("\nRequest id = ") << requestId);
 
-    if (Q_UNLIKELY(!isRequestForSearchString && !m_filterBySavedSearchWidget.isEnabled())) {
+    m_noteSearchQueryCache.put(m_savedSearchQueryString, noteSearchQuery, noteLocalUids,
+                               m_savedSearchQueryCacheGeneration);
+
+    if (Q_UNLIKELY(!m_filterBySavedSearchWidget.isEnabled())) {
         QNDEBUG(QStringLiteral("Ignoring the update with note local uids for saved search because the filter "
                                "by saved search widget is disabled which means filtering by saved search is overridden "
                                "by filtering via search string"));
@@ -365,10 +474,7 @@ void NoteFiltersManager::onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuer
                                                                   ErrorString errorDescription,
                                                                   QUuid requestId)
 {
-    bool isRequestForSearchString = (requestId == m_findNoteLocalUidsForSearchStringRequestId);
-    bool isRequestForSavedSearch = !isRequestForSearchString && (requestId == m_findNoteLocalUidsForSavedSearchQueryRequestId);
-
-    if (!isRequestForSearchString && !isRequestForSavedSearch) {
+    if (requestId != m_findNoteLocalUidsForSavedSearchQueryRequestId) {
         return;
     }
 
@@ -376,34 +482,14 @@ void NoteFiltersManager::onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuer
               << requestId << QStringLiteral(", note search query = ") << noteSearchQuery
               << QStringLiteral("\nError description: ") << errorDescription);
 
-    if (isRequestForSearchString)
-    {
-        ErrorString error(QT_TR_NOOP("Can't set the search string to note filter"));
-        error.appendBase(errorDescription.base());
-        error.appendBase(errorDescription.additionalBases());
-        error.details() = errorDescription.details();
-        QNDEBUG(error);
-        Q_EMIT notifyError(error);
-
-        m_filterBySavedSearchWidget.setEnabled(true);
-
-        bool res = setFilterBySavedSearch();
-        if (res) {
-            Q_EMIT filterChanged();
-            return;
-        }
-    }
-    else // isRequestForSavedSearch
-    {
-        m_filteredSavedSearchLocalUid.clear();
+    m_filteredSavedSearchLocalUid.clear();
 
-        ErrorString error(QT_TR_NOOP("Can't set the saved search to note filter"));
-        error.appendBase(errorDescription.base());
-        error.appendBase(errorDescription.additionalBases());
-        error.details() = errorDescription.details();
-        QNDEBUG(error);
-        Q_EMIT notifyError(error);
-    }
+    ErrorString error(QT_TR_NOOP("Can't set the saved search to note filter"));
+    error.appendBase(errorDescription.base());
+    error.appendBase(errorDescription.additionalBases());
+    error.details() = errorDescription.details();
+    QNDEBUG(error);
+    Q_EMIT notifyError(error);
 
     m_noteFilterModel.beginUpdateFilter();
 
@@ -415,11 +501,23 @@ void NoteFiltersManager::onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuer
     Q_EMIT filterChanged();
 }
 
+void NoteFiltersManager::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
+{
+    QNTRACE(QStringLiteral("NoteFiltersManager::onUpdateNotebookComplete: notebook = ") << notebook
+            << QStringLiteral(", request id = ") << requestId);
+
+    m_noteSearchQueryCache.onNotebooksChanged();
+    m_savedSearchResultSets.onNotebooksChanged();
+}
+
 void NoteFiltersManager::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
     QNDEBUG(QStringLiteral("NoteFiltersManager::onExpungeNotebookComplete: notebook = ") << notebook
             << QStringLiteral(", request id = ") << requestId);
 
+    m_noteSearchQueryCache.onNotebooksChanged();
+    m_savedSearchResultSets.onNotebooksChanged();
+
     if (!m_filterByNotebookWidget.isEnabled()) {
         QNDEBUG(QStringLiteral("Filter by notebook is overridden by either search string or saved search filter"));
         return;
@@ -438,12 +536,25 @@ void NoteFiltersManager::onExpungeNotebookComplete(Notebook notebook, QUuid requ
     m_noteFilterModel.setNotebookLocalUids(notebookLocalUids);
 }
 
+void NoteFiltersManager::onUpdateTagComplete(Tag tag, QUuid requestId)
+{
+    QNTRACE(QStringLiteral("NoteFiltersManager::onUpdateTagComplete: tag = ") << tag
+            << QStringLiteral(", request id = ") << requestId);
+
+    m_noteSearchQueryCache.onTagsChanged();
+    m_savedSearchResultSets.onTagsChanged();
+}
+
 void NoteFiltersManager::onExpungeTagComplete(Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
 {
     QNDEBUG(QStringLiteral("NoteFiltersManager::onExpungeTagComplete: tag = ") << tag
             << QStringLiteral("\nExpunged child tag local uids: ") << expungedChildTagLocalUids.join(QStringLiteral(", "))
             << QStringLiteral(", request id = ") << requestId);
 
+    // The notes which were labeled with the expunged tags are no longer labeled with them
+    m_noteSearchQueryCache.onTagsChanged();
+    m_savedSearchResultSets.onTagsChanged();
+
     QStringList expungedTagLocalUids;
     expungedTagLocalUids << tag.localUid();
     expungedTagLocalUids << expungedChildTagLocalUids;
@@ -538,6 +649,8 @@ void NoteFiltersManager::onAddNoteComplete(Note note, QUuid requestId)
     QNTRACE(QStringLiteral("NoteFiltersManager::onAddNoteComplete: note = ") << note
             << QStringLiteral("\nRequest id = ") << requestId);
 
+    onNoteAddedOrUpdated(note, /* tags known = */ true, /* resources known = */ true);
+
     m_noteFilterModel.invalidate();
 }
 
@@ -548,6 +661,9 @@ void NoteFiltersManager::onUpdateNoteComplete(Note note, bool updateResources, b
             << QStringLiteral(", update tags = ") << (updateTags ? QStringLiteral("true") : QStringLiteral("false"))
             << QStringLiteral(", request id = ") << requestId);
 
+    // The note's tags and resources which were not updated are not necessarily present within the note
+    onNoteAddedOrUpdated(note, updateTags, updateResources);
+
     m_noteFilterModel.invalidate();
 }
 
@@ -556,6 +672,9 @@ void NoteFiltersManager::onExpungeNoteComplete(Note note, QUuid requestId)
     QNTRACE(QStringLiteral("NoteFiltersManager::onExpungeNoteComplete: note = ") << note
             << QStringLiteral("\nRequest id = ") << requestId);
 
+    m_noteSearchQueryCache.onNoteExpunged(note.localUid());
+    m_savedSearchResultSets.onNoteExpunged(note.localUid());
+
     m_noteFilterModel.invalidate();
 }
 
@@ -609,6 +728,23 @@ void NoteFiltersManager::createConnections()
                      this, QNSLOT(NoteFiltersManager,onSearchStringChanged),
                      Qt::UniqueConnection);
 
+    QObject::connect(&m_searchStringQueryRunner,
+                     QNSIGNAL(NoteSearchQueryRunner,finished,QStringList,NoteSearchQuery,QUuid),
+                     this, QNSLOT(NoteFiltersManager,onSearchStringQueryCompleted,QStringList,NoteSearchQuery,QUuid),
+                     Qt::UniqueConnection);
+    QObject::connect(&m_searchStringQueryRunner,
+                     QNSIGNAL(NoteSearchQueryRunner,failed,NoteSearchQuery,ErrorString,QUuid),
+                     this, QNSLOT(NoteFiltersManager,onSearchStringQueryFailed,NoteSearchQuery,ErrorString,QUuid),
+                     Qt::UniqueConnection);
+
+    QObject::connect(&m_savedSearchResultSets,
+                     QNSIGNAL(SavedSearchResultSets,noteLocalUidsChanged,QString,int),
+                     this, QNSLOT(NoteFiltersManager,onSavedSearchNoteLocalUidsChanged,QString,int),
+                     Qt::UniqueConnection);
+    QObject::connect(&m_savedSearchResultSets, QNSIGNAL(SavedSearchResultSets,notifyError,ErrorString),
+                     this, QNSIGNAL(NoteFiltersManager,notifyError,ErrorString),
+                     Qt::UniqueConnection);
+
     QObject::connect(this, QNSIGNAL(NoteFiltersManager,findNoteLocalUidsForNoteSearchQuery,NoteSearchQuery,QUuid),
                      &m_localStorageManagerAsync,
                      QNSLOT(LocalStorageManagerAsync,onFindNoteLocalUidsWithSearchQuery,NoteSearchQuery,QUuid),
@@ -622,9 +758,15 @@ void NoteFiltersManager::createConnections()
                      this, QNSLOT(NoteFiltersManager,onFindNoteLocalUidsWithSearchQueryFailed,NoteSearchQuery,ErrorString,QUuid),
                      Qt::UniqueConnection);
 
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,updateNotebookComplete,Notebook,QUuid),
+                     this, QNSLOT(NoteFiltersManager,onUpdateNotebookComplete,Notebook,QUuid),
+                     Qt::UniqueConnection);
     QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,expungeNotebookComplete,Notebook,QUuid),
                      this, QNSLOT(NoteFiltersManager,onExpungeNotebookComplete,Notebook,QUuid),
                      Qt::UniqueConnection);
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,updateTagComplete,Tag,QUuid),
+                     this, QNSLOT(NoteFiltersManager,onUpdateTagComplete,Tag,QUuid),
+                     Qt::UniqueConnection);
     QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,expungeTagComplete,Tag,QStringList,QUuid),
                      this, QNSLOT(NoteFiltersManager,onExpungeTagComplete,Tag,QStringList,QUuid),
                      Qt::UniqueConnection);
@@ -682,6 +824,51 @@ void NoteFiltersManager::evaluate()
     Q_EMIT filterChanged();
 }
 
+void NoteFiltersManager::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_searchStringEditDelayTimer.timerId()) {
+        m_searchStringEditDelayTimer.stop();
+        onSearchStringEditDelayElapsed();
+        return;
+    }
+
+    QObject::timerEvent(pEvent);
+}
+
+void NoteFiltersManager::onSearchStringEditDelayElapsed()
+{
+    QNDEBUG(QStringLiteral("NoteFiltersManager::onSearchStringEditDelayElapsed"));
+
+    QString searchString = m_searchLineEdit.text();
+    if (searchString.isEmpty() || (isFilterBySearchStringActive() && (searchString == m_searchStringInFilter))) {
+        return;
+    }
+
+    // While the user is typing, the search string is often temporarily invalid, e.g. with unbalanced quotes;
+    // there's no point to bother the user with the error until the editing is finished
+    ErrorString error;
+    NoteSearchQuery query = createNoteSearchQuery(searchString, error);
+    if (query.isEmpty()) {
+        QNDEBUG(QStringLiteral("The search string is not valid yet, won't update the filter"));
+        return;
+    }
+
+    if (setFilterBySearchString()) {
+        Q_EMIT filterChanged();
+    }
+}
+
+void NoteFiltersManager::cancelFilterBySearchString()
+{
+    m_searchStringQueryRunner.cancel();
+    m_findNoteLocalUidsForSearchStringRequestId = QUuid();
+    m_searchStringInFilter.clear();
+}
+
 void NoteFiltersManager::persistSearchString()
 {
     QNDEBUG(QStringLiteral("NoteFiltersManager::persistSearchString"));
@@ -722,6 +909,7 @@ bool NoteFiltersManager::setFilterBySearchString()
     QString searchString = m_searchLineEdit.text();
     if (searchString.isEmpty()) {
         QNDEBUG(QStringLiteral("The search string is empty"));
+        cancelFilterBySearchString();
         return false;
     }
 
@@ -730,17 +918,35 @@ bool NoteFiltersManager::setFilterBySearchString()
     if (query.isEmpty()) {
         QToolTip::showText(m_searchLineEdit.mapToGlobal(QPoint(0, m_searchLineEdit.height())),
                            error.localizedString(), &m_searchLineEdit);
+        cancelFilterBySearchString();
         return false;
     }
 
     // Invalidate the active request to find note local uids per saved search's query (if there was any)
     m_findNoteLocalUidsForSavedSearchQueryRequestId = QUuid();
 
-    m_findNoteLocalUidsForSearchStringRequestId = QUuid::createUuid();
-    QNTRACE(QStringLiteral("Emitting the request to find note local uids corresponding to the note search query: request id = ")
-            << m_findNoteLocalUidsForSearchStringRequestId << QStringLiteral(", query: ") << query
-            << QStringLiteral("\nSearch string: ") << searchString);
-    Q_EMIT findNoteLocalUidsForNoteSearchQuery(query, m_findNoteLocalUidsForSearchStringRequestId);
+    m_searchStringInFilter = searchString;
+
+    const QStringList * pCachedNoteLocalUids = m_noteSearchQueryCache.get(searchString);
+    if (pCachedNoteLocalUids)
+    {
+        QNTRACE(QStringLiteral("Found cached note local uids corresponding to the search string: ") << searchString);
+
+        // The results of the query for the previous search string, if it is still running, are no longer needed
+        m_searchStringQueryRunner.cancel();
+        m_findNoteLocalUidsForSearchStringRequestId = QUuid();
+
+        m_noteFilterModel.setNoteLocalUids(*pCachedNoteLocalUids);
+    }
+    else
+    {
+        // The runner supersedes the previous query for search string, if it is still running
+        m_searchStringQueryCacheGeneration = m_noteSearchQueryCache.generation();
+        m_findNoteLocalUidsForSearchStringRequestId = m_searchStringQueryRunner.run(query);
+        QNTRACE(QStringLiteral("Requested note local uids corresponding to the note search query: request id = ")
+                << m_findNoteLocalUidsForSearchStringRequestId << QStringLiteral(", query: ") << query
+                << QStringLiteral("\nSearch string: ") << searchString);
+    }
 
     m_filterByTagWidget.setDisabled(true);
     m_filterByNotebookWidget.setDisabled(true);
@@ -816,6 +1022,37 @@ bool NoteFiltersManager::setFilterBySavedSearch()
 
     m_filteredSavedSearchLocalUid = pItem->m_localUid;
 
+    QStringList noteLocalUids;
+    if (m_savedSearchResultSets.noteLocalUids(pItem->m_localUid, noteLocalUids))
+    {
+        QNTRACE(QStringLiteral("The results of the saved search are up to date: ") << *pItem);
+
+        m_findNoteLocalUidsForSavedSearchQueryRequestId = QUuid();
+        m_noteFilterModel.setNoteLocalUids(noteLocalUids);
+
+        m_filterByTagWidget.setDisabled(true);
+        m_filterByNotebookWidget.setDisabled(true);
+
+        return true;
+    }
+
+    const QStringList * pCachedNoteLocalUids = m_noteSearchQueryCache.get(pItem->m_query);
+    if (pCachedNoteLocalUids)
+    {
+        QNTRACE(QStringLiteral("Found cached note local uids corresponding to the saved search: ") << *pItem);
+
+        m_findNoteLocalUidsForSavedSearchQueryRequestId = QUuid();
+        m_noteFilterModel.setNoteLocalUids(*pCachedNoteLocalUids);
+
+        m_filterByTagWidget.setDisabled(true);
+        m_filterByNotebookWidget.setDisabled(true);
+
+        return true;
+    }
+
+    m_savedSearchQueryString = pItem->m_query;
+    m_savedSearchQueryCacheGeneration = m_noteSearchQueryCache.generation();
+
     m_findNoteLocalUidsForSavedSearchQueryRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to find note local uids corresponding to the saved search: request id = ")
             << m_findNoteLocalUidsForSavedSearchQueryRequestId << QStringLiteral(", query: ") << query
@@ -864,6 +1101,8 @@ void NoteFiltersManager::clearFilterWidgetsItems()
 {
     QNDEBUG(QStringLiteral("NoteFiltersManager::clearFilterWidgetsItems"));
 
+    m_searchStringEditDelayTimer.stop();
+
     // Clear tags
 
     QObject::disconnect(&m_filterByTagWidget, QNSIGNAL(FilterByTagWidget,cleared),
@@ -911,6 +1150,39 @@ void NoteFiltersManager::clearFilterWidgetsItems()
     persistSearchString();
 }
 
+void NoteFiltersManager::onNoteAddedOrUpdated(const Note & note, const bool tagsKnown, const bool resourcesKnown)
+{
+    NoteSearchQueryMatcher::NoteInfo noteInfo;
+    noteInfo.m_note = note;
+    noteInfo.m_resourcesKnown = resourcesKnown;
+
+    const NotebookModel * pNotebookModel = m_filterByNotebookWidget.notebookModel();
+    if (pNotebookModel && note.hasNotebookLocalUid()) {
+        noteInfo.m_notebookName = pNotebookModel->itemNameForLocalUid(note.notebookLocalUid());
+    }
+
+    // The tags just added to the local storage might be not yet known to the tag model
+    noteInfo.m_tagNamesKnown = tagsKnown;
+    const TagModel * pTagModel = m_filterByTagWidget.tagModel();
+    if (noteInfo.m_tagNamesKnown && note.hasTagLocalUids())
+    {
+        const QStringList & tagLocalUids = note.tagLocalUids();
+        for(auto it = tagLocalUids.constBegin(), end = tagLocalUids.constEnd(); it != end; ++it)
+        {
+            QString tagName = (pTagModel ? pTagModel->itemNameForLocalUid(*it) : QString());
+            if (tagName.isEmpty()) {
+                noteInfo.m_tagNamesKnown = false;
+                break;
+            }
+
+            noteInfo.m_tagNames << tagName;
+        }
+    }
+
+    m_noteSearchQueryCache.onNoteAddedOrUpdated(noteInfo);
+    m_savedSearchResultSets.onNoteAddedOrUpdated(noteInfo);
+}
+
 void NoteFiltersManager::checkFiltersReadiness()
 {
     QNDEBUG(QStringLiteral("NoteFiltersManager::checkFiltersReadiness"));
@@ -19,6 +19,9 @@
 #ifndef QUENTIER_NOTE_FILTERS_MANAGER_H
 #define QUENTIER_NOTE_FILTERS_MANAGER_H
 
+#include "NoteSearchQueryRunner.h"
+#include "NoteSearchQueryCache.h"
+#include "SavedSearchResultSets.h"
 #include <quentier/utility/Macros.h>
 #include <quentier/types/ErrorString.h>
 #include <quentier/types/Tag.h>
@@ -29,6 +32,7 @@
 #include <quentier/local_storage/NoteSearchQuery.h>
 #include <QObject>
 #include <QUuid>
+#include <QBasicTimer>
 
 QT_FORWARD_DECLARE_CLASS(QLineEdit)
 
@@ -80,6 +84,12 @@ Q_SIGNALS:
      */
     void ready();
 
+    /**
+     * @brief savedSearchNoteCountChanged signal is emitted when the number of notes matching the saved search
+     * becomes known or changes
+     */
+    void savedSearchNoteCountChanged(QString savedSearchLocalUid, int noteCount);
+
     // private signals
     void findNoteLocalUidsForNoteSearchQuery(NoteSearchQuery noteSearchQuery, QUuid requestId);
 
@@ -106,6 +116,13 @@ private Q_SLOTS:
     void onSearchStringEdited(const QString & text);
     void onSearchStringChanged();
 
+    // Slots for the search string query runner
+    void onSearchStringQueryCompleted(QStringList noteLocalUids, NoteSearchQuery noteSearchQuery, QUuid requestId);
+    void onSearchStringQueryFailed(NoteSearchQuery noteSearchQuery, ErrorString errorDescription, QUuid requestId);
+
+    // Slots for the saved searches' result sets
+    void onSavedSearchNoteLocalUidsChanged(QString savedSearchLocalUid, int noteCount);
+
     // Slots for events from local storage
     void onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids,
                                                      NoteSearchQuery noteSearchQuery,
@@ -114,11 +131,13 @@ private Q_SLOTS:
                                                   ErrorString errorDescription,
                                                   QUuid requestId);
 
-    // NOTE: don't care of notebook updates because the filtering by notebook
-    // is done by its local uid anyway
+    // NOTE: the filtering by notebook is done by its local uid so notebook updates
+    // only matter for the cached results of note search queries
 
+    void onUpdateNotebookComplete(Notebook notebook, QUuid requestId);
     void onExpungeNotebookComplete(Notebook notebook, QUuid requestId);
 
+    void onUpdateTagComplete(Tag tag, QUuid requestId);
     void onExpungeTagComplete(Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId);
 
     void onUpdateSavedSearchComplete(SavedSearch search, QUuid requestId);
@@ -128,10 +147,16 @@ private Q_SLOTS:
     void onUpdateNoteComplete(Note note, bool updateResources, bool updateTags, QUuid requestId);
     void onExpungeNoteComplete(Note note, QUuid requestId);
 
+private:
+    virtual void timerEvent(QTimerEvent * pEvent) Q_DECL_OVERRIDE;
+
 private:
     void createConnections();
     void evaluate();
 
+    void onSearchStringEditDelayElapsed();
+    void cancelFilterBySearchString();
+
     void persistSearchString();
     void restoreSearchString();
 
@@ -142,6 +167,8 @@ private:
 
     void clearFilterWidgetsItems();
 
+    void onNoteAddedOrUpdated(const Note & note, const bool tagsKnown, const bool resourcesKnown);
+
     void checkFiltersReadiness();
 
 private:
@@ -157,9 +184,23 @@ private:
 
     QString         m_lastSearchString;
 
+    // The search string which the current filter by search string corresponds to
+    QString         m_searchStringInFilter;
+    QBasicTimer     m_searchStringEditDelayTimer;
+
+    NoteSearchQueryRunner   m_searchStringQueryRunner;
+
     QUuid           m_findNoteLocalUidsForSearchStringRequestId;
     QUuid           m_findNoteLocalUidsForSavedSearchQueryRequestId;
 
+    NoteSearchQueryCache    m_noteSearchQueryCache;
+    SavedSearchResultSets   m_savedSearchResultSets;
+
+    // The generations of the cache at the moments when the currently running queries were sent to the local storage
+    quint64         m_searchStringQueryCacheGeneration;
+    quint64         m_savedSearchQueryCacheGeneration;
+    QString         m_savedSearchQueryString;
+
     bool            m_noteSearchQueryValidated;
 
     bool            m_isReady;
@@ -0,0 +1,260 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NotePrefetcher.h"
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/logging/QuentierLogger.h>
+#include <QTimerEvent>
+
+// The delay since the last change of adjacent notes before starting the prefetching: while the user quickly
+// moves through the note list, the prefetching would be cancelled anyway, so there's no point to start it
+#define NOTE_PREFETCH_DELAY_MSEC (250)
+
+// The max total size of notes' contents and resources' binary data loaded by the prefetcher
+// for a single set of adjacent notes
+#define NOTE_PREFETCH_MEMORY_BUDGET (32 * 1024 * 1024)
+
+namespace quentier {
+
+NotePrefetcher::NotePrefetcher(LocalStorageManagerAsync & localStorageManagerAsync,
+                               NoteCache & noteCache, QObject * parent) :
+    QObject(parent),
+    m_localStorageManagerAsync(localStorageManagerAsync),
+    m_noteCache(noteCache),
+    m_pendingNoteLocalUids(),
+    m_prefetchDelayTimer(),
+    m_inFlightNoteLocalUid(),
+    m_findNoteRequestId(),
+    m_noteLocalUidsBySentFindNoteRequestIds(),
+    m_prefetchedBytes(0)
+{
+    createConnections();
+}
+
+void NotePrefetcher::cancel()
+{
+    QNDEBUG(QStringLiteral("NotePrefetcher::cancel"));
+
+    m_prefetchDelayTimer.stop();
+    m_pendingNoteLocalUids.clear();
+    m_inFlightNoteLocalUid.clear();
+    m_findNoteRequestId = QUuid();
+    m_prefetchedBytes = 0;
+}
+
+void NotePrefetcher::onAdjacentNotesChanged(QStringList noteLocalUids)
+{
+    QNTRACE(QStringLiteral("NotePrefetcher::onAdjacentNotesChanged: ") << noteLocalUids.join(QStringLiteral(", ")));
+
+    m_pendingNoteLocalUids.clear();
+    m_prefetchedBytes = 0;
+
+    // The results of the request already in flight are still useful if the note remains adjacent to the current one,
+    // otherwise they are going to be ignored
+    if (!m_inFlightNoteLocalUid.isEmpty() && !noteLocalUids.contains(m_inFlightNoteLocalUid)) {
+        QNTRACE(QStringLiteral("Note ") << m_inFlightNoteLocalUid << QStringLiteral(" is no longer adjacent to the current one"));
+        m_inFlightNoteLocalUid.clear();
+        m_findNoteRequestId = QUuid();
+    }
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        const QString & noteLocalUid = *it;
+        if (noteLocalUid.isEmpty() || (noteLocalUid == m_inFlightNoteLocalUid) ||
+            m_pendingNoteLocalUids.contains(noteLocalUid) || isNoteFullyCached(noteLocalUid))
+        {
+            continue;
+        }
+
+        m_pendingNoteLocalUids << noteLocalUid;
+    }
+
+    if (m_pendingNoteLocalUids.isEmpty()) {
+        m_prefetchDelayTimer.stop();
+        return;
+    }
+
+    m_prefetchDelayTimer.start(NOTE_PREFETCH_DELAY_MSEC, this);
+}
+
+void NotePrefetcher::onFindNoteComplete(Note note, bool withResourceMetadata, bool withResourceBinaryData, QUuid requestId)
+{
+    if (m_noteLocalUidsBySentFindNoteRequestIds.remove(requestId) == 0) {
+        return;
+    }
+
+    if (requestId != m_findNoteRequestId) {
+        QNTRACE(QStringLiteral("The result of the prefetch request ") << requestId << QStringLiteral(" is no longer awaited"));
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("NotePrefetcher::onFindNoteComplete: request id = ") << requestId
+            << QStringLiteral(", note local uid = ") << note.localUid());
+
+    Q_UNUSED(withResourceMetadata)
+    Q_UNUSED(withResourceBinaryData)
+
+    m_inFlightNoteLocalUid.clear();
+    m_findNoteRequestId = QUuid();
+
+    qint64 noteSize = 0;
+    if (note.hasContent()) {
+        noteSize += note.content().size();
+    }
+
+    QList<Resource> resources = note.resources();
+    for(auto it = resources.constBegin(), end = resources.constEnd(); it != end; ++it)
+    {
+        const Resource & resource = *it;
+        if (resource.hasDataBody()) {
+            noteSize += resource.dataBody().size();
+        }
+    }
+
+    m_prefetchedBytes += noteSize;
+    if (m_prefetchedBytes > NOTE_PREFETCH_MEMORY_BUDGET)
+    {
+        QNDEBUG(QStringLiteral("The memory budget for prefetched notes is exhausted, the note of size ") << noteSize
+                << QStringLiteral(" won't be cached, the remaining notes won't be prefetched"));
+        m_pendingNoteLocalUids.clear();
+        return;
+    }
+
+    // The note might have been put into the cache by someone else while the request was in flight; in this case
+    // the cached note is at least as fresh as the prefetched one, so it is left intact
+    if (!isNoteFullyCached(note.localUid())) {
+        m_noteCache.put(note.localUid(), note);
+    }
+
+    prefetchNextNote();
+}
+
+void NotePrefetcher::onFindNoteFailed(Note note, bool withResourceMetadata, bool withResourceBinaryData,
+                                      ErrorString errorDescription, QUuid requestId)
+{
+    if (m_noteLocalUidsBySentFindNoteRequestIds.remove(requestId) == 0) {
+        return;
+    }
+
+    if (requestId != m_findNoteRequestId) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("NotePrefetcher::onFindNoteFailed: request id = ") << requestId
+            << QStringLiteral(", error description = ") << errorDescription
+            << QStringLiteral("; note local uid = ") << note.localUid());
+
+    Q_UNUSED(withResourceMetadata)
+    Q_UNUSED(withResourceBinaryData)
+
+    m_inFlightNoteLocalUid.clear();
+    m_findNoteRequestId = QUuid();
+
+    // The failure to prefetch the note is not an error from the user's point of view: the note editor
+    // would just find the note on its own if it is ever needed
+    prefetchNextNote();
+}
+
+void NotePrefetcher::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_prefetchDelayTimer.timerId()) {
+        m_prefetchDelayTimer.stop();
+        prefetchNextNote();
+        return;
+    }
+
+    QObject::timerEvent(pEvent);
+}
+
+void NotePrefetcher::createConnections()
+{
+    QNDEBUG(QStringLiteral("NotePrefetcher::createConnections"));
+
+    QObject::connect(this, QNSIGNAL(NotePrefetcher,findNote,Note,bool,bool,QUuid),
+                     &m_localStorageManagerAsync, QNSLOT(LocalStorageManagerAsync,onFindNoteRequest,Note,bool,bool,QUuid));
+
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,findNoteComplete,Note,bool,bool,QUuid),
+                     this, QNSLOT(NotePrefetcher,onFindNoteComplete,Note,bool,bool,QUuid));
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,findNoteFailed,Note,bool,bool,ErrorString,QUuid),
+                     this, QNSLOT(NotePrefetcher,onFindNoteFailed,Note,bool,bool,ErrorString,QUuid));
+}
+
+void NotePrefetcher::prefetchNextNote()
+{
+    if (!m_findNoteRequestId.isNull()) {
+        QNTRACE(QStringLiteral("The prefetch request is already in flight"));
+        return;
+    }
+
+    while(!m_pendingNoteLocalUids.isEmpty())
+    {
+        QString noteLocalUid = m_pendingNoteLocalUids.takeFirst();
+        if (isNoteFullyCached(noteLocalUid)) {
+            continue;
+        }
+
+        m_inFlightNoteLocalUid = noteLocalUid;
+
+        // The note might still be requested by the request whose results were dropped before, in this case
+        // that request's results become awaited again instead of sending one more request for the same note
+        QUuid sentRequestId = m_noteLocalUidsBySentFindNoteRequestIds.key(noteLocalUid);
+        if (!sentRequestId.isNull()) {
+            QNTRACE(QStringLiteral("The request to prefetch note ") << noteLocalUid
+                    << QStringLiteral(" is already in flight: request id = ") << sentRequestId);
+            m_findNoteRequestId = sentRequestId;
+            return;
+        }
+
+        m_findNoteRequestId = QUuid::createUuid();
+        m_noteLocalUidsBySentFindNoteRequestIds[m_findNoteRequestId] = noteLocalUid;
+
+        Note dummy;
+        dummy.setLocalUid(noteLocalUid);
+        QNTRACE(QStringLiteral("Emitting the request to prefetch note: local uid = ") << noteLocalUid
+                << QStringLiteral(", request id = ") << m_findNoteRequestId);
+        Q_EMIT findNote(dummy, /* with resource metadata = */ true, /* with resource binary data = */ true, m_findNoteRequestId);
+        return;
+    }
+}
+
+bool NotePrefetcher::isNoteFullyCached(const QString & noteLocalUid) const
+{
+    const Note * pCachedNote = m_noteCache.get(noteLocalUid);
+    if (!pCachedNote) {
+        return false;
+    }
+
+    // The cache might contain the note without resource binary data, in this case the note editor would
+    // still need to find the note in the local storage
+    QList<Resource> resources = pCachedNote->resources();
+    for(auto it = resources.constBegin(), end = resources.constEnd(); it != end; ++it)
+    {
+        const Resource & resource = *it;
+        if (resource.hasDataHash() && !resource.hasDataBody()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace quentier
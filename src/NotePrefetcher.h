@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_NOTE_PREFETCHER_H
+#define QUENTIER_NOTE_PREFETCHER_H
+
+#include "models/NoteCache.h"
+#include <quentier/types/Note.h>
+#include <quentier/utility/Macros.h>
+#include <quentier/types/ErrorString.h>
+#include <QObject>
+#include <QStringList>
+#include <QBasicTimer>
+#include <QUuid>
+#include <QHash>
+
+namespace quentier {
+
+QT_FORWARD_DECLARE_CLASS(LocalStorageManagerAsync)
+
+/**
+ * @brief The NotePrefetcher class loads the notes adjacent to the current one within the note list
+ * (along with their resources' binary data) from the local storage into the note cache so that
+ * the note editor doesn't need to wait for the local storage when the user moves to one of these notes.
+ *
+ * The prefetching is done with the lowest possible impact on other local storage requests: it starts
+ * after a short delay since the last change of the current note and issues only one request at a time.
+ * The pending prefetching is cancelled whenever the set of adjacent notes changes.
+ */
+class NotePrefetcher: public QObject
+{
+    Q_OBJECT
+public:
+    explicit NotePrefetcher(LocalStorageManagerAsync & localStorageManagerAsync,
+                            NoteCache & noteCache, QObject * parent = Q_NULLPTR);
+
+    // Drops both the pending prefetching and the results of the request currently in flight, if any
+    void cancel();
+
+Q_SIGNALS:
+    // private signals:
+    void findNote(Note note, bool withResourceMetadata, bool withResourceBinaryData, QUuid requestId);
+
+public Q_SLOTS:
+    /**
+     * @param noteLocalUids - local uids of notes to be prefetched, in the order of preference
+     */
+    void onAdjacentNotesChanged(QStringList noteLocalUids);
+
+private Q_SLOTS:
+    void onFindNoteComplete(Note note, bool withResourceMetadata, bool withResourceBinaryData, QUuid requestId);
+    void onFindNoteFailed(Note note, bool withResourceMetadata, bool withResourceBinaryData,
+                          ErrorString errorDescription, QUuid requestId);
+
+private:
+    virtual void timerEvent(QTimerEvent * pEvent) Q_DECL_OVERRIDE;
+
+private:
+    void createConnections();
+    void prefetchNextNote();
+    bool isNoteFullyCached(const QString & noteLocalUid) const;
+
+private:
+    Q_DISABLE_COPY(NotePrefetcher)
+
+private:
+    LocalStorageManagerAsync &  m_localStorageManagerAsync;
+    NoteCache &                 m_noteCache;
+
+    QStringList                 m_pendingNoteLocalUids;
+    QBasicTimer                 m_prefetchDelayTimer;
+
+    QString                     m_inFlightNoteLocalUid;
+    QUuid                       m_findNoteRequestId;
+
+    // All the requests sent to the local storage and not answered yet, including the ones whose results
+    // are no longer awaited; used to avoid requesting the same note while the previous request for it is in flight
+    QHash<QUuid, QString>       m_noteLocalUidsBySentFindNoteRequestIds;
+
+    qint64                      m_prefetchedBytes;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_NOTE_PREFETCHER_H
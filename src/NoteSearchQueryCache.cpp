@@ -0,0 +1,202 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteSearchQueryCache.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <limits>
+
+namespace quentier {
+
+NoteSearchQueryCache::NoteSearchQueryCache(const int maxSize) :
+    m_maxSize(maxSize),
+    m_entriesByNormalizedQueryString(),
+    m_useCounter(0),
+    m_generation(0)
+{}
+
+QString NoteSearchQueryCache::normalizedQueryString(const QString & queryString)
+{
+    return queryString.simplified();
+}
+
+const QStringList * NoteSearchQueryCache::get(const QString & queryString)
+{
+    auto it = m_entriesByNormalizedQueryString.find(normalizedQueryString(queryString));
+    if (it == m_entriesByNormalizedQueryString.end()) {
+        return Q_NULLPTR;
+    }
+
+    it.value().m_lastUseCounter = ++m_useCounter;
+    return &(it.value().m_noteLocalUids);
+}
+
+quint64 NoteSearchQueryCache::generation() const
+{
+    return m_generation;
+}
+
+void NoteSearchQueryCache::put(const QString & queryString, const NoteSearchQuery & query,
+                               const QStringList & noteLocalUids, const quint64 generation)
+{
+    if (generation != m_generation) {
+        QNTRACE(QStringLiteral("Won't cache the results of note search query ") << queryString
+                << QStringLiteral(": notes were changed while the query was running"));
+        return;
+    }
+
+    QString key = normalizedQueryString(queryString);
+    if (!isQueryCacheable(key)) {
+        QNTRACE(QStringLiteral("Won't cache the results of note search query ") << queryString
+                << QStringLiteral(": they depend on the current time"));
+        return;
+    }
+
+    Entry & entry = m_entriesByNormalizedQueryString[key];
+    entry.m_query = query;
+    entry.m_noteLocalUids = noteLocalUids;
+    entry.m_noteLocalUidsSet = noteLocalUids.toSet();
+    entry.m_lastUseCounter = ++m_useCounter;
+
+    while(m_entriesByNormalizedQueryString.size() > m_maxSize) {
+        evictLeastRecentlyUsed();
+    }
+}
+
+void NoteSearchQueryCache::onNoteAddedOrUpdated(const NoteSearchQueryMatcher::NoteInfo & noteInfo)
+{
+    ++m_generation;
+
+    QStringList evictedQueryStrings;
+    const QString & noteLocalUid = noteInfo.m_note.localUid();
+
+    for(auto it = m_entriesByNormalizedQueryString.begin(), end = m_entriesByNormalizedQueryString.end(); it != end; ++it)
+    {
+        Entry & entry = it.value();
+
+        bool mightMatch = NoteSearchQueryMatcher::noteMightMatchQuery(entry.m_query, noteInfo);
+        if (mightMatch) {
+            // Whether the note matches the query or not can only be found out by running the query
+            evictedQueryStrings << it.key();
+            continue;
+        }
+
+        if (entry.m_noteLocalUidsSet.remove(noteLocalUid)) {
+            // The note used to match the query but it certainly doesn't anymore
+            Q_UNUSED(entry.m_noteLocalUids.removeAll(noteLocalUid))
+        }
+    }
+
+    QNTRACE(QStringLiteral("Note ") << noteLocalUid << QStringLiteral(" was added or updated, evicting ")
+            << evictedQueryStrings.size() << QStringLiteral(" out of ") << m_entriesByNormalizedQueryString.size()
+            << QStringLiteral(" cached note search queries"));
+    evict(evictedQueryStrings);
+}
+
+void NoteSearchQueryCache::onNoteExpunged(const QString & noteLocalUid)
+{
+    ++m_generation;
+
+    for(auto it = m_entriesByNormalizedQueryString.begin(), end = m_entriesByNormalizedQueryString.end(); it != end; ++it)
+    {
+        Entry & entry = it.value();
+        if (entry.m_noteLocalUidsSet.remove(noteLocalUid)) {
+            Q_UNUSED(entry.m_noteLocalUids.removeAll(noteLocalUid))
+        }
+    }
+}
+
+void NoteSearchQueryCache::onNotebooksChanged()
+{
+    ++m_generation;
+
+    QStringList evictedQueryStrings;
+    for(auto it = m_entriesByNormalizedQueryString.constBegin(), end = m_entriesByNormalizedQueryString.constEnd();
+        it != end; ++it)
+    {
+        if (NoteSearchQueryMatcher::queryDependsOnNotebookNames(it.value().m_query)) {
+            evictedQueryStrings << it.key();
+        }
+    }
+
+    evict(evictedQueryStrings);
+}
+
+void NoteSearchQueryCache::onTagsChanged()
+{
+    ++m_generation;
+
+    QStringList evictedQueryStrings;
+    for(auto it = m_entriesByNormalizedQueryString.constBegin(), end = m_entriesByNormalizedQueryString.constEnd();
+        it != end; ++it)
+    {
+        if (NoteSearchQueryMatcher::queryDependsOnTagNames(it.value().m_query)) {
+            evictedQueryStrings << it.key();
+        }
+    }
+
+    evict(evictedQueryStrings);
+}
+
+void NoteSearchQueryCache::clear()
+{
+    ++m_generation;
+    m_entriesByNormalizedQueryString.clear();
+}
+
+int NoteSearchQueryCache::size() const
+{
+    return m_entriesByNormalizedQueryString.size();
+}
+
+bool NoteSearchQueryCache::isQueryCacheable(const QString & normalizedQueryString)
+{
+    // The date modifiers can be relative to the current date so the results of such queries go stale by themselves
+    QString lowerCaseQueryString = normalizedQueryString.toLower();
+    return !lowerCaseQueryString.contains(QStringLiteral("created:")) &&
+           !lowerCaseQueryString.contains(QStringLiteral("updated:")) &&
+           !lowerCaseQueryString.contains(QStringLiteral("subjectdate:")) &&
+           !lowerCaseQueryString.contains(QStringLiteral("remindertime:")) &&
+           !lowerCaseQueryString.contains(QStringLiteral("reminderdonetime:"));
+}
+
+void NoteSearchQueryCache::evict(const QStringList & normalizedQueryStrings)
+{
+    for(auto it = normalizedQueryStrings.constBegin(), end = normalizedQueryStrings.constEnd(); it != end; ++it) {
+        Q_UNUSED(m_entriesByNormalizedQueryString.remove(*it))
+    }
+}
+
+void NoteSearchQueryCache::evictLeastRecentlyUsed()
+{
+    auto leastRecentlyUsedIt = m_entriesByNormalizedQueryString.end();
+    quint64 leastUseCounter = std::numeric_limits<quint64>::max();
+
+    for(auto it = m_entriesByNormalizedQueryString.begin(), end = m_entriesByNormalizedQueryString.end(); it != end; ++it)
+    {
+        if (it.value().m_lastUseCounter < leastUseCounter) {
+            leastUseCounter = it.value().m_lastUseCounter;
+            leastRecentlyUsedIt = it;
+        }
+    }
+
+    if (leastRecentlyUsedIt != m_entriesByNormalizedQueryString.end()) {
+        Q_UNUSED(m_entriesByNormalizedQueryString.erase(leastRecentlyUsedIt))
+    }
+}
+
+} // namespace quentier
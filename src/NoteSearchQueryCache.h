@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_NOTE_SEARCH_QUERY_CACHE_H
+#define QUENTIER_NOTE_SEARCH_QUERY_CACHE_H
+
+#include "NoteSearchQueryMatcher.h"
+#include <quentier/utility/Macros.h>
+#include <quentier/local_storage/NoteSearchQuery.h>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+
+namespace quentier {
+
+/**
+ * @brief The NoteSearchQueryCache class keeps the local uids of notes matching the recently run note search queries
+ * so that returning to the recent search string or saved search doesn't require running the query once again
+ *
+ * The cache is keyed by the normalized query string and holds a limited number of queries, the least recently used
+ * one is dropped when the limit is exceeded. The cache needs to be informed about each change of notes: the expunged
+ * notes are just removed from the cached results while the added or updated notes evict only those cached queries
+ * which the note might match (or might have stopped matching), judging by the query's terms and modifiers.
+ * The results of the queries which could not be affected by the change stay in the cache.
+ */
+class NoteSearchQueryCache
+{
+public:
+    explicit NoteSearchQueryCache(const int maxSize);
+
+    static QString normalizedQueryString(const QString & queryString);
+
+    /**
+     * @return the pointer to the cached local uids of notes matching the query or null pointer if the query is not
+     * within the cache; the pointer stays valid until the next non-const call to the cache
+     */
+    const QStringList * get(const QString & queryString);
+
+    /**
+     * @brief generation - the counter of changes invalidating the cached results; the value should be remembered
+     * when the query is sent to the local storage and passed to put along with the results of the query so that
+     * the results which might have been affected by the changes of notes made meanwhile are not cached
+     */
+    quint64 generation() const;
+
+    void put(const QString & queryString, const NoteSearchQuery & query,
+             const QStringList & noteLocalUids, const quint64 generation);
+
+    // Evicts the cached queries which might be affected by the addition or update of the note
+    void onNoteAddedOrUpdated(const NoteSearchQueryMatcher::NoteInfo & noteInfo);
+
+    void onNoteExpunged(const QString & noteLocalUid);
+
+    // The notebook or tag names could have changed so the cached queries mentioning them can't be trusted anymore
+    void onNotebooksChanged();
+    void onTagsChanged();
+
+    void clear();
+    int size() const;
+
+private:
+    struct Entry
+    {
+        Entry() :
+            m_query(),
+            m_noteLocalUids(),
+            m_noteLocalUidsSet(),
+            m_lastUseCounter(0)
+        {}
+
+        NoteSearchQuery     m_query;
+        QStringList         m_noteLocalUids;
+        QSet<QString>       m_noteLocalUidsSet;
+        quint64             m_lastUseCounter;
+    };
+
+    static bool isQueryCacheable(const QString & normalizedQueryString);
+
+    void evict(const QStringList & normalizedQueryStrings);
+    void evictLeastRecentlyUsed();
+
+private:
+    Q_DISABLE_COPY(NoteSearchQueryCache)
+
+private:
+    int                     m_maxSize;
+    QHash<QString, Entry>   m_entriesByNormalizedQueryString;
+    quint64                 m_useCounter;
+    quint64                 m_generation;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_NOTE_SEARCH_QUERY_CACHE_H
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteSearchQueryMatcher.h"
+#include <QRegExp>
+
+namespace quentier {
+
+// Lower case text without diacritics: the local storage's full text search ignores both the case and the diacritics
+static QString foldedText(const QString & text)
+{
+    QString decomposedText = text.normalized(QString::NormalizationForm_KD);
+
+    QString result;
+    result.reserve(decomposedText.size());
+    for(auto it = decomposedText.constBegin(), end = decomposedText.constEnd(); it != end; ++it)
+    {
+        QChar::Category category = it->category();
+        if ((category == QChar::Mark_NonSpacing) || (category == QChar::Mark_SpacingCombining) ||
+            (category == QChar::Mark_Enclosing))
+        {
+            continue;
+        }
+
+        result += *it;
+    }
+
+    return result.toLower();
+}
+
+/**
+ * The search term matches only the words which it is a prefix of (if it has the wildcard) or which are equal to it,
+ * so if any of the term's alphanumeric fragments is not a substring of the text, the term can't match the text
+ */
+static bool textMightContainTerm(const QString & text, const QString & term)
+{
+    QString foldedTerm = foldedText(term);
+
+    QString fragment;
+    for(int i = 0, size = foldedTerm.size(); i <= size; ++i)
+    {
+        if ((i < size) && foldedTerm[i].isLetterOrNumber()) {
+            fragment += foldedTerm[i];
+            continue;
+        }
+
+        if (!fragment.isEmpty() && !text.contains(fragment)) {
+            return false;
+        }
+
+        fragment.clear();
+    }
+
+    return true;
+}
+
+static bool nameMatchesTerm(const QString & name, const QString & term)
+{
+    QString foldedName = foldedText(name);
+
+    QString foldedTerm = foldedText(term);
+    foldedTerm.remove(QChar::fromLatin1('\"'));
+
+    if (foldedTerm.endsWith(QChar::fromLatin1('*'))) {
+        foldedTerm.chop(1);
+        return foldedName.startsWith(foldedTerm);
+    }
+
+    return (foldedName == foldedTerm);
+}
+
+static bool anyNameMatchesTerm(const QStringList & names, const QString & term)
+{
+    for(auto it = names.constBegin(), end = names.constEnd(); it != end; ++it)
+    {
+        if (nameMatchesTerm(*it, term)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @return false if the text to be matched against the search terms can't be reliably extracted from the note content,
+ * true otherwise
+ */
+static bool noteContentTextForMatching(const QString & content, QString & text)
+{
+    QString strippedContent = content;
+    strippedContent.remove(QRegExp(QStringLiteral("<[^>]*>")));
+
+    // The characters escaped as entities other than the predefined XML ones can't be matched against the search terms
+    QRegExp entityRegExp(QStringLiteral("&(?!(amp|lt|gt|quot|apos);)"));
+    if (entityRegExp.indexIn(strippedContent) >= 0) {
+        return false;
+    }
+
+    text = foldedText(strippedContent);
+    return true;
+}
+
+bool NoteSearchQueryMatcher::noteMightMatchQuery(const NoteSearchQuery & query, const NoteInfo & noteInfo)
+{
+    const Note & note = noteInfo.m_note;
+    const QString & notebookName = noteInfo.m_notebookName;
+    const QStringList & tagNames = noteInfo.m_tagNames;
+    const bool tagNamesKnown = noteInfo.m_tagNamesKnown;
+
+    // With "any:" modifier it is enough for the note to satisfy any of the query's terms, hard to rule out that cheaply
+    if (query.hasAnyModifier()) {
+        return true;
+    }
+
+    const QString notebookModifier = query.notebookModifier();
+    if (!notebookModifier.isEmpty() && !notebookName.isEmpty() && !nameMatchesTerm(notebookName, notebookModifier)) {
+        return false;
+    }
+
+    if (tagNamesKnown)
+    {
+        const QStringList & tagTerms = query.tagNames();
+        for(auto it = tagTerms.constBegin(), end = tagTerms.constEnd(); it != end; ++it)
+        {
+            if (!anyNameMatchesTerm(tagNames, *it)) {
+                return false;
+            }
+        }
+
+        const QStringList & negatedTagTerms = query.negatedTagNames();
+        for(auto it = negatedTagTerms.constBegin(), end = negatedTagTerms.constEnd(); it != end; ++it)
+        {
+            if (anyNameMatchesTerm(tagNames, *it)) {
+                return false;
+            }
+        }
+
+        if ((query.hasAnyTag() && tagNames.isEmpty()) || (query.hasNegatedAnyTag() && !tagNames.isEmpty())) {
+            return false;
+        }
+    }
+
+    QString foldedTitle;
+    if (note.hasTitle())
+    {
+        foldedTitle = foldedText(note.title());
+
+        const QStringList & titleTerms = query.titleNames();
+        for(auto it = titleTerms.constBegin(), end = titleTerms.constEnd(); it != end; ++it)
+        {
+            if (!textMightContainTerm(foldedTitle, *it)) {
+                return false;
+            }
+        }
+    }
+
+    // The resources' recognition data and attachments' text are searched too, they are not checked here
+    if (!note.hasContent() || !tagNamesKnown || !noteInfo.m_resourcesKnown || note.hasResources()) {
+        return true;
+    }
+
+    QString text;
+    if (!noteContentTextForMatching(note.content(), text)) {
+        return true;
+    }
+
+    text += QStringLiteral(" ");
+    text += foldedTitle;
+    for(auto it = tagNames.constBegin(), end = tagNames.constEnd(); it != end; ++it) {
+        text += QStringLiteral(" ");
+        text += foldedText(*it);
+    }
+
+    const QStringList & contentTerms = query.contentSearchTerms();
+    for(auto it = contentTerms.constBegin(), end = contentTerms.constEnd(); it != end; ++it)
+    {
+        if (!textMightContainTerm(text, *it)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool NoteSearchQueryMatcher::queryDependsOnNotebookNames(const NoteSearchQuery & query)
+{
+    return !query.notebookModifier().isEmpty();
+}
+
+bool NoteSearchQueryMatcher::queryDependsOnTagNames(const NoteSearchQuery & query)
+{
+    return !query.tagNames().isEmpty() || !query.negatedTagNames().isEmpty() ||
+           query.hasAnyTag() || query.hasNegatedAnyTag();
+}
+
+} // namespace quentier
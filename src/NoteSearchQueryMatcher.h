@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_NOTE_SEARCH_QUERY_MATCHER_H
+#define QUENTIER_NOTE_SEARCH_QUERY_MATCHER_H
+
+#include <quentier/types/Note.h>
+#include <quentier/local_storage/NoteSearchQuery.h>
+#include <QStringList>
+
+namespace quentier {
+
+/**
+ * @brief The NoteSearchQueryMatcher class checks the changed notes against the note search queries in memory
+ * to find out which queries' results could be affected by the change
+ *
+ * The check is conservative: it only rules out the notes which certainly can't match the query judging by its
+ * notebook, tag, title and plain search terms; whether the note which might match the query really matches it
+ * can only be found out by running the query within the local storage.
+ */
+class NoteSearchQueryMatcher
+{
+public:
+    struct NoteInfo
+    {
+        NoteInfo() :
+            m_note(),
+            m_notebookName(),
+            m_tagNames(),
+            m_tagNamesKnown(false),
+            m_resourcesKnown(false)
+        {}
+
+        // The added or updated note
+        Note            m_note;
+
+        // The name of the note's notebook, empty if not known
+        QString         m_notebookName;
+
+        // The names of the note's tags; m_tagNamesKnown is true if they contain the names of all the note's tags
+        QStringList     m_tagNames;
+        bool            m_tagNamesKnown;
+
+        // True if the note contains all of its resources
+        bool            m_resourcesKnown;
+    };
+
+    /**
+     * @return false if the note certainly can't match the query, true if it might match it
+     */
+    static bool noteMightMatchQuery(const NoteSearchQuery & query, const NoteInfo & noteInfo);
+
+    // The results of such queries can be changed by the renaming of notebooks or tags
+    static bool queryDependsOnNotebookNames(const NoteSearchQuery & query);
+    static bool queryDependsOnTagNames(const NoteSearchQuery & query);
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_NOTE_SEARCH_QUERY_MATCHER_H
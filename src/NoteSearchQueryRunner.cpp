@@ -0,0 +1,138 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteSearchQueryRunner.h"
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/logging/QuentierLogger.h>
+
+namespace quentier {
+
+NoteSearchQueryRunner::NoteSearchQueryRunner(LocalStorageManagerAsync & localStorageManagerAsync,
+                                             QObject * parent) :
+    QObject(parent),
+    m_inFlightRequestId(),
+    m_currentRequestId(),
+    m_scheduledQuery(),
+    m_hasScheduledQuery(false)
+{
+    createConnections(localStorageManagerAsync);
+}
+
+QUuid NoteSearchQueryRunner::run(const NoteSearchQuery & query)
+{
+    m_currentRequestId = QUuid::createUuid();
+
+    if (m_inFlightRequestId.isNull()) {
+        startQuery(query, m_currentRequestId);
+        return m_currentRequestId;
+    }
+
+    QNDEBUG(QStringLiteral("NoteSearchQueryRunner::run: the previous query is still in flight, scheduling the query: ")
+            << query << QStringLiteral("\nRequest id = ") << m_currentRequestId);
+
+    m_scheduledQuery = query;
+    m_hasScheduledQuery = true;
+    return m_currentRequestId;
+}
+
+void NoteSearchQueryRunner::cancel()
+{
+    QNDEBUG(QStringLiteral("NoteSearchQueryRunner::cancel"));
+
+    m_currentRequestId = QUuid();
+    m_scheduledQuery.clear();
+    m_hasScheduledQuery = false;
+}
+
+void NoteSearchQueryRunner::onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids,
+                                                                        NoteSearchQuery noteSearchQuery,
+                                                                        QUuid requestId)
+{
+    if (!onQueryFinished(requestId)) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("NoteSearchQueryRunner::onFindNoteLocalUidsWithSearchQueryCompleted: request id = ")
+            << requestId << QStringLiteral(", found ") << noteLocalUids.size() << QStringLiteral(" notes"));
+
+    Q_EMIT finished(noteLocalUids, noteSearchQuery, requestId);
+}
+
+void NoteSearchQueryRunner::onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuery noteSearchQuery,
+                                                                     ErrorString errorDescription,
+                                                                     QUuid requestId)
+{
+    if (!onQueryFinished(requestId)) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("NoteSearchQueryRunner::onFindNoteLocalUidsWithSearchQueryFailed: request id = ")
+            << requestId << QStringLiteral(", error: ") << errorDescription);
+
+    Q_EMIT failed(noteSearchQuery, errorDescription, requestId);
+}
+
+void NoteSearchQueryRunner::createConnections(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("NoteSearchQueryRunner::createConnections"));
+
+    QObject::connect(this, QNSIGNAL(NoteSearchQueryRunner,findNoteLocalUidsWithSearchQuery,NoteSearchQuery,QUuid),
+                     &localStorageManagerAsync,
+                     QNSLOT(LocalStorageManagerAsync,onFindNoteLocalUidsWithSearchQuery,NoteSearchQuery,QUuid));
+    QObject::connect(&localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,findNoteLocalUidsWithSearchQueryComplete,QStringList,NoteSearchQuery,QUuid),
+                     this, QNSLOT(NoteSearchQueryRunner,onFindNoteLocalUidsWithSearchQueryCompleted,QStringList,NoteSearchQuery,QUuid));
+    QObject::connect(&localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,findNoteLocalUidsWithSearchQueryFailed,NoteSearchQuery,ErrorString,QUuid),
+                     this, QNSLOT(NoteSearchQueryRunner,onFindNoteLocalUidsWithSearchQueryFailed,NoteSearchQuery,ErrorString,QUuid));
+}
+
+void NoteSearchQueryRunner::startQuery(const NoteSearchQuery & query, const QUuid & requestId)
+{
+    m_inFlightRequestId = requestId;
+
+    QNTRACE(QStringLiteral("Emitting the request to find note local uids corresponding to the note search query: request id = ")
+            << requestId << QStringLiteral(", query: ") << query);
+    Q_EMIT findNoteLocalUidsWithSearchQuery(query, requestId);
+}
+
+bool NoteSearchQueryRunner::onQueryFinished(const QUuid & requestId)
+{
+    if (requestId.isNull() || (requestId != m_inFlightRequestId)) {
+        return false;
+    }
+
+    m_inFlightRequestId = QUuid();
+
+    if (m_hasScheduledQuery) {
+        NoteSearchQuery query = m_scheduledQuery;
+        m_scheduledQuery.clear();
+        m_hasScheduledQuery = false;
+        startQuery(query, m_currentRequestId);
+    }
+
+    if (requestId != m_currentRequestId) {
+        QNTRACE(QStringLiteral("Dropping the results of the superseded note search query: request id = ") << requestId);
+        return false;
+    }
+
+    m_currentRequestId = QUuid();
+    return true;
+}
+
+} // namespace quentier
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_NOTE_SEARCH_QUERY_RUNNER_H
+#define QUENTIER_NOTE_SEARCH_QUERY_RUNNER_H
+
+#include <quentier/utility/Macros.h>
+#include <quentier/types/ErrorString.h>
+#include <quentier/local_storage/NoteSearchQuery.h>
+#include <QObject>
+#include <QStringList>
+#include <QUuid>
+
+namespace quentier {
+
+QT_FORWARD_DECLARE_CLASS(LocalStorageManagerAsync)
+
+/**
+ * @brief The NoteSearchQueryRunner class runs the note search queries which supersede each other,
+ * like the ones produced by the search as you type, keeping at most one of them within the local storage thread
+ *
+ * The local storage can't abort the query once it has been started, so the runner doesn't send the new query
+ * to the local storage until the previous one is finished; instead it keeps the latest query and starts it
+ * once the local storage is done with the previous one. The queries superseded while waiting are never started,
+ * the results of the superseded query which was already in flight are dropped.
+ */
+class NoteSearchQueryRunner: public QObject
+{
+    Q_OBJECT
+public:
+    explicit NoteSearchQueryRunner(LocalStorageManagerAsync & localStorageManagerAsync,
+                                   QObject * parent = Q_NULLPTR);
+
+    /**
+     * @brief run - starts the query or schedules it to be started after the query in flight, superseding
+     * all the previously run queries
+     * @return the id of the request with which the results of the query would be reported
+     */
+    QUuid run(const NoteSearchQuery & query);
+
+    /**
+     * @brief cancel - drops the scheduled query, if any, and the results of the query in flight, if any
+     */
+    void cancel();
+
+    bool hasQueryInFlight() const { return !m_inFlightRequestId.isNull(); }
+
+Q_SIGNALS:
+    void finished(QStringList noteLocalUids, NoteSearchQuery noteSearchQuery, QUuid requestId);
+    void failed(NoteSearchQuery noteSearchQuery, ErrorString errorDescription, QUuid requestId);
+
+    // private signals
+    void findNoteLocalUidsWithSearchQuery(NoteSearchQuery noteSearchQuery, QUuid requestId);
+
+private Q_SLOTS:
+    void onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids,
+                                                     NoteSearchQuery noteSearchQuery,
+                                                     QUuid requestId);
+    void onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuery noteSearchQuery,
+                                                  ErrorString errorDescription,
+                                                  QUuid requestId);
+
+private:
+    void createConnections(LocalStorageManagerAsync & localStorageManagerAsync);
+    void startQuery(const NoteSearchQuery & query, const QUuid & requestId);
+
+    // Returns true if the finished query was the current one rather than the superseded one
+    bool onQueryFinished(const QUuid & requestId);
+
+private:
+    Q_DISABLE_COPY(NoteSearchQueryRunner)
+
+private:
+    QUuid               m_inFlightRequestId;
+
+    // The id of the request which results are expected, either of the request in flight
+    // or of the scheduled one
+    QUuid               m_currentRequestId;
+
+    NoteSearchQuery     m_scheduledQuery;
+    bool                m_hasScheduledQuery;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_NOTE_SEARCH_QUERY_RUNNER_H
@@ -0,0 +1,495 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SavedSearchResultSets.h"
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/logging/QuentierLogger.h>
+#include <QTimerEvent>
+#include <algorithm>
+
+#define SAVED_SEARCH_LIST_LIMIT (40)
+
+// The delay since the saved search's results become stale before running its query again: the notes are often changed
+// in bursts (i.e. during the sync) so the query is run once per burst rather than once per each changed note
+#define SAVED_SEARCH_REFRESH_DELAY_MSEC (1000)
+
+// The upper bound for the refresh delay: while the notes keep changing right after each refresh (i.e. during the long
+// sync), the delay is doubled with each refresh so that the queries don't keep re-running over and over again
+#define SAVED_SEARCH_MAX_REFRESH_DELAY_MSEC (30000)
+
+namespace quentier {
+
+SavedSearchResultSets::SavedSearchResultSets(LocalStorageManagerAsync & localStorageManagerAsync,
+                                             QObject * parent) :
+    QObject(parent),
+    m_localStorageManagerAsync(localStorageManagerAsync),
+    m_entriesBySavedSearchLocalUid(),
+    m_listSavedSearchesOffset(0),
+    m_listSavedSearchesRequestId(),
+    m_staleSavedSearchLocalUids(),
+    m_savedSearchLocalUidsToRefresh(),
+    m_refreshDelayTimer(),
+    m_refreshDelayMsec(SAVED_SEARCH_REFRESH_DELAY_MSEC),
+    m_lastRefreshFinishedTimer(),
+    m_refreshingSavedSearchLocalUid(),
+    m_refreshRequestId(),
+    m_refreshOutdated(false),
+    m_noteLocalUidsRuledOutDuringRefresh()
+{
+    createConnections();
+    requestSavedSearchesList();
+}
+
+bool SavedSearchResultSets::noteLocalUids(const QString & savedSearchLocalUid, QStringList & noteLocalUids) const
+{
+    auto it = m_entriesBySavedSearchLocalUid.find(savedSearchLocalUid);
+    if ((it == m_entriesBySavedSearchLocalUid.end()) || !it.value().m_upToDate) {
+        return false;
+    }
+
+    noteLocalUids = it.value().m_noteLocalUids;
+    return true;
+}
+
+void SavedSearchResultSets::onNoteAddedOrUpdated(const NoteSearchQueryMatcher::NoteInfo & noteInfo)
+{
+    const QString & noteLocalUid = noteInfo.m_note.localUid();
+
+    QStringList savedSearchLocalUids = m_entriesBySavedSearchLocalUid.keys();
+    for(auto it = savedSearchLocalUids.constBegin(), end = savedSearchLocalUids.constEnd(); it != end; ++it)
+    {
+        const QString & savedSearchLocalUid = *it;
+        const Entry & entry = m_entriesBySavedSearchLocalUid[savedSearchLocalUid];
+        if (entry.m_query.isEmpty()) {
+            continue;
+        }
+
+        if (NoteSearchQueryMatcher::noteMightMatchQuery(entry.m_query, noteInfo)) {
+            markStale(savedSearchLocalUid);
+            continue;
+        }
+
+        // The note certainly doesn't match the query (anymore)
+        removeNoteLocalUid(savedSearchLocalUid, noteLocalUid);
+    }
+}
+
+void SavedSearchResultSets::onNoteExpunged(const QString & noteLocalUid)
+{
+    QStringList savedSearchLocalUids = m_entriesBySavedSearchLocalUid.keys();
+    for(auto it = savedSearchLocalUids.constBegin(), end = savedSearchLocalUids.constEnd(); it != end; ++it) {
+        removeNoteLocalUid(*it, noteLocalUid);
+    }
+}
+
+void SavedSearchResultSets::onNotebooksChanged()
+{
+    QStringList savedSearchLocalUids = m_entriesBySavedSearchLocalUid.keys();
+    for(auto it = savedSearchLocalUids.constBegin(), end = savedSearchLocalUids.constEnd(); it != end; ++it)
+    {
+        const Entry & entry = m_entriesBySavedSearchLocalUid[*it];
+        if (!entry.m_query.isEmpty() && NoteSearchQueryMatcher::queryDependsOnNotebookNames(entry.m_query)) {
+            markStale(*it);
+        }
+    }
+}
+
+void SavedSearchResultSets::onTagsChanged()
+{
+    QStringList savedSearchLocalUids = m_entriesBySavedSearchLocalUid.keys();
+    for(auto it = savedSearchLocalUids.constBegin(), end = savedSearchLocalUids.constEnd(); it != end; ++it)
+    {
+        const Entry & entry = m_entriesBySavedSearchLocalUid[*it];
+        if (!entry.m_query.isEmpty() && NoteSearchQueryMatcher::queryDependsOnTagNames(entry.m_query)) {
+            markStale(*it);
+        }
+    }
+}
+
+void SavedSearchResultSets::onListSavedSearchesComplete(LocalStorageManager::ListObjectsOptions flag,
+                                                        size_t limit, size_t offset,
+                                                        LocalStorageManager::ListSavedSearchesOrder::type order,
+                                                        LocalStorageManager::OrderDirection::type orderDirection,
+                                                        QList<SavedSearch> foundSearches, QUuid requestId)
+{
+    if (requestId != m_listSavedSearchesRequestId) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("SavedSearchResultSets::onListSavedSearchesComplete: flag = ") << flag
+            << QStringLiteral(", limit = ") << limit << QStringLiteral(", offset = ") << offset
+            << QStringLiteral(", order = ") << order << QStringLiteral(", direction = ") << orderDirection
+            << QStringLiteral(", num found searches = ") << foundSearches.size()
+            << QStringLiteral(", request id = ") << requestId);
+
+    for(auto it = foundSearches.constBegin(), end = foundSearches.constEnd(); it != end; ++it) {
+        onSavedSearchAddedOrUpdated(*it);
+    }
+
+    m_listSavedSearchesRequestId = QUuid();
+
+    if (!foundSearches.isEmpty()) {
+        m_listSavedSearchesOffset += static_cast<size_t>(foundSearches.size());
+        requestSavedSearchesList();
+    }
+}
+
+void SavedSearchResultSets::onListSavedSearchesFailed(LocalStorageManager::ListObjectsOptions flag,
+                                                      size_t limit, size_t offset,
+                                                      LocalStorageManager::ListSavedSearchesOrder::type order,
+                                                      LocalStorageManager::OrderDirection::type orderDirection,
+                                                      ErrorString errorDescription, QUuid requestId)
+{
+    if (requestId != m_listSavedSearchesRequestId) {
+        return;
+    }
+
+    QNWARNING(QStringLiteral("SavedSearchResultSets::onListSavedSearchesFailed: flag = ") << flag
+              << QStringLiteral(", limit = ") << limit << QStringLiteral(", offset = ") << offset
+              << QStringLiteral(", order = ") << order << QStringLiteral(", direction = ") << orderDirection
+              << QStringLiteral(", error: ") << errorDescription << QStringLiteral(", request id = ") << requestId);
+
+    m_listSavedSearchesRequestId = QUuid();
+
+    Q_EMIT notifyError(errorDescription);
+}
+
+void SavedSearchResultSets::onAddSavedSearchComplete(SavedSearch search, QUuid requestId)
+{
+    QNTRACE(QStringLiteral("SavedSearchResultSets::onAddSavedSearchComplete: search = ") << search
+            << QStringLiteral("\nRequest id = ") << requestId);
+
+    onSavedSearchAddedOrUpdated(search);
+}
+
+void SavedSearchResultSets::onUpdateSavedSearchComplete(SavedSearch search, QUuid requestId)
+{
+    QNTRACE(QStringLiteral("SavedSearchResultSets::onUpdateSavedSearchComplete: search = ") << search
+            << QStringLiteral("\nRequest id = ") << requestId);
+
+    onSavedSearchAddedOrUpdated(search);
+}
+
+void SavedSearchResultSets::onExpungeSavedSearchComplete(SavedSearch search, QUuid requestId)
+{
+    QNTRACE(QStringLiteral("SavedSearchResultSets::onExpungeSavedSearchComplete: search = ") << search
+            << QStringLiteral("\nRequest id = ") << requestId);
+
+    const QString & savedSearchLocalUid = search.localUid();
+    Q_UNUSED(m_entriesBySavedSearchLocalUid.remove(savedSearchLocalUid))
+    Q_UNUSED(m_staleSavedSearchLocalUids.removeAll(savedSearchLocalUid))
+    Q_UNUSED(m_savedSearchLocalUidsToRefresh.removeAll(savedSearchLocalUid))
+
+    // The results of the query in flight, if any, would be ignored since there's no entry for them anymore
+}
+
+void SavedSearchResultSets::onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids,
+                                                                        NoteSearchQuery noteSearchQuery,
+                                                                        QUuid requestId)
+{
+    if (requestId != m_refreshRequestId) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("SavedSearchResultSets::onFindNoteLocalUidsWithSearchQueryCompleted: saved search local uid = ")
+            << m_refreshingSavedSearchLocalUid << QStringLiteral(", num found notes = ") << noteLocalUids.size()
+            << QStringLiteral(", request id = ") << requestId);
+
+    Q_UNUSED(noteSearchQuery)
+
+    QString savedSearchLocalUid = m_refreshingSavedSearchLocalUid;
+    bool refreshOutdated = m_refreshOutdated;
+    QSet<QString> noteLocalUidsRuledOutDuringRefresh = m_noteLocalUidsRuledOutDuringRefresh;
+
+    m_refreshingSavedSearchLocalUid.clear();
+    m_refreshRequestId = QUuid();
+    m_refreshOutdated = false;
+    m_noteLocalUidsRuledOutDuringRefresh.clear();
+
+    auto it = m_entriesBySavedSearchLocalUid.find(savedSearchLocalUid);
+    if (it == m_entriesBySavedSearchLocalUid.end()) {
+        QNDEBUG(QStringLiteral("The saved search was expunged while its query was running"));
+        refreshNextSavedSearch();
+        return;
+    }
+
+    if (refreshOutdated) {
+        // The notes are likely still being changed, so the query is run again only within the next refresh
+        QNDEBUG(QStringLiteral("The notes were changed while the query was running, it needs to be run once again"));
+        markStale(savedSearchLocalUid);
+        refreshNextSavedSearch();
+        return;
+    }
+
+    Entry & entry = it.value();
+    entry.m_noteLocalUids.clear();
+    entry.m_noteLocalUids.reserve(noteLocalUids.size());
+    for(auto uidIt = noteLocalUids.constBegin(), uidEnd = noteLocalUids.constEnd(); uidIt != uidEnd; ++uidIt)
+    {
+        if (!noteLocalUidsRuledOutDuringRefresh.contains(*uidIt)) {
+            entry.m_noteLocalUids << *uidIt;
+        }
+    }
+
+    entry.m_noteLocalUidsSet = entry.m_noteLocalUids.toSet();
+    entry.m_upToDate = true;
+
+    Q_EMIT noteLocalUidsChanged(savedSearchLocalUid, entry.m_noteLocalUids.size());
+
+    refreshNextSavedSearch();
+}
+
+void SavedSearchResultSets::onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuery noteSearchQuery,
+                                                                     ErrorString errorDescription,
+                                                                     QUuid requestId)
+{
+    if (requestId != m_refreshRequestId) {
+        return;
+    }
+
+    QNWARNING(QStringLiteral("SavedSearchResultSets::onFindNoteLocalUidsWithSearchQueryFailed: saved search local uid = ")
+              << m_refreshingSavedSearchLocalUid << QStringLiteral(", query = ") << noteSearchQuery
+              << QStringLiteral("\nError description: ") << errorDescription);
+
+    // The saved search's results stay not up to date; if the saved search is selected within the filter,
+    // its query would be run as usual and the error, if it repeats, would be reported to the user then
+    m_refreshingSavedSearchLocalUid.clear();
+    m_refreshRequestId = QUuid();
+    m_refreshOutdated = false;
+    m_noteLocalUidsRuledOutDuringRefresh.clear();
+
+    refreshNextSavedSearch();
+}
+
+void SavedSearchResultSets::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_refreshDelayTimer.timerId()) {
+        m_refreshDelayTimer.stop();
+        m_savedSearchLocalUidsToRefresh = m_staleSavedSearchLocalUids;
+        m_staleSavedSearchLocalUids.clear();
+        refreshNextSavedSearch();
+        return;
+    }
+
+    QObject::timerEvent(pEvent);
+}
+
+void SavedSearchResultSets::createConnections()
+{
+    QNDEBUG(QStringLiteral("SavedSearchResultSets::createConnections"));
+
+    QObject::connect(this, QNSIGNAL(SavedSearchResultSets,listSavedSearches,LocalStorageManager::ListObjectsOptions,
+                                    size_t,size_t,LocalStorageManager::ListSavedSearchesOrder::type,
+                                    LocalStorageManager::OrderDirection::type,QUuid),
+                     &m_localStorageManagerAsync, QNSLOT(LocalStorageManagerAsync,onListSavedSearchesRequest,
+                                                         LocalStorageManager::ListObjectsOptions,
+                                                         size_t,size_t,LocalStorageManager::ListSavedSearchesOrder::type,
+                                                         LocalStorageManager::OrderDirection::type,QUuid));
+    QObject::connect(this, QNSIGNAL(SavedSearchResultSets,findNoteLocalUidsWithSearchQuery,NoteSearchQuery,QUuid),
+                     &m_localStorageManagerAsync,
+                     QNSLOT(LocalStorageManagerAsync,onFindNoteLocalUidsWithSearchQuery,NoteSearchQuery,QUuid));
+
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,listSavedSearchesComplete,LocalStorageManager::ListObjectsOptions,
+                              size_t,size_t,LocalStorageManager::ListSavedSearchesOrder::type,
+                              LocalStorageManager::OrderDirection::type,QList<SavedSearch>,QUuid),
+                     this, QNSLOT(SavedSearchResultSets,onListSavedSearchesComplete,LocalStorageManager::ListObjectsOptions,
+                                  size_t,size_t,LocalStorageManager::ListSavedSearchesOrder::type,
+                                  LocalStorageManager::OrderDirection::type,QList<SavedSearch>,QUuid));
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,listSavedSearchesFailed,LocalStorageManager::ListObjectsOptions,
+                              size_t,size_t,LocalStorageManager::ListSavedSearchesOrder::type,
+                              LocalStorageManager::OrderDirection::type,ErrorString,QUuid),
+                     this, QNSLOT(SavedSearchResultSets,onListSavedSearchesFailed,LocalStorageManager::ListObjectsOptions,
+                                  size_t,size_t,LocalStorageManager::ListSavedSearchesOrder::type,
+                                  LocalStorageManager::OrderDirection::type,ErrorString,QUuid));
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,addSavedSearchComplete,SavedSearch,QUuid),
+                     this, QNSLOT(SavedSearchResultSets,onAddSavedSearchComplete,SavedSearch,QUuid));
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,updateSavedSearchComplete,SavedSearch,QUuid),
+                     this, QNSLOT(SavedSearchResultSets,onUpdateSavedSearchComplete,SavedSearch,QUuid));
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,expungeSavedSearchComplete,SavedSearch,QUuid),
+                     this, QNSLOT(SavedSearchResultSets,onExpungeSavedSearchComplete,SavedSearch,QUuid));
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,findNoteLocalUidsWithSearchQueryComplete,QStringList,NoteSearchQuery,QUuid),
+                     this, QNSLOT(SavedSearchResultSets,onFindNoteLocalUidsWithSearchQueryCompleted,QStringList,NoteSearchQuery,QUuid));
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,findNoteLocalUidsWithSearchQueryFailed,NoteSearchQuery,ErrorString,QUuid),
+                     this, QNSLOT(SavedSearchResultSets,onFindNoteLocalUidsWithSearchQueryFailed,NoteSearchQuery,ErrorString,QUuid));
+}
+
+void SavedSearchResultSets::requestSavedSearchesList()
+{
+    QNDEBUG(QStringLiteral("SavedSearchResultSets::requestSavedSearchesList: offset = ") << m_listSavedSearchesOffset);
+
+    LocalStorageManager::ListObjectsOptions flags = LocalStorageManager::ListAll;
+    LocalStorageManager::ListSavedSearchesOrder::type order = LocalStorageManager::ListSavedSearchesOrder::NoOrder;
+    LocalStorageManager::OrderDirection::type direction = LocalStorageManager::OrderDirection::Ascending;
+
+    m_listSavedSearchesRequestId = QUuid::createUuid();
+    QNTRACE(QStringLiteral("Emitting the request to list saved searches: offset = ") << m_listSavedSearchesOffset
+            << QStringLiteral(", request id = ") << m_listSavedSearchesRequestId);
+    Q_EMIT listSavedSearches(flags, SAVED_SEARCH_LIST_LIMIT, m_listSavedSearchesOffset,
+                             order, direction, m_listSavedSearchesRequestId);
+}
+
+void SavedSearchResultSets::onSavedSearchAddedOrUpdated(const SavedSearch & search)
+{
+    const QString & savedSearchLocalUid = search.localUid();
+    QString queryString = (search.hasQuery() ? search.query() : QString());
+
+    auto it = m_entriesBySavedSearchLocalUid.find(savedSearchLocalUid);
+    if ((it != m_entriesBySavedSearchLocalUid.end()) && (it.value().m_queryString == queryString)) {
+        QNTRACE(QStringLiteral("The query of saved search ") << savedSearchLocalUid << QStringLiteral(" has not changed"));
+        return;
+    }
+
+    Entry entry;
+    entry.m_queryString = queryString;
+
+    ErrorString errorDescription;
+    if (!queryString.isEmpty() && !entry.m_query.setQueryString(queryString, errorDescription)) {
+        QNDEBUG(QStringLiteral("Can't parse the query of saved search ") << savedSearchLocalUid
+                << QStringLiteral(": ") << errorDescription);
+        entry.m_query = NoteSearchQuery();
+    }
+
+    m_entriesBySavedSearchLocalUid[savedSearchLocalUid] = entry;
+
+    if (entry.m_query.isEmpty()) {
+        Q_UNUSED(m_staleSavedSearchLocalUids.removeAll(savedSearchLocalUid))
+        Q_UNUSED(m_savedSearchLocalUidsToRefresh.removeAll(savedSearchLocalUid))
+        return;
+    }
+
+    markStale(savedSearchLocalUid);
+}
+
+void SavedSearchResultSets::markStale(const QString & savedSearchLocalUid)
+{
+    auto it = m_entriesBySavedSearchLocalUid.find(savedSearchLocalUid);
+    if (Q_UNLIKELY(it == m_entriesBySavedSearchLocalUid.end())) {
+        return;
+    }
+
+    it.value().m_upToDate = false;
+
+    if (savedSearchLocalUid == m_refreshingSavedSearchLocalUid) {
+        m_refreshOutdated = true;
+        return;
+    }
+
+    if (m_savedSearchLocalUidsToRefresh.contains(savedSearchLocalUid)) {
+        QNTRACE(QStringLiteral("The query of saved search ") << savedSearchLocalUid
+                << QStringLiteral(" is yet to be run within the current refresh"));
+        return;
+    }
+
+    if (!m_staleSavedSearchLocalUids.contains(savedSearchLocalUid)) {
+        m_staleSavedSearchLocalUids << savedSearchLocalUid;
+    }
+
+    scheduleRefresh();
+}
+
+void SavedSearchResultSets::scheduleRefresh()
+{
+    if (m_staleSavedSearchLocalUids.isEmpty()) {
+        return;
+    }
+
+    // NOTE: not restarting the active timer so that a continuous stream of note changes can't postpone the refresh forever
+    if (m_refreshDelayTimer.isActive()) {
+        return;
+    }
+
+    // The saved searches staled during the refresh are picked up by the next one, after it's finished
+    if (!m_refreshRequestId.isNull() || !m_savedSearchLocalUidsToRefresh.isEmpty()) {
+        return;
+    }
+
+    if (m_lastRefreshFinishedTimer.isValid() && (m_lastRefreshFinishedTimer.elapsed() < m_refreshDelayMsec)) {
+        m_refreshDelayMsec = std::min(2 * m_refreshDelayMsec, SAVED_SEARCH_MAX_REFRESH_DELAY_MSEC);
+    }
+    else {
+        m_refreshDelayMsec = SAVED_SEARCH_REFRESH_DELAY_MSEC;
+    }
+
+    QNTRACE(QStringLiteral("Scheduling the refresh of stale saved searches in ") << m_refreshDelayMsec
+            << QStringLiteral(" msec"));
+    m_refreshDelayTimer.start(m_refreshDelayMsec, this);
+}
+
+void SavedSearchResultSets::removeNoteLocalUid(const QString & savedSearchLocalUid, const QString & noteLocalUid)
+{
+    if (savedSearchLocalUid == m_refreshingSavedSearchLocalUid) {
+        Q_UNUSED(m_noteLocalUidsRuledOutDuringRefresh.insert(noteLocalUid))
+    }
+
+    auto it = m_entriesBySavedSearchLocalUid.find(savedSearchLocalUid);
+    if (Q_UNLIKELY(it == m_entriesBySavedSearchLocalUid.end())) {
+        return;
+    }
+
+    Entry & entry = it.value();
+    if (!entry.m_noteLocalUidsSet.remove(noteLocalUid)) {
+        return;
+    }
+
+    Q_UNUSED(entry.m_noteLocalUids.removeAll(noteLocalUid))
+
+    if (entry.m_upToDate) {
+        Q_EMIT noteLocalUidsChanged(savedSearchLocalUid, entry.m_noteLocalUids.size());
+    }
+}
+
+void SavedSearchResultSets::refreshNextSavedSearch()
+{
+    if (!m_refreshRequestId.isNull()) {
+        QNTRACE(QStringLiteral("The query of another saved search is already running"));
+        return;
+    }
+
+    while(!m_savedSearchLocalUidsToRefresh.isEmpty())
+    {
+        QString savedSearchLocalUid = m_savedSearchLocalUidsToRefresh.takeFirst();
+        auto it = m_entriesBySavedSearchLocalUid.constFind(savedSearchLocalUid);
+        if ((it == m_entriesBySavedSearchLocalUid.constEnd()) || it.value().m_query.isEmpty()) {
+            continue;
+        }
+
+        m_refreshingSavedSearchLocalUid = savedSearchLocalUid;
+        m_refreshRequestId = QUuid::createUuid();
+        m_refreshOutdated = false;
+        m_noteLocalUidsRuledOutDuringRefresh.clear();
+
+        QNTRACE(QStringLiteral("Emitting the request to find note local uids matching saved search ")
+                << savedSearchLocalUid << QStringLiteral(": request id = ") << m_refreshRequestId);
+        Q_EMIT findNoteLocalUidsWithSearchQuery(it.value().m_query, m_refreshRequestId);
+        return;
+    }
+
+    QNTRACE(QStringLiteral("Finished the refresh of stale saved searches"));
+    m_lastRefreshFinishedTimer.start();
+    scheduleRefresh();
+}
+
+} // namespace quentier
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_SAVED_SEARCH_RESULT_SETS_H
+#define QUENTIER_SAVED_SEARCH_RESULT_SETS_H
+
+#include "NoteSearchQueryMatcher.h"
+#include <quentier/utility/Macros.h>
+#include <quentier/types/ErrorString.h>
+#include <quentier/types/SavedSearch.h>
+#include <quentier/local_storage/LocalStorageManager.h>
+#include <quentier/local_storage/NoteSearchQuery.h>
+#include <QObject>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QUuid>
+
+namespace quentier {
+
+QT_FORWARD_DECLARE_CLASS(LocalStorageManagerAsync)
+
+/**
+ * @brief The SavedSearchResultSets class keeps the local uids of notes matching each saved search of the account
+ * up to date as the notes change so that the saved search's results are available without running its query
+ *
+ * The queries of all saved searches are run once in the background, one at a time. After that each added or updated
+ * note is checked against the saved searches' queries in memory: the note which certainly doesn't match the query
+ * is removed from its results right away while the query which the note might match is scheduled to be run again.
+ * The re-runs are delayed a bit so that a burst of note changes (i.e. during the sync) costs a single run per query;
+ * if the notes keep changing right after the re-runs, the delay grows until the changes stop.
+ */
+class SavedSearchResultSets: public QObject
+{
+    Q_OBJECT
+public:
+    explicit SavedSearchResultSets(LocalStorageManagerAsync & localStorageManagerAsync,
+                                   QObject * parent = Q_NULLPTR);
+
+    /**
+     * @return true and the local uids of notes matching the saved search if its results are up to date,
+     * false otherwise
+     */
+    bool noteLocalUids(const QString & savedSearchLocalUid, QStringList & noteLocalUids) const;
+
+    void onNoteAddedOrUpdated(const NoteSearchQueryMatcher::NoteInfo & noteInfo);
+    void onNoteExpunged(const QString & noteLocalUid);
+    void onNotebooksChanged();
+    void onTagsChanged();
+
+Q_SIGNALS:
+    void notifyError(ErrorString errorDescription);
+
+    /**
+     * @brief noteLocalUidsChanged signal is emitted when the results of the saved search become up to date
+     * or change while being up to date
+     */
+    void noteLocalUidsChanged(QString savedSearchLocalUid, int noteCount);
+
+    // private signals
+    void listSavedSearches(LocalStorageManager::ListObjectsOptions flag,
+                           size_t limit, size_t offset,
+                           LocalStorageManager::ListSavedSearchesOrder::type order,
+                           LocalStorageManager::OrderDirection::type orderDirection,
+                           QUuid requestId);
+    void findNoteLocalUidsWithSearchQuery(NoteSearchQuery noteSearchQuery, QUuid requestId);
+
+private Q_SLOTS:
+    void onListSavedSearchesComplete(LocalStorageManager::ListObjectsOptions flag,
+                                     size_t limit, size_t offset,
+                                     LocalStorageManager::ListSavedSearchesOrder::type order,
+                                     LocalStorageManager::OrderDirection::type orderDirection,
+                                     QList<SavedSearch> foundSearches, QUuid requestId);
+    void onListSavedSearchesFailed(LocalStorageManager::ListObjectsOptions flag,
+                                   size_t limit, size_t offset,
+                                   LocalStorageManager::ListSavedSearchesOrder::type order,
+                                   LocalStorageManager::OrderDirection::type orderDirection,
+                                   ErrorString errorDescription, QUuid requestId);
+
+    void onAddSavedSearchComplete(SavedSearch search, QUuid requestId);
+    void onUpdateSavedSearchComplete(SavedSearch search, QUuid requestId);
+    void onExpungeSavedSearchComplete(SavedSearch search, QUuid requestId);
+
+    void onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids,
+                                                     NoteSearchQuery noteSearchQuery,
+                                                     QUuid requestId);
+    void onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuery noteSearchQuery,
+                                                  ErrorString errorDescription,
+                                                  QUuid requestId);
+
+private:
+    virtual void timerEvent(QTimerEvent * pEvent) Q_DECL_OVERRIDE;
+
+private:
+    void createConnections();
+    void requestSavedSearchesList();
+
+    void onSavedSearchAddedOrUpdated(const SavedSearch & search);
+
+    void markStale(const QString & savedSearchLocalUid);
+    void removeNoteLocalUid(const QString & savedSearchLocalUid, const QString & noteLocalUid);
+    void scheduleRefresh();
+    void refreshNextSavedSearch();
+
+private:
+    Q_DISABLE_COPY(SavedSearchResultSets)
+
+private:
+    struct Entry
+    {
+        Entry() :
+            m_queryString(),
+            m_query(),
+            m_noteLocalUids(),
+            m_noteLocalUidsSet(),
+            m_upToDate(false)
+        {}
+
+        QString             m_queryString;
+        NoteSearchQuery     m_query;
+        QStringList         m_noteLocalUids;
+        QSet<QString>       m_noteLocalUidsSet;
+        bool                m_upToDate;
+    };
+
+    LocalStorageManagerAsync &  m_localStorageManagerAsync;
+
+    QHash<QString, Entry>       m_entriesBySavedSearchLocalUid;
+
+    size_t                      m_listSavedSearchesOffset;
+    QUuid                       m_listSavedSearchesRequestId;
+
+    // Local uids of saved searches the queries of which need to be run again, in the order of staling
+    QStringList                 m_staleSavedSearchLocalUids;
+
+    // Local uids of stale saved searches the queries of which are yet to be run within the current refresh
+    QStringList                 m_savedSearchLocalUidsToRefresh;
+
+    QBasicTimer                 m_refreshDelayTimer;
+    int                         m_refreshDelayMsec;
+    QElapsedTimer               m_lastRefreshFinishedTimer;
+
+    QString                     m_refreshingSavedSearchLocalUid;
+    QUuid                       m_refreshRequestId;
+
+    // The note changes made while the query is running might not be reflected in its results
+    bool                        m_refreshOutdated;
+    QSet<QString>               m_noteLocalUidsRuledOutDuringRefresh;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_SAVED_SEARCH_RESULT_SETS_H
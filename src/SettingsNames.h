@@ -23,6 +23,9 @@
 // The name of the environment variable allowing to override the system tray availability
 #define OVERRIDE_SYSTEM_TRAY_AVAILABILITY_ENV_VAR "QUENTIER_OVERRIDE_SYSTEM_TRAY_AVAILABILITY"
 
+// The name of the environment variable enabling the models' instrumentation right from the start
+#define MODEL_INSTRUMENTATION_ENV_VAR "QUENTIER_MODEL_INSTRUMENTATION"
+
 #define SYSTEM_TRAY_ICON_KIND_KEY QStringLiteral("TrayIconKind")
 
 #define SINGLE_CLICK_TRAY_ACTION_SETTINGS_KEY QStringLiteral("SingleClickTrayAction")
@@ -79,6 +82,9 @@
 
 #define ONCE_DISPLAYED_GREETER_SCREEN QStringLiteral("OnceDisplayedGreeterScreen")
 
+#define NUM_INACTIVE_ACCOUNTS_WITH_WARM_MODELS QStringLiteral("NumInactiveAccountsWithWarmModels")
+#define MAX_NUM_NOTES_IN_WARM_MODELS QStringLiteral("MaxNumNotesInWarmModels")
+
 // Environment variables that can be used to specify the account to use on startup
 #define ACCOUNT_NAME_ENV_VAR "QUENTIER_ACCOUNT_NAME"
 #define ACCOUNT_TYPE_ENV_VAR "QUENTIER_ACCOUNT_TYPE"
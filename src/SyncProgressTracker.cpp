@@ -0,0 +1,210 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SyncProgressTracker.h"
+#include <algorithm>
+#include <cmath>
+
+// The rate of processing measured over a shorter period is too noisy to be shown
+#define SYNC_PROGRESS_MIN_RATE_MEASUREMENT_MSEC (1000)
+
+// The sync progress notifications might come thousands of times per second during the first sync,
+// rendering each of them would only waste the GUI thread's time
+#define SYNC_PROGRESS_RENDERING_INTERVAL_MSEC (100)
+
+namespace quentier {
+
+SyncProgressTracker::SyncProgressTracker() :
+    m_stageDescription(),
+    m_clock(),
+    m_stageStartMsec(0),
+    m_itemsKnown(false),
+    m_processedItems(0),
+    m_totalItems(0),
+    m_processedItemsAtStageStart(0),
+    m_percentage(0.0),
+    m_lastRenderingMsec(-1),
+    m_pendingRendering(false)
+{
+    m_clock.start();
+}
+
+SyncProgressTracker::~SyncProgressTracker()
+{}
+
+void SyncProgressTracker::setItemsProgress(const QString & stageDescription, const qint64 processedItems,
+                                           const qint64 totalItems)
+{
+    if (!m_itemsKnown) {
+        // Switching from percentage progress to items progress means the stage has changed
+        m_stageDescription.clear();
+    }
+
+    if (stageDescription != m_stageDescription) {
+        m_processedItemsAtStageStart = processedItems;
+    }
+
+    startStageIfChanged(stageDescription);
+
+    m_itemsKnown = true;
+    m_processedItems = processedItems;
+    m_totalItems = totalItems;
+    m_percentage = ((totalItems > 0)
+                    ? std::min(static_cast<double>(processedItems) / static_cast<double>(totalItems) * 100.0, 100.0)
+                    : 0.0);
+}
+
+void SyncProgressTracker::setPercentageProgress(const QString & stageDescription, const double percentage)
+{
+    if (m_itemsKnown) {
+        // Switching from items progress to percentage progress means the stage has changed
+        m_stageDescription.clear();
+    }
+
+    startStageIfChanged(stageDescription);
+
+    m_itemsKnown = false;
+    m_processedItems = 0;
+    m_totalItems = 0;
+    m_processedItemsAtStageStart = 0;
+    m_percentage = std::min(std::max(percentage, 0.0), 100.0);
+}
+
+void SyncProgressTracker::clear()
+{
+    m_stageDescription.clear();
+    m_stageStartMsec = 0;
+    m_itemsKnown = false;
+    m_processedItems = 0;
+    m_totalItems = 0;
+    m_processedItemsAtStageStart = 0;
+    m_percentage = 0.0;
+    m_lastRenderingMsec = -1;
+    m_pendingRendering = false;
+}
+
+QString SyncProgressTracker::toString() const
+{
+    if (isEmpty()) {
+        return QString();
+    }
+
+    QString result = m_stageDescription;
+    result += QStringLiteral(": ");
+
+    if (m_itemsKnown) {
+        result += QString::number(m_processedItems) + QStringLiteral(" ") + tr("of") + QStringLiteral(" ") +
+                  QString::number(m_totalItems);
+    }
+    else {
+        result += QString::number(m_percentage, 'f', 1) + QStringLiteral("%");
+    }
+
+    qint64 elapsedMsec = currentMsec() - m_stageStartMsec;
+    if (elapsedMsec < SYNC_PROGRESS_MIN_RATE_MEASUREMENT_MSEC) {
+        return result;
+    }
+
+    double elapsedSec = static_cast<double>(elapsedMsec) / 1000.0;
+    qint64 secondsRemaining = -1;
+
+    if (m_itemsKnown)
+    {
+        double itemsPerSecond = static_cast<double>(m_processedItems - m_processedItemsAtStageStart) / elapsedSec;
+        if (itemsPerSecond > 0.0)
+        {
+            result += QStringLiteral(", ") + QString::number(itemsPerSecond, 'f', 1) + QStringLiteral(" ") + tr("per second");
+
+            qint64 remainingItems = std::max(m_totalItems - m_processedItems, qint64(0));
+            secondsRemaining = static_cast<qint64>(std::ceil(static_cast<double>(remainingItems) / itemsPerSecond));
+        }
+    }
+    else if (m_percentage > 0.0)
+    {
+        secondsRemaining = static_cast<qint64>(std::ceil(elapsedSec * (100.0 - m_percentage) / m_percentage));
+    }
+
+    if (secondsRemaining >= 0) {
+        result += QStringLiteral(", ") + tr("about") + QStringLiteral(" ") + durationToString(secondsRemaining) +
+                  QStringLiteral(" ") + tr("left");
+    }
+
+    return result;
+}
+
+int SyncProgressTracker::renderingIntervalMsec()
+{
+    return SYNC_PROGRESS_RENDERING_INTERVAL_MSEC;
+}
+
+bool SyncProgressTracker::checkRenderingNow()
+{
+    qint64 now = currentMsec();
+    if ((m_lastRenderingMsec >= 0) && (now - m_lastRenderingMsec < SYNC_PROGRESS_RENDERING_INTERVAL_MSEC)) {
+        m_pendingRendering = true;
+        return false;
+    }
+
+    m_lastRenderingMsec = now;
+    m_pendingRendering = false;
+    return true;
+}
+
+bool SyncProgressTracker::takePendingRendering()
+{
+    if (!m_pendingRendering) {
+        return false;
+    }
+
+    m_lastRenderingMsec = currentMsec();
+    m_pendingRendering = false;
+    return true;
+}
+
+qint64 SyncProgressTracker::currentMsec() const
+{
+    return m_clock.elapsed();
+}
+
+void SyncProgressTracker::startStageIfChanged(const QString & stageDescription)
+{
+    if (stageDescription == m_stageDescription) {
+        return;
+    }
+
+    m_stageDescription = stageDescription;
+    m_stageStartMsec = currentMsec();
+}
+
+QString SyncProgressTracker::durationToString(const qint64 seconds)
+{
+    qint64 hours = seconds / 3600;
+    qint64 minutes = (seconds % 3600) / 60;
+    qint64 remainingSeconds = seconds % 60;
+
+    QString result;
+    if (hours > 0) {
+        result += QString::number(hours) + QStringLiteral(":");
+    }
+
+    result += QStringLiteral("%1:%2").arg(minutes, (hours > 0 ? 2 : 1), 10, QChar::fromLatin1('0'))
+                                     .arg(remainingSeconds, 2, 10, QChar::fromLatin1('0'));
+    return result;
+}
+
+} // namespace quentier
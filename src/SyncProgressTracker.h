@@ -0,0 +1,114 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_SYNC_PROGRESS_TRACKER_H
+#define QUENTIER_SYNC_PROGRESS_TRACKER_H
+
+#include <quentier/utility/Macros.h>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QString>
+#include <QtGlobal>
+
+namespace quentier {
+
+/**
+ * @brief The SyncProgressTracker class aggregates the progress notifications coming from the synchronization
+ * into the single state describing the current stage of the synchronization: the stage's description,
+ * the number of processed items or the percentage of completion and the rate of processing measured since
+ * the start of the stage. The state is rendered into the human readable text which includes the items per second
+ * rate and the estimated time remaining for the stage, if these can be computed.
+ *
+ * The tracker also decides when the state should be rendered: the progress notifications might come thousands
+ * of times per second during the first sync so the state is rendered no more often than once per rendering interval.
+ * The first update after a quiet period is rendered right away, the further updates within the interval are coalesced
+ * into the single rendering at the end of the interval.
+ */
+class SyncProgressTracker
+{
+    Q_DECLARE_TR_FUNCTIONS(SyncProgressTracker)
+public:
+    SyncProgressTracker();
+    virtual ~SyncProgressTracker();
+
+    /**
+     * Updates the progress of the stage processing the known number of items; if the stage description differs from
+     * the one of the current stage, the new stage starts
+     */
+    void setItemsProgress(const QString & stageDescription, const qint64 processedItems, const qint64 totalItems);
+
+    /**
+     * Updates the progress of the stage for which only the percentage of completion is known; if the stage description
+     * differs from the one of the current stage, the new stage starts
+     */
+    void setPercentageProgress(const QString & stageDescription, const double percentage);
+
+    void clear();
+    bool isEmpty() const { return m_stageDescription.isEmpty(); }
+
+    QString toString() const;
+
+    static int renderingIntervalMsec();
+
+    /**
+     * Should be called after each progress update; returns true if the progress should be rendered right away,
+     * otherwise the rendering is postponed until the end of the current rendering interval
+     */
+    bool checkRenderingNow();
+
+    /**
+     * Should be called at the end of each rendering interval; returns true if the progress updated during
+     * the interval should be rendered now, false if there was no update to render
+     */
+    bool takePendingRendering();
+
+    bool hasPendingRendering() const { return m_pendingRendering; }
+
+    /**
+     * Drops the rendering postponed until the end of the current rendering interval, i.e. when the progress
+     * is superseded by some other message
+     */
+    void cancelPendingRendering() { m_pendingRendering = false; }
+
+protected:
+    // The monotonic time in milliseconds; virtual for the sake of testing
+    virtual qint64 currentMsec() const;
+
+private:
+    void startStageIfChanged(const QString & stageDescription);
+    static QString durationToString(const qint64 seconds);
+
+private:
+    QString         m_stageDescription;
+    QElapsedTimer   m_clock;
+    qint64          m_stageStartMsec;
+
+    bool            m_itemsKnown;
+    qint64          m_processedItems;
+    qint64          m_totalItems;
+    qint64          m_processedItemsAtStageStart;
+    double          m_percentage;
+
+    // The time of the last rendering, -1 if the progress wasn't rendered yet
+    qint64          m_lastRenderingMsec;
+    bool            m_pendingRendering;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_SYNC_PROGRESS_TRACKER_H
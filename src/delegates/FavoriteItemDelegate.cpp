@@ -153,7 +153,8 @@ QSize FavoriteItemDelegate::favoriteItemNameSizeHint(const QStyleOptionViewItem
     FavoritesModelItem::Type::type itemTypeInt = static_cast<FavoritesModelItem::Type::type>(itemType.toInt(&conversionResult));
     if (conversionResult &&
         ((itemTypeInt == FavoritesModelItem::Type::Notebook) ||
-         (itemTypeInt == FavoritesModelItem::Type::Tag)))
+         (itemTypeInt == FavoritesModelItem::Type::Tag) ||
+         (itemTypeInt == FavoritesModelItem::Type::SavedSearch)))
     {
         QModelIndex numNotesIndex = model->index(index.row(), FavoritesModel::Columns::NumNotesTargeted, index.parent());
         QVariant numNotes = model->data(numNotesIndex);
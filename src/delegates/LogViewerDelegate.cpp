@@ -19,11 +19,9 @@
 #include "LogViewerDelegate.h"
 #include <QFontMetrics>
 #include <QPainter>
-#include <QStringRef>
+#include <algorithm>
 #include <cmath>
 
-#define LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE (150)
-
 namespace quentier {
 
 LogViewerDelegate::LogViewerDelegate(QObject * parent) :
@@ -32,8 +30,14 @@ LogViewerDelegate::LogViewerDelegate(QObject * parent) :
     m_widestLogLevelName(QStringLiteral("Warning")),
     m_sampleDateTimeString(QStringLiteral("26/09/2017 19:31:23:457")),
     m_sampleSourceFileLineNumberString(QStringLiteral("99999")),
-    m_newlineChar(QChar::fromLatin1('\n')),
-    m_whitespaceChar(QChar::fromLatin1(' '))
+    m_cachedFont(),
+    m_cachedFontMetrics(m_cachedFont),
+    m_cachedTimestampSizeHint(),
+    m_cachedSourceFileLineNumberSizeHint(),
+    m_cachedLogLevelSizeHint(),
+    m_cachedCharWidth(0),
+    m_cachedLineSpacing(0),
+    m_fontMetricsCacheValid(false)
 {}
 
 QWidget * LogViewerDelegate::createEditor(QWidget * pParent,
@@ -61,28 +65,18 @@ QSize LogViewerDelegate::sizeHint(const QStyleOptionViewItem & option, const QMo
     // it has to be very fast, otherwise the performance is complete crap
     // so there are some shortcuts and missing checks which should normally be here
 
-    QFontMetrics fontMetrics(option.font);
-    QSize size;
-
-#define STRING_SIZE_HINT(str) \
-    { \
-        size.setWidth(static_cast<int>(std::floor(fontMetrics.width(str) * (1.0 + m_margin) + 0.5))); \
-        size.setHeight(static_cast<int>(std::floor(fontMetrics.lineSpacing() * (1.0 + m_margin) + 0.5))); \
-        return size; \
-    }
+    updateFontMetricsCache(option.font);
 
     switch(index.column())
     {
     case LogViewerModel::Columns::Timestamp:
-        STRING_SIZE_HINT(m_sampleDateTimeString)
+        return m_cachedTimestampSizeHint;
     case LogViewerModel::Columns::SourceFileLineNumber:
-        STRING_SIZE_HINT(m_sampleSourceFileLineNumberString)
+        return m_cachedSourceFileLineNumberSizeHint;
     case LogViewerModel::Columns::LogLevel:
-        STRING_SIZE_HINT(m_widestLogLevelName)
+        return m_cachedLogLevelSizeHint;
     }
 
-#undef STRING_SIZE_HINT
-
     // If we haven't returned yet, either the index is invalid or we are dealing
     // with either log entry column or source file name column
 
@@ -101,10 +95,12 @@ QSize LogViewerDelegate::sizeHint(const QStyleOptionViewItem & option, const QMo
         return QStyledItemDelegate::sizeHint(option, index);
     }
 
+    QSize size;
+
     if (index.column() == LogViewerModel::Columns::SourceFileName)
     {
         int numSubRows = 1;
-        int originalWidth = static_cast<int>(std::floor(fontMetrics.width(pDataEntry->m_sourceFileName) * (1.0 + m_margin) + 0.5));
+        int originalWidth = static_cast<int>(std::floor(m_cachedFontMetrics.width(pDataEntry->m_sourceFileName) * (1.0 + m_margin) + 0.5));
         int width = originalWidth;
         while(width > MAX_SOURCE_FILE_NAME_COLUMN_WIDTH) {
             ++numSubRows;
@@ -112,66 +108,16 @@ QSize LogViewerDelegate::sizeHint(const QStyleOptionViewItem & option, const QMo
         }
 
         size.setWidth(std::min(originalWidth, MAX_SOURCE_FILE_NAME_COLUMN_WIDTH));
-        size.setHeight(static_cast<int>(std::floor(fontMetrics.lineSpacing() * (numSubRows + 1 + m_margin) + 0.5)));
+        size.setHeight(static_cast<int>(std::floor(m_cachedLineSpacing * (numSubRows + 1 + m_margin) + 0.5)));
         return size;
     }
 
-    int numDisplayedLines = 0;
-    const int logEntrySize = pDataEntry->m_logEntry.size();
-    int maxLineSize = 0;
-    int lineStartPos = -1;
-    QString logEntryLineBuffer;
-    while(true)
-    {
-        int lineEndPos = -1;
-        int index = pDataEntry->m_logEntry.indexOf(m_newlineChar, (lineStartPos + 1));
-        if (index < 0)
-        {
-            lineEndPos = (lineStartPos + LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE);
+    // The log entry's displayed lines were found by the log file parser, no need to scan the log entry here
+    const int numDisplayedLines = pDataEntry->m_logEntryLineStartPositions.size();
+    const int maxLineSize = pDataEntry->m_logEntryMaxLineSize;
 
-            int previousWhitespaceIndex = pDataEntry->m_logEntry.lastIndexOf(m_whitespaceChar, (lineEndPos - 1));
-            if (previousWhitespaceIndex > lineStartPos) {
-                lineEndPos = previousWhitespaceIndex;
-            }
-        }
-        else
-        {
-            lineEndPos = index;
-
-            if (lineEndPos - lineStartPos > LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE)
-            {
-                lineEndPos = lineStartPos + LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE;
-
-                int previousWhitespaceIndex = pDataEntry->m_logEntry.lastIndexOf(m_whitespaceChar, (lineEndPos - 1));
-                if (previousWhitespaceIndex > lineStartPos) {
-                    lineEndPos = previousWhitespaceIndex;
-                }
-            }
-        }
-
-        if (lineEndPos > logEntrySize) {
-            lineEndPos = logEntrySize;
-        }
-
-        bool lastIteration = (lineEndPos == logEntrySize);
-
-        logEntryLineBuffer = pDataEntry->m_logEntry.mid(lineStartPos, (lineEndPos - lineStartPos)).trimmed();
-        int lineSize = logEntryLineBuffer.size();
-        if (lineSize > maxLineSize) {
-            maxLineSize = lineSize;
-        }
-
-        ++numDisplayedLines;
-
-        if (lastIteration) {
-            break;
-        }
-
-        lineStartPos = lineEndPos;
-    }
-
-    size.setWidth(static_cast<int>(std::floor(fontMetrics.width(QStringLiteral("w")) * (maxLineSize + 2 + m_margin) + 0.5)));
-    size.setHeight(static_cast<int>(std::floor((numDisplayedLines + 1) * fontMetrics.lineSpacing() + m_margin)));
+    size.setWidth(static_cast<int>(std::floor(m_cachedCharWidth * (maxLineSize + 2 + m_margin) + 0.5)));
+    size.setHeight(static_cast<int>(std::floor((numDisplayedLines + 1) * m_cachedLineSpacing + m_margin)));
     return size;
 }
 
@@ -245,8 +191,8 @@ bool LogViewerDelegate::paintImpl(QPainter * pPainter, const QStyleOptionViewIte
     case LogViewerModel::Columns::LogEntry:
         // pPainter->drawText(adjustedRect, pDataEntry->m_logEntry, textOption);
         {
-            QFontMetrics fontMetrics(option.font);
-            paintLogEntry(*pPainter, adjustedRect, *pDataEntry, fontMetrics);
+            updateFontMetricsCache(option.font);
+            paintLogEntry(*pPainter, adjustedRect, *pDataEntry, m_cachedFontMetrics);
         }
         break;
     default:
@@ -264,9 +210,6 @@ void LogViewerDelegate::paintLogEntry(QPainter & painter, const QRect & adjusted
         return;
     }
 
-    QString logEntryLineBuffer;
-    logEntryLineBuffer.reserve(LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE + 1);
-
     int lineSpacing = fontMetrics.height();
 
     QRect currentRect;
@@ -282,52 +225,43 @@ void LogViewerDelegate::paintLogEntry(QPainter & painter, const QRect & adjusted
     QTextOption textOption(Qt::Alignment(Qt::AlignLeft | Qt::AlignTop));
     textOption.setWrapMode(QTextOption::NoWrap);
 
-    int lineStartPos = -1;
-    const int logEntrySize = dataEntry.m_logEntry.size();
-    while(true)
+    const int numLines = std::min(dataEntry.m_logEntryLineStartPositions.size(), dataEntry.m_logEntryLineSizes.size());
+    for(int i = 0; i < numLines; ++i)
     {
-        int lineEndPos = -1;
-        int index = dataEntry.m_logEntry.indexOf(m_newlineChar, (lineStartPos + 1));
-        if (index < 0)
-        {
-            lineEndPos = (lineStartPos + LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE);
-
-            int previousWhitespaceIndex = dataEntry.m_logEntry.lastIndexOf(m_whitespaceChar, (lineEndPos - 1));
-            if (previousWhitespaceIndex > lineStartPos) {
-                lineEndPos = previousWhitespaceIndex;
-            }
+        // Not painting the lines below the visible part of the item
+        if (currentRect.top() > adjustedRect.bottom()) {
+            break;
         }
-        else
-        {
-            lineEndPos = index;
 
-            if (lineEndPos - lineStartPos > LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE)
-            {
-                lineEndPos = lineStartPos + LOG_VIEWER_MODEL_MAX_LOG_ENTRY_LINE_SIZE;
+        painter.drawText(currentRect, dataEntry.m_logEntry.mid(dataEntry.m_logEntryLineStartPositions[i],
+                                                               dataEntry.m_logEntryLineSizes[i]),
+                         textOption);
+        currentRect.moveTop(currentRect.top() + lineSpacing);
+    }
+}
 
-                int previousWhitespaceIndex = dataEntry.m_logEntry.lastIndexOf(m_whitespaceChar, (lineEndPos - 1));
-                if (previousWhitespaceIndex > lineStartPos) {
-                    lineEndPos = previousWhitespaceIndex;
-                }
-            }
-        }
+void LogViewerDelegate::updateFontMetricsCache(const QFont & font) const
+{
+    if (m_fontMetricsCacheValid && (font == m_cachedFont)) {
+        return;
+    }
 
-        if (lineEndPos > logEntrySize) {
-            lineEndPos = logEntrySize;
-        }
+    m_cachedFont = font;
+    m_cachedFontMetrics = QFontMetrics(font);
+    m_cachedCharWidth = m_cachedFontMetrics.width(QStringLiteral("w"));
+    m_cachedLineSpacing = m_cachedFontMetrics.lineSpacing();
 
-        bool lastIteration = (lineEndPos == logEntrySize);
+#define STRING_SIZE_HINT(str, sizeHint) \
+    sizeHint.setWidth(static_cast<int>(std::floor(m_cachedFontMetrics.width(str) * (1.0 + m_margin) + 0.5))); \
+    sizeHint.setHeight(static_cast<int>(std::floor(m_cachedLineSpacing * (1.0 + m_margin) + 0.5)))
 
-        logEntryLineBuffer = dataEntry.m_logEntry.mid(lineStartPos, (lineEndPos - lineStartPos)).trimmed();
-        painter.drawText(currentRect, logEntryLineBuffer, textOption);
+    STRING_SIZE_HINT(m_sampleDateTimeString, m_cachedTimestampSizeHint);
+    STRING_SIZE_HINT(m_sampleSourceFileLineNumberString, m_cachedSourceFileLineNumberSizeHint);
+    STRING_SIZE_HINT(m_widestLogLevelName, m_cachedLogLevelSizeHint);
 
-        if (lastIteration) {
-            break;
-        }
+#undef STRING_SIZE_HINT
 
-        lineStartPos = lineEndPos;
-        currentRect.moveTop(currentRect.top() + lineSpacing);
-    }
+    m_fontMetricsCacheValid = true;
 }
 
 } // namespace quentier
@@ -22,6 +22,9 @@
 #include "../models/LogViewerModel.h"
 #include <quentier/utility/Macros.h>
 #include <QStyledItemDelegate>
+#include <QFont>
+#include <QFontMetrics>
+#include <QSize>
 
 #define MAX_SOURCE_FILE_NAME_COLUMN_WIDTH (200)
 
@@ -47,14 +50,25 @@ private:
     void paintLogEntry(QPainter & painter, const QRect & adjustedRect, const LogViewerModel::Data & dataEntry,
                        const QFontMetrics & fontMetrics) const;
 
+    // Recomputes the cached font dependent sizes if the font differs from the one they were computed for
+    void updateFontMetricsCache(const QFont & font) const;
+
 private:
     double      m_margin;
     QString     m_widestLogLevelName;
     QString     m_sampleDateTimeString;
     QString     m_sampleSourceFileLineNumberString;
 
-    QChar       m_newlineChar;
-    QChar       m_whitespaceChar;
+    // The views ask for size hints of rows all the time while scrolling so everything depending only
+    // on the font is computed once per font
+    mutable QFont           m_cachedFont;
+    mutable QFontMetrics    m_cachedFontMetrics;
+    mutable QSize           m_cachedTimestampSizeHint;
+    mutable QSize           m_cachedSourceFileLineNumberSizeHint;
+    mutable QSize           m_cachedLogLevelSizeHint;
+    mutable int             m_cachedCharWidth;
+    mutable int             m_cachedLineSpacing;
+    mutable bool            m_fontMetricsCacheValid;
 };
 
 } // namespace quentier
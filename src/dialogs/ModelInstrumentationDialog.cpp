@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelInstrumentationDialog.h"
+#include "ui_ModelInstrumentationDialog.h"
+#include "../models/ModelInstrumentation.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <QFileDialog>
+#include <QDir>
+
+namespace quentier {
+
+ModelInstrumentationDialog::ModelInstrumentationDialog(QWidget * parent) :
+    QDialog(parent),
+    m_pUi(new Ui::ModelInstrumentationDialog)
+{
+    m_pUi->setupUi(this);
+    setWindowTitle(tr("Model instrumentation"));
+
+    m_pUi->enabledCheckBox->setChecked(ModelInstrumentation::isEnabled());
+    m_pUi->statusLabel->hide();
+    refreshReport();
+
+    QObject::connect(m_pUi->enabledCheckBox, QNSIGNAL(QCheckBox,toggled,bool),
+                     this, QNSLOT(ModelInstrumentationDialog,onEnabledCheckBoxToggled,bool));
+    QObject::connect(m_pUi->refreshPushButton, QNSIGNAL(QPushButton,clicked),
+                     this, QNSLOT(ModelInstrumentationDialog,onRefreshPushButtonPressed));
+    QObject::connect(m_pUi->resetPushButton, QNSIGNAL(QPushButton,clicked),
+                     this, QNSLOT(ModelInstrumentationDialog,onResetPushButtonPressed));
+    QObject::connect(m_pUi->saveToFilePushButton, QNSIGNAL(QPushButton,clicked),
+                     this, QNSLOT(ModelInstrumentationDialog,onSaveToFilePushButtonPressed));
+    QObject::connect(m_pUi->closePushButton, QNSIGNAL(QPushButton,clicked),
+                     this, QNSLOT(ModelInstrumentationDialog,accept));
+}
+
+ModelInstrumentationDialog::~ModelInstrumentationDialog()
+{
+    delete m_pUi;
+}
+
+void ModelInstrumentationDialog::onEnabledCheckBoxToggled(bool checked)
+{
+    QNDEBUG(QStringLiteral("ModelInstrumentationDialog::onEnabledCheckBoxToggled: ")
+            << (checked ? QStringLiteral("true") : QStringLiteral("false")));
+    ModelInstrumentation::setEnabled(checked);
+}
+
+void ModelInstrumentationDialog::onRefreshPushButtonPressed()
+{
+    refreshReport();
+}
+
+void ModelInstrumentationDialog::onResetPushButtonPressed()
+{
+    QNDEBUG(QStringLiteral("ModelInstrumentationDialog::onResetPushButtonPressed"));
+    ModelInstrumentation::reset();
+    refreshReport();
+}
+
+void ModelInstrumentationDialog::onSaveToFilePushButtonPressed()
+{
+    QNDEBUG(QStringLiteral("ModelInstrumentationDialog::onSaveToFilePushButtonPressed"));
+
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Save the model instrumentation report"),
+                                                    QDir::homePath() + QStringLiteral("/quentier_model_instrumentation.txt"),
+                                                    tr("Text files") + QStringLiteral(" (*.txt)"));
+    if (filePath.isEmpty()) {
+        QNDEBUG(QStringLiteral("No file was selected"));
+        return;
+    }
+
+    ErrorString errorDescription;
+    bool res = ModelInstrumentation::dumpToFile(filePath, errorDescription);
+    if (!res) {
+        QNWARNING(errorDescription);
+        m_pUi->statusLabel->setText(errorDescription.localizedString());
+        m_pUi->statusLabel->show();
+        return;
+    }
+
+    m_pUi->statusLabel->setText(tr("The report was saved to") + QStringLiteral(" ") + QDir::toNativeSeparators(filePath));
+    m_pUi->statusLabel->show();
+}
+
+void ModelInstrumentationDialog::refreshReport()
+{
+    m_pUi->reportPlainTextEdit->setPlainText(ModelInstrumentation::report());
+}
+
+} // namespace quentier
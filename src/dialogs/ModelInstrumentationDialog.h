@@ -0,0 +1,57 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_DIALOGS_MODEL_INSTRUMENTATION_DIALOG_H
+#define QUENTIER_DIALOGS_MODEL_INSTRUMENTATION_DIALOG_H
+
+#include <quentier/utility/Macros.h>
+#include <QDialog>
+
+namespace Ui {
+class ModelInstrumentationDialog;
+}
+
+namespace quentier {
+
+/**
+ * @brief The ModelInstrumentationDialog class is the debug dialog showing the report of the models' instrumentation
+ * and allowing to enable or disable the instrumentation, reset the collected timings and dump the report to a file
+ */
+class ModelInstrumentationDialog: public QDialog
+{
+    Q_OBJECT
+public:
+    explicit ModelInstrumentationDialog(QWidget * parent = Q_NULLPTR);
+    ~ModelInstrumentationDialog();
+
+private Q_SLOTS:
+    void onEnabledCheckBoxToggled(bool checked);
+    void onRefreshPushButtonPressed();
+    void onResetPushButtonPressed();
+    void onSaveToFilePushButtonPressed();
+
+private:
+    void refreshReport();
+
+private:
+    Ui::ModelInstrumentationDialog *    m_pUi;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_DIALOGS_MODEL_INSTRUMENTATION_DIALOG_H
@@ -71,7 +71,9 @@ CommandLineParser::CommandLineParser(int argc, char * argv[]) :
              "override the availability of the system tray\n(0 - override to false,\n"
              "any other value - override to true)")
             ("startMinimizedToTray", "start Quentier minimized to system tray")
-            ("startMinimized", "start Quentier with its main window minimized to the task bar");
+            ("startMinimized", "start Quentier with its main window minimized to the task bar")
+            ("startupTrace", po::value<QString>(), "write the trace of the app's startup phases into the specified file "
+                                                   "(in Chrome trace event format) and log the startup's critical path");
 
         po::variables_map varsMap;
         po::store(po::parse_command_line(argc, argv, desc), varsMap);
@@ -21,6 +21,8 @@
 #include "SetupTranslations.h"
 #include "SetupStartAtLogin.h"
 #include "ParseStartupAccount.h"
+#include "StartupTracer.h"
+#include "StartupTasks.h"
 #include "../SettingsNames.h"
 #include "../AccountManager.h"
 #include <quentier/logging/QuentierLogger.h>
@@ -35,6 +37,7 @@
 #endif
 
 #include <QFileInfo>
+#include <QScopedPointer>
 
 namespace quentier {
 
@@ -62,17 +65,51 @@ bool initialize(QuentierApplication & app, const CommandLineParser::CommandLineO
     }
 
     // Initialize logging
-    QUENTIER_INITIALIZE_LOGGING();
-    QUENTIER_SET_MIN_LOG_LEVEL(Info);
-    QUENTIER_ADD_STDOUT_LOG_DESTINATION();
+    {
+        StartupTracer::Phase phase("Initialize logging");
+        QUENTIER_INITIALIZE_LOGGING();
+        QUENTIER_SET_MIN_LOG_LEVEL(Info);
+        QUENTIER_ADD_STDOUT_LOG_DESTINATION();
+    }
 
 #ifdef BUILDING_WITH_BREAKPAD
-    setupBreakpad(app);
+    {
+        StartupTracer::Phase phase("Setup breakpad");
+        setupBreakpad(app);
+    }
 #endif
 
-    initializeLibquentier();
-    setupApplicationIcon(app);
-    setupTranslations(app);
+    {
+        StartupTracer::Phase phase("Initialize libquentier");
+        initializeLibquentier();
+    }
+
+    // Reading the translations and the accounts' info from the disk doesn't need the GUI thread
+    StartupTaskGraph * pStartupTaskGraph = StartupTaskGraph::instance();
+    if (pStartupTaskGraph) {
+        pStartupTaskGraph->addTask(LOAD_TRANSLATIONS_STARTUP_TASK, new LoadTranslationsTask(app.applicationDirPath()));
+        pStartupTaskGraph->addTask(DETECT_AVAILABLE_ACCOUNTS_STARTUP_TASK, new DetectAvailableAccountsTask);
+    }
+
+    {
+        StartupTracer::Phase phase("Setup application icon");
+        setupApplicationIcon(app);
+    }
+
+    {
+        StartupTracer::Phase phase("Setup translations");
+        LoadTranslationsTask * pLoadTranslationsTask = Q_NULLPTR;
+        if (pStartupTaskGraph) {
+            pLoadTranslationsTask = static_cast<LoadTranslationsTask*>(pStartupTaskGraph->join(LOAD_TRANSLATIONS_STARTUP_TASK));
+        }
+
+        if (pLoadTranslationsTask) {
+            app.installTranslator(pLoadTranslationsTask->takeTranslator());
+        }
+        else {
+            setupTranslations(app);
+        }
+    }
 
     // Restore the last active min log level
     ApplicationSettings appSettings;
@@ -86,7 +123,10 @@ bool initialize(QuentierApplication & app, const CommandLineParser::CommandLineO
         }
     }
 
-    setupStartQuentierAtLogin();
+    {
+        StartupTracer::Phase phase("Setup start at login");
+        setupStartQuentierAtLogin();
+    }
 
     return processCommandLineOptions(cmdOptions);
 }
@@ -138,6 +178,11 @@ bool processStorageDirCommandLineOption(const CommandLineParser::CommandLineOpti
 
 bool processCommandLineOptions(const CommandLineParser::CommandLineOptions & cmdOptions)
 {
+    CmdOptions::const_iterator startupTraceIt = cmdOptions.find(QStringLiteral("startupTrace"));
+    if (startupTraceIt != cmdOptions.constEnd()) {
+        StartupTracer::setTraceFilePath(startupTraceIt.value().toString());
+    }
+
     CmdOptions::const_iterator accountIt = cmdOptions.find(QStringLiteral("account"));
     if (accountIt != cmdOptions.constEnd())
     {
@@ -160,8 +205,8 @@ bool processCommandLineOptions(const CommandLineParser::CommandLineOptions & cmd
         bool foundAccount = false;
         Account::EvernoteAccountType::type evernoteAccountType = Account::EvernoteAccountType::Free;
 
-        AccountManager accountManager;
-        const QVector<Account> & availableAccounts = accountManager.availableAccounts();
+        QScopedPointer<AccountManager> pAccountManager(createAccountManager());
+        const QVector<Account> & availableAccounts = pAccountManager->availableAccounts();
         for(int i = 0, numAvailableAccounts = availableAccounts.size(); i < numAvailableAccounts; ++i)
         {
             const Account & availableAccount = availableAccounts.at(i);
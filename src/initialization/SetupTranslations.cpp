@@ -96,11 +96,11 @@ void loadTranslations(const QString & defaultSearchPath, const QString & searchP
     }
 }
 
-void setupTranslations(QuentierApplication & app)
+QTranslator * loadTranslator(const QString & applicationDirPath)
 {
-    QNDEBUG(QStringLiteral("setupTranslations"));
+    QNDEBUG(QStringLiteral("loadTranslator: application dir path = ") << applicationDirPath);
 
-    QString defaultLibquentierTranslationsSearchPath = app.applicationDirPath() +
+    QString defaultLibquentierTranslationsSearchPath = applicationDirPath +
 #ifdef Q_OS_MAC
                                                        QStringLiteral("/../Resources/translations/libquentier");
 #else
@@ -108,7 +108,7 @@ void setupTranslations(QuentierApplication & app)
 #endif
     QNDEBUG(QStringLiteral("Default libquentier translations search path: ") <<defaultLibquentierTranslationsSearchPath);
 
-    QString defaultQuentierTranslationsSearchPath = app.applicationDirPath() +
+    QString defaultQuentierTranslationsSearchPath = applicationDirPath +
 #ifdef Q_OS_MAC
                                                     QStringLiteral("/../Resources/translations/quentier");
 #else
@@ -126,7 +126,13 @@ void setupTranslations(QuentierApplication & app)
     loadTranslations(defaultQuentierTranslationsSearchPath, QUENTIER_TRANSLATIONS_SEARCH_PATH,
                      QStringLiteral("quentier_*.qm"), *pTranslator);
 
-    app.installTranslator(pTranslator);
+    return pTranslator;
+}
+
+void setupTranslations(QuentierApplication & app)
+{
+    QNDEBUG(QStringLiteral("setupTranslations"));
+    app.installTranslator(loadTranslator(app.applicationDirPath()));
 }
 
 } // namespace quentier
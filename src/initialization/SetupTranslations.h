@@ -21,8 +21,16 @@
 
 #include <quentier/utility/QuentierApplication.h>
 
+QT_FORWARD_DECLARE_CLASS(QTranslator)
+
 namespace quentier {
 
+/**
+ * @brief loadTranslator - loads the libquentier's and quentier's translations for the system locale
+ * into the new translator; doesn't touch the application object so can be called from any thread
+ */
+QTranslator * loadTranslator(const QString & applicationDirPath);
+
 void setupTranslations(QuentierApplication & app);
 
 } // namespace quentier
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupTaskGraph.h"
+#include "StartupTracer.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QElapsedTimer>
+#include <QByteArray>
+
+// The startup tasks are mostly I/O bound so there's little point to have more threads than there are
+// independent tasks
+#define STARTUP_TASK_GRAPH_MAX_THREAD_COUNT (4)
+
+namespace quentier {
+
+StartupTaskGraph * StartupTaskGraph::m_pInstance = Q_NULLPTR;
+
+class StartupTaskRunnable: public QRunnable
+{
+public:
+    StartupTaskRunnable(StartupTaskGraph & graph, const QString & name, StartupTask & task) :
+        m_graph(graph),
+        m_name(name),
+        m_task(task)
+    {}
+
+    virtual void run() Q_DECL_OVERRIDE
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        std::exception_ptr exception;
+        try {
+            m_task.run();
+        }
+        catch(...) {
+            exception = std::current_exception();
+        }
+
+        m_graph.onTaskFinished(m_name, exception, timer.elapsed());
+    }
+
+private:
+    StartupTaskGraph &  m_graph;
+    QString             m_name;
+    StartupTask &       m_task;
+};
+
+StartupTaskGraph::StartupTaskGraph() :
+    m_mutex(),
+    m_taskFinishedCondition(),
+    m_tasks(),
+    m_threadPool()
+{
+    m_threadPool.setMaxThreadCount(STARTUP_TASK_GRAPH_MAX_THREAD_COUNT);
+    m_pInstance = this;
+}
+
+StartupTaskGraph::~StartupTaskGraph()
+{
+    m_threadPool.waitForDone();
+
+    for(auto it = m_tasks.begin(), end = m_tasks.end(); it != end; ++it) {
+        delete it.value().m_pTask;
+    }
+
+    if (m_pInstance == this) {
+        m_pInstance = Q_NULLPTR;
+    }
+}
+
+StartupTaskGraph * StartupTaskGraph::instance()
+{
+    return m_pInstance;
+}
+
+void StartupTaskGraph::addTask(const QString & name, StartupTask * pTask, const QStringList & dependencies)
+{
+    QNDEBUG(QStringLiteral("StartupTaskGraph::addTask: ") << name << QStringLiteral(", dependencies: ")
+            << dependencies.join(QStringLiteral(", ")));
+
+    QMutexLocker locker(&m_mutex);
+
+    if (Q_UNLIKELY(m_tasks.contains(name))) {
+        QNWARNING(QStringLiteral("Detected the attempt to add the startup task with duplicate name: ") << name);
+        delete pTask;
+        return;
+    }
+
+    TaskInfo & taskInfo = m_tasks[name];
+    taskInfo.m_pTask = pTask;
+
+    for(auto it = dependencies.constBegin(), end = dependencies.constEnd(); it != end; ++it)
+    {
+        if (Q_UNLIKELY(!m_tasks.contains(*it))) {
+            QNWARNING(QStringLiteral("Startup task ") << name << QStringLiteral(" depends on unknown task ") << *it
+                      << QStringLiteral(", ignoring this dependency"));
+            continue;
+        }
+
+        taskInfo.m_dependencies << *it;
+    }
+
+    startReadyTasks();
+}
+
+bool StartupTaskGraph::hasTask(const QString & name) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_tasks.contains(name);
+}
+
+StartupTask * StartupTaskGraph::join(const QString & name)
+{
+    QByteArray phaseName = QByteArray("Join startup task: ") + name.toUtf8();
+    StartupTracer::Phase startupPhase(phaseName.constData());
+
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_tasks.find(name);
+    if (Q_UNLIKELY(it == m_tasks.end())) {
+        QNDEBUG(QStringLiteral("No startup task to join: ") << name);
+        return Q_NULLPTR;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while(it.value().m_status != TaskStatus::Finished) {
+        m_taskFinishedCondition.wait(&m_mutex);
+        // The hash might have been rehashed while the mutex was unlocked
+        it = m_tasks.find(name);
+    }
+
+    const TaskInfo & taskInfo = it.value();
+    QNDEBUG(QStringLiteral("Joined startup task ") << name << QStringLiteral(": the task took ")
+            << taskInfo.m_durationMsec << QStringLiteral(" msec, the join waited for ") << timer.elapsed()
+            << QStringLiteral(" msec"));
+
+    if (taskInfo.m_exception) {
+        std::exception_ptr exception = taskInfo.m_exception;
+        locker.unlock();
+        std::rethrow_exception(exception);
+    }
+
+    return taskInfo.m_pTask;
+}
+
+void StartupTaskGraph::onTaskFinished(const QString & name, std::exception_ptr exception, const qint64 durationMsec)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_tasks.find(name);
+    if (Q_UNLIKELY(it == m_tasks.end())) {
+        return;
+    }
+
+    TaskInfo & taskInfo = it.value();
+    taskInfo.m_status = TaskStatus::Finished;
+    taskInfo.m_exception = exception;
+    taskInfo.m_durationMsec = durationMsec;
+
+    startReadyTasks();
+    m_taskFinishedCondition.wakeAll();
+}
+
+void StartupTaskGraph::startReadyTasks()
+{
+    bool failedTasksFound = false;
+
+    for(auto it = m_tasks.begin(), end = m_tasks.end(); it != end; ++it)
+    {
+        TaskInfo & taskInfo = it.value();
+        if (taskInfo.m_status != TaskStatus::Pending) {
+            continue;
+        }
+
+        std::exception_ptr failedDependencyException;
+        if (!dependenciesFinished(taskInfo, failedDependencyException)) {
+            continue;
+        }
+
+        if (failedDependencyException) {
+            QNDEBUG(QStringLiteral("Skipping startup task ") << it.key() << QStringLiteral(" as its dependency has failed"));
+            taskInfo.m_status = TaskStatus::Finished;
+            taskInfo.m_exception = failedDependencyException;
+            failedTasksFound = true;
+            continue;
+        }
+
+        QNTRACE(QStringLiteral("Starting startup task ") << it.key());
+        taskInfo.m_status = TaskStatus::Running;
+        m_threadPool.start(new StartupTaskRunnable(*this, it.key(), *taskInfo.m_pTask));
+    }
+
+    // The tasks depending on the skipped ones need to be skipped as well
+    if (failedTasksFound) {
+        startReadyTasks();
+    }
+}
+
+bool StartupTaskGraph::dependenciesFinished(const TaskInfo & taskInfo, std::exception_ptr & failedDependencyException) const
+{
+    for(auto it = taskInfo.m_dependencies.constBegin(), end = taskInfo.m_dependencies.constEnd(); it != end; ++it)
+    {
+        auto dependencyIt = m_tasks.constFind(*it);
+        if (dependencyIt == m_tasks.constEnd()) {
+            continue;
+        }
+
+        const TaskInfo & dependencyInfo = dependencyIt.value();
+        if (dependencyInfo.m_status != TaskStatus::Finished) {
+            return false;
+        }
+
+        if (dependencyInfo.m_exception) {
+            failedDependencyException = dependencyInfo.m_exception;
+        }
+    }
+
+    return true;
+}
+
+} // namespace quentier
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_INITIALIZATION_STARTUP_TASK_GRAPH_H
+#define QUENTIER_INITIALIZATION_STARTUP_TASK_GRAPH_H
+
+#include <quentier/utility/Macros.h>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QStringList>
+#include <exception>
+
+namespace quentier {
+
+/**
+ * @brief The StartupTask class is the interface for the piece of startup work which doesn't need the GUI thread
+ */
+class StartupTask
+{
+public:
+    virtual ~StartupTask() {}
+
+    /**
+     * Runs on the worker thread; the exception thrown from this method is rethrown to the thread joining the task
+     */
+    virtual void run() = 0;
+};
+
+/**
+ * @brief The StartupTaskGraph class runs the independent pieces of startup work on the worker threads
+ * while the GUI thread does the work which Qt requires to be done within the GUI thread
+ *
+ * Each task is started as soon as all the tasks it depends on are finished; the GUI thread joins the task
+ * at the point where it needs the task's results. The task which dependency has failed is not run, joining it
+ * rethrows the exception from the failed dependency.
+ *
+ * The graph exists only during the startup: once it is destroyed, the code which would otherwise join
+ * the startup tasks is expected to do the work synchronously, see @link instance @endlink.
+ */
+class StartupTaskGraph
+{
+public:
+    StartupTaskGraph();
+
+    /**
+     * Waits for all the started tasks to finish
+     */
+    ~StartupTaskGraph();
+
+    /**
+     * @return the existing startup task graph or null if there's none i.e. if the startup is over
+     */
+    static StartupTaskGraph * instance();
+
+    /**
+     * @brief addTask - adds the task to the graph, the graph takes the ownership of the task
+     * @param name - the unique name of the task
+     * @param pTask - the task to be run
+     * @param dependencies - the names of tasks which need to be finished before this task can be started;
+     * these tasks must have been already added to the graph
+     */
+    void addTask(const QString & name, StartupTask * pTask, const QStringList & dependencies = QStringList());
+
+    bool hasTask(const QString & name) const;
+
+    /**
+     * @brief join - blocks the calling thread until the task is finished
+     * @return the finished task (still owned by the graph) or null if there's no such task within the graph;
+     * if the task has thrown an exception, it is rethrown
+     */
+    StartupTask * join(const QString & name);
+
+private:
+    struct TaskStatus
+    {
+        enum type {
+            Pending = 0,
+            Running,
+            Finished
+        };
+    };
+
+    struct TaskInfo
+    {
+        TaskInfo() :
+            m_pTask(Q_NULLPTR),
+            m_dependencies(),
+            m_status(TaskStatus::Pending),
+            m_exception(),
+            m_durationMsec(0)
+        {}
+
+        StartupTask *       m_pTask;
+        QStringList         m_dependencies;
+        TaskStatus::type    m_status;
+        std::exception_ptr  m_exception;
+        qint64              m_durationMsec;
+    };
+
+    friend class StartupTaskRunnable;
+
+    void onTaskFinished(const QString & name, std::exception_ptr exception, const qint64 durationMsec);
+
+    // The following methods expect m_mutex to be locked
+    void startReadyTasks();
+    bool dependenciesFinished(const TaskInfo & taskInfo, std::exception_ptr & failedDependencyException) const;
+
+private:
+    Q_DISABLE_COPY(StartupTaskGraph)
+
+private:
+    mutable QMutex              m_mutex;
+    QWaitCondition              m_taskFinishedCondition;
+    QHash<QString, TaskInfo>    m_tasks;
+    QThreadPool                 m_threadPool;
+
+    static StartupTaskGraph *   m_pInstance;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_INITIALIZATION_STARTUP_TASK_GRAPH_H
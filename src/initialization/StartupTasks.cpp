@@ -0,0 +1,120 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupTasks.h"
+#include "SetupTranslations.h"
+#include "../AccountManager.h"
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/logging/QuentierLogger.h>
+#include <QCoreApplication>
+#include <QTranslator>
+#include <QThread>
+#include <QScopedPointer>
+
+namespace quentier {
+
+LoadTranslationsTask::LoadTranslationsTask(const QString & applicationDirPath) :
+    m_applicationDirPath(applicationDirPath),
+    m_pTranslator(Q_NULLPTR)
+{}
+
+LoadTranslationsTask::~LoadTranslationsTask()
+{
+    delete m_pTranslator;
+}
+
+void LoadTranslationsTask::run()
+{
+    QNDEBUG(QStringLiteral("LoadTranslationsTask::run"));
+
+    m_pTranslator = loadTranslator(m_applicationDirPath);
+
+    QCoreApplication * pApp = QCoreApplication::instance();
+    if (pApp) {
+        m_pTranslator->moveToThread(pApp->thread());
+    }
+}
+
+QTranslator * LoadTranslationsTask::takeTranslator()
+{
+    QTranslator * pTranslator = m_pTranslator;
+    m_pTranslator = Q_NULLPTR;
+    return pTranslator;
+}
+
+DetectAvailableAccountsTask::DetectAvailableAccountsTask() :
+    m_availableAccounts()
+{}
+
+void DetectAvailableAccountsTask::run()
+{
+    QNDEBUG(QStringLiteral("DetectAvailableAccountsTask::run"));
+
+    AccountManager accountManager;
+    m_availableAccounts = accountManager.availableAccounts();
+}
+
+OpenLocalStorageTask::OpenLocalStorageTask(const Account & account, QThread * pLocalStorageManagerThread) :
+    m_account(account),
+    m_pLocalStorageManagerThread(pLocalStorageManagerThread),
+    m_pLocalStorageManagerAsync(Q_NULLPTR)
+{}
+
+OpenLocalStorageTask::~OpenLocalStorageTask()
+{
+    // The local storage manager has already been moved to its own thread
+    if (m_pLocalStorageManagerAsync) {
+        m_pLocalStorageManagerAsync->deleteLater();
+    }
+}
+
+void OpenLocalStorageTask::run()
+{
+    QNDEBUG(QStringLiteral("OpenLocalStorageTask::run: account = ") << m_account.name());
+
+    QScopedPointer<LocalStorageManagerAsync> pLocalStorageManagerAsync(
+        new LocalStorageManagerAsync(m_account, /* start from scratch = */ false, /* override lock = */ false));
+    pLocalStorageManagerAsync->init();
+    pLocalStorageManagerAsync->moveToThread(m_pLocalStorageManagerThread);
+
+    m_pLocalStorageManagerAsync = pLocalStorageManagerAsync.take();
+}
+
+LocalStorageManagerAsync * OpenLocalStorageTask::takeLocalStorageManagerAsync()
+{
+    LocalStorageManagerAsync * pLocalStorageManagerAsync = m_pLocalStorageManagerAsync;
+    m_pLocalStorageManagerAsync = Q_NULLPTR;
+    return pLocalStorageManagerAsync;
+}
+
+AccountManager * createAccountManager(QObject * parent)
+{
+    StartupTaskGraph * pStartupTaskGraph = StartupTaskGraph::instance();
+    if (pStartupTaskGraph && pStartupTaskGraph->hasTask(DETECT_AVAILABLE_ACCOUNTS_STARTUP_TASK))
+    {
+        DetectAvailableAccountsTask * pTask =
+            static_cast<DetectAvailableAccountsTask*>(pStartupTaskGraph->join(DETECT_AVAILABLE_ACCOUNTS_STARTUP_TASK));
+        if (pTask) {
+            return new AccountManager(pTask->availableAccounts(), parent);
+        }
+    }
+
+    return new AccountManager(parent);
+}
+
+} // namespace quentier
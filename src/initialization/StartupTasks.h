@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_INITIALIZATION_STARTUP_TASKS_H
+#define QUENTIER_INITIALIZATION_STARTUP_TASKS_H
+
+#include "StartupTaskGraph.h"
+#include <quentier/types/Account.h>
+#include <QVector>
+
+QT_FORWARD_DECLARE_CLASS(QObject)
+QT_FORWARD_DECLARE_CLASS(QThread)
+QT_FORWARD_DECLARE_CLASS(QTranslator)
+
+#define LOAD_TRANSLATIONS_STARTUP_TASK QStringLiteral("Load translations")
+#define DETECT_AVAILABLE_ACCOUNTS_STARTUP_TASK QStringLiteral("Detect available accounts")
+#define OPEN_LOCAL_STORAGE_STARTUP_TASK QStringLiteral("Open local storage")
+
+namespace quentier {
+
+QT_FORWARD_DECLARE_CLASS(AccountManager)
+QT_FORWARD_DECLARE_CLASS(LocalStorageManagerAsync)
+
+/**
+ * @brief The LoadTranslationsTask class loads the translations from files; installing the translator
+ * into the application is left to the GUI thread
+ */
+class LoadTranslationsTask: public StartupTask
+{
+public:
+    explicit LoadTranslationsTask(const QString & applicationDirPath);
+    virtual ~LoadTranslationsTask();
+
+    virtual void run() Q_DECL_OVERRIDE;
+
+    /**
+     * @return the loaded translator belonging to the GUI thread; the caller takes the ownership
+     */
+    QTranslator * takeTranslator();
+
+private:
+    QString         m_applicationDirPath;
+    QTranslator *   m_pTranslator;
+};
+
+/**
+ * @brief The DetectAvailableAccountsTask class scans the persistent storage for the existing accounts
+ */
+class DetectAvailableAccountsTask: public StartupTask
+{
+public:
+    DetectAvailableAccountsTask();
+
+    virtual void run() Q_DECL_OVERRIDE;
+
+    const QVector<Account> & availableAccounts() const { return m_availableAccounts; }
+
+private:
+    QVector<Account>    m_availableAccounts;
+};
+
+/**
+ * @brief The OpenLocalStorageTask class creates and initializes the local storage manager for the account
+ * i.e. opens the database and checks its version, then moves the local storage manager to its own thread
+ */
+class OpenLocalStorageTask: public StartupTask
+{
+public:
+    OpenLocalStorageTask(const Account & account, QThread * pLocalStorageManagerThread);
+    virtual ~OpenLocalStorageTask();
+
+    virtual void run() Q_DECL_OVERRIDE;
+
+    /**
+     * @return the initialized local storage manager living in the local storage manager thread;
+     * the caller takes the ownership
+     */
+    LocalStorageManagerAsync * takeLocalStorageManagerAsync();
+
+private:
+    Account                     m_account;
+    QThread *                   m_pLocalStorageManagerThread;
+    LocalStorageManagerAsync *  m_pLocalStorageManagerAsync;
+};
+
+/**
+ * @brief createAccountManager - creates the account manager from the available accounts detected by
+ * the startup task, if there's one, otherwise the account manager detects the available accounts on its own
+ */
+AccountManager * createAccountManager(QObject * parent = Q_NULLPTR);
+
+} // namespace quentier
+
+#endif // QUENTIER_INITIALIZATION_STARTUP_TASKS_H
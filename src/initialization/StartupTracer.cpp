@@ -0,0 +1,548 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupTracer.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QByteArray>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <utility>
+
+// The number of the slowest nested phases listed under each synchronous phase within the critical path summary
+#define STARTUP_TRACER_NUM_LISTED_NESTED_PHASES (3)
+
+namespace quentier {
+
+namespace {
+
+struct TraceEvent
+{
+    struct Type
+    {
+        enum type {
+            Phase = 0,
+            AsyncPhase,
+            Milestone
+        };
+    };
+
+    TraceEvent() :
+        m_name(),
+        m_type(Type::Phase),
+        m_startNsec(0),
+        m_endNsec(-1),
+        m_parentIndex(-1),
+        m_unfinished(false)
+    {}
+
+    QByteArray      m_name;
+    Type::type      m_type;
+    qint64          m_startNsec;
+    qint64          m_endNsec;
+    int             m_parentIndex;
+    bool            m_unfinished;
+};
+
+struct CriticalPathItem
+{
+    CriticalPathItem() :
+        m_eventIndex(-1),
+        m_startNsec(0),
+        m_endNsec(0)
+    {}
+
+    // -1 for the time not covered by any traced phase
+    int         m_eventIndex;
+    qint64      m_startNsec;
+    qint64      m_endNsec;
+};
+
+struct TracerState
+{
+    TracerState() :
+        m_timer(),
+        m_events(),
+        m_phaseStack(),
+        m_numAsyncPhasesInProgress(0),
+        m_enteringEventLoop(false),
+        m_finishNsec(-1),
+        m_traceFilePath()
+    {}
+
+    QElapsedTimer       m_timer;
+    QVector<TraceEvent> m_events;
+
+    // The indices of the synchronous phases in progress, the innermost one is the last
+    QVector<int>        m_phaseStack;
+
+    int                 m_numAsyncPhasesInProgress;
+    bool                m_enteringEventLoop;
+    qint64              m_finishNsec;
+    QString             m_traceFilePath;
+};
+
+TracerState & state()
+{
+    static TracerState tracerState;
+    return tracerState;
+}
+
+double nsecToMsec(const qint64 nsec)
+{
+    return static_cast<double>(nsec) / 1.0e6;
+}
+
+QString formatMsec(const qint64 nsec)
+{
+    return QString::number(nsecToMsec(nsec), 'f', 1);
+}
+
+QString eventDisplayName(const TraceEvent & event)
+{
+    QString name = QString::fromUtf8(event.m_name);
+    if (event.m_type == TraceEvent::Type::AsyncPhase) {
+        name += QStringLiteral(" (asynchronous)");
+    }
+
+    if (event.m_unfinished) {
+        name += QStringLiteral(" (unfinished)");
+    }
+
+    return name;
+}
+
+QString toJsonString(const QByteArray & str)
+{
+    QString result = QString::fromUtf8(str);
+    result.replace(QStringLiteral("\\"), QStringLiteral("\\\\"));
+    result.replace(QStringLiteral("\""), QStringLiteral("\\\""));
+    return QStringLiteral("\"") + result + QStringLiteral("\"");
+}
+
+QString nsecToJsonUsec(const qint64 nsec)
+{
+    return QString::number(static_cast<double>(nsec) / 1.0e3, 'f', 3);
+}
+
+QVector<CriticalPathItem> computeCriticalPath()
+{
+    const TracerState & tracerState = state();
+    const QVector<TraceEvent> & events = tracerState.m_events;
+
+    // The critical path is traced backwards from the end of the startup: at each point in time the path continues
+    // through the top level synchronous phase the GUI thread was busy with at that moment or, if the GUI thread
+    // was idle, through the phase which finished last before that moment
+    QVector<CriticalPathItem> path;
+    QVector<bool> used(events.size(), false);
+
+    qint64 currentNsec = tracerState.m_finishNsec;
+    while(currentNsec > 0)
+    {
+        int coveringIndex = -1;
+        int latestEndedIndex = -1;
+
+        for(int i = 0, size = events.size(); i < size; ++i)
+        {
+            const TraceEvent & event = events[i];
+            if (used[i] || (event.m_type == TraceEvent::Type::Milestone) || (event.m_startNsec >= currentNsec)) {
+                continue;
+            }
+
+            if ((event.m_type == TraceEvent::Type::Phase) && (event.m_parentIndex >= 0)) {
+                continue;
+            }
+
+            if ((event.m_type == TraceEvent::Type::Phase) && (event.m_endNsec >= currentNsec)) {
+                coveringIndex = i;
+                break;
+            }
+
+            if (event.m_endNsec > currentNsec) {
+                continue;
+            }
+
+            if ( (latestEndedIndex < 0) ||
+                 (event.m_endNsec > events[latestEndedIndex].m_endNsec) ||
+                 ((event.m_endNsec == events[latestEndedIndex].m_endNsec) &&
+                  (event.m_startNsec < events[latestEndedIndex].m_startNsec)) )
+            {
+                latestEndedIndex = i;
+            }
+        }
+
+        int index = (coveringIndex >= 0) ? coveringIndex : latestEndedIndex;
+        if (index < 0) {
+            break;
+        }
+
+        const TraceEvent & event = events[index];
+        used[index] = true;
+
+        if (event.m_endNsec < currentNsec) {
+            CriticalPathItem gapItem;
+            gapItem.m_startNsec = event.m_endNsec;
+            gapItem.m_endNsec = currentNsec;
+            path.prepend(gapItem);
+        }
+
+        CriticalPathItem item;
+        item.m_eventIndex = index;
+        item.m_startNsec = event.m_startNsec;
+        item.m_endNsec = std::min(event.m_endNsec, currentNsec);
+        path.prepend(item);
+
+        currentNsec = event.m_startNsec;
+    }
+
+    if (currentNsec > 0) {
+        CriticalPathItem gapItem;
+        gapItem.m_endNsec = currentNsec;
+        path.prepend(gapItem);
+    }
+
+    return path;
+}
+
+} // namespace
+
+bool StartupTracer::m_active = false;
+
+void StartupTracer::start()
+{
+    TracerState & tracerState = state();
+    tracerState.m_timer.start();
+    tracerState.m_events.clear();
+    tracerState.m_phaseStack.clear();
+    tracerState.m_numAsyncPhasesInProgress = 0;
+    tracerState.m_enteringEventLoop = false;
+    tracerState.m_finishNsec = -1;
+
+    m_active = true;
+}
+
+void StartupTracer::setTraceFilePath(const QString & filePath)
+{
+    state().m_traceFilePath = filePath;
+}
+
+void StartupTracer::beginPhase(const char * name)
+{
+    if (!m_active) {
+        return;
+    }
+
+    TracerState & tracerState = state();
+
+    TraceEvent event;
+    event.m_name = QByteArray(name);
+    event.m_type = TraceEvent::Type::Phase;
+    event.m_startNsec = tracerState.m_timer.nsecsElapsed();
+    event.m_parentIndex = (tracerState.m_phaseStack.isEmpty() ? -1 : tracerState.m_phaseStack.last());
+
+    tracerState.m_phaseStack << tracerState.m_events.size();
+    tracerState.m_events << event;
+}
+
+void StartupTracer::endPhase(const char * name)
+{
+    if (!m_active) {
+        return;
+    }
+
+    TracerState & tracerState = state();
+    qint64 nowNsec = tracerState.m_timer.nsecsElapsed();
+
+    // The phases not ended explicitly are ended along with their outer phase
+    QByteArray phaseName(name);
+    for(int i = tracerState.m_phaseStack.size() - 1; i >= 0; --i)
+    {
+        if (tracerState.m_events[tracerState.m_phaseStack[i]].m_name != phaseName) {
+            continue;
+        }
+
+        while(tracerState.m_phaseStack.size() > i) {
+            tracerState.m_events[tracerState.m_phaseStack.last()].m_endNsec = nowNsec;
+            tracerState.m_phaseStack.pop_back();
+        }
+
+        return;
+    }
+}
+
+void StartupTracer::beginAsyncPhase(const char * name)
+{
+    if (!m_active) {
+        return;
+    }
+
+    TracerState & tracerState = state();
+
+    TraceEvent event;
+    event.m_name = QByteArray(name);
+    event.m_type = TraceEvent::Type::AsyncPhase;
+    event.m_startNsec = tracerState.m_timer.nsecsElapsed();
+    tracerState.m_events << event;
+
+    ++tracerState.m_numAsyncPhasesInProgress;
+}
+
+void StartupTracer::endAsyncPhase(const char * name)
+{
+    if (!m_active) {
+        return;
+    }
+
+    TracerState & tracerState = state();
+    QByteArray phaseName(name);
+
+    for(int i = tracerState.m_events.size() - 1; i >= 0; --i)
+    {
+        TraceEvent & event = tracerState.m_events[i];
+        if ((event.m_type != TraceEvent::Type::AsyncPhase) || (event.m_endNsec >= 0) || (event.m_name != phaseName)) {
+            continue;
+        }
+
+        event.m_endNsec = tracerState.m_timer.nsecsElapsed();
+        --tracerState.m_numAsyncPhasesInProgress;
+        break;
+    }
+
+    if (tracerState.m_enteringEventLoop && (tracerState.m_numAsyncPhasesInProgress == 0)) {
+        finish();
+    }
+}
+
+void StartupTracer::milestone(const char * name)
+{
+    if (!m_active) {
+        return;
+    }
+
+    TracerState & tracerState = state();
+
+    TraceEvent event;
+    event.m_name = QByteArray(name);
+    event.m_type = TraceEvent::Type::Milestone;
+    event.m_startNsec = tracerState.m_timer.nsecsElapsed();
+    event.m_endNsec = event.m_startNsec;
+    tracerState.m_events << event;
+}
+
+void StartupTracer::onEnteringEventLoop()
+{
+    if (!m_active) {
+        return;
+    }
+
+    milestone("Entering the event loop");
+
+    TracerState & tracerState = state();
+    tracerState.m_enteringEventLoop = true;
+
+    if (tracerState.m_numAsyncPhasesInProgress == 0) {
+        finish();
+    }
+}
+
+void StartupTracer::finish()
+{
+    if (!m_active) {
+        return;
+    }
+
+    m_active = false;
+
+    TracerState & tracerState = state();
+    tracerState.m_finishNsec = tracerState.m_timer.nsecsElapsed();
+
+    for(auto it = tracerState.m_events.begin(), end = tracerState.m_events.end(); it != end; ++it)
+    {
+        if (it->m_endNsec < 0) {
+            it->m_endNsec = tracerState.m_finishNsec;
+            it->m_unfinished = true;
+        }
+    }
+
+    tracerState.m_phaseStack.clear();
+
+    if (tracerState.m_traceFilePath.isEmpty()) {
+        QNDEBUG(criticalPathSummary());
+        return;
+    }
+
+    QNINFO(criticalPathSummary());
+
+    ErrorString errorDescription;
+    if (!writeTraceFile(tracerState.m_traceFilePath, errorDescription)) {
+        QNWARNING(errorDescription << QStringLiteral(": ") << tracerState.m_traceFilePath);
+    }
+    else {
+        QNINFO(QStringLiteral("Wrote the startup trace to ") << tracerState.m_traceFilePath);
+    }
+}
+
+QString StartupTracer::criticalPathSummary()
+{
+    const TracerState & tracerState = state();
+    if (tracerState.m_finishNsec < 0) {
+        return QStringLiteral("The startup tracing is not finished yet");
+    }
+
+    const QVector<TraceEvent> & events = tracerState.m_events;
+
+    QString summary;
+    QTextStream strm(&summary);
+
+    strm << QStringLiteral("Startup critical path, ") << formatMsec(tracerState.m_finishNsec)
+         << QStringLiteral(" ms in total:\n");
+
+    QVector<CriticalPathItem> path = computeCriticalPath();
+    for(auto it = path.constBegin(), end = path.constEnd(); it != end; ++it)
+    {
+        const CriticalPathItem & item = *it;
+
+        strm << QStringLiteral("  ") << formatMsec(item.m_startNsec).rightJustified(9)
+             << QStringLiteral(" - ") << formatMsec(item.m_endNsec).rightJustified(9)
+             << QStringLiteral(" ms ") << formatMsec(item.m_endNsec - item.m_startNsec).rightJustified(9)
+             << QStringLiteral(" ms  ");
+
+        if (item.m_eventIndex < 0) {
+            strm << QStringLiteral("<untraced>\n");
+            continue;
+        }
+
+        const TraceEvent & event = events[item.m_eventIndex];
+        strm << eventDisplayName(event);
+        if (item.m_endNsec < event.m_endNsec) {
+            strm << QStringLiteral(" (until the next item started)");
+        }
+
+        strm << QStringLiteral("\n");
+
+        if (event.m_type != TraceEvent::Type::Phase) {
+            continue;
+        }
+
+        QVector<std::pair<qint64, int> > nestedPhases;
+        for(int i = 0, size = events.size(); i < size; ++i)
+        {
+            const TraceEvent & nestedEvent = events[i];
+            if ((nestedEvent.m_parentIndex == item.m_eventIndex) && (nestedEvent.m_startNsec < item.m_endNsec)) {
+                nestedPhases << std::make_pair(std::min(nestedEvent.m_endNsec, item.m_endNsec) - nestedEvent.m_startNsec, i);
+            }
+        }
+
+        std::sort(nestedPhases.begin(), nestedPhases.end());
+        std::reverse(nestedPhases.begin(), nestedPhases.end());
+
+        for(int i = 0, size = std::min(nestedPhases.size(), STARTUP_TRACER_NUM_LISTED_NESTED_PHASES); i < size; ++i) {
+            strm << QString(46, QChar::fromLatin1(' ')) << QStringLiteral("of which ")
+                 << eventDisplayName(events[nestedPhases[i].second]) << QStringLiteral(": ")
+                 << formatMsec(nestedPhases[i].first) << QStringLiteral(" ms\n");
+        }
+    }
+
+    bool foundMilestones = false;
+    for(auto it = events.constBegin(), end = events.constEnd(); it != end; ++it)
+    {
+        if (it->m_type != TraceEvent::Type::Milestone) {
+            continue;
+        }
+
+        if (!foundMilestones) {
+            strm << QStringLiteral("Milestones:\n");
+            foundMilestones = true;
+        }
+
+        strm << QStringLiteral("  ") << formatMsec(it->m_startNsec).rightJustified(9) << QStringLiteral(" ms  ")
+             << QString::fromUtf8(it->m_name) << QStringLiteral("\n");
+    }
+
+    strm.flush();
+    return summary;
+}
+
+bool StartupTracer::writeTraceFile(const QString & filePath, ErrorString & errorDescription)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        errorDescription.setBase(QT_TRANSLATE_NOOP("StartupTracer", "Can't open the startup trace file for writing"));
+        errorDescription.details() = file.errorString();
+        return false;
+    }
+
+    const QVector<TraceEvent> & events = state().m_events;
+
+    QTextStream strm(&file);
+    strm << "{\n  \"displayTimeUnit\": \"ms\",\n  \"traceEvents\": [\n";
+    strm << "    { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": { \"name\": \"GUI thread\" } }";
+
+    // Each asynchronous phase gets its own track since the asynchronous phases overlap arbitrarily
+    int asyncTrackId = 1;
+    for(auto it = events.constBegin(), end = events.constEnd(); it != end; ++it)
+    {
+        const TraceEvent & event = *it;
+        strm << ",\n    { \"name\": " << toJsonString(event.m_name) << ", \"cat\": \"startup\", \"pid\": 1, ";
+
+        switch(event.m_type)
+        {
+        case TraceEvent::Type::Phase:
+            strm << "\"tid\": 1, \"ph\": \"X\", \"ts\": " << nsecToJsonUsec(event.m_startNsec)
+                 << ", \"dur\": " << nsecToJsonUsec(event.m_endNsec - event.m_startNsec) << " }";
+            break;
+        case TraceEvent::Type::AsyncPhase:
+            ++asyncTrackId;
+            strm << "\"tid\": " << asyncTrackId << ", \"ph\": \"X\", \"ts\": " << nsecToJsonUsec(event.m_startNsec)
+                 << ", \"dur\": " << nsecToJsonUsec(event.m_endNsec - event.m_startNsec)
+                 << ", \"args\": { \"unfinished\": " << (event.m_unfinished ? "true" : "false") << " } },\n";
+            strm << "    { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << asyncTrackId
+                 << ", \"args\": { \"name\": " << toJsonString(event.m_name) << " } }";
+            break;
+        case TraceEvent::Type::Milestone:
+            strm << "\"tid\": 1, \"ph\": \"i\", \"s\": \"g\", \"ts\": " << nsecToJsonUsec(event.m_startNsec) << " }";
+            break;
+        }
+    }
+
+    strm << "\n  ]\n}\n";
+    strm.flush();
+
+    if (file.error() != QFile::NoError) {
+        errorDescription.setBase(QT_TRANSLATE_NOOP("StartupTracer", "Failed to write the startup trace file"));
+        errorDescription.details() = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+StartupTracer::Phase::Phase(const char * name) :
+    m_name(name)
+{
+    StartupTracer::beginPhase(m_name);
+}
+
+StartupTracer::Phase::~Phase()
+{
+    StartupTracer::endPhase(m_name);
+}
+
+} // namespace quentier
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_INITIALIZATION_STARTUP_TRACER_H
+#define QUENTIER_INITIALIZATION_STARTUP_TRACER_H
+
+#include <quentier/utility/Macros.h>
+#include <quentier/types/ErrorString.h>
+#include <QString>
+
+namespace quentier {
+
+/**
+ * @brief The StartupTracer class timestamps the phases of the app's startup: the synchronous ones done
+ * by the GUI thread (possibly nested into each other) and the asynchronous ones, like the initial listing
+ * of the models' items from the local storage, which overlap with the synchronous ones.
+ *
+ * The startup is considered finished once the GUI thread is about to enter the main event loop and all
+ * the asynchronous phases have ended. At that point the critical path of the startup is computed
+ * and, if the trace file path was set, the trace is written to that file in Chrome trace event format
+ * (viewable via chrome://tracing) and the critical path summary is logged.
+ *
+ * The tracing costs a single check of a static flag after the startup is finished. The class is intended
+ * to be used from the GUI thread only.
+ */
+class StartupTracer
+{
+public:
+    /**
+     * @brief start - marks the beginning of the startup, should be called at the very beginning of main
+     */
+    static void start();
+
+    static bool isActive() { return m_active; }
+
+    /**
+     * @brief setTraceFilePath - requests writing the trace into the specified file once the startup is finished
+     */
+    static void setTraceFilePath(const QString & filePath);
+
+    static void beginPhase(const char * name);
+    static void endPhase(const char * name);
+
+    /**
+     * The asynchronous phases are identified by their names so the name must be unique among the asynchronous
+     * phases in progress
+     */
+    static void beginAsyncPhase(const char * name);
+    static void endAsyncPhase(const char * name);
+
+    static void milestone(const char * name);
+
+    /**
+     * @brief onEnteringEventLoop - to be called right before the main event loop is started: the startup
+     * is finished as soon as there are no asynchronous phases in progress
+     */
+    static void onEnteringEventLoop();
+
+    /**
+     * @brief finish - finishes the startup tracing regardless of asynchronous phases still in progress,
+     * does nothing if the tracing is already finished
+     */
+    static void finish();
+
+    static QString criticalPathSummary();
+    static bool writeTraceFile(const QString & filePath, ErrorString & errorDescription);
+
+    /**
+     * @brief The Phase class begins the synchronous startup phase in its constructor and ends it in its destructor
+     */
+    class Phase
+    {
+    public:
+        explicit Phase(const char * name);
+        ~Phase();
+
+    private:
+        Q_DISABLE_COPY(Phase)
+
+    private:
+        const char *    m_name;
+    };
+
+private:
+    StartupTracer() Q_DECL_EQ_DELETE;
+    Q_DISABLE_COPY(StartupTracer)
+
+private:
+    static bool m_active;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_INITIALIZATION_STARTUP_TRACER_H
@@ -20,6 +20,8 @@
 #include "SystemTrayIconManager.h"
 #include "initialization/Initialize.h"
 #include "initialization/LoadDependencies.h"
+#include "initialization/StartupTracer.h"
+#include "initialization/StartupTaskGraph.h"
 #include <quentier/utility/QuentierApplication.h>
 #include <quentier/utility/MessageBox.h>
 #include <quentier/logging/QuentierLogger.h>
@@ -34,11 +36,19 @@ using namespace quentier;
 
 int main(int argc, char *argv[])
 {
+    StartupTracer::start();
+
     // Loading the dependencies manually - required on Windows
-    loadDependencies();
+    {
+        StartupTracer::Phase phase("Load dependencies");
+        loadDependencies();
+    }
 
     ParseCommandLineResult parseCmdResult;
-    parseCommandLine(argc, argv, parseCmdResult);
+    {
+        StartupTracer::Phase phase("Parse command line");
+        parseCommandLine(argc, argv, parseCmdResult);
+    }
     if (parseCmdResult.m_shouldQuit)
     {
         if (!parseCmdResult.m_errorDescription.isEmpty()) {
@@ -50,12 +60,23 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    StartupTracer::beginPhase("Create application");
     QuentierApplication app(argc, argv);
     app.setOrganizationName(QStringLiteral("quentier.org"));
     app.setApplicationName(QStringLiteral("Quentier"));
     app.setQuitOnLastWindowClosed(false);
+    StartupTracer::endPhase("Create application");
+
+    // The graph runs the parts of initialization not requiring the GUI thread on the worker threads
+    // until the main window is shown
+    QScopedPointer<StartupTaskGraph> pStartupTaskGraph(new StartupTaskGraph);
+
+    bool res = false;
+    {
+        StartupTracer::Phase phase("Initialize");
+        res = initialize(app, parseCmdResult.m_cmdOptions);
+    }
 
-    bool res = initialize(app, parseCmdResult.m_cmdOptions);
     if (!res) {
         return 1;
     }
@@ -64,7 +85,12 @@ int main(int argc, char *argv[])
 
     try
     {
-        pMainWindow.reset(new MainWindow);
+        {
+            StartupTracer::Phase phase("Construct main window");
+            pMainWindow.reset(new MainWindow);
+        }
+
+        StartupTracer::Phase showMainWindowPhase("Show main window");
 
         bool shouldStartMinimizedToSystemTray = false;
         auto startMinimizedToTrayIt = parseCmdResult.m_cmdOptions.find(QStringLiteral("startMinimizedToTray"));
@@ -135,5 +161,12 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    return app.exec();
+    pStartupTaskGraph.reset();
+
+    StartupTracer::onEnteringEventLoop();
+    int result = app.exec();
+
+    // The startup might have never finished if some of the models failed to list their items
+    StartupTracer::finish();
+    return result;
 }
@@ -17,6 +17,7 @@
  */
 
 #include "FavoritesModel.h"
+#include "ModelInstrumentation.h"
 #include "NoteModel.h"
 #include <quentier/logging/QuentierLogger.h>
 
@@ -55,7 +56,7 @@ FavoritesModel::FavoritesModel(const Account & account, const NoteModel & noteMo
     m_updateNoteRequestIds(),
     m_findNoteToRestoreFailedUpdateRequestIds(),
     m_findNoteToPerformUpdateRequestIds(),
-    m_findNoteToUnfavoriteRequestIds(),
+    m_pendingNoteFieldsUpdatesByNoteLocalUid(),
     m_updateNotebookRequestIds(),
     m_findNotebookToRestoreFailedUpdateRequestIds(),
     m_findNotebookToPerformUpdateRequestIds(),
@@ -76,6 +77,7 @@ FavoritesModel::FavoritesModel(const Account & account, const NoteModel & noteMo
     m_receivedTagLocalUidsForAllNotes(false),
     m_notebookLocalUidToNoteCountRequestIdBimap(),
     m_tagLocalUidToNoteCountRequestIdBimap(),
+    m_noteCountsBySavedSearchLocalUid(),
     m_sortedColumn(Columns::DisplayName),
     m_sortOrder(Qt::AscendingOrder),
     m_allItemsListed(false)
@@ -675,12 +677,16 @@ void FavoritesModel::onAllNotesListed()
 
 void FavoritesModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onAddNoteComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onAddNoteComplete: note = ") << note << QStringLiteral("\nRequest id = ") << requestId);
     onNoteAddedOrUpdated(note);
 }
 
 void FavoritesModel::onUpdateNoteComplete(Note note, bool updateResources, bool updateTags, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateNoteComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onUpdateNoteComplete: note = ") << note << QStringLiteral("\nUpdate resources = ")
             << (updateResources ? QStringLiteral("true") : QStringLiteral("false")) << QStringLiteral(", update tags = ")
             << (updateTags ? QStringLiteral("true") : QStringLiteral("false")) << QStringLiteral(", request id = ") << requestId);
@@ -697,6 +703,8 @@ void FavoritesModel::onUpdateNoteComplete(Note note, bool updateResources, bool
 void FavoritesModel::onUpdateNoteFailed(Note note, bool updateResources, bool updateTags,
                                         ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateNoteFailed", requestId);
+
     auto it = m_updateNoteRequestIds.find(requestId);
     if (it == m_updateNoteRequestIds.end()) {
         return;
@@ -713,18 +721,19 @@ void FavoritesModel::onUpdateNoteFailed(Note note, bool updateResources, bool up
     Q_UNUSED(m_findNoteToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to find a note: local uid = ") << note.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findNote");
     Q_EMIT findNote(note, /* with resource metadata = */ true, /* with resource binary data = */ false, requestId);
 }
 
 void FavoritesModel::onFindNoteComplete(Note note, bool withResourceMetadata, bool withResourceBinaryData, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindNoteComplete", requestId);
+
     auto restoreUpdateIt = m_findNoteToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNoteToPerformUpdateRequestIds.find(requestId);
-    auto unfavoriteIt = m_findNoteToUnfavoriteRequestIds.find(requestId);
 
     if ((restoreUpdateIt == m_findNoteToRestoreFailedUpdateRequestIds.end()) &&
-        (performUpdateIt == m_findNoteToPerformUpdateRequestIds.end()) &&
-        (unfavoriteIt == m_findNoteToUnfavoriteRequestIds.end()))
+        (performUpdateIt == m_findNoteToPerformUpdateRequestIds.end()))
     {
         return;
     }
@@ -743,30 +752,25 @@ void FavoritesModel::onFindNoteComplete(Note note, bool withResourceMetadata, bo
         Q_UNUSED(m_findNoteToPerformUpdateRequestIds.erase(performUpdateIt))
         m_noteCache.put(note.localUid(), note);
 
-        FavoritesDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
-        auto it = localUidIndex.find(note.localUid());
-        if (it != localUidIndex.end()) {
-            updateItemInLocalStorage(*it);
+        auto pendingUpdateIt = m_pendingNoteFieldsUpdatesByNoteLocalUid.find(note.localUid());
+        if (pendingUpdateIt != m_pendingNoteFieldsUpdatesByNoteLocalUid.end()) {
+            NoteFieldsUpdate update = pendingUpdateIt.value();
+            Q_UNUSED(m_pendingNoteFieldsUpdatesByNoteLocalUid.erase(pendingUpdateIt))
+            updateNoteFieldsInLocalStorage(note.localUid(), update);
         }
     }
-    else if (unfavoriteIt != m_findNoteToUnfavoriteRequestIds.end())
-    {
-        Q_UNUSED(m_findNoteToUnfavoriteRequestIds.erase(unfavoriteIt))
-        m_noteCache.put(note.localUid(), note);
-        unfavoriteNote(note.localUid());
-    }
 }
 
 void FavoritesModel::onFindNoteFailed(Note note, bool withResourceMetadata, bool withResourceBinaryData,
                                       ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindNoteFailed", requestId);
+
     auto restoreUpdateIt = m_findNoteToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNoteToPerformUpdateRequestIds.find(requestId);
-    auto unfavoriteIt = m_findNoteToUnfavoriteRequestIds.find(requestId);
 
     if ((restoreUpdateIt == m_findNoteToRestoreFailedUpdateRequestIds.end()) &&
-        (performUpdateIt == m_findNoteToPerformUpdateRequestIds.end()) &&
-        (unfavoriteIt == m_findNoteToUnfavoriteRequestIds.end()))
+        (performUpdateIt == m_findNoteToPerformUpdateRequestIds.end()))
     {
         return;
     }
@@ -781,9 +785,7 @@ void FavoritesModel::onFindNoteFailed(Note note, bool withResourceMetadata, bool
     }
     else if (performUpdateIt != m_findNoteToPerformUpdateRequestIds.end()) {
         Q_UNUSED(m_findNoteToPerformUpdateRequestIds.erase(performUpdateIt))
-    }
-    else if (unfavoriteIt != m_findNoteToUnfavoriteRequestIds.end()) {
-        Q_UNUSED(m_findNoteToUnfavoriteRequestIds.erase(unfavoriteIt))
+        Q_UNUSED(m_pendingNoteFieldsUpdatesByNoteLocalUid.remove(note.localUid()))
     }
 
     Q_EMIT notifyError(errorDescription);
@@ -795,6 +797,8 @@ void FavoritesModel::onListNotesComplete(LocalStorageManager::ListObjectsOptions
                                          LocalStorageManager::OrderDirection::type orderDirection, QString linkedNotebookGuid,
                                          QList<Note> foundNotes, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListNotesComplete", requestId);
+
     if (requestId != m_listNotesRequestId) {
         return;
     }
@@ -828,6 +832,8 @@ void FavoritesModel::onListNotesFailed(LocalStorageManager::ListObjectsOptions f
                                        LocalStorageManager::OrderDirection::type orderDirection, QString linkedNotebookGuid,
                                        ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListNotesFailed", requestId);
+
     if (requestId != m_listNotesRequestId) {
         return;
     }
@@ -846,6 +852,8 @@ void FavoritesModel::onListNotesFailed(LocalStorageManager::ListObjectsOptions f
 
 void FavoritesModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onExpungeNoteComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onExpungeNoteComplete: note = ") << note << QStringLiteral("\nRequest id = ")
             << requestId);
 
@@ -857,6 +865,8 @@ void FavoritesModel::onExpungeNoteComplete(Note note, QUuid requestId)
 
 void FavoritesModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onAddNotebookComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onAddNotebookComplete: notebook = ") << notebook << QStringLiteral(", request id = ")
             << requestId);
     onNotebookAddedOrUpdated(notebook);
@@ -864,6 +874,8 @@ void FavoritesModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 
 void FavoritesModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateNotebookComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onUpdateNotebookComplete: notebook = ") << notebook
             << QStringLiteral(", request id = ") << requestId);
 
@@ -878,6 +890,8 @@ void FavoritesModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId
 
 void FavoritesModel::onUpdateNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateNotebookFailed", requestId);
+
     auto it = m_updateNotebookRequestIds.find(requestId);
     if (it == m_updateNotebookRequestIds.end()) {
         return;
@@ -892,11 +906,14 @@ void FavoritesModel::onUpdateNotebookFailed(Notebook notebook, ErrorString error
     Q_UNUSED(m_findNotebookToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to find a notebook: local uid = ") << notebook.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findNotebook");
     Q_EMIT findNotebook(notebook, requestId);
 }
 
 void FavoritesModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindNotebookComplete", requestId);
+
     auto restoreUpdateIt = m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findNotebookToUnfavoriteRequestIds.find(requestId);
@@ -936,6 +953,8 @@ void FavoritesModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 
 void FavoritesModel::onFindNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindNotebookFailed", requestId);
+
     auto restoreUpdateIt = m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findNotebookToUnfavoriteRequestIds.find(requestId);
@@ -970,6 +989,8 @@ void FavoritesModel::onListNotebooksComplete(LocalStorageManager::ListObjectsOpt
                                              QString linkedNotebookGuid, QList<Notebook> foundNotebooks,
                                              QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListNotebooksComplete", requestId);
+
     if (requestId != m_listNotebooksRequestId) {
         return;
     }
@@ -1002,6 +1023,8 @@ void FavoritesModel::onListNotebooksFailed(LocalStorageManager::ListObjectsOptio
                                            LocalStorageManager::OrderDirection::type orderDirection,
                                            QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListNotebooksFailed", requestId);
+
     if (requestId != m_listNotebooksRequestId) {
         return;
     }
@@ -1019,6 +1042,8 @@ void FavoritesModel::onListNotebooksFailed(LocalStorageManager::ListObjectsOptio
 
 void FavoritesModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onExpungeNotebookComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onExpungeNotebookComplete: notebook = ") << notebook
             << QStringLiteral("\nRequest id = ") << requestId);
     removeItemByLocalUid(notebook.localUid());
@@ -1026,12 +1051,16 @@ void FavoritesModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestI
 
 void FavoritesModel::onAddTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onAddTagComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onAddTagComplete: tag = ") << tag << QStringLiteral("\nRequest id = ") << requestId);
     onTagAddedOrUpdated(tag);
 }
 
 void FavoritesModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateTagComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onUpdateTagComplete: tag = ") << tag << QStringLiteral("\nRequest id = ") << requestId);
 
     auto it = m_updateTagRequestIds.find(requestId);
@@ -1045,6 +1074,8 @@ void FavoritesModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 
 void FavoritesModel::onUpdateTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateTagFailed", requestId);
+
     auto it = m_updateTagRequestIds.find(requestId);
     if (it == m_updateTagRequestIds.end()) {
         return;
@@ -1059,11 +1090,14 @@ void FavoritesModel::onUpdateTagFailed(Tag tag, ErrorString errorDescription, QU
     Q_UNUSED(m_findTagToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to find a tag: local uid = ") << tag.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findTag");
     Q_EMIT findTag(tag, requestId);
 }
 
 void FavoritesModel::onFindTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindTagComplete", requestId);
+
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findTagToUnfavoriteRequestIds.find(requestId);
@@ -1102,6 +1136,8 @@ void FavoritesModel::onFindTagComplete(Tag tag, QUuid requestId)
 
 void FavoritesModel::onFindTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindTagFailed", requestId);
+
 
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
@@ -1136,6 +1172,8 @@ void FavoritesModel::onListTagsComplete(LocalStorageManager::ListObjectsOptions
                                         LocalStorageManager::OrderDirection::type orderDirection,
                                         QString linkedNotebookGuid, QList<Tag> foundTags, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListTagsComplete", requestId);
+
     if (requestId != m_listTagsRequestId) {
         return;
     }
@@ -1168,6 +1206,8 @@ void FavoritesModel::onListTagsFailed(LocalStorageManager::ListObjectsOptions fl
                                       LocalStorageManager::OrderDirection::type orderDirection,
                                       QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListTagsFailed", requestId);
+
     if (requestId != m_listTagsRequestId) {
         return;
     }
@@ -1185,6 +1225,8 @@ void FavoritesModel::onListTagsFailed(LocalStorageManager::ListObjectsOptions fl
 
 void FavoritesModel::onExpungeTagComplete(Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onExpungeTagComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onExpungeTagComplete: tag = ") << tag
             << QStringLiteral("\nExpunged child tag local uids: ") << expungedChildTagLocalUids.join(QStringLiteral(", "))
             << QStringLiteral(", request id = ") << requestId);
@@ -1198,12 +1240,16 @@ void FavoritesModel::onExpungeTagComplete(Tag tag, QStringList expungedChildTagL
 
 void FavoritesModel::onAddSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onAddSavedSearchComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onAddSavedSearchComplete: ") << search << QStringLiteral("\nRequest id = ") << requestId);
     onSavedSearchAddedOrUpdated(search);
 }
 
 void FavoritesModel::onUpdateSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateSavedSearchComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onUpdateSavedSearchComplete: ") << search << QStringLiteral("\nRequest id = ") << requestId);
 
     auto it = m_updateSavedSearchRequestIds.find(requestId);
@@ -1217,6 +1263,8 @@ void FavoritesModel::onUpdateSavedSearchComplete(SavedSearch search, QUuid reque
 
 void FavoritesModel::onUpdateSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onUpdateSavedSearchFailed", requestId);
+
     auto it = m_updateSavedSearchRequestIds.find(requestId);
     if (it == m_updateSavedSearchRequestIds.end()) {
         return;
@@ -1231,11 +1279,14 @@ void FavoritesModel::onUpdateSavedSearchFailed(SavedSearch search, ErrorString e
     Q_UNUSED(m_findSavedSearchToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to find the saved search: local uid = ") << search.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findSavedSearch");
     Q_EMIT findSavedSearch(search, requestId);
 }
 
 void FavoritesModel::onFindSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindSavedSearchComplete", requestId);
+
     auto restoreUpdateIt = m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findSavedSearchToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findSavedSearchToUnfavoriteRequestIds.find(requestId);
@@ -1275,6 +1326,8 @@ void FavoritesModel::onFindSavedSearchComplete(SavedSearch search, QUuid request
 
 void FavoritesModel::onFindSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onFindSavedSearchFailed", requestId);
+
     auto restoreUpdateIt = m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findSavedSearchToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findSavedSearchToUnfavoriteRequestIds.find(requestId);
@@ -1308,6 +1361,8 @@ void FavoritesModel::onListSavedSearchesComplete(LocalStorageManager::ListObject
                                                  LocalStorageManager::OrderDirection::type orderDirection,
                                                  QList<SavedSearch> foundSearches, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListSavedSearchesComplete", requestId);
+
     if (requestId != m_listSavedSearchesRequestId) {
         return;
     }
@@ -1339,6 +1394,8 @@ void FavoritesModel::onListSavedSearchesFailed(LocalStorageManager::ListObjectsO
                                                LocalStorageManager::OrderDirection::type orderDirection,
                                                ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onListSavedSearchesFailed", requestId);
+
     if (requestId != m_listSavedSearchesRequestId) {
         return;
     }
@@ -1354,13 +1411,18 @@ void FavoritesModel::onListSavedSearchesFailed(LocalStorageManager::ListObjectsO
 
 void FavoritesModel::onExpungeSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onExpungeSavedSearchComplete", requestId);
+
     QNDEBUG(QStringLiteral("FavoritesModel::onExpungeSavedSearchComplete: search = ") << search
             << QStringLiteral("\nRequest id = ") << requestId);
+    Q_UNUSED(m_noteCountsBySavedSearchLocalUid.remove(search.localUid()))
     removeItemByLocalUid(search.localUid());
 }
 
 void FavoritesModel::onGetNoteCountPerNotebookComplete(int noteCount, Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onGetNoteCountPerNotebookComplete", requestId);
+
     auto it = m_notebookLocalUidToNoteCountRequestIdBimap.right.find(requestId);
     if (it == m_notebookLocalUidToNoteCountRequestIdBimap.right.end()) {
         return;
@@ -1386,6 +1448,8 @@ void FavoritesModel::onGetNoteCountPerNotebookComplete(int noteCount, Notebook n
 
 void FavoritesModel::onGetNoteCountPerNotebookFailed(ErrorString errorDescription, Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onGetNoteCountPerNotebookFailed", requestId);
+
     auto it = m_notebookLocalUidToNoteCountRequestIdBimap.right.find(requestId);
     if (it == m_notebookLocalUidToNoteCountRequestIdBimap.right.end()) {
         return;
@@ -1402,6 +1466,8 @@ void FavoritesModel::onGetNoteCountPerNotebookFailed(ErrorString errorDescriptio
 
 void FavoritesModel::onGetNoteCountPerTagComplete(int noteCount, Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onGetNoteCountPerTagComplete", requestId);
+
     auto it = m_tagLocalUidToNoteCountRequestIdBimap.right.find(requestId);
     if (it == m_tagLocalUidToNoteCountRequestIdBimap.right.end()) {
         return;
@@ -1427,6 +1493,8 @@ void FavoritesModel::onGetNoteCountPerTagComplete(int noteCount, Tag tag, QUuid
 
 void FavoritesModel::onGetNoteCountPerTagFailed(ErrorString errorDescription, Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("FavoritesModel::onGetNoteCountPerTagFailed", requestId);
+
     auto it = m_tagLocalUidToNoteCountRequestIdBimap.right.find(requestId);
     if (it == m_tagLocalUidToNoteCountRequestIdBimap.right.end()) {
         return;
@@ -1441,6 +1509,58 @@ void FavoritesModel::onGetNoteCountPerTagFailed(ErrorString errorDescription, Ta
     Q_EMIT notifyError(errorDescription);
 }
 
+void FavoritesModel::connectToLocalStorage(const NoteModel & noteModel, LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("FavoritesModel::connectToLocalStorage"));
+    createConnections(noteModel, localStorageManagerAsync);
+}
+
+void FavoritesModel::disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("FavoritesModel::disconnectFromLocalStorage"));
+    QObject::disconnect(this, Q_NULLPTR, &localStorageManagerAsync, Q_NULLPTR);
+    QObject::disconnect(&localStorageManagerAsync, Q_NULLPTR, this, Q_NULLPTR);
+}
+
+bool FavoritesModel::hasPendingRequests() const
+{
+    return !m_listNotesRequestId.isNull() || !m_listNotebooksRequestId.isNull() || !m_listTagsRequestId.isNull() ||
+           !m_listSavedSearchesRequestId.isNull() || !m_updateNoteRequestIds.isEmpty() ||
+           !m_findNoteToRestoreFailedUpdateRequestIds.isEmpty() || !m_findNoteToPerformUpdateRequestIds.isEmpty() ||
+           !m_updateNotebookRequestIds.isEmpty() || !m_findNotebookToRestoreFailedUpdateRequestIds.isEmpty() ||
+           !m_findNotebookToPerformUpdateRequestIds.isEmpty() || !m_findNotebookToUnfavoriteRequestIds.isEmpty() ||
+           !m_updateTagRequestIds.isEmpty() || !m_findTagToRestoreFailedUpdateRequestIds.isEmpty() ||
+           !m_findTagToPerformUpdateRequestIds.isEmpty() || !m_findTagToUnfavoriteRequestIds.isEmpty() ||
+           !m_updateSavedSearchRequestIds.isEmpty() || !m_findSavedSearchToRestoreFailedUpdateRequestIds.isEmpty() ||
+           !m_findSavedSearchToPerformUpdateRequestIds.isEmpty() || !m_findSavedSearchToUnfavoriteRequestIds.isEmpty() ||
+           !m_pendingNoteFieldsUpdatesByNoteLocalUid.isEmpty() || !m_notebookLocalUidToNoteCountRequestIdBimap.empty() ||
+           !m_tagLocalUidToNoteCountRequestIdBimap.empty();
+}
+
+void FavoritesModel::setSavedSearchNoteCount(QString savedSearchLocalUid, int noteCount)
+{
+    QNTRACE(QStringLiteral("FavoritesModel::setSavedSearchNoteCount: saved search local uid = ") << savedSearchLocalUid
+            << QStringLiteral(", note count = ") << noteCount);
+
+    // The count is remembered even if the saved search is not favorited: it might become favorited later
+    m_noteCountsBySavedSearchLocalUid[savedSearchLocalUid] = noteCount;
+
+    FavoritesDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    auto itemIt = localUidIndex.find(savedSearchLocalUid);
+    if (itemIt == localUidIndex.end()) {
+        return;
+    }
+
+    if (itemIt->numNotesTargeted() == noteCount) {
+        return;
+    }
+
+    FavoritesModelItem item = *itemIt;
+    item.setNumNotesTargeted(noteCount);
+    Q_UNUSED(localUidIndex.replace(itemIt, item))
+    updateItemColumnInView(item, Columns::NumNotesTargeted);
+}
+
 void FavoritesModel::createConnections(const NoteModel & noteModel, LocalStorageManagerAsync & localStorageManagerAsync)
 {
     QNDEBUG(QStringLiteral("FavoritesModel::createConnections"));
@@ -1614,6 +1734,7 @@ void FavoritesModel::requestNotesList()
 
     m_listNotesRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list notes: offset = ") << m_listNotesOffset << QStringLiteral(", request id = ") << m_listNotesRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listNotesRequestId, "FavoritesModel::listNotes");
     Q_EMIT listNotes(flags, /* with resource metadata = */ false, /* with resource binary data = */ false,
                      NOTE_LIST_LIMIT, m_listNotesOffset, order, direction, QString(), m_listNotesRequestId);
 }
@@ -1631,6 +1752,7 @@ void FavoritesModel::requestNotebooksList()
     m_listNotebooksRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list notebooks: offset = ") << m_listNotebooksOffset
             << QStringLiteral(", request id = ") << m_listNotebooksRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listNotebooksRequestId, "FavoritesModel::listNotebooks");
     Q_EMIT listNotebooks(flags, NOTEBOOK_LIST_LIMIT, m_listNotebooksOffset, order, direction, QString(), m_listNotebooksRequestId);
 }
 
@@ -1647,6 +1769,7 @@ void FavoritesModel::requestTagsList()
     m_listTagsRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list tags: offset = ") << m_listTagsOffset
             << QStringLiteral(", request id = ") << m_listTagsRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listTagsRequestId, "FavoritesModel::listTags");
     Q_EMIT listTags(flags, TAG_LIST_LIMIT, m_listTagsOffset, order, direction, QString(), m_listTagsRequestId);
 }
 
@@ -1663,6 +1786,7 @@ void FavoritesModel::requestSavedSearchesList()
     m_listSavedSearchesRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list saved searches: offset = ") << m_listSavedSearchesOffset
             << QStringLiteral(", request id = ") << m_listSavedSearchesRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listSavedSearchesRequestId, "FavoritesModel::listSavedSearches");
     Q_EMIT listSavedSearches(flags, SAVED_SEARCH_LIST_LIMIT, m_listSavedSearchesOffset,
                            order, direction, m_listSavedSearchesRequestId);
 }
@@ -2007,27 +2131,30 @@ void FavoritesModel::updateItemRowWithRespectToSorting(const FavoritesModelItem
         return;
     }
 
-    FavoritesModelItem itemCopy(item);
+    Comparator comparator(m_sortedColumn, m_sortOrder);
 
-    beginRemoveRows(QModelIndex(), originalRow, originalRow);
-    Q_UNUSED(rowIndex.erase(it))
-    endRemoveRows();
+    // The rest of the items are still sorted, so if the item is in order with respect to its neighbours,
+    // it is already at the appropriate row
+    bool inOrderWithPrevious = ((it == rowIndex.begin()) || !comparator(item, *(it - 1)));
+    bool inOrderWithNext = ((it + 1 == rowIndex.end()) || !comparator(*(it + 1), item));
+    if (inOrderWithPrevious && inOrderWithNext) {
+        return;
+    }
 
-    auto positionIter = std::lower_bound(rowIndex.begin(), rowIndex.end(), itemCopy,
-                                         Comparator(m_sortedColumn, m_sortOrder));
-    if (positionIter == rowIndex.end())
-    {
-        int row = static_cast<int>(rowIndex.size());
-        beginInsertRows(QModelIndex(), row, row);
-        rowIndex.push_back(itemCopy);
-        endInsertRows();
+    auto positionIter = (inOrderWithPrevious
+                         ? std::lower_bound(it + 1, rowIndex.end(), item, comparator)
+                         : std::lower_bound(rowIndex.begin(), it, item, comparator));
+    int destinationRow = static_cast<int>(std::distance(rowIndex.begin(), positionIter));
+
+    bool res = beginMoveRows(QModelIndex(), originalRow, originalRow, QModelIndex(), destinationRow);
+    if (Q_UNLIKELY(!res)) {
+        QNWARNING(QStringLiteral("Internal error, can't move row within the favorites model for sorting purposes: from row ")
+                  << originalRow << QStringLiteral(" to the position before row ") << destinationRow);
         return;
     }
 
-    int row = static_cast<int>(std::distance(rowIndex.begin(), positionIter));
-    beginInsertRows(QModelIndex(), row, row);
-    Q_UNUSED(rowIndex.insert(positionIter, itemCopy))
-    endInsertRows();
+    rowIndex.relocate(positionIter, it);
+    endMoveRows();
 }
 
 void FavoritesModel::updateItemInLocalStorage(const FavoritesModelItem & item)
@@ -2060,25 +2187,45 @@ void FavoritesModel::updateNoteInLocalStorage(const FavoritesModelItem & item)
     QNDEBUG(QStringLiteral("FavoritesModel::updateNoteInLocalStorage: local uid = ") << item.localUid()
             << QStringLiteral(", title = ") << item.displayName());
 
-    const Note * pCachedNote = m_noteCache.get(item.localUid());
+    NoteFieldsUpdate update;
+    update.setTitle(item.displayName());
+    update.setDirty(true);
+    updateNoteFieldsInLocalStorage(item.localUid(), update);
+}
+
+void FavoritesModel::updateNoteFieldsInLocalStorage(const QString & noteLocalUid, const NoteFieldsUpdate & update)
+{
+    QNTRACE(QStringLiteral("FavoritesModel::updateNoteFieldsInLocalStorage: local uid = ") << noteLocalUid
+            << QStringLiteral(", update: ") << update);
+
+    auto pendingUpdateIt = m_pendingNoteFieldsUpdatesByNoteLocalUid.find(noteLocalUid);
+    if (pendingUpdateIt != m_pendingNoteFieldsUpdatesByNoteLocalUid.end()) {
+        QNTRACE(QStringLiteral("The note is already being looked up in the local storage, merging the updates"));
+        pendingUpdateIt->merge(update);
+        return;
+    }
+
+    const Note * pCachedNote = m_noteCache.get(noteLocalUid);
     if (Q_UNLIKELY(!pCachedNote))
     {
+        Q_UNUSED(m_pendingNoteFieldsUpdatesByNoteLocalUid.insert(noteLocalUid, update))
+
         QUuid requestId = QUuid::createUuid();
         Q_UNUSED(m_findNoteToPerformUpdateRequestIds.insert(requestId))
         Note dummy;
-        dummy.setLocalUid(item.localUid());
-        QNTRACE(QStringLiteral("Emitting the request to find a note: local uid = ") << item.localUid()
+        dummy.setLocalUid(noteLocalUid);
+        QNTRACE(QStringLiteral("Emitting the request to find a note: local uid = ") << noteLocalUid
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findNote");
         Q_EMIT findNote(dummy, /* with resource metadata = */ true, /* with resource binary data = */ false, requestId);
         return;
     }
 
     Note note = *pCachedNote;
-
-    note.setLocalUid(item.localUid());
-    bool dirty = note.isDirty() || !note.hasTitle() || (note.title() != item.displayName());
-    note.setDirty(dirty);
-    note.setTitle(item.displayName());
+    if (!update.apply(note)) {
+        QNDEBUG(QStringLiteral("The update doesn't change the note, nothing to write to the local storage"));
+        return;
+    }
 
     QUuid requestId = QUuid::createUuid();
     Q_UNUSED(m_updateNoteRequestIds.insert(requestId))
@@ -2089,7 +2236,8 @@ void FavoritesModel::updateNoteInLocalStorage(const FavoritesModelItem & item)
 
     QNTRACE(QStringLiteral("Emitting the request to update the note in local storage: id = ")
             << requestId << QStringLiteral(", note: ") << note);
-    Q_EMIT updateNote(note, /* update resources = */ false, /* update tags = */ false, requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::updateNote");
+    Q_EMIT updateNote(note, /* update resources = */ false, /* update tags = */ update.updatesTags(), requestId);
 }
 
 void FavoritesModel::updateNotebookInLocalStorage(const FavoritesModelItem & item)
@@ -2106,6 +2254,7 @@ void FavoritesModel::updateNotebookInLocalStorage(const FavoritesModelItem & ite
         dummy.setLocalUid(item.localUid());
         QNTRACE(QStringLiteral("Emitting the request to find a notebook: local uid = ") << item.localUid()
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findNotebook");
         Q_EMIT findNotebook(dummy, requestId);
         return;
     }
@@ -2126,6 +2275,7 @@ void FavoritesModel::updateNotebookInLocalStorage(const FavoritesModelItem & ite
 
     QNTRACE(QStringLiteral("Emitting the request to update the notebook in local storage: id = ") << requestId
             << QStringLiteral(", notebook: ") << notebook);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::updateNotebook");
     Q_EMIT updateNotebook(notebook, requestId);
 }
 
@@ -2143,6 +2293,7 @@ void FavoritesModel::updateTagInLocalStorage(const FavoritesModelItem & item)
         dummy.setLocalUid(item.localUid());
         QNTRACE(QStringLiteral("Emitting the request to find a tag: local uid = ") << item.localUid()
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findTag");
         Q_EMIT findTag(dummy, requestId);
         return;
     }
@@ -2163,6 +2314,7 @@ void FavoritesModel::updateTagInLocalStorage(const FavoritesModelItem & item)
 
     QNTRACE(QStringLiteral("Emitting the request to update the tag in local storage: id = ") << requestId
             << QStringLiteral(", tag: ") << tag);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::updateTag");
     Q_EMIT updateTag(tag, requestId);
 }
 
@@ -2180,6 +2332,7 @@ void FavoritesModel::updateSavedSearchInLocalStorage(const FavoritesModelItem &
         dummy.setLocalUid(item.localUid());
         QNTRACE(QStringLiteral("Emitting the request to find a saved search: local uid = ") << item.localUid()
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findSavedSearch");
         Q_EMIT findSavedSearch(dummy, requestId);
         return;
     }
@@ -2200,6 +2353,7 @@ void FavoritesModel::updateSavedSearchInLocalStorage(const FavoritesModelItem &
 
     QNTRACE(QStringLiteral("Emitting the request to update the saved search in local storage: id = ")
             << requestId << QStringLiteral(", saved search: ") << search);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::updateSavedSearch");
     Q_EMIT updateSavedSearch(search, requestId);
 }
 
@@ -2262,36 +2416,10 @@ void FavoritesModel::unfavoriteNote(const QString & localUid)
 {
     QNDEBUG(QStringLiteral("FavoritesModel::unfavoriteNote: local uid = ") << localUid);
 
-    const Note * pCachedNote = m_noteCache.get(localUid);
-    if (Q_UNLIKELY(!pCachedNote))
-    {
-        QUuid requestId = QUuid::createUuid();
-        Q_UNUSED(m_findNoteToUnfavoriteRequestIds.insert(requestId))
-        Note dummy;
-        dummy.setLocalUid(localUid);
-        QNTRACE(QStringLiteral("Emitting the request to find a note: local uid = ") << localUid
-                << QStringLiteral(", request id = ") << requestId);
-        Q_EMIT findNote(dummy, /* with resource metadata = */ true, /* with resource binary data = */ false, requestId);
-        return;
-    }
-
-    Note note = *pCachedNote;
-
-    note.setLocalUid(localUid);
-    bool dirty = note.isDirty() || note.isFavorited();
-    note.setDirty(dirty);
-    note.setFavorited(false);
-
-    QUuid requestId = QUuid::createUuid();
-    Q_UNUSED(m_updateNoteRequestIds.insert(requestId))
-
-    // While the note is being updated in the local storage,
-    // remove its stale copy from the cache
-    Q_UNUSED(m_noteCache.remove(note.localUid()))
-
-    QNTRACE(QStringLiteral("Emitting the request to update the note in local storage: id = ") << requestId
-            << QStringLiteral(", note: ") << note);
-    Q_EMIT updateNote(note, /* update resources = */ false, /* update tags = */ false, requestId);
+    NoteFieldsUpdate update;
+    update.setFavorited(false);
+    update.setDirty(true);
+    updateNoteFieldsInLocalStorage(localUid, update);
 }
 
 void FavoritesModel::unfavoriteNotebook(const QString & localUid)
@@ -2307,6 +2435,7 @@ void FavoritesModel::unfavoriteNotebook(const QString & localUid)
         dummy.setLocalUid(localUid);
         QNTRACE(QStringLiteral("Emitting the request to find a notebook: local uid = ") << localUid
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findNotebook");
         Q_EMIT findNotebook(dummy, requestId);
         return;
     }
@@ -2327,6 +2456,7 @@ void FavoritesModel::unfavoriteNotebook(const QString & localUid)
 
     QNTRACE(QStringLiteral("Emitting the request to update the notebook in local storage: id = ") << requestId
             << QStringLiteral(", notebook: ") << notebook);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::updateNotebook");
     Q_EMIT updateNotebook(notebook, requestId);
 }
 
@@ -2343,6 +2473,7 @@ void FavoritesModel::unfavoriteTag(const QString & localUid)
         dummy.setLocalUid(localUid);
         QNTRACE(QStringLiteral("Emitting the request to find a tag: local uid = ") << localUid
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findTag");
         Q_EMIT findTag(dummy, requestId);
         return;
     }
@@ -2363,6 +2494,7 @@ void FavoritesModel::unfavoriteTag(const QString & localUid)
 
     QNTRACE(QStringLiteral("Emitting the request to update the tag in local storage: id = ") << requestId
             << QStringLiteral(", tag: ") << tag);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::updateTag");
     Q_EMIT updateTag(tag, requestId);
 }
 
@@ -2379,6 +2511,7 @@ void FavoritesModel::unfavoriteSavedSearch(const QString & localUid)
         dummy.setLocalUid(localUid);
         QNTRACE(QStringLiteral("Emitting the request to find a saved search: local uid = ") << localUid
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::findSavedSearch");
         Q_EMIT findSavedSearch(dummy, requestId);
         return;
     }
@@ -2399,6 +2532,7 @@ void FavoritesModel::unfavoriteSavedSearch(const QString & localUid)
 
     QNTRACE(QStringLiteral("Emitting the request to update the saved search in local storage: id = ") << requestId
             << QStringLiteral(", saved search: ") << search);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "FavoritesModel::updateSavedSearch");
     Q_EMIT updateSavedSearch(search, requestId);
 }
 
@@ -2739,7 +2873,7 @@ void FavoritesModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
     FavoritesModelItem item;
     item.setType(FavoritesModelItem::Type::SavedSearch);
     item.setLocalUid(search.localUid());
-    item.setNumNotesTargeted(-1);
+    item.setNumNotesTargeted(m_noteCountsBySavedSearchLocalUid.value(search.localUid(), -1));
     item.setDisplayName(search.name());
 
     FavoritesDataByIndex & rowIndex = m_data.get<ByIndex>();
@@ -3056,7 +3190,7 @@ bool FavoritesModel::Comparator::operator()(const FavoritesModelItem & lhs, cons
     {
     case Columns::DisplayName:
         {
-            int compareResult = lhs.displayName().localeAwareCompare(rhs.displayName());
+            int compareResult = lhs.displayNameSortKey().compare(rhs.displayNameSortKey());
             less = compareResult < 0;
             greater = compareResult > 0;
             break;
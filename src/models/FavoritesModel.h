@@ -20,6 +20,7 @@
 #define QUENTIER_MODELS_FAVORITES_MODEL_H
 
 #include "FavoritesModelItem.h"
+#include "NoteFieldsUpdate.h"
 #include "NoteCache.h"
 #include "NotebookCache.h"
 #include "TagCache.h"
@@ -87,6 +88,29 @@ public:
      */
     bool allItemsListed() const { return m_allItemsListed; }
 
+    /**
+     * @brief connectToLocalStorage, disconnectFromLocalStorage - the model kept alive while its account
+     * is not the current one must be disconnected from the local storage manager since the latter
+     * serves another account meanwhile; the model needs to be connected back once its account
+     * becomes the current one again
+     */
+    void connectToLocalStorage(const NoteModel & noteModel, LocalStorageManagerAsync & localStorageManagerAsync);
+    void disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync);
+
+    /**
+     * @return true if the model has sent some requests to the local storage manager and hasn't received
+     * the responses to them yet; the model disconnected from the local storage in this state would never
+     * receive these responses
+     */
+    bool hasPendingRequests() const;
+
+public Q_SLOTS:
+    /**
+     * @brief setSavedSearchNoteCount - sets the number of notes matching the saved search; the model doesn't run
+     * the saved searches' queries so this number, unlike the note counts of notebooks and tags, comes from the outside
+     */
+    void setSavedSearchNoteCount(QString savedSearchLocalUid, int noteCount);
+
 public:
     // QAbstractItemModel interface
     virtual Qt::ItemFlags flags(const QModelIndex & index) const Q_DECL_OVERRIDE;
@@ -281,6 +305,7 @@ private:
     void updateItemRowWithRespectToSorting(const FavoritesModelItem & item);
     void updateItemInLocalStorage(const FavoritesModelItem & item);
     void updateNoteInLocalStorage(const FavoritesModelItem & item);
+    void updateNoteFieldsInLocalStorage(const QString & noteLocalUid, const NoteFieldsUpdate & update);
     void updateNotebookInLocalStorage(const FavoritesModelItem & item);
     void updateTagInLocalStorage(const FavoritesModelItem & item);
     void updateSavedSearchInLocalStorage(const FavoritesModelItem & item);
@@ -389,7 +414,9 @@ private:
     QSet<QUuid>             m_updateNoteRequestIds;
     QSet<QUuid>             m_findNoteToRestoreFailedUpdateRequestIds;
     QSet<QUuid>             m_findNoteToPerformUpdateRequestIds;
-    QSet<QUuid>             m_findNoteToUnfavoriteRequestIds;
+
+    // The updates awaiting the notes to be found in the local storage; the key is note local uid
+    QHash<QString, NoteFieldsUpdate>    m_pendingNoteFieldsUpdatesByNoteLocalUid;
 
     QSet<QUuid>             m_updateNotebookRequestIds;
     QSet<QUuid>             m_findNotebookToRestoreFailedUpdateRequestIds;
@@ -418,6 +445,8 @@ private:
     LocalUidToRequestIdBimap        m_notebookLocalUidToNoteCountRequestIdBimap;
     LocalUidToRequestIdBimap        m_tagLocalUidToNoteCountRequestIdBimap;
 
+    QHash<QString, int>             m_noteCountsBySavedSearchLocalUid;
+
     QHash<QString, NotebookRestrictionsData>    m_notebookRestrictionsData;
 
     Columns::type           m_sortedColumn;
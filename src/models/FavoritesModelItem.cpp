@@ -27,6 +27,7 @@ FavoritesModelItem::FavoritesModelItem(const Type::type type,
     m_type(type),
     m_localUid(localUid),
     m_displayName(displayName),
+    m_displayNameSortKey(displayName),
     m_numNotesTargeted(numNotesTargeted)
 {}
 
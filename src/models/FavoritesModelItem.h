@@ -19,6 +19,7 @@
 #ifndef QUENTIER_MODELS_FAVORITES_MODEL_ITEM_H
 #define QUENTIER_MODELS_FAVORITES_MODEL_ITEM_H
 
+#include "NameSortKey.h"
 #include <quentier/utility/Printable.h>
 
 namespace quentier {
@@ -51,7 +52,10 @@ public:
     void setLocalUid(const QString & localUid) { m_localUid = localUid; }
 
     const QString & displayName() const { return m_displayName; }
-    void setDisplayName(const QString & displayName) { m_displayName = displayName; }
+    void setDisplayName(const QString & displayName) { m_displayName = displayName; m_displayNameSortKey = NameSortKey(displayName); }
+
+    // The collation key of the display name, to be used for sorting the favorited items by display name
+    const NameSortKey & displayNameSortKey() const { return m_displayNameSortKey; }
 
     int numNotesTargeted() const { return m_numNotesTargeted; }
     void setNumNotesTargeted(const int numNotesTargeted) { m_numNotesTargeted = numNotesTargeted; }
@@ -62,6 +66,7 @@ private:
     Type::type      m_type;
     QString         m_localUid;
     QString         m_displayName;
+    NameSortKey     m_displayNameSortKey;
     int             m_numNotesTargeted;
 };
 
@@ -18,6 +18,7 @@
 
 #include "LogViewerModel.h"
 #include "LogViewerModelFileReaderAsync.h"
+#include "LogViewerModelFileSaverAsync.h"
 #include "../SettingsNames.h"
 #include <quentier/utility/Utility.h>
 #include <quentier/utility/EventLoopWithExitStatus.h>
@@ -91,7 +92,8 @@ LogViewerModel::LogViewerModel(QObject * parent) :
     m_currentLogFileSizePollingTimer(),
     m_pReadLogFileIOThread(Q_NULLPTR),
     m_pFileReaderAsync(Q_NULLPTR),
-    m_targetSaveFile(),
+    m_pSaveLogFileIOThread(Q_NULLPTR),
+    m_pFileSaverAsync(Q_NULLPTR),
     m_internalLogEnabled(false),
     m_internalLogFile(applicationPersistentStoragePath() + QStringLiteral("/logs-quentier/LogViewerModelLog.txt"))
 {
@@ -126,6 +128,8 @@ LogViewerModel::~LogViewerModel()
         m_pFileReaderAsync->disconnect(this);
         m_pFileReaderAsync = Q_NULLPTR;
     }
+
+    stopFileSaverAsync();
 }
 
 QString LogViewerModel::logFileName() const
@@ -456,7 +460,7 @@ const QVector<LogViewerModel::Data> * LogViewerModel::dataChunkContainingModelRo
     return m_logFileChunkDataCache.get(pLogFileChunkMetadata->number());
 }
 
-QString LogViewerModel::dataEntryToString(const LogViewerModel::Data & dataEntry) const
+QString LogViewerModel::dataEntryToString(const LogViewerModel::Data & dataEntry)
 {
     QString result;
     QTextStream strm(&result);
@@ -505,93 +509,59 @@ void LogViewerModel::saveModelEntriesToFile(const QString & targetFilePath)
 {
     LVMDEBUG(QStringLiteral("LogViewerModel::saveModelEntriesToFile: ") << targetFilePath);
 
-    m_targetSaveFile.setFileName(targetFilePath);
-    if (!m_targetSaveFile.open(QIODevice::WriteOnly)) {
-        ErrorString errorDescription(QT_TR_NOOP("Can't save log entries to file: could not open the selected file for writing"));
+    if (Q_UNLIKELY(m_pFileSaverAsync)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't save log entries to file: the previous saving is still in progress"));
         LVMDEBUG(errorDescription);
         Q_EMIT saveModelEntriesToFileFinished(errorDescription);
         return;
     }
 
-    const LogFileChunksMetadataIndexByNumber & indexByNumber = m_logFileChunksMetadata.get<LogFileChunksMetadataByNumber>();
-    if (indexByNumber.empty()) {
-        LVMDEBUG(QStringLiteral("The index of log file chunks metadata by number is empty, requesting the chunks starting from the first"));
-        requestDataEntriesChunkFromLogFile(0, LogFileDataEntryRequestReason::SaveLogEntriesToFile);
+    if (Q_UNLIKELY(!m_isActive)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't save log entries to file: no log file is selected"));
+        LVMDEBUG(errorDescription);
+        Q_EMIT saveModelEntriesToFileFinished(errorDescription);
         return;
     }
 
-    qint64 currentLogFileSize = m_currentLogFileInfo.size();
-    LVMDEBUG(QStringLiteral("The number of log file metadata chunks = ") << indexByNumber.size()
-             << QStringLiteral(", current log file size = ") << currentLogFileSize);
-
-    for(auto it = indexByNumber.begin(), end = indexByNumber.end(); it != end; ++it)
+    if (!m_pSaveLogFileIOThread)
     {
-        const QVector<Data> * pDataEntries = m_logFileChunkDataCache.get(it->number());
-        if (!pDataEntries) {
-            LVMDEBUG(QStringLiteral("Log data entries are not cached for log file metadata chunk with number ")
-                     << it->number() << QStringLiteral(", requesting log file data chunks starting from pos ")
-                     << it->startLogFilePos());
-            requestDataEntriesChunkFromLogFile(it->startLogFilePos(), LogFileDataEntryRequestReason::SaveLogEntriesToFile);
-            return;
-        }
+        m_pSaveLogFileIOThread = new QThread;
 
-        LVMDEBUG(QStringLiteral("Processing ") << pDataEntries->size() << QStringLiteral(" data entries"));
-        for(auto dit = pDataEntries->constBegin(), dend = pDataEntries->constEnd(); dit != dend; ++dit) {
-            QString entry = dataEntryToString(*dit);
-            entry += QStringLiteral("\n");
-            m_targetSaveFile.write(entry.toUtf8());
-        }
-
-        if (currentLogFileSize > 0) {
-            double progressPercent = static_cast<double>(it->endLogFilePos()) / static_cast<double>(currentLogFileSize) * 100.0;
-            LVMDEBUG(QStringLiteral("Emitting save log to file progress: ") << progressPercent);
-            Q_EMIT saveModelEntriesToFileProgress(progressPercent);
-        }
-    }
-
-    if (canFetchMore(QModelIndex())) {
-        auto lastIt = indexByNumber.end();
-        --lastIt;
-        LVMDEBUG(QStringLiteral("The model can fetch more entries, requesting data entries starting from pos ")
-                 << lastIt->endLogFilePos());
-        requestDataEntriesChunkFromLogFile(lastIt->endLogFilePos(), LogFileDataEntryRequestReason::SaveLogEntriesToFile);
-        return;
-    }
-
-    // If we got here, we found all data entries within the cache, can close the file and return
-    LVMDEBUG(QStringLiteral("Seemingly all log entries were written to the file, reporting finish"));
-    m_targetSaveFile.close();
-    Q_EMIT saveModelEntriesToFileFinished(ErrorString());
+        QObject::connect(m_pSaveLogFileIOThread, QNSIGNAL(QThread,finished),
+                         m_pSaveLogFileIOThread, QNSLOT(QThread,deleteLater));
+        QObject::connect(this, QNSIGNAL(LogViewerModel,destroyed),
+                         m_pSaveLogFileIOThread, QNSLOT(QThread,quit));
+        m_pSaveLogFileIOThread->start(QThread::LowPriority);
+    }
+
+    m_pFileSaverAsync = new FileSaverAsync(m_currentLogFileInfo.absoluteFilePath(), targetFilePath, m_filteringOptions);
+    m_pFileSaverAsync->moveToThread(m_pSaveLogFileIOThread);
+
+    QObject::connect(m_pSaveLogFileIOThread, QNSIGNAL(QThread,finished),
+                     m_pFileSaverAsync, QNSLOT(FileSaverAsync,deleteLater));
+    QObject::connect(this, QNSIGNAL(LogViewerModel,startSavingModelEntriesToFile),
+                     m_pFileSaverAsync, QNSLOT(FileSaverAsync,onStartSaving),
+                     Qt::ConnectionType(Qt::UniqueConnection | Qt::QueuedConnection));
+    QObject::connect(m_pFileSaverAsync, QNSIGNAL(FileSaverAsync,progress,double),
+                     this, QNSLOT(LogViewerModel,onFileSaverAsyncProgress,double),
+                     Qt::ConnectionType(Qt::UniqueConnection | Qt::QueuedConnection));
+    QObject::connect(m_pFileSaverAsync, QNSIGNAL(FileSaverAsync,finished,ErrorString),
+                     this, QNSLOT(LogViewerModel,onFileSaverAsyncFinished,ErrorString),
+                     Qt::ConnectionType(Qt::UniqueConnection | Qt::QueuedConnection));
+
+    Q_EMIT startSavingModelEntriesToFile();
+    LVMDEBUG(QStringLiteral("Emitted the request to start saving the log entries to file"));
 }
 
 bool LogViewerModel::isSavingModelEntriesToFileInProgress() const
 {
-    for(auto it = m_logFilePosRequestedToBeRead.constBegin(),
-        end = m_logFilePosRequestedToBeRead.constEnd(); it != end; ++it)
-    {
-        if (it.value() & LogFileDataEntryRequestReason::SaveLogEntriesToFile) {
-            return true;
-        }
-    }
-
-    return false;
+    return (m_pFileSaverAsync != Q_NULLPTR);
 }
 
 void LogViewerModel::cancelSavingModelEntriesToFile()
 {
-    for(auto it = m_logFilePosRequestedToBeRead.begin();
-        it != m_logFilePosRequestedToBeRead.end(); )
-    {
-        if (it.value() == LogFileDataEntryRequestReasons(LogFileDataEntryRequestReason::SaveLogEntriesToFile)) {
-            it = m_logFilePosRequestedToBeRead.erase(it);
-        }
-        else if (it.value() & LogFileDataEntryRequestReason::SaveLogEntriesToFile) {
-            it.value() &= ~LogFileDataEntryRequestReason::SaveLogEntriesToFile;
-            ++it;
-        }
-    }
-
-    m_targetSaveFile.close();
+    LVMDEBUG(QStringLiteral("LogViewerModel::cancelSavingModelEntriesToFile"));
+    stopFileSaverAsync();
 }
 
 int LogViewerModel::rowCount(const QModelIndex & parent) const
@@ -870,7 +840,6 @@ void LogViewerModel::onLogFileDataEntriesRead(qint64 fromPos, qint64 endPos,
         return;
     }
 
-    LogFileDataEntryRequestReasons reasons = fromPosIt.value();
     Q_UNUSED(m_logFilePosRequestedToBeRead.erase(fromPosIt))
 
     if (!errorDescription.isEmpty())
@@ -880,50 +849,7 @@ void LogViewerModel::onLogFileDataEntriesRead(qint64 fromPos, qint64 endPos,
         error.appendBase(errorDescription.additionalBases());
         error.details() = errorDescription.details();
 
-        if (reasons.testFlag(LogFileDataEntryRequestReason::SaveLogEntriesToFile)) {
-            m_targetSaveFile.close();
-            Q_EMIT saveModelEntriesToFileFinished(error);
-        }
-        else {
-            Q_EMIT notifyError(error);
-        }
-
-        return;
-    }
-
-    if (reasons.testFlag(LogFileDataEntryRequestReason::SaveLogEntriesToFile))
-    {
-        QChar newline(QChar::fromLatin1('\n'));
-        for(auto it = dataEntries.constBegin(), end = dataEntries.constEnd(); it != end; ++it)
-        {
-            QString entry = dataEntryToString(*it);
-            if (!entry.endsWith(newline)) {
-                entry += newline;
-            }
-
-            m_targetSaveFile.write(entry.toUtf8());
-        }
-
-        if (dataEntries.size() < LOG_VIEWER_MODEL_NUM_ITEMS_PER_CACHE_BUCKET)
-        {
-            // We must have reached the end of the log file
-            m_targetSaveFile.close();
-            Q_EMIT saveModelEntriesToFileFinished(ErrorString());
-        }
-        else
-        {
-            qint64 currentLogFileSize = m_currentLogFileInfo.size();
-            if (currentLogFileSize > 0) {
-                double progressPercent = static_cast<double>(endPos) / static_cast<double>(currentLogFileSize) * 100.0;
-                Q_EMIT saveModelEntriesToFileProgress(progressPercent);
-            }
-
-            requestDataEntriesChunkFromLogFile(endPos, LogFileDataEntryRequestReason::SaveLogEntriesToFile);
-        }
-    }
-
-    if (reasons == LogFileDataEntryRequestReasons(LogFileDataEntryRequestReason::SaveLogEntriesToFile)) {
-        // If there were no other reasons for this request, don't really need to do anything here
+        Q_EMIT notifyError(error);
         return;
     }
 
@@ -1006,6 +932,20 @@ void LogViewerModel::onLogFileDataEntriesRead(qint64 fromPos, qint64 endPos,
     }
 }
 
+void LogViewerModel::onFileSaverAsyncProgress(double progressPercent)
+{
+    LVMDEBUG(QStringLiteral("LogViewerModel::onFileSaverAsyncProgress: ") << progressPercent);
+    Q_EMIT saveModelEntriesToFileProgress(progressPercent);
+}
+
+void LogViewerModel::onFileSaverAsyncFinished(ErrorString errorDescription)
+{
+    LVMDEBUG(QStringLiteral("LogViewerModel::onFileSaverAsyncFinished: error description = ") << errorDescription);
+
+    stopFileSaverAsync();
+    Q_EMIT saveModelEntriesToFileFinished(errorDescription);
+}
+
 void LogViewerModel::requestDataEntriesChunkFromLogFile(const qint64 startPos, const LogFileDataEntryRequestReason::type reason)
 {
     LVMDEBUG(QStringLiteral("LogViewerModel::requestDataEntriesChunkFromLogFile: start pos = ") << startPos
@@ -1223,6 +1163,20 @@ LogViewerModel::findLogFileChunkMetadataIteratorByLogFilePos(const qint64 pos) c
     return prevIt;
 }
 
+void LogViewerModel::stopFileSaverAsync()
+{
+    if (!m_pFileSaverAsync) {
+        return;
+    }
+
+    // NOTE: the saver processes the log file in portions through its thread's event loop,
+    // so the deferred deletion interrupts the saving in between the portions
+    m_pFileSaverAsync->disconnect(this);
+    this->disconnect(m_pFileSaverAsync);
+    m_pFileSaverAsync->deleteLater();
+    m_pFileSaverAsync = Q_NULLPTR;
+}
+
 LogViewerModel::FilteringOptions::FilteringOptions() :
     Printable(),
     m_startLogFilePos(),
@@ -1358,6 +1312,7 @@ QTextStream & LogViewerModel::Data::print(QTextStream & strm) const
          << QStringLiteral(", source file name = ") << m_sourceFileName
          << QStringLiteral(", line number = ") << m_sourceFileLineNumber
          << QStringLiteral(", log level = ") << m_logLevel
+         << QStringLiteral(", num displayed lines = ") << m_logEntryLineStartPositions.size()
          << QStringLiteral(", log entry: ") << m_logEntry;
     return strm;
 }
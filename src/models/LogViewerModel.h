@@ -43,6 +43,9 @@
 #include <boost/multi_index/ordered_index.hpp>
 #endif
 
+// The max number of chars within a single displayed line of the log entry: longer lines are split
+#define LOG_VIEWER_MODEL_MAX_DISPLAYED_LOG_ENTRY_LINE_SIZE (150)
+
 namespace quentier {
 
 class LogViewerModel: public QAbstractTableModel
@@ -116,7 +119,10 @@ public:
             m_sourceFileName(),
             m_sourceFileLineNumber(-1),
             m_logLevel(LogLevel::InfoLevel),
-            m_logEntry()
+            m_logEntry(),
+            m_logEntryLineStartPositions(),
+            m_logEntryLineSizes(),
+            m_logEntryMaxLineSize(0)
         {}
 
         virtual QTextStream & print(QTextStream & strm) const Q_DECL_OVERRIDE;
@@ -126,16 +132,29 @@ public:
         qint64          m_sourceFileLineNumber;
         LogLevel::type  m_logLevel;
         QString         m_logEntry;
+
+        // The log entry is displayed as a sequence of lines of no more than LOG_VIEWER_MODEL_MAX_DISPLAYED_LOG_ENTRY_LINE_SIZE
+        // chars each; the positions and sizes of these (trimmed) lines within the log entry are computed by the log file parser
+        // so that the log entry's text doesn't need to be scanned each time the log entry is displayed
+        QVector<int>    m_logEntryLineStartPositions;
+        QVector<int>    m_logEntryLineSizes;
+        int             m_logEntryMaxLineSize;
     };
 
     const Data * dataEntry(const int row) const;
 
     const QVector<Data> * dataChunkContainingModelRow(const int row, int * pStartModelRow = Q_NULLPTR) const;
 
-    QString dataEntryToString(const Data & dataEntry) const;
+    static QString dataEntryToString(const Data & dataEntry);
 
     QColor backgroundColorForLogLevel(const LogLevel::type logLevel) const;
 
+    /**
+     * Starts saving the log entries matching the current filtering options to the specified file;
+     * the saving is done in a separate thread which reads the log file independently of the entries
+     * cached by the model for display. The progress and the completion are reported via
+     * saveModelEntriesToFileProgress and saveModelEntriesToFileFinished signals
+     */
     void saveModelEntriesToFile(const QString & targetFilePath);
     bool isSavingModelEntriesToFileInProgress() const;
     void cancelSavingModelEntriesToFile();
@@ -168,6 +187,7 @@ Q_SIGNALS:
     void startAsyncLogFileReading();
     void readLogFileDataEntries(qint64 fromPos, int maxDataEntries);
     void deleteFileReaderAsync();
+    void startSavingModelEntriesToFile();
     void wipeCurrentLogFileFinished();
 
 public:
@@ -187,6 +207,9 @@ private Q_SLOTS:
                                   QVector<LogViewerModel::Data> dataEntries,
                                   ErrorString errorDescription);
 
+    void onFileSaverAsyncProgress(double progressPercent);
+    void onFileSaverAsyncFinished(ErrorString errorDescription);
+
 private:
     struct LogFileDataEntryRequestReason
     {
@@ -194,8 +217,7 @@ private:
         {
             InitialRead = 1 << 1,
             CacheMiss = 1 << 2,
-            FetchMore = 1 << 3,
-            SaveLogEntriesToFile = 1 << 4
+            FetchMore = 1 << 3
         };
     };
     Q_DECLARE_FLAGS(LogFileDataEntryRequestReasons, LogFileDataEntryRequestReason::type)
@@ -208,6 +230,7 @@ private:
 
 private:
     class FileReaderAsync;
+    class FileSaverAsync;
     class LogFileParser;
 
 private:
@@ -297,6 +320,8 @@ private:
     LogFileChunksMetadataIndexByStartModelRow::const_iterator findLogFileChunkMetadataIteratorByModelRow(const int row) const;
     LogFileChunksMetadataIndexByStartLogFilePos::const_iterator findLogFileChunkMetadataIteratorByLogFilePos(const qint64 pos) const;
 
+    void stopFileSaverAsync();
+
 private:
     bool                m_isActive;
     QFileInfo           m_currentLogFileInfo;
@@ -320,7 +345,8 @@ private:
     QThread *           m_pReadLogFileIOThread;
     FileReaderAsync *   m_pFileReaderAsync;
 
-    QFile               m_targetSaveFile;
+    QThread *           m_pSaveLogFileIOThread;
+    FileSaverAsync *    m_pFileSaverAsync;
 
     bool                m_internalLogEnabled;
     mutable QFile       m_internalLogFile;
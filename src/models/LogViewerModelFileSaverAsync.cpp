@@ -0,0 +1,169 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogViewerModelFileSaverAsync.h"
+#include <QFileInfo>
+#include <QMetaObject>
+
+// The number of log entries parsed from the source log file per single invokation of onSaveDataEntriesToFile slot
+#define LOG_VIEWER_MODEL_NUM_ITEMS_PER_SAVE_PORTION (5000)
+
+// The size of the buffer accumulating the data before writing it to the target file
+#define LOG_VIEWER_MODEL_SAVE_BUFFER_SIZE (4 * 1024 * 1024)
+
+namespace quentier {
+
+LogViewerModel::FileSaverAsync::FileSaverAsync(const QString & sourceFilePath, const QString & targetFilePath,
+                                               const LogViewerModel::FilteringOptions & filteringOptions,
+                                               QObject * parent) :
+    QObject(parent),
+    m_sourceFile(sourceFilePath),
+    m_targetFile(targetFilePath),
+    m_disabledLogLevels(filteringOptions.m_disabledLogLevels),
+    m_filterRegExp(filteringOptions.m_logEntryContentFilter, Qt::CaseSensitive, QRegExp::Wildcard),
+    m_parser(),
+    m_currentPos(filteringOptions.m_startLogFilePos.isSet() ? filteringOptions.m_startLogFilePos.ref() : qint64(0)),
+    m_sourceFileSize(0),
+    m_buffer(),
+    m_dataEntries()
+{}
+
+LogViewerModel::FileSaverAsync::~FileSaverAsync()
+{
+    if (m_sourceFile.isOpen()) {
+        m_sourceFile.close();
+    }
+
+    if (m_targetFile.isOpen()) {
+        m_targetFile.close();
+    }
+}
+
+void LogViewerModel::FileSaverAsync::onStartSaving()
+{
+    if (!m_targetFile.open(QIODevice::WriteOnly)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't save log entries to file: could not open the selected file for writing"));
+        errorDescription.details() = m_targetFile.errorString();
+        finishWithError(errorDescription);
+        return;
+    }
+
+    if (!m_sourceFile.open(QIODevice::ReadOnly)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't save log entries to file: could not open the log file for reading"));
+        errorDescription.details() = m_sourceFile.errorString();
+        finishWithError(errorDescription);
+        return;
+    }
+
+    m_sourceFileSize = QFileInfo(m_sourceFile).size();
+    m_buffer.reserve(LOG_VIEWER_MODEL_SAVE_BUFFER_SIZE);
+    m_dataEntries.reserve(LOG_VIEWER_MODEL_NUM_ITEMS_PER_SAVE_PORTION);
+
+    onSaveDataEntriesToFile();
+}
+
+void LogViewerModel::FileSaverAsync::onSaveDataEntriesToFile()
+{
+    qint64 endPos = -1;
+    ErrorString errorDescription;
+    bool res = m_parser.parseDataEntriesFromLogFile(m_currentPos, LOG_VIEWER_MODEL_NUM_ITEMS_PER_SAVE_PORTION,
+                                                    m_disabledLogLevels, m_filterRegExp, m_sourceFile,
+                                                    m_dataEntries, endPos, errorDescription);
+    if (!res) {
+        ErrorString error(QT_TR_NOOP("Failed to read a portion of log from file: "));
+        error.appendBase(errorDescription.base());
+        error.appendBase(errorDescription.additionalBases());
+        error.details() = errorDescription.details();
+        finishWithError(error);
+        return;
+    }
+
+    const char newline = '\n';
+    for(auto it = m_dataEntries.constBegin(), end = m_dataEntries.constEnd(); it != end; ++it)
+    {
+        m_buffer.append(LogViewerModel::dataEntryToString(*it).toUtf8());
+        if (!m_buffer.endsWith(newline)) {
+            m_buffer.append(newline);
+        }
+
+        if ((m_buffer.size() >= LOG_VIEWER_MODEL_SAVE_BUFFER_SIZE) && !flushBuffer(errorDescription)) {
+            finishWithError(errorDescription);
+            return;
+        }
+    }
+
+    bool reachedEnd = (m_dataEntries.size() < LOG_VIEWER_MODEL_NUM_ITEMS_PER_SAVE_PORTION) || (endPos <= m_currentPos);
+    m_currentPos = endPos;
+
+    if (!reachedEnd)
+    {
+        if (m_sourceFileSize > 0) {
+            double progressPercent = static_cast<double>(m_currentPos) / static_cast<double>(m_sourceFileSize) * 100.0;
+            Q_EMIT progress(progressPercent);
+        }
+
+        // Continue with the next portion through the event loop so that the cancellation
+        // (i.e. the deletion of this object via deleteLater) has the chance to be processed in between
+        QMetaObject::invokeMethod(this, "onSaveDataEntriesToFile", Qt::QueuedConnection);
+        return;
+    }
+
+    if (!flushBuffer(errorDescription)) {
+        finishWithError(errorDescription);
+        return;
+    }
+
+    m_sourceFile.close();
+    m_targetFile.close();
+
+    Q_EMIT progress(100.0);
+    Q_EMIT finished(ErrorString());
+}
+
+bool LogViewerModel::FileSaverAsync::flushBuffer(ErrorString & errorDescription)
+{
+    if (m_buffer.isEmpty()) {
+        return true;
+    }
+
+    qint64 bytesWritten = m_targetFile.write(m_buffer);
+    if (Q_UNLIKELY(bytesWritten != static_cast<qint64>(m_buffer.size()))) {
+        errorDescription.setBase(QT_TR_NOOP("Can't save log entries to file: failed to write the data to the file"));
+        errorDescription.details() = m_targetFile.errorString();
+        return false;
+    }
+
+    // NOTE: QByteArray::clear would release the reserved memory, resize keeps it
+    m_buffer.resize(0);
+    return true;
+}
+
+void LogViewerModel::FileSaverAsync::finishWithError(const ErrorString & errorDescription)
+{
+    if (m_sourceFile.isOpen()) {
+        m_sourceFile.close();
+    }
+
+    if (m_targetFile.isOpen()) {
+        m_targetFile.close();
+    }
+
+    Q_EMIT finished(errorDescription);
+}
+
+} // namespace quentier
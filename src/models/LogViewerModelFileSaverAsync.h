@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_MODELS_LOG_VIEWER_MODEL_FILE_SAVER_ASYNC_H
+#define QUENTIER_MODELS_LOG_VIEWER_MODEL_FILE_SAVER_ASYNC_H
+
+#include "LogViewerModel.h"
+#include "LogViewerModelLogFileParser.h"
+#include <QFile>
+#include <QByteArray>
+#include <QVector>
+#include <QRegExp>
+
+namespace quentier {
+
+/**
+ * @brief The LogViewerModel::FileSaverAsync class saves the log entries matching the model's filtering options
+ * to the target file; it is meant to live in a separate thread and it re-reads the source log file on its own,
+ * without using the chunks cached by the model for display.
+ *
+ * The entries are processed in portions, each portion being handled by a separate invokation of
+ * onSaveDataEntriesToFile slot, so that the saving can be cancelled in between the portions by the deletion
+ * of the saver object.
+ */
+class LogViewerModel::FileSaverAsync: public QObject
+{
+    Q_OBJECT
+public:
+    explicit FileSaverAsync(const QString & sourceFilePath, const QString & targetFilePath,
+                            const LogViewerModel::FilteringOptions & filteringOptions,
+                            QObject * parent = Q_NULLPTR);
+    virtual ~FileSaverAsync();
+
+Q_SIGNALS:
+    void progress(double progressPercent);
+    void finished(ErrorString errorDescription);
+
+public Q_SLOTS:
+    void onStartSaving();
+
+private Q_SLOTS:
+    void onSaveDataEntriesToFile();
+
+private:
+    bool flushBuffer(ErrorString & errorDescription);
+    void finishWithError(const ErrorString & errorDescription);
+
+private:
+    Q_DISABLE_COPY(FileSaverAsync)
+
+private:
+    QFile                           m_sourceFile;
+    QFile                           m_targetFile;
+    QVector<LogLevel::type>         m_disabledLogLevels;
+    QRegExp                         m_filterRegExp;
+    LogViewerModel::LogFileParser   m_parser;
+
+    qint64                          m_currentPos;
+    qint64                          m_sourceFileSize;
+
+    QByteArray                      m_buffer;
+    QVector<LogViewerModel::Data>   m_dataEntries;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_MODELS_LOG_VIEWER_MODEL_FILE_SAVER_ASYNC_H
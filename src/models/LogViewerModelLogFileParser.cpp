@@ -24,6 +24,7 @@
 #include <QTextStream>
 #include <QDebug>
 #include <QCoreApplication>
+#include <algorithm>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 2, 0)
 #include <QTimeZone>
@@ -166,6 +167,12 @@ bool LogViewerModel::LogFileParser::parseDataEntriesFromLogFile(const qint64 fro
         }
     }
 
+    // The entries are complete only now since the lines following the entry's first line are appended to it
+    // while parsing the subsequent lines of the log file
+    for(auto it = dataEntries.begin(), end = dataEntries.end(); it != end; ++it) {
+        splitLogEntryIntoDisplayedLines(*it);
+    }
+
     endPos = strm.pos();
     LVMPDEBUG(QStringLiteral("End pos before returning = ") << endPos);
     return true;
@@ -290,6 +297,68 @@ void LogViewerModel::LogFileParser::appendLogEntryLine(LogViewerModel::Data & da
     data.m_logEntry += line;
 }
 
+void LogViewerModel::LogFileParser::splitLogEntryIntoDisplayedLines(LogViewerModel::Data & data) const
+{
+    data.m_logEntryLineStartPositions.clear();
+    data.m_logEntryLineSizes.clear();
+    data.m_logEntryMaxLineSize = 0;
+
+    const QString & logEntry = data.m_logEntry;
+    const int logEntrySize = logEntry.size();
+    const QChar newlineChar = QChar::fromLatin1('\n');
+    const QChar whitespaceChar = QChar::fromLatin1(' ');
+
+    int lineStartPos = -1;
+    while(true)
+    {
+        int lineEndPos = -1;
+        int index = logEntry.indexOf(newlineChar, (lineStartPos + 1));
+        if ((index < 0) || (index - lineStartPos > LOG_VIEWER_MODEL_MAX_DISPLAYED_LOG_ENTRY_LINE_SIZE))
+        {
+            lineEndPos = (lineStartPos + LOG_VIEWER_MODEL_MAX_DISPLAYED_LOG_ENTRY_LINE_SIZE);
+
+            int previousWhitespaceIndex = logEntry.lastIndexOf(whitespaceChar, (lineEndPos - 1));
+            if (previousWhitespaceIndex > lineStartPos) {
+                lineEndPos = previousWhitespaceIndex;
+            }
+        }
+        else
+        {
+            lineEndPos = index;
+        }
+
+        if (lineEndPos > logEntrySize) {
+            lineEndPos = logEntrySize;
+        }
+
+        bool lastIteration = (lineEndPos == logEntrySize);
+
+        // Trimming the line without actually extracting it from the log entry
+        int trimmedLineStartPos = std::max(lineStartPos, 0);
+        int trimmedLineEndPos = lineEndPos;
+        while((trimmedLineStartPos < trimmedLineEndPos) && logEntry.at(trimmedLineStartPos).isSpace()) {
+            ++trimmedLineStartPos;
+        }
+
+        while((trimmedLineEndPos > trimmedLineStartPos) && logEntry.at(trimmedLineEndPos - 1).isSpace()) {
+            --trimmedLineEndPos;
+        }
+
+        int lineSize = trimmedLineEndPos - trimmedLineStartPos;
+        data.m_logEntryLineStartPositions.push_back(trimmedLineStartPos);
+        data.m_logEntryLineSizes.push_back(lineSize);
+        if (lineSize > data.m_logEntryMaxLineSize) {
+            data.m_logEntryMaxLineSize = lineSize;
+        }
+
+        if (lastIteration) {
+            break;
+        }
+
+        lineStartPos = lineEndPos;
+    }
+}
+
 void LogViewerModel::LogFileParser::setInternalLogEnabled(const bool enabled)
 {
     if (m_internalLogEnabled == enabled) {
@@ -52,6 +52,7 @@ private:
                                            QVector<LogViewerModel::Data> & dataEntries, ErrorString & errorDescription);
 
     void appendLogEntryLine(LogViewerModel::Data & data, const QString & line) const;
+    void splitLogEntryIntoDisplayedLines(LogViewerModel::Data & data) const;
 
     void setInternalLogEnabled(const bool enabled);
 
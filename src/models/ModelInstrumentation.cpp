@@ -0,0 +1,278 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelInstrumentation.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <QHash>
+#include <QMap>
+#include <QFile>
+#include <QTextStream>
+#include <QDateTime>
+#include <algorithm>
+
+// The histogram bucket i contains the timings within [2^(i-1), 2^i) microseconds, the bucket 0 - the timings
+// below 1 microsecond; the last bucket also contains everything beyond its upper bound
+#define MODEL_INSTRUMENTATION_NUM_HISTOGRAM_BUCKETS (32)
+
+// The requests which never got the response (i.e. the ones belonging to the local storage of the account
+// which is no longer the current one) are dropped once there are too many of them
+#define MODEL_INSTRUMENTATION_MAX_NUM_PENDING_REQUESTS (100000)
+
+namespace quentier {
+
+namespace {
+
+class Histogram
+{
+public:
+    Histogram() :
+        m_count(0),
+        m_sumUsec(0),
+        m_minUsec(0),
+        m_maxUsec(0)
+    {
+        std::fill(m_buckets, m_buckets + MODEL_INSTRUMENTATION_NUM_HISTOGRAM_BUCKETS, quint64(0));
+    }
+
+    void add(const qint64 usec)
+    {
+        int bucket = 0;
+        for(qint64 value = usec; (value > 0) && (bucket < MODEL_INSTRUMENTATION_NUM_HISTOGRAM_BUCKETS - 1); value >>= 1) {
+            ++bucket;
+        }
+
+        ++m_buckets[bucket];
+
+        m_minUsec = (m_count == 0) ? usec : std::min(m_minUsec, usec);
+        m_maxUsec = std::max(m_maxUsec, usec);
+        m_sumUsec += usec;
+        ++m_count;
+    }
+
+    void merge(const Histogram & other)
+    {
+        if (other.m_count == 0) {
+            return;
+        }
+
+        for(int i = 0; i < MODEL_INSTRUMENTATION_NUM_HISTOGRAM_BUCKETS; ++i) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+
+        m_minUsec = (m_count == 0) ? other.m_minUsec : std::min(m_minUsec, other.m_minUsec);
+        m_maxUsec = std::max(m_maxUsec, other.m_maxUsec);
+        m_sumUsec += other.m_sumUsec;
+        m_count += other.m_count;
+    }
+
+    // Returns the upper bound of the bucket containing the specified percentile
+    qint64 percentileUpperBoundUsec(const double percentile) const
+    {
+        quint64 threshold = static_cast<quint64>(static_cast<double>(m_count) * percentile / 100.0);
+        quint64 accumulated = 0;
+        for(int i = 0; i < MODEL_INSTRUMENTATION_NUM_HISTOGRAM_BUCKETS; ++i)
+        {
+            accumulated += m_buckets[i];
+            if ((accumulated > threshold) || (accumulated == m_count)) {
+                return std::min(qint64(1) << i, m_maxUsec);
+            }
+        }
+
+        return m_maxUsec;
+    }
+
+    void print(QTextStream & strm) const
+    {
+        double meanUsec = (m_count > 0) ? (static_cast<double>(m_sumUsec) / static_cast<double>(m_count)) : 0.0;
+        strm << QStringLiteral("count = ") << m_count
+             << QStringLiteral(", total = ") << (m_sumUsec / 1000) << QStringLiteral(" ms")
+             << QStringLiteral(", mean = ") << meanUsec << QStringLiteral(" us")
+             << QStringLiteral(", min = ") << m_minUsec << QStringLiteral(" us")
+             << QStringLiteral(", p50 <= ") << percentileUpperBoundUsec(50.0) << QStringLiteral(" us")
+             << QStringLiteral(", p90 <= ") << percentileUpperBoundUsec(90.0) << QStringLiteral(" us")
+             << QStringLiteral(", p99 <= ") << percentileUpperBoundUsec(99.0) << QStringLiteral(" us")
+             << QStringLiteral(", max = ") << m_maxUsec << QStringLiteral(" us");
+    }
+
+private:
+    quint64     m_count;
+    qint64      m_sumUsec;
+    qint64      m_minUsec;
+    qint64      m_maxUsec;
+    quint64     m_buckets[MODEL_INSTRUMENTATION_NUM_HISTOGRAM_BUCKETS];
+};
+
+struct PendingRequest
+{
+    PendingRequest() :
+        m_requestName(Q_NULLPTR),
+        m_timer()
+    {}
+
+    const char *    m_requestName;
+    QElapsedTimer   m_timer;
+};
+
+// NOTE: the keys are string literals coming from the instrumentation points; the pointers are used as keys
+// to avoid constructing the strings on each measurement; the same names coming from different instrumentation
+// points might have different addresses so the histograms are merged by name for the report
+QHash<const char*, Histogram> & requestLatencies()
+{
+    static QHash<const char*, Histogram> latencies;
+    return latencies;
+}
+
+QHash<const char*, Histogram> & handlerTimes()
+{
+    static QHash<const char*, Histogram> times;
+    return times;
+}
+
+QHash<QUuid, PendingRequest> & pendingRequests()
+{
+    static QHash<QUuid, PendingRequest> requests;
+    return requests;
+}
+
+void printHistograms(const QHash<const char*, Histogram> & histograms, QTextStream & strm)
+{
+    // Sort by name for the report to be stable between the dumps
+    QMap<QString, Histogram> sortedHistograms;
+    for(auto it = histograms.constBegin(), end = histograms.constEnd(); it != end; ++it) {
+        sortedHistograms[QString::fromUtf8(it.key())].merge(it.value());
+    }
+
+    for(auto it = sortedHistograms.constBegin(), end = sortedHistograms.constEnd(); it != end; ++it) {
+        strm << it.key() << QStringLiteral(": ");
+        it.value().print(strm);
+        strm << QStringLiteral("\n");
+    }
+}
+
+} // namespace
+
+bool ModelInstrumentation::m_enabled = false;
+
+void ModelInstrumentation::setEnabled(const bool enabled)
+{
+    QNDEBUG(QStringLiteral("ModelInstrumentation::setEnabled: ") << (enabled ? QStringLiteral("true") : QStringLiteral("false")));
+
+    m_enabled = enabled;
+    if (!m_enabled) {
+        pendingRequests().clear();
+    }
+}
+
+void ModelInstrumentation::onRequestSent(const QUuid & requestId, const char * requestName)
+{
+    QHash<QUuid, PendingRequest> & requests = pendingRequests();
+    if (Q_UNLIKELY(requests.size() >= MODEL_INSTRUMENTATION_MAX_NUM_PENDING_REQUESTS)) {
+        QNDEBUG(QStringLiteral("Too many requests without responses, dropping them"));
+        requests.clear();
+    }
+
+    PendingRequest & request = requests[requestId];
+    request.m_requestName = requestName;
+    request.m_timer.start();
+}
+
+void ModelInstrumentation::onResponseReceived(const QUuid & requestId)
+{
+    // NOTE: several models might handle the response to the same request, the latency is recorded for the first one
+    QHash<QUuid, PendingRequest> & requests = pendingRequests();
+    auto it = requests.find(requestId);
+    if (it == requests.end()) {
+        return;
+    }
+
+    requestLatencies()[it->m_requestName].add(it->m_timer.nsecsElapsed() / 1000);
+    Q_UNUSED(requests.erase(it))
+}
+
+void ModelInstrumentation::onHandlerFinished(const char * handlerName, const qint64 nsecsElapsed)
+{
+    handlerTimes()[handlerName].add(nsecsElapsed / 1000);
+}
+
+void ModelInstrumentation::reset()
+{
+    requestLatencies().clear();
+    handlerTimes().clear();
+    pendingRequests().clear();
+}
+
+QString ModelInstrumentation::report()
+{
+    QString result;
+    QTextStream strm(&result);
+
+    strm << QStringLiteral("Model instrumentation report, ")
+         << QDateTime::currentDateTime().toString(Qt::ISODate) << QStringLiteral("\n\n");
+
+    strm << QStringLiteral("Local storage request latencies:\n");
+    printHistograms(requestLatencies(), strm);
+
+    strm << QStringLiteral("\nGUI thread time within local storage signal handlers:\n");
+    printHistograms(handlerTimes(), strm);
+
+    strm << QStringLiteral("\nRequests awaiting the response: ") << pendingRequests().size() << QStringLiteral("\n");
+
+    strm.flush();
+    return result;
+}
+
+bool ModelInstrumentation::dumpToFile(const QString & filePath, ErrorString & errorDescription)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        errorDescription.setBase(QT_TR_NOOP("Can't open the file for writing the model instrumentation report"));
+        errorDescription.details() = file.errorString();
+        return false;
+    }
+
+    QByteArray data = report().toUtf8();
+    if (file.write(data) != data.size()) {
+        errorDescription.setBase(QT_TR_NOOP("Failed to write the model instrumentation report to the file"));
+        errorDescription.details() = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+ModelInstrumentation::HandlerTimer::HandlerTimer(const char * handlerName, const QUuid & requestId) :
+    m_handlerName(Q_NULLPTR),
+    m_timer()
+{
+    if (Q_LIKELY(!ModelInstrumentation::isEnabled())) {
+        return;
+    }
+
+    m_handlerName = handlerName;
+    ModelInstrumentation::onResponseReceived(requestId);
+    m_timer.start();
+}
+
+ModelInstrumentation::HandlerTimer::~HandlerTimer()
+{
+    if (m_handlerName) {
+        ModelInstrumentation::onHandlerFinished(m_handlerName, m_timer.nsecsElapsed());
+    }
+}
+
+} // namespace quentier
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_MODELS_MODEL_INSTRUMENTATION_H
+#define QUENTIER_MODELS_MODEL_INSTRUMENTATION_H
+
+#include <quentier/utility/Macros.h>
+#include <quentier/types/ErrorString.h>
+#include <QElapsedTimer>
+#include <QString>
+#include <QUuid>
+
+namespace quentier {
+
+/**
+ * @brief The ModelInstrumentation class collects the timings of the models' interaction with the local storage:
+ * the latency between sending the request to LocalStorageManagerAsync and receiving the response to it
+ * (per request type) and the time spent by the GUI thread within the handlers of local storage's signals
+ * (per handler). The timings are accumulated in histograms with power-of-two buckets.
+ *
+ * The instrumentation is disabled by default; while disabled, the instrumentation points cost a single
+ * check of a static flag. The class is intended to be used from the GUI thread only, the one in which
+ * the models live.
+ */
+class ModelInstrumentation
+{
+public:
+    static bool isEnabled() { return m_enabled; }
+    static void setEnabled(const bool enabled);
+
+    /**
+     * @param requestName - the name of the request in the form of "ModelName::signalName"
+     */
+    static void onRequestSent(const QUuid & requestId, const char * requestName);
+    static void onResponseReceived(const QUuid & requestId);
+    static void onHandlerFinished(const char * handlerName, const qint64 nsecsElapsed);
+
+    static void reset();
+
+    static QString report();
+    static bool dumpToFile(const QString & filePath, ErrorString & errorDescription);
+
+    class HandlerTimer
+    {
+    public:
+        HandlerTimer(const char * handlerName, const QUuid & requestId);
+        ~HandlerTimer();
+
+    private:
+        Q_DISABLE_COPY(HandlerTimer)
+
+    private:
+        const char *    m_handlerName;
+        QElapsedTimer   m_timer;
+    };
+
+private:
+    ModelInstrumentation() Q_DECL_EQ_DELETE;
+    Q_DISABLE_COPY(ModelInstrumentation)
+
+private:
+    static bool m_enabled;
+};
+
+} // namespace quentier
+
+#define QUENTIER_MODEL_REQUEST_SENT(requestId, requestName) \
+    do { \
+        if (Q_UNLIKELY(quentier::ModelInstrumentation::isEnabled())) { \
+            quentier::ModelInstrumentation::onRequestSent(requestId, requestName); \
+        } \
+    } while(false)
+
+#define QUENTIER_MODEL_HANDLER_TIMER(handlerName, requestId) \
+    quentier::ModelInstrumentation::HandlerTimer modelHandlerTimer(handlerName, requestId)
+
+#endif // QUENTIER_MODELS_MODEL_INSTRUMENTATION_H
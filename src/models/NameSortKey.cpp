@@ -0,0 +1,68 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NameSortKey.h"
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 2, 0)
+#include <QCollator>
+#include <QLocale>
+#endif
+
+namespace quentier {
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 2, 0)
+
+// The models live in the GUI thread so the single collator is enough; it is built for the system locale,
+// the one QString::localeAwareCompare collates the strings for
+static const QCollator & nameCollator()
+{
+    static const QCollator collator(QLocale::system());
+    return collator;
+}
+
+NameSortKey::NameSortKey() :
+    m_key(nameCollator().sortKey(QString()))
+{}
+
+NameSortKey::NameSortKey(const QString & name) :
+    m_key(nameCollator().sortKey(name))
+{}
+
+int NameSortKey::compare(const NameSortKey & other) const
+{
+    return m_key.compare(other.m_key);
+}
+
+#else
+
+NameSortKey::NameSortKey() :
+    m_key()
+{}
+
+NameSortKey::NameSortKey(const QString & name) :
+    m_key(name)
+{}
+
+int NameSortKey::compare(const NameSortKey & other) const
+{
+    return m_key.localeAwareCompare(other.m_key);
+}
+
+#endif
+
+} // namespace quentier
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_MODELS_NAME_SORT_KEY_H
+#define QUENTIER_MODELS_NAME_SORT_KEY_H
+
+#include <QString>
+#include <QtGlobal>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 2, 0)
+#include <QCollatorSortKey>
+#endif
+
+namespace quentier {
+
+/**
+ * @brief The NameSortKey class holds the collation key for the name of the model item: it is computed once,
+ * when the name is set, so that the comparison of names while sorting the model's items doesn't need to run
+ * the locale aware collation of strings for every pair of compared items.
+ *
+ * The keys are computed by the collator for the system locale, the same locale QString::localeAwareCompare uses
+ * to compare the strings; with Qt4 there's no collation key API so the key is just the name itself compared
+ * via QString::localeAwareCompare.
+ */
+class NameSortKey
+{
+public:
+    NameSortKey();
+    explicit NameSortKey(const QString & name);
+
+    /**
+     * @return negative value if this key goes before the other one, positive value if it goes after the other one
+     * and zero if the keys are equal
+     */
+    int compare(const NameSortKey & other) const;
+
+private:
+#if QT_VERSION >= QT_VERSION_CHECK(5, 2, 0)
+    QCollatorSortKey    m_key;
+#else
+    QString             m_key;
+#endif
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_MODELS_NAME_SORT_KEY_H
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteFieldsUpdate.h"
+
+#define MERGE_FIELD(field) \
+    if (other.field.isSet()) { \
+        field = other.field.ref(); \
+    }
+
+#define PRINT_FIELD(field, name) \
+    if (field.isSet()) { \
+        strm << QStringLiteral("  " name " = ") << field.ref() << QStringLiteral(";\n"); \
+    }
+
+namespace quentier {
+
+NoteFieldsUpdate::NoteFieldsUpdate() :
+    m_title(),
+    m_favorited(),
+    m_active(),
+    m_local(),
+    m_dirty(),
+    m_notebookLocalUid(),
+    m_notebookGuid(),
+    m_tagLocalUids(),
+    m_tagGuids(),
+    m_creationTimestamp(),
+    m_modificationTimestamp(),
+    m_deletionTimestamp()
+{}
+
+void NoteFieldsUpdate::setNotebook(const QString & notebookLocalUid, const QString & notebookGuid)
+{
+    m_notebookLocalUid = notebookLocalUid;
+    m_notebookGuid = notebookGuid;
+}
+
+void NoteFieldsUpdate::setTags(const QStringList & tagLocalUids, const QStringList & tagGuids)
+{
+    m_tagLocalUids = tagLocalUids;
+    m_tagGuids = tagGuids;
+}
+
+bool NoteFieldsUpdate::isEmpty() const
+{
+    return !m_title.isSet() && !m_favorited.isSet() && !m_active.isSet() && !m_local.isSet() &&
+           !m_dirty.isSet() && !m_notebookLocalUid.isSet() && !m_tagLocalUids.isSet() &&
+           !m_creationTimestamp.isSet() && !m_modificationTimestamp.isSet() && !m_deletionTimestamp.isSet();
+}
+
+void NoteFieldsUpdate::merge(const NoteFieldsUpdate & other)
+{
+    MERGE_FIELD(m_title)
+    MERGE_FIELD(m_favorited)
+    MERGE_FIELD(m_active)
+    MERGE_FIELD(m_local)
+    MERGE_FIELD(m_dirty)
+    MERGE_FIELD(m_notebookLocalUid)
+    MERGE_FIELD(m_notebookGuid)
+    MERGE_FIELD(m_tagLocalUids)
+    MERGE_FIELD(m_tagGuids)
+    MERGE_FIELD(m_creationTimestamp)
+    MERGE_FIELD(m_modificationTimestamp)
+    MERGE_FIELD(m_deletionTimestamp)
+}
+
+bool NoteFieldsUpdate::apply(Note & note) const
+{
+    bool changed = false;
+
+    if (m_title.isSet() && ((note.hasTitle() ? note.title() : QString()) != m_title.ref())) {
+        note.setTitle(m_title.ref());
+        changed = true;
+    }
+
+    if (m_favorited.isSet() && (note.isFavorited() != m_favorited.ref())) {
+        note.setFavorited(m_favorited.ref());
+        changed = true;
+    }
+
+    if (m_active.isSet() && (!note.hasActive() || (note.active() != m_active.ref()))) {
+        note.setActive(m_active.ref());
+        changed = true;
+    }
+
+    if (m_local.isSet() && (note.isLocal() != m_local.ref())) {
+        note.setLocal(m_local.ref());
+        changed = true;
+    }
+
+    if (m_notebookLocalUid.isSet() && (!note.hasNotebookLocalUid() || (note.notebookLocalUid() != m_notebookLocalUid.ref())))
+    {
+        note.setNotebookLocalUid(m_notebookLocalUid.ref());
+        note.setNotebookGuid(m_notebookGuid.isSet() ? m_notebookGuid.ref() : QString());
+        changed = true;
+    }
+
+    if (m_tagLocalUids.isSet() && (note.tagLocalUids() != m_tagLocalUids.ref()))
+    {
+        note.setTagLocalUids(m_tagLocalUids.ref());
+        note.setTagGuids(m_tagGuids.isSet() ? m_tagGuids.ref() : QStringList());
+        changed = true;
+    }
+
+    if (m_creationTimestamp.isSet() &&
+        ((note.hasCreationTimestamp() ? note.creationTimestamp() : qint64(-1)) != m_creationTimestamp.ref()))
+    {
+        note.setCreationTimestamp(m_creationTimestamp.ref());
+        changed = true;
+    }
+
+    // NOTE: the models represent the missing timestamps by negative values
+    if (m_deletionTimestamp.isSet() &&
+        ((note.hasDeletionTimestamp() ? note.deletionTimestamp() : qint64(-1)) != m_deletionTimestamp.ref()))
+    {
+        note.setDeletionTimestamp(m_deletionTimestamp.ref());
+        changed = true;
+    }
+
+    // Modification timestamp and dirty flag only accompany the changes of other fields
+    if (changed)
+    {
+        if (m_modificationTimestamp.isSet()) {
+            note.setModificationTimestamp(m_modificationTimestamp.ref());
+        }
+
+        if (m_dirty.isSet()) {
+            note.setDirty(m_dirty.ref());
+        }
+    }
+
+    return changed;
+}
+
+QTextStream & NoteFieldsUpdate::print(QTextStream & strm) const
+{
+    strm << QStringLiteral("NoteFieldsUpdate: {\n");
+
+    PRINT_FIELD(m_title, "title")
+    PRINT_FIELD(m_favorited, "favorited")
+    PRINT_FIELD(m_active, "active")
+    PRINT_FIELD(m_local, "local")
+    PRINT_FIELD(m_dirty, "dirty")
+    PRINT_FIELD(m_notebookLocalUid, "notebook local uid")
+    PRINT_FIELD(m_notebookGuid, "notebook guid")
+
+    if (m_tagLocalUids.isSet()) {
+        strm << QStringLiteral("  tag local uids = ") << m_tagLocalUids.ref().join(QStringLiteral(", ")) << QStringLiteral(";\n");
+    }
+
+    if (m_tagGuids.isSet()) {
+        strm << QStringLiteral("  tag guids = ") << m_tagGuids.ref().join(QStringLiteral(", ")) << QStringLiteral(";\n");
+    }
+
+    PRINT_FIELD(m_creationTimestamp, "creation timestamp")
+    PRINT_FIELD(m_modificationTimestamp, "modification timestamp")
+    PRINT_FIELD(m_deletionTimestamp, "deletion timestamp")
+
+    strm << QStringLiteral("};\n");
+    return strm;
+}
+
+} // namespace quentier
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_MODELS_NOTE_FIELDS_UPDATE_H
+#define QUENTIER_MODELS_NOTE_FIELDS_UPDATE_H
+
+#include <quentier/types/Note.h>
+#include <quentier/utility/Printable.h>
+#include <QStringList>
+
+namespace quentier {
+
+/**
+ * @brief The NoteFieldsUpdate class represents the change of a few note fields owned by the models
+ * (title, favorited flag, notebook, tags, deletion state and the like) to be applied to the note
+ * in the local storage.
+ *
+ * The update carries only the modified fields and is applied on top of the most recent version of the note
+ * found in the note cache or in the local storage so that it doesn't revert the concurrent changes of other fields
+ * (i.e. the note content edited in the note editor meanwhile). Several updates of the same note issued while
+ * the note is being looked up in the local storage are merged into one so that they cost a single read
+ * and a single write.
+ */
+class NoteFieldsUpdate: public Printable
+{
+public:
+    NoteFieldsUpdate();
+
+    void setTitle(const QString & title) { m_title = title; }
+    void setFavorited(const bool favorited) { m_favorited = favorited; }
+    void setActive(const bool active) { m_active = active; }
+    void setLocal(const bool local) { m_local = local; }
+    void setDirty(const bool dirty) { m_dirty = dirty; }
+
+    void setNotebook(const QString & notebookLocalUid, const QString & notebookGuid);
+    void setTags(const QStringList & tagLocalUids, const QStringList & tagGuids);
+
+    void setCreationTimestamp(const qint64 timestamp) { m_creationTimestamp = timestamp; }
+    void setModificationTimestamp(const qint64 timestamp) { m_modificationTimestamp = timestamp; }
+    void setDeletionTimestamp(const qint64 timestamp) { m_deletionTimestamp = timestamp; }
+
+    bool isEmpty() const;
+    bool updatesTags() const { return m_tagLocalUids.isSet(); }
+
+    /**
+     * @brief merge - adds the fields set in the other update to this one; the fields set in both updates
+     * take their values from the other one as from the more recent update
+     */
+    void merge(const NoteFieldsUpdate & other);
+
+    /**
+     * @brief apply - sets the fields of the update to the note
+     * @return true if any field of the note was actually changed, false otherwise
+     */
+    bool apply(Note & note) const;
+
+    virtual QTextStream & print(QTextStream & strm) const Q_DECL_OVERRIDE;
+
+private:
+    qevercloud::Optional<QString>       m_title;
+    qevercloud::Optional<bool>          m_favorited;
+    qevercloud::Optional<bool>          m_active;
+    qevercloud::Optional<bool>          m_local;
+    qevercloud::Optional<bool>          m_dirty;
+    qevercloud::Optional<QString>       m_notebookLocalUid;
+    qevercloud::Optional<QString>       m_notebookGuid;
+    qevercloud::Optional<QStringList>   m_tagLocalUids;
+    qevercloud::Optional<QStringList>   m_tagGuids;
+    qevercloud::Optional<qint64>        m_creationTimestamp;
+    qevercloud::Optional<qint64>        m_modificationTimestamp;
+    qevercloud::Optional<qint64>        m_deletionTimestamp;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_MODELS_NOTE_FIELDS_UPDATE_H
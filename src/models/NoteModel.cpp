@@ -17,12 +17,14 @@
  */
 
 #include "NoteModel.h"
+#include "ModelInstrumentation.h"
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/UidGenerator.h>
 #include <quentier/utility/Utility.h>
 #include <quentier/types/Resource.h>
 #include <QDateTime>
 #include <iterator>
+#include <algorithm>
 
 // Separate logging macros for the note model - to distinguish the one
 // for deleted notes from the one for non-deleted notes
@@ -97,6 +99,8 @@ NoteModel::NoteModel(const Account & account, LocalStorageManagerAsync & localSt
     m_findNotebookRequestForNotebookLocalUid(),
     m_noteItemsPendingNotebookDataUpdate(),
     m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap(),
+    m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook(),
+    m_pendingNoteFieldsUpdatesByNoteLocalUid(),
     m_tagDataByTagLocalUid(),
     m_findTagRequestForTagLocalUid(),
     m_tagLocalUidToNoteLocalUid(),
@@ -276,6 +280,7 @@ void NoteModel::moveNoteToNotebook(const QString & noteLocalUid, const QString &
     NMTRACE(QStringLiteral("Emitting the request to find a notebook by name for moving the note to it: request id = ")
             << requestId << QStringLiteral(", notebook name = ") << notebookName << QStringLiteral(", note local uid = ")
             << noteLocalUid);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::findNotebook");
     Q_EMIT findNotebook(dummy, requestId);
 }
 
@@ -291,6 +296,262 @@ void NoteModel::unfavoriteNote(const QString & noteLocalUid)
     setNoteFavorited(noteLocalUid, false);
 }
 
+bool NoteModel::deleteNotes(const QStringList & noteLocalUids)
+{
+    NMINFO(QStringLiteral("NoteModel::deleteNotes: ") << noteLocalUids.size() << QStringLiteral(" notes"));
+
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            REPORT_ERROR(QT_TR_NOOP("Can't delete the notes: internal error, can't find one of notes "
+                                    "within the note model by local uid"));
+            return false;
+        }
+
+        if (!canUpdateNoteItem(*itemIt)) {
+            REPORT_ERROR(QT_TR_NOOP("Can't delete the notes: one of notes belongs to the notebook "
+                                    "which doesn't allow to update notes"));
+            return false;
+        }
+    }
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    QList<NoteModelItem> deletedItems;
+    deletedItems.reserve(noteLocalUids.size());
+
+    QStringList deletedNoteLocalUids;
+    deletedNoteLocalUids.reserve(noteLocalUids.size());
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (itemIt->deletionTimestamp() >= 0) {
+            continue;
+        }
+
+        NoteModelItem item = *itemIt;
+        item.setDeletionTimestamp(timestamp);
+        item.setActive(false);
+        item.setDirty(true);
+
+        if (m_includedNotes != IncludedNotes::NonDeleted) {
+            item.setModificationTimestamp(timestamp);
+        }
+
+        Q_UNUSED(localUidIndex.replace(itemIt, item))
+        deletedItems << item;
+        deletedNoteLocalUids << item.localUid();
+    }
+
+    if (deletedItems.isEmpty()) {
+        NMDEBUG(QStringLiteral("All the notes are already deleted, nothing to do"));
+        return true;
+    }
+
+    if (m_includedNotes == IncludedNotes::NonDeleted)
+    {
+        // The deleted notes would be removed from the model one by one on update completions anyway,
+        // removing them right away allows to remove them with a few grouped changes
+        removeItemsByLocalUids(deletedNoteLocalUids);
+
+        for(auto it = deletedItems.constBegin(), end = deletedItems.constEnd(); it != end; ++it) {
+            updateNoteInLocalStorage(*it);
+        }
+
+        return true;
+    }
+
+    notifyItemsChanged(deletedNoteLocalUids, Columns::ModificationTimestamp, Columns::Dirty);
+
+    if ((m_sortedColumn == Columns::ModificationTimestamp) || (m_sortedColumn == Columns::DeletionTimestamp) ||
+        (m_sortedColumn == Columns::Dirty))
+    {
+        sortItems();
+    }
+
+    for(auto it = deletedItems.constBegin(), end = deletedItems.constEnd(); it != end; ++it) {
+        updateNoteInLocalStorage(*it);
+    }
+
+    return true;
+}
+
+bool NoteModel::expungeNotes(const QStringList & noteLocalUids)
+{
+    NMINFO(QStringLiteral("NoteModel::expungeNotes: ") << noteLocalUids.size() << QStringLiteral(" notes"));
+
+    const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            REPORT_ERROR(QT_TR_NOOP("Can't expunge the notes: internal error, can't find one of notes "
+                                    "within the note model by local uid"));
+            return false;
+        }
+
+        if (!itemIt->guid().isEmpty()) {
+            REPORT_ERROR(QT_TR_NOOP("Can't remove the synchronizable note"));
+            return false;
+        }
+    }
+
+    removeItemsByLocalUids(noteLocalUids);
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        Note note;
+        note.setLocalUid(*it);
+
+        QUuid requestId = QUuid::createUuid();
+        Q_UNUSED(m_expungeNoteRequestIds.insert(requestId))
+        NMTRACE(QStringLiteral("Emitting the request to expunge the note from the local storage: request id = ")
+                << requestId << QStringLiteral(", note local uid: ") << *it);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::expungeNote");
+        Q_EMIT expungeNote(note, requestId);
+    }
+
+    return true;
+}
+
+void NoteModel::moveNotesToNotebook(const QStringList & noteLocalUids, const QString & notebookName)
+{
+    NMDEBUG(QStringLiteral("NoteModel::moveNotesToNotebook: ") << noteLocalUids.size()
+            << QStringLiteral(" notes, notebook name = ") << notebookName);
+
+    if (Q_UNLIKELY(notebookName.isEmpty())) {
+        REPORT_ERROR(QT_TR_NOOP("Can't move the notes to another notebook: the name of the target notebook is empty"));
+        return;
+    }
+
+    if (noteLocalUids.isEmpty()) {
+        return;
+    }
+
+    for(auto nit = m_notebookCache.begin(), end = m_notebookCache.end(); nit != end; ++nit)
+    {
+        const Notebook & notebook = nit->second;
+        if (notebook.hasName() && (notebook.name() == notebookName)) {
+            moveNotesToNotebookImpl(noteLocalUids, notebook);
+            return;
+        }
+    }
+
+    // The single lookup of the target notebook serves the whole batch
+    Notebook dummy;
+    dummy.setName(notebookName);
+    dummy.setLocalUid(QString());
+    QUuid requestId = QUuid::createUuid();
+    m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook[requestId] = noteLocalUids;
+    NMTRACE(QStringLiteral("Emitting the request to find a notebook by name for moving the notes to it: request id = ")
+            << requestId << QStringLiteral(", notebook name = ") << notebookName);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::findNotebook");
+    Q_EMIT findNotebook(dummy, requestId);
+}
+
+void NoteModel::favoriteNotes(const QStringList & noteLocalUids)
+{
+    NMDEBUG(QStringLiteral("NoteModel::favoriteNotes: ") << noteLocalUids.size() << QStringLiteral(" notes"));
+    setNotesFavorited(noteLocalUids, true);
+}
+
+void NoteModel::unfavoriteNotes(const QStringList & noteLocalUids)
+{
+    NMDEBUG(QStringLiteral("NoteModel::unfavoriteNotes: ") << noteLocalUids.size() << QStringLiteral(" notes"));
+    setNotesFavorited(noteLocalUids, false);
+}
+
+bool NoteModel::addTagToNotes(const QStringList & noteLocalUids, const QString & tagLocalUid)
+{
+    NMDEBUG(QStringLiteral("NoteModel::addTagToNotes: ") << noteLocalUids.size()
+            << QStringLiteral(" notes, tag local uid = ") << tagLocalUid);
+
+    if (Q_UNLIKELY(tagLocalUid.isEmpty())) {
+        REPORT_ERROR(QT_TR_NOOP("Can't add tag to the notes: the local uid of the tag is empty"));
+        return false;
+    }
+
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            REPORT_ERROR(QT_TR_NOOP("Can't add tag to the notes: internal error, can't find one of notes "
+                                    "within the note model by local uid"));
+            return false;
+        }
+
+        if (!canUpdateNoteItem(*itemIt)) {
+            REPORT_ERROR(QT_TR_NOOP("Can't add tag to the notes: one of notes belongs to the notebook "
+                                    "which doesn't allow to update notes"));
+            return false;
+        }
+    }
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    QList<NoteModelItem> updatedItems;
+    updatedItems.reserve(noteLocalUids.size());
+
+    QStringList updatedNoteLocalUids;
+    updatedNoteLocalUids.reserve(noteLocalUids.size());
+
+    auto tagDataIt = m_tagDataByTagLocalUid.find(tagLocalUid);
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (itemIt->hasTagLocalUid(tagLocalUid)) {
+            continue;
+        }
+
+        NoteModelItem item = *itemIt;
+        item.addTagLocalUid(tagLocalUid);
+
+        if (tagDataIt != m_tagDataByTagLocalUid.end())
+        {
+            if (!tagDataIt->m_guid.isEmpty()) {
+                item.addTagGuid(tagDataIt->m_guid);
+            }
+        }
+
+        // NOTE: findTagNamesForItem appends the names of all the note's tags it knows about
+        // and requests the data of unknown tags from the local storage
+        item.setTagNameList(QStringList());
+        findTagNamesForItem(item);
+
+        item.setDirty(true);
+        item.setModificationTimestamp(timestamp);
+
+        Q_UNUSED(localUidIndex.replace(itemIt, item))
+        updatedItems << item;
+        updatedNoteLocalUids << item.localUid();
+    }
+
+    if (updatedItems.isEmpty()) {
+        NMDEBUG(QStringLiteral("All the notes already have this tag, nothing to do"));
+        return true;
+    }
+
+    notifyItemsChanged(updatedNoteLocalUids, Columns::ModificationTimestamp, Columns::Dirty);
+
+    if ((m_sortedColumn == Columns::ModificationTimestamp) || (m_sortedColumn == Columns::Dirty)) {
+        sortItems();
+    }
+
+    for(auto it = updatedItems.constBegin(), end = updatedItems.constEnd(); it != end; ++it) {
+        updateNoteInLocalStorage(*it, /* update tags = */ true);
+    }
+
+    return true;
+}
+
 bool NoteModel::notebookContainsSyncronizedNotes(const QString & notebookLocalUid) const
 {
     if (notebookLocalUid.isEmpty()) {
@@ -700,6 +961,7 @@ bool NoteModel::removeRows(int row, int count, const QModelIndex & parent)
         Q_UNUSED(m_expungeNoteRequestIds.insert(requestId))
         NMTRACE(QStringLiteral("Emitting the request to expunge the note from the local storage: request id = ")
                 << requestId << QStringLiteral(", note local uid: ") << *it);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::expungeNote");
         Q_EMIT expungeNote(note, requestId);
     }
 
@@ -748,6 +1010,15 @@ void NoteModel::sort(int column, Qt::SortOrder order)
     m_sortedColumn = static_cast<Columns::type>(column);
     m_sortOrder = order;
 
+    sortItems();
+}
+
+void NoteModel::sortItems()
+{
+    NMTRACE(QStringLiteral("NoteModel::sortItems"));
+
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+
     Q_EMIT layoutAboutToBeChanged();
 
     QModelIndexList persistentIndices = persistentIndexList();
@@ -811,6 +1082,8 @@ void NoteModel::sort(int column, Qt::SortOrder order)
 
 void NoteModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onAddNoteComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onAddNoteComplete: ") << note << QStringLiteral("\nRequest id = ") << requestId);
 
     ++m_numberOfNotesPerAccount;
@@ -826,6 +1099,8 @@ void NoteModel::onAddNoteComplete(Note note, QUuid requestId)
 
 void NoteModel::onAddNoteFailed(Note note, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onAddNoteFailed", requestId);
+
     auto it = m_addNoteRequestIds.find(requestId);
     if (it == m_addNoteRequestIds.end()) {
         return;
@@ -842,6 +1117,8 @@ void NoteModel::onAddNoteFailed(Note note, ErrorString errorDescription, QUuid r
 
 void NoteModel::onUpdateNoteComplete(Note note, bool updateResources, bool updateTags, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onUpdateNoteComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onUpdateNoteComplete: note = ") << note << QStringLiteral("\nRequest id = ") << requestId);
 
     Q_UNUSED(updateResources)
@@ -901,6 +1178,8 @@ void NoteModel::onUpdateNoteComplete(Note note, bool updateResources, bool updat
 void NoteModel::onUpdateNoteFailed(Note note, bool updateResources, bool updateTags,
                                    ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onUpdateNoteFailed", requestId);
+
     Q_UNUSED(updateResources)
     Q_UNUSED(updateTags)
 
@@ -918,11 +1197,14 @@ void NoteModel::onUpdateNoteFailed(Note note, bool updateResources, bool updateT
     Q_UNUSED(m_findNoteToRestoreFailedUpdateRequestIds.insert(requestId))
     NMTRACE(QStringLiteral("Emitting the request to find a note: local uid = ") << note.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::findNote");
     Q_EMIT findNote(note, /* with resource metadata = */ true, /* with resource binary data = */ false, requestId);
 }
 
 void NoteModel::onFindNoteComplete(Note note, bool withResourceMetadata, bool withResourceBinaryData, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onFindNoteComplete", requestId);
+
     Q_UNUSED(withResourceMetadata)
     Q_UNUSED(withResourceBinaryData)
 
@@ -948,10 +1230,11 @@ void NoteModel::onFindNoteComplete(Note note, bool withResourceMetadata, bool wi
 
         m_cache.put(note.localUid(), note);
 
-        NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
-        auto it = localUidIndex.find(note.localUid());
-        if (it != localUidIndex.end()) {
-            updateNoteInLocalStorage(*it);
+        auto pendingUpdateIt = m_pendingNoteFieldsUpdatesByNoteLocalUid.find(note.localUid());
+        if (pendingUpdateIt != m_pendingNoteFieldsUpdatesByNoteLocalUid.end()) {
+            NoteFieldsUpdate update = pendingUpdateIt.value();
+            Q_UNUSED(m_pendingNoteFieldsUpdatesByNoteLocalUid.erase(pendingUpdateIt))
+            updateNoteFieldsInLocalStorage(note.localUid(), update);
         }
     }
 }
@@ -959,6 +1242,8 @@ void NoteModel::onFindNoteComplete(Note note, bool withResourceMetadata, bool wi
 void NoteModel::onFindNoteFailed(Note note, bool withResourceMetadata, bool withResourceBinaryData,
                                  ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onFindNoteFailed", requestId);
+
     Q_UNUSED(withResourceMetadata)
     Q_UNUSED(withResourceBinaryData)
 
@@ -978,6 +1263,7 @@ void NoteModel::onFindNoteFailed(Note note, bool withResourceMetadata, bool with
     }
     else if (performUpdateIt != m_findNoteToPerformUpdateRequestIds.end()) {
         Q_UNUSED(m_findNoteToPerformUpdateRequestIds.erase(performUpdateIt))
+        Q_UNUSED(m_pendingNoteFieldsUpdatesByNoteLocalUid.remove(note.localUid()))
     }
 
     Q_EMIT notifyError(errorDescription);
@@ -989,6 +1275,8 @@ void NoteModel::onListNotesComplete(LocalStorageManager::ListObjectsOptions flag
                                     LocalStorageManager::OrderDirection::type orderDirection,
                                     QString linkedNotebookGuid, QList<Note> foundNotes, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onListNotesComplete", requestId);
+
     if (requestId != m_listNotesRequestId) {
         return;
     }
@@ -1023,6 +1311,8 @@ void NoteModel::onListNotesFailed(LocalStorageManager::ListObjectsOptions flag,
                                   LocalStorageManager::OrderDirection::type orderDirection,
                                   QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onListNotesFailed", requestId);
+
     if (requestId != m_listNotesRequestId) {
         return;
     }
@@ -1040,6 +1330,8 @@ void NoteModel::onListNotesFailed(LocalStorageManager::ListObjectsOptions flag,
 
 void NoteModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onExpungeNoteComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onExpungeNoteComplete: note = ") << note << QStringLiteral("\nRequest id = ") << requestId);
 
     --m_numberOfNotesPerAccount;
@@ -1055,6 +1347,8 @@ void NoteModel::onExpungeNoteComplete(Note note, QUuid requestId)
 
 void NoteModel::onExpungeNoteFailed(Note note, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onExpungeNoteFailed", requestId);
+
     auto it = m_expungeNoteRequestIds.find(requestId);
     if (it == m_expungeNoteRequestIds.end()) {
         return;
@@ -1070,13 +1364,18 @@ void NoteModel::onExpungeNoteFailed(Note note, ErrorString errorDescription, QUu
 
 void NoteModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onFindNotebookComplete", requestId);
+
     auto fit = m_findNotebookRequestForNotebookLocalUid.right.find(requestId);
     auto mit = ((fit == m_findNotebookRequestForNotebookLocalUid.right.end())
-                ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()
-                : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId));
+                ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId)
+                : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end());
+
+    auto bit = m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.find(requestId);
 
     if ( (fit == m_findNotebookRequestForNotebookLocalUid.right.end()) &&
-         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) )
+         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) &&
+         (bit == m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end()) )
     {
         return;
     }
@@ -1107,17 +1406,28 @@ void NoteModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 
         moveNoteToNotebookImpl(it, notebook);
     }
+    else if (bit != m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end())
+    {
+        QStringList noteLocalUids = bit.value();
+        Q_UNUSED(m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.erase(bit))
+        moveNotesToNotebookImpl(noteLocalUids, notebook);
+    }
 }
 
 void NoteModel::onFindNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onFindNotebookFailed", requestId);
+
     auto fit = m_findNotebookRequestForNotebookLocalUid.right.find(requestId);
     auto mit = ((fit == m_findNotebookRequestForNotebookLocalUid.right.end())
-                ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()
-                : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId));
+                ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId)
+                : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end());
+
+    auto bit = m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.find(requestId);
 
     if ( (fit == m_findNotebookRequestForNotebookLocalUid.right.end()) &&
-         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) )
+         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) &&
+         (bit == m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end()) )
     {
         return;
     }
@@ -1141,10 +1451,23 @@ void NoteModel::onFindNotebookFailed(Notebook notebook, ErrorString errorDescrip
         NMDEBUG(error);
         Q_EMIT notifyError(error);
     }
+    else if (bit != m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end())
+    {
+        Q_UNUSED(m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.erase(bit))
+
+        ErrorString error(QT_TR_NOOP("Can't move the notes to another notebook: failed to find the target notebook"));
+        error.appendBase(errorDescription.base());
+        error.appendBase(errorDescription.additionalBases());
+        error.details() = errorDescription.details();
+        NMDEBUG(error);
+        Q_EMIT notifyError(error);
+    }
 }
 
 void NoteModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onAddNotebookComplete", requestId);
+
     NMDEBUG(QStringLiteral("NoteModel::onAddNotebookComplete: local uid = ") << notebook.localUid());
     Q_UNUSED(requestId)
     m_notebookCache.put(notebook.localUid(), notebook);
@@ -1153,6 +1476,8 @@ void NoteModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NoteModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onUpdateNotebookComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onUpdateNotebookComplete: local uid = ") << notebook.localUid());
     Q_UNUSED(requestId)
     m_notebookCache.put(notebook.localUid(), notebook);
@@ -1161,6 +1486,8 @@ void NoteModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NoteModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onExpungeNotebookComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onExpungeNotebookComplete: local uid = ") << notebook.localUid());
 
     Q_UNUSED(requestId)
@@ -1174,6 +1501,8 @@ void NoteModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NoteModel::onFindTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onFindTagComplete", requestId);
+
     auto it = m_findTagRequestForTagLocalUid.right.find(requestId);
     if (it == m_findTagRequestForTagLocalUid.right.end()) {
         return;
@@ -1189,6 +1518,8 @@ void NoteModel::onFindTagComplete(Tag tag, QUuid requestId)
 
 void NoteModel::onFindTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onFindTagFailed", requestId);
+
     auto it = m_findTagRequestForTagLocalUid.right.find(requestId);
     if (it == m_findTagRequestForTagLocalUid.right.end()) {
         return;
@@ -1204,18 +1535,24 @@ void NoteModel::onFindTagFailed(Tag tag, ErrorString errorDescription, QUuid req
 
 void NoteModel::onAddTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onAddTagComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onAddTagComplete: tag = ") << tag << QStringLiteral(", request id = ") << requestId);
     updateTagData(tag);
 }
 
 void NoteModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onUpdateTagComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onUpdateTagComplete: tag = ") << tag << QStringLiteral(", request id = ") << requestId);
     updateTagData(tag);
 }
 
 void NoteModel::onExpungeTagComplete(Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NoteModel::onExpungeTagComplete", requestId);
+
     NMTRACE(QStringLiteral("NoteModel::onExpungeTagComplete: tag = ") << tag
             << QStringLiteral("\nExpunged child tag local uids = ") << expungedChildTagLocalUids.join(QStringLiteral(", "))
             << QStringLiteral(", request id = ") << requestId);
@@ -1228,6 +1565,30 @@ void NoteModel::onExpungeTagComplete(Tag tag, QStringList expungedChildTagLocalU
     }
 }
 
+void NoteModel::connectToLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    NMDEBUG(QStringLiteral("NoteModel::connectToLocalStorage"));
+    createConnections(localStorageManagerAsync);
+}
+
+void NoteModel::disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    NMDEBUG(QStringLiteral("NoteModel::disconnectFromLocalStorage"));
+    QObject::disconnect(this, Q_NULLPTR, &localStorageManagerAsync, Q_NULLPTR);
+    QObject::disconnect(&localStorageManagerAsync, Q_NULLPTR, this, Q_NULLPTR);
+}
+
+bool NoteModel::hasPendingRequests() const
+{
+    return !m_listNotesRequestId.isNull() || !m_addNoteRequestIds.isEmpty() || !m_updateNoteRequestIds.isEmpty() ||
+           !m_expungeNoteRequestIds.isEmpty() || !m_findNoteToRestoreFailedUpdateRequestIds.isEmpty() ||
+           !m_findNoteToPerformUpdateRequestIds.isEmpty() ||
+           !m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.isEmpty() ||
+           !m_pendingNoteFieldsUpdatesByNoteLocalUid.isEmpty() || !m_findNotebookRequestForNotebookLocalUid.empty() ||
+           !m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.empty() ||
+           !m_findTagRequestForTagLocalUid.empty();
+}
+
 void NoteModel::createConnections(LocalStorageManagerAsync & localStorageManagerAsync)
 {
     NMTRACE(QStringLiteral("NoteModel::createConnections"));
@@ -1343,6 +1704,7 @@ void NoteModel::requestNotesList()
     NMTRACE(QStringLiteral("Emitting the request to list notes: offset = ") << m_listNotesOffset
             << QStringLiteral(", request id = ") << m_listNotesRequestId << QStringLiteral(", order = ")
             << order << QStringLiteral(", direction = ") << direction);
+    QUENTIER_MODEL_REQUEST_SENT(m_listNotesRequestId, "NoteModel::listNotes");
     Q_EMIT listNotes(flags, /* with resource metadata = */ false, /* with resource binary data = */ false,
                      NOTE_LIST_LIMIT, m_listNotesOffset, order, direction, QString(), m_listNotesRequestId);
 }
@@ -1604,6 +1966,55 @@ void NoteModel::removeItemByLocalUid(const QString & localUid)
     endRemoveRows();
 }
 
+void NoteModel::removeItemsByLocalUids(const QStringList & localUids)
+{
+    NMDEBUG(QStringLiteral("NoteModel::removeItemsByLocalUids: ") << localUids.size() << QStringLiteral(" items"));
+
+    const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+
+    std::vector<int> rows;
+    rows.reserve(static_cast<size_t>(std::max(localUids.size(), 0)));
+
+    for(auto it = localUids.constBegin(), end = localUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            NMDEBUG(QStringLiteral("Can't find item to remove from the note model: ") << *it);
+            continue;
+        }
+
+        auto indexIt = m_data.project<ByIndex>(itemIt);
+        rows.push_back(static_cast<int>(std::distance(index.begin(), indexIt)));
+    }
+
+    if (rows.empty()) {
+        return;
+    }
+
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // Going from the last range to the first one keeps the rows of the not yet removed ranges intact
+    size_t rangeEnd = rows.size();
+    while(rangeEnd > 0)
+    {
+        size_t rangeStart = rangeEnd - 1;
+        while((rangeStart > 0) && (rows[rangeStart - 1] == rows[rangeStart] - 1)) {
+            --rangeStart;
+        }
+
+        int firstRow = rows[rangeStart];
+        int lastRow = rows[rangeEnd - 1];
+
+        beginRemoveRows(QModelIndex(), firstRow, lastRow);
+        Q_UNUSED(index.erase(index.begin() + firstRow, index.begin() + lastRow + 1))
+        endRemoveRows();
+
+        rangeEnd = rangeStart;
+    }
+}
+
 void NoteModel::updateItemRowWithRespectToSorting(const NoteModelItem & item)
 {
     NMDEBUG(QStringLiteral("NoteModel::updateItemRowWithRespectToSorting: item local uid = ")
@@ -1631,33 +2042,36 @@ void NoteModel::updateItemRowWithRespectToSorting(const NoteModelItem & item)
         return;
     }
 
-    NoteModelItem itemCopy(item);
+    NoteComparator comparator(m_sortedColumn, m_sortOrder);
 
-    NMTRACE(QStringLiteral("Removing the moved item from the original row ") << originalRow);
-    beginRemoveRows(QModelIndex(), originalRow, originalRow);
-    Q_UNUSED(index.erase(it))
-    endRemoveRows();
+    // The rest of the items are still sorted, so if the item is in order with respect to its neighbours,
+    // it is already at the appropriate row
+    bool inOrderWithPrevious = ((it == index.begin()) || !comparator(item, *(it - 1)));
+    bool inOrderWithNext = ((it + 1 == index.end()) || !comparator(*(it + 1), item));
+    if (inOrderWithPrevious && inOrderWithNext) {
+        NMTRACE(QStringLiteral("The item is already at the appropriate row ") << originalRow);
+        return;
+    }
 
-    auto positionIter = std::lower_bound(index.begin(), index.end(), itemCopy,
-                                         NoteComparator(m_sortedColumn, m_sortOrder));
-    if (positionIter == index.end())
-    {
-        int newRow = static_cast<int>(index.size());
+    // Looking up the appropriate position among the other items, before the item's row if it should be moved up
+    // and after it otherwise
+    auto positionIter = (inOrderWithPrevious
+                         ? std::lower_bound(it + 1, index.end(), item, comparator)
+                         : std::lower_bound(index.begin(), it, item, comparator));
+    int destinationRow = static_cast<int>(std::distance(index.begin(), positionIter));
 
-        NMTRACE(QStringLiteral("Inserting the moved item at row ") << newRow);
-        beginInsertRows(QModelIndex(), newRow, newRow);
-        index.push_back(itemCopy);
-        endInsertRows();
+    NMTRACE(QStringLiteral("Moving the item from row ") << originalRow << QStringLiteral(" to the position before row ")
+            << destinationRow);
 
+    bool res = beginMoveRows(QModelIndex(), originalRow, originalRow, QModelIndex(), destinationRow);
+    if (Q_UNLIKELY(!res)) {
+        NMWARNING(QStringLiteral("Internal error, can't move row within the note model for sorting purposes: from row ")
+                  << originalRow << QStringLiteral(" to the position before row ") << destinationRow);
         return;
     }
 
-    int newRow = static_cast<int>(std::distance(index.begin(), positionIter));
-
-    NMTRACE(QStringLiteral("Inserting the moved item at row ") << newRow);
-    beginInsertRows(QModelIndex(), newRow, newRow);
-    Q_UNUSED(index.insert(positionIter, itemCopy))
-    endInsertRows();
+    index.relocate(positionIter, it);
+    endMoveRows();
 }
 
 void NoteModel::updateNoteInLocalStorage(const NoteModelItem & item, const bool updateTags)
@@ -1666,67 +2080,135 @@ void NoteModel::updateNoteInLocalStorage(const NoteModelItem & item, const bool
             << item.localUid() << QStringLiteral(", update tags = ")
             << (updateTags ? QStringLiteral("true") : QStringLiteral("false")));
 
-    Note note;
-
     auto notYetSavedItemIt = m_noteItemsNotYetInLocalStorageUids.find(item.localUid());
-    if (notYetSavedItemIt == m_noteItemsNotYetInLocalStorageUids.end())
+    if (notYetSavedItemIt != m_noteItemsNotYetInLocalStorageUids.end())
     {
-        NMTRACE(QStringLiteral("Updating the note"));
+        Note note;
+        note.setLocalUid(item.localUid());
+        note.setGuid(item.guid());
+        note.setNotebookLocalUid(item.notebookLocalUid());
+        note.setNotebookGuid(item.notebookGuid());
+        note.setCreationTimestamp(item.creationTimestamp());
+        note.setModificationTimestamp(item.modificationTimestamp());
+        note.setDeletionTimestamp(item.deletionTimestamp());
+        note.setTagLocalUids(item.tagLocalUids());
+        note.setTagGuids(item.tagGuids());
+        note.setTitle(item.title());
+        note.setLocal(!item.isSynchronizable());
+        note.setDirty(item.isDirty());
+        note.setFavorited(item.isFavorited());
+        note.setActive(item.isActive());
 
-        const Note * pCachedNote = m_cache.get(item.localUid());
-        if (Q_UNLIKELY(!pCachedNote))
-        {
-            QUuid requestId = QUuid::createUuid();
-            Q_UNUSED(m_findNoteToPerformUpdateRequestIds.insert(requestId))
-            Note dummy;
-            dummy.setLocalUid(item.localUid());
-            NMTRACE(QStringLiteral("Emitting the request to find note: local uid = ") << item.localUid()
-                    << QStringLiteral(", request id = ") << requestId);
-            Q_EMIT findNote(dummy, /* with resource metadata = */ true, /* with resource binary data = */ false, requestId);
-            return;
-        }
+        QUuid requestId = QUuid::createUuid();
+        Q_UNUSED(m_addNoteRequestIds.insert(requestId))
+        Q_UNUSED(m_noteItemsNotYetInLocalStorageUids.erase(notYetSavedItemIt))
 
-        note = *pCachedNote;
+        NMTRACE(QStringLiteral("Emitting the request to add the note to local storage: id = ") << requestId
+                << QStringLiteral(", note: ") << note);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::addNote");
+        Q_EMIT addNote(note, requestId);
+        return;
     }
 
-    note.setLocalUid(item.localUid());
-    note.setGuid(item.guid());
-    note.setNotebookLocalUid(item.notebookLocalUid());
-    note.setNotebookGuid(item.notebookGuid());
-    note.setCreationTimestamp(item.creationTimestamp());
-    note.setModificationTimestamp(item.modificationTimestamp());
-    note.setDeletionTimestamp(item.deletionTimestamp());
-    note.setTagLocalUids(item.tagLocalUids());
-    note.setTagGuids(item.tagGuids());
-    note.setTitle(item.title());
-    note.setLocal(!item.isSynchronizable());
-    note.setDirty(item.isDirty());
-    note.setFavorited(item.isFavorited());
-    note.setActive(item.isActive());
+    NoteFieldsUpdate update;
+    update.setNotebook(item.notebookLocalUid(), item.notebookGuid());
+    update.setCreationTimestamp(item.creationTimestamp());
+    update.setModificationTimestamp(item.modificationTimestamp());
+    update.setDeletionTimestamp(item.deletionTimestamp());
+    update.setTitle(item.title());
+    update.setLocal(!item.isSynchronizable());
+    update.setDirty(item.isDirty());
+    update.setFavorited(item.isFavorited());
+    update.setActive(item.isActive());
 
-    QUuid requestId = QUuid::createUuid();
+    if (updateTags) {
+        update.setTags(item.tagLocalUids(), item.tagGuids());
+    }
 
-    if (notYetSavedItemIt != m_noteItemsNotYetInLocalStorageUids.end())
+    updateNoteFieldsInLocalStorage(item.localUid(), update);
+}
+
+void NoteModel::updateNoteFieldsInLocalStorage(const QString & noteLocalUid, const NoteFieldsUpdate & update)
+{
+    NMTRACE(QStringLiteral("NoteModel::updateNoteFieldsInLocalStorage: local uid = ") << noteLocalUid
+            << QStringLiteral(", update: ") << update);
+
+    auto pendingUpdateIt = m_pendingNoteFieldsUpdatesByNoteLocalUid.find(noteLocalUid);
+    if (pendingUpdateIt != m_pendingNoteFieldsUpdatesByNoteLocalUid.end()) {
+        NMTRACE(QStringLiteral("The note is already being looked up in the local storage, merging the updates"));
+        pendingUpdateIt->merge(update);
+        return;
+    }
+
+    const Note * pCachedNote = m_cache.get(noteLocalUid);
+    if (Q_UNLIKELY(!pCachedNote))
     {
-        Q_UNUSED(m_addNoteRequestIds.insert(requestId))
-        Q_UNUSED(m_noteItemsNotYetInLocalStorageUids.erase(notYetSavedItemIt))
+        Q_UNUSED(m_pendingNoteFieldsUpdatesByNoteLocalUid.insert(noteLocalUid, update))
 
-        NMTRACE(QStringLiteral("Emitting the request to add the note to local storage: id = ") << requestId
-                << QStringLiteral(", note: ") << note);
-        Q_EMIT addNote(note, requestId);
+        QUuid requestId = QUuid::createUuid();
+        Q_UNUSED(m_findNoteToPerformUpdateRequestIds.insert(requestId))
+        Note dummy;
+        dummy.setLocalUid(noteLocalUid);
+        NMTRACE(QStringLiteral("Emitting the request to find note: local uid = ") << noteLocalUid
+                << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::findNote");
+        Q_EMIT findNote(dummy, /* with resource metadata = */ true, /* with resource binary data = */ false, requestId);
+        return;
     }
-    else
+
+    Note note = *pCachedNote;
+    if (!update.apply(note)) {
+        NMDEBUG(QStringLiteral("The update doesn't change the note, nothing to write to the local storage"));
+        return;
+    }
+
+    QUuid requestId = QUuid::createUuid();
+    Q_UNUSED(m_updateNoteRequestIds.insert(requestId))
+
+    // While the note is being updated in the local storage,
+    // remove its stale copy from the cache
+    Q_UNUSED(m_cache.remove(note.localUid()))
+
+    NMTRACE(QStringLiteral("Emitting the request to update the note in local storage: id = ") << requestId
+            << QStringLiteral(", note: ") << note);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::updateNote");
+    Q_EMIT updateNote(note, /* update resources = */ false, /* update tags = */ update.updatesTags(), requestId);
+}
+
+void NoteModel::notifyItemsChanged(const QStringList & localUids, const int firstColumn, const int lastColumn)
+{
+    const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    const NoteDataByIndex & index = m_data.get<ByIndex>();
+
+    int firstRow = -1;
+    int lastRow = -1;
+
+    for(auto it = localUids.constBegin(), end = localUids.constEnd(); it != end; ++it)
     {
-        Q_UNUSED(m_updateNoteRequestIds.insert(requestId))
+        auto itemIt = localUidIndex.find(*it);
+        if (itemIt == localUidIndex.end()) {
+            continue;
+        }
 
-        // While the note is being updated in the local storage,
-        // remove its stale copy from the cache
-        Q_UNUSED(m_cache.remove(note.localUid()))
+        auto indexIt = m_data.project<ByIndex>(itemIt);
+        int row = static_cast<int>(std::distance(index.begin(), indexIt));
 
-        NMTRACE(QStringLiteral("Emitting the request to update the note in local storage: id = ") << requestId
-                << QStringLiteral(", note: ") << note);
-        Q_EMIT updateNote(note, /* update resources = */ false, /* update tags = */ updateTags, requestId);
+        if ((firstRow < 0) || (row < firstRow)) {
+            firstRow = row;
+        }
+
+        if (row > lastRow) {
+            lastRow = row;
+        }
     }
+
+    if (firstRow < 0) {
+        return;
+    }
+
+    QModelIndex topLeftChangedIndex = createIndex(firstRow, firstColumn);
+    QModelIndex bottomRightChangedIndex = createIndex(lastRow, lastColumn);
+    Q_EMIT dataChanged(topLeftChangedIndex, bottomRightChangedIndex);
 }
 
 int NoteModel::rowForNewItem(const NoteModelItem & item) const
@@ -1913,7 +2395,41 @@ void NoteModel::setNoteFavorited(const QString & noteLocalUid, const bool favori
     itemCopy.setFavorited(favorited);
 
     localUidIndex.replace(it, itemCopy);
-    updateNoteInLocalStorage(itemCopy);
+
+    NoteFieldsUpdate update;
+    update.setFavorited(favorited);
+    updateNoteFieldsInLocalStorage(noteLocalUid, update);
+}
+
+void NoteModel::setNotesFavorited(const QStringList & noteLocalUids, const bool favorited)
+{
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        if (Q_UNLIKELY(localUidIndex.find(*it) == localUidIndex.end())) {
+            REPORT_ERROR(QT_TR_NOOP("Can't favorite/unfavorite the notes: internal error, one of notes "
+                                    "to be favorited/unfavorited was not found within the model"));
+            return;
+        }
+    }
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (favorited == itemIt->isFavorited()) {
+            continue;
+        }
+
+        NoteModelItem itemCopy(*itemIt);
+        itemCopy.setFavorited(favorited);
+
+        Q_UNUSED(localUidIndex.replace(itemIt, itemCopy))
+
+        NoteFieldsUpdate update;
+        update.setFavorited(favorited);
+        updateNoteFieldsInLocalStorage(itemCopy.localUid(), update);
+    }
 }
 
 void NoteModel::checkAddedNoteItemsPendingNotebookData(const QString & notebookLocalUid, const NotebookData & notebookData)
@@ -1969,6 +2485,7 @@ void NoteModel::onNoteAddedOrUpdated(const Note & note)
             Q_UNUSED(m_findNotebookRequestForNotebookLocalUid.insert(LocalUidToRequestIdBimap::value_type(item.notebookLocalUid(), requestId)))
             NMTRACE(QStringLiteral("Emitting the request to find notebook local uid: = ") << item.notebookLocalUid()
                     << QStringLiteral(", request id = ") << requestId);
+            QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::findNotebook");
             Q_EMIT findNotebook(notebook, requestId);
         }
         else
@@ -2139,6 +2656,7 @@ void NoteModel::findTagNamesForItem(NoteModelItem & item)
         tag.setLocalUid(tagLocalUid);
         NMDEBUG(QStringLiteral("Emitting the request to find tag: tag local uid = ") << tagLocalUid
                 << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "NoteModel::findTag");
         Q_EMIT findTag(tag, requestId);
     }
 }
@@ -2182,6 +2700,71 @@ void NoteModel::moveNoteToNotebookImpl(NoteDataByLocalUid::iterator it, const No
     updateNoteInLocalStorage(item);
 }
 
+void NoteModel::moveNotesToNotebookImpl(const QStringList & noteLocalUids, const Notebook & notebook)
+{
+    NMTRACE(QStringLiteral("NoteModel::moveNotesToNotebookImpl: ") << noteLocalUids.size()
+            << QStringLiteral(" notes, notebook = ") << notebook);
+
+    if (!notebook.canCreateNotes()) {
+        ErrorString error(QT_TR_NOOP("Can't move the notes to another notebook: the target notebook "
+                                     "doesn't allow to create notes in it"));
+        NMINFO(error << QStringLiteral(", notebook: ") << notebook);
+        Q_EMIT notifyError(error);
+        return;
+    }
+
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    QList<NoteModelItem> movedItems;
+    movedItems.reserve(noteLocalUids.size());
+
+    QStringList movedNoteLocalUids;
+    movedNoteLocalUids.reserve(noteLocalUids.size());
+
+    for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            NMDEBUG(QStringLiteral("The note to be moved to another notebook is no longer within the model: ") << *it);
+            continue;
+        }
+
+        if (itemIt->notebookLocalUid() == notebook.localUid()) {
+            continue;
+        }
+
+        NoteModelItem item = *itemIt;
+        item.setNotebookLocalUid(notebook.localUid());
+        item.setNotebookName(notebook.hasName() ? notebook.name() : QString());
+        item.setNotebookGuid(notebook.hasGuid() ? notebook.guid() : QString());
+        item.setDirty(true);
+        item.setModificationTimestamp(timestamp);
+
+        Q_UNUSED(localUidIndex.replace(itemIt, item))
+        movedItems << item;
+        movedNoteLocalUids << item.localUid();
+    }
+
+    if (movedItems.isEmpty()) {
+        NMDEBUG(QStringLiteral("All the notes are already within the target notebook, nothing to do"));
+        return;
+    }
+
+    notifyItemsChanged(movedNoteLocalUids, Columns::ModificationTimestamp, Columns::Dirty);
+
+    if ((m_sortedColumn == Columns::ModificationTimestamp) || (m_sortedColumn == Columns::NotebookName) ||
+        (m_sortedColumn == Columns::Dirty))
+    {
+        sortItems();
+    }
+
+    for(auto it = movedItems.constBegin(), end = movedItems.constEnd(); it != end; ++it) {
+        updateNoteInLocalStorage(*it);
+    }
+}
+
 void NoteModel::checkAndNotifyAllNotesListed()
 {
     NMTRACE(QStringLiteral("NoteModel::checkAndNotifyAllNotesListed"));
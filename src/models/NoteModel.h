@@ -20,6 +20,7 @@
 #define QUENTIER_MODELS_NOTE_MODEL_H
 
 #include "NoteModelItem.h"
+#include "NoteFieldsUpdate.h"
 #include "NoteCache.h"
 #include "NotebookCache.h"
 #include <quentier/types/Note.h>
@@ -119,6 +120,22 @@ public:
 
     bool allNotesListed() const { return m_allNotesListed; }
 
+    /**
+     * @brief connectToLocalStorage, disconnectFromLocalStorage - the model kept alive while its account
+     * is not the current one must be disconnected from the local storage manager since the latter
+     * serves another account meanwhile; the model needs to be connected back once its account
+     * becomes the current one again
+     */
+    void connectToLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync);
+    void disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync);
+
+    /**
+     * @return true if the model has sent some requests to the local storage manager and hasn't received
+     * the responses to them yet; the model disconnected from the local storage in this state would never
+     * receive these responses
+     */
+    bool hasPendingRequests() const;
+
     /**
      * @brief deleteNote - attempts to mark the note with the specified local uid as deleted.
      *
@@ -165,6 +182,28 @@ public:
      */
     void unfavoriteNote(const QString & noteLocalUid);
 
+    /**
+     * @brief deleteNotes, expungeNotes, moveNotesToNotebook, favoriteNotes, unfavoriteNotes, addTagToNotes -
+     * bulk counterparts of the single note operations above intended for the actions applied to the multiple
+     * selected notes at once (or to all notes in the trash)
+     *
+     * Unlike the sequential calls of single note methods, the bulk methods validate the whole batch
+     * before changing anything, look up the target notebook only once and notify the views about the changes
+     * of the model with as few grouped signals as possible instead of the per-note row removals and moves.
+     * The local storage requests are still issued per note since local storage doesn't provide batch requests.
+     *
+     * @return true if the operation was applied to all the notes from the batch, false if it was rejected
+     * (in which case @link notifyError @endlink signal is emitted and the model is left intact); methods without
+     * return code report the errors via @link notifyError @endlink only because they might have to do their
+     * job asynchronously
+     */
+    bool deleteNotes(const QStringList & noteLocalUids);
+    bool expungeNotes(const QStringList & noteLocalUids);
+    void moveNotesToNotebook(const QStringList & noteLocalUids, const QString & notebookName);
+    void favoriteNotes(const QStringList & noteLocalUids);
+    void unfavoriteNotes(const QStringList & noteLocalUids);
+    bool addTagToNotes(const QStringList & noteLocalUids, const QString & tagLocalUid);
+
     /**
      * @brief notebookContainsSyncronizedNotes - answers the question whether there are notes with non-empty guids
      * within the notebook with the specified local uid
@@ -256,9 +295,26 @@ private:
 
     void processTagExpunging(const QString & tagLocalUid);
     void removeItemByLocalUid(const QString & localUid);
+
+    // Removes the items with the specified local uids issuing one beginRemoveRows/endRemoveRows pair
+    // per each contiguous range of rows
+    void removeItemsByLocalUids(const QStringList & localUids);
+
     void updateItemRowWithRespectToSorting(const NoteModelItem & item);
+
+    // Re-sorts all the items according to the current sorting column and order as a single layout change
+    void sortItems();
+
+    // Emits dataChanged for the specified columns spanning the rows of all the items with the specified local uids
+    void notifyItemsChanged(const QStringList & localUids, const int firstColumn, const int lastColumn);
+
+
     void updateNoteInLocalStorage(const NoteModelItem & item, const bool updateTags = false);
 
+    // Applies the update on top of the cached note or, if the note is not cached, on top of the note
+    // found in the local storage; the updates issued while the note is being looked up are merged into one
+    void updateNoteFieldsInLocalStorage(const QString & noteLocalUid, const NoteFieldsUpdate & update);
+
     // Returns the appropriate row before which the new item should be inserted according to the current sorting criteria and column
     int rowForNewItem(const NoteModelItem & newItem) const;
 
@@ -269,6 +325,7 @@ private:
     void updateTagData(const Tag & tag);
 
     void setNoteFavorited(const QString & noteLocalUid, const bool favorited);
+    void setNotesFavorited(const QStringList & noteLocalUids, const bool favorited);
 
 private:
     struct ByLocalUid{};
@@ -357,6 +414,7 @@ private:
     void findTagNamesForItem(NoteModelItem & item);
 
     void moveNoteToNotebookImpl(NoteDataByLocalUid::iterator it, const Notebook & notebook);
+    void moveNotesToNotebookImpl(const QStringList & noteLocalUids, const Notebook & notebook);
 
     void checkAndNotifyAllNotesListed();
 
@@ -390,6 +448,10 @@ private:
     QMultiHash<QString, NoteModelItem>  m_noteItemsPendingNotebookDataUpdate;   // The key is notebook local uid
 
     LocalUidToRequestIdBimap            m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap;
+    QHash<QUuid, QStringList>           m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook;
+
+    // The updates awaiting the notes to be found in the local storage; the key is note local uid
+    QHash<QString, NoteFieldsUpdate>    m_pendingNoteFieldsUpdatesByNoteLocalUid;
 
     QHash<QString, TagData>             m_tagDataByTagLocalUid;
 
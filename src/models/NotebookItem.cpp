@@ -41,6 +41,7 @@ NotebookItem::NotebookItem(const QString & localUid,
     m_guid(guid),
     m_linkedNotebookGuid(linkedNotebookGuid),
     m_name(name),
+    m_nameSortKey(name.toUpper()),
     m_stack(stack),
     m_flags(),
     m_numNotesPerNotebook(numNotesPerNotebook)
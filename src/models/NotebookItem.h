@@ -19,6 +19,7 @@
 #ifndef QUENTIER_MODELS_NOTEBOOK_ITEM_H
 #define QUENTIER_MODELS_NOTEBOOK_ITEM_H
 
+#include "NameSortKey.h"
 #include <quentier/utility/Printable.h>
 #include <bitset>
 
@@ -55,10 +56,13 @@ public:
     void setLinkedNotebookGuid(const QString & linkedNotebookGuid) { m_linkedNotebookGuid = linkedNotebookGuid; }
 
     const QString & name() const { return m_name; }
-    void setName(const QString & name) { m_name = name; }
+    void setName(const QString & name) { m_name = name; m_nameSortKey = NameSortKey(nameUpper()); }
 
     QString nameUpper() const { return m_name.toUpper(); }
 
+    // The collation key of the upper case name, to be used for sorting the notebook items by name
+    const NameSortKey & nameSortKey() const { return m_nameSortKey; }
+
     const QString & stack() const { return m_stack; }
     void setStack(const QString & stack) { m_stack = stack; }
 
@@ -102,6 +106,7 @@ private:
     QString     m_guid;
     QString     m_linkedNotebookGuid;
     QString     m_name;
+    NameSortKey m_nameSortKey;
     QString     m_stack;
 
     // Will use a bitset here to save some space from the more straigforward alternative of using booleans
@@ -19,6 +19,7 @@
 #ifndef QUENTIER_MODELS_NOTEBOOK_LINKED_NOTEBOOK_ROOT_ITEM_H
 #define QUENTIER_MODELS_NOTEBOOK_LINKED_NOTEBOOK_ROOT_ITEM_H
 
+#include "NameSortKey.h"
 #include <quentier/utility/Printable.h>
 
 namespace quentier {
@@ -29,11 +30,15 @@ public:
     NotebookLinkedNotebookRootItem(const QString & username,
                                    const QString & linkedNotebookGuid) :
         m_username(username),
+        m_usernameSortKey(username.toUpper()),
         m_linkedNotebookGuid(linkedNotebookGuid)
     {}
 
     const QString & username() const { return m_username; }
-    void setUsername(const QString & username) { m_username = username; }
+    void setUsername(const QString & username) { m_username = username; m_usernameSortKey = NameSortKey(username.toUpper()); }
+
+    // The collation key of the upper case username, to be used for sorting the linked notebook root items by name
+    const NameSortKey & usernameSortKey() const { return m_usernameSortKey; }
 
     const QString & linkedNotebookGuid() const { return m_linkedNotebookGuid; }
     void setLinkedNotebookGuid(const QString & linkedNotebookGuid) { m_linkedNotebookGuid = linkedNotebookGuid; }
@@ -42,6 +47,7 @@ public:
 
 private:
     QString         m_username;
+    NameSortKey     m_usernameSortKey;
     QString         m_linkedNotebookGuid;
 };
 
@@ -17,6 +17,7 @@
  */
 
 #include "NotebookModel.h"
+#include "ModelInstrumentation.h"
 #include "NoteModel.h"
 #include "NewItemNameGenerator.hpp"
 #include <quentier/logging/QuentierLogger.h>
@@ -2185,6 +2186,8 @@ void NotebookModel::onAllNotesListed()
 
 void NotebookModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onAddNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onAddNotebookComplete: notebook = ") << notebook << QStringLiteral("\nRequest id = ")
             << requestId);
 
@@ -2200,6 +2203,8 @@ void NotebookModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NotebookModel::onAddNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onAddNotebookFailed", requestId);
+
     auto it = m_addNotebookRequestIds.find(requestId);
     if (it == m_addNotebookRequestIds.end()) {
         return;
@@ -2217,6 +2222,8 @@ void NotebookModel::onAddNotebookFailed(Notebook notebook, ErrorString errorDesc
 
 void NotebookModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onUpdateNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onUpdateNotebookComplete: notebook = ") << notebook << QStringLiteral("\nRequest id = ")
             << requestId);
 
@@ -2231,6 +2238,8 @@ void NotebookModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NotebookModel::onUpdateNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onUpdateNotebookFailed", requestId);
+
     auto it = m_updateNotebookRequestIds.find(requestId);
     if (it == m_updateNotebookRequestIds.end()) {
         return;
@@ -2245,11 +2254,14 @@ void NotebookModel::onUpdateNotebookFailed(Notebook notebook, ErrorString errorD
     Q_UNUSED(m_findNotebookToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to find the notebook: local uid = ") << notebook.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "NotebookModel::findNotebook");
     Q_EMIT findNotebook(notebook, requestId);
 }
 
 void NotebookModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onFindNotebookComplete", requestId);
+
     auto restoreUpdateIt = m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
     if ((restoreUpdateIt == m_findNotebookToRestoreFailedUpdateRequestIds.end()) &&
@@ -2279,6 +2291,8 @@ void NotebookModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NotebookModel::onFindNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onFindNotebookFailed", requestId);
+
     auto restoreUpdateIt = m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
     if ((restoreUpdateIt == m_findNotebookToRestoreFailedUpdateRequestIds.end()) &&
@@ -2306,6 +2320,8 @@ void NotebookModel::onListNotebooksComplete(LocalStorageManager::ListObjectsOpti
                                             LocalStorageManager::OrderDirection::type orderDirection,
                                             QString linkedNotebookGuid, QList<Notebook> foundNotebooks, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onListNotebooksComplete", requestId);
+
     if (requestId != m_listNotebooksRequestId) {
         return;
     }
@@ -2345,6 +2361,8 @@ void NotebookModel::onListNotebooksFailed(LocalStorageManager::ListObjectsOption
                                           LocalStorageManager::OrderDirection::type orderDirection,
                                           QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onListNotebooksFailed", requestId);
+
     if (requestId != m_listNotebooksRequestId) {
         return;
     }
@@ -2362,6 +2380,8 @@ void NotebookModel::onListNotebooksFailed(LocalStorageManager::ListObjectsOption
 
 void NotebookModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onExpungeNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onExpungeNotebookComplete: notebook = ") << notebook
             << QStringLiteral("\nRequest id = ") << requestId);
 
@@ -2378,6 +2398,8 @@ void NotebookModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId
 
 void NotebookModel::onExpungeNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onExpungeNotebookFailed", requestId);
+
     auto it = m_expungeNotebookRequestIds.find(requestId);
     if (it == m_expungeNotebookRequestIds.end()) {
         return;
@@ -2394,6 +2416,8 @@ void NotebookModel::onExpungeNotebookFailed(Notebook notebook, ErrorString error
 
 void NotebookModel::onGetNoteCountPerNotebookComplete(int noteCount, Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onGetNoteCountPerNotebookComplete", requestId);
+
     auto it = m_noteCountPerNotebookRequestIds.find(requestId);
     if (it == m_noteCountPerNotebookRequestIds.end()) {
         return;
@@ -2421,6 +2445,8 @@ void NotebookModel::onGetNoteCountPerNotebookComplete(int noteCount, Notebook no
 
 void NotebookModel::onGetNoteCountPerNotebookFailed(ErrorString errorDescription, Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onGetNoteCountPerNotebookFailed", requestId);
+
     auto it = m_noteCountPerNotebookRequestIds.find(requestId);
     if (it == m_noteCountPerNotebookRequestIds.end()) {
         return;
@@ -2450,6 +2476,8 @@ void NotebookModel::onGetNoteCountPerNotebookFailed(ErrorString errorDescription
 
 void NotebookModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onAddNoteComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onAddNoteComplete: note = ") << note
             << QStringLiteral(", request id = ") << requestId);
 
@@ -2483,6 +2511,8 @@ void NotebookModel::onAddNoteComplete(Note note, QUuid requestId)
 
 void NotebookModel::onUpdateNoteComplete(Note note, bool updateResources, bool updateTags, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onUpdateNoteComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onUpdateNoteComplete: note = ") << note
             << QStringLiteral("\nUpdate resources = ") << (updateResources ? QStringLiteral("true") : QStringLiteral("false"))
             << QStringLiteral(", update tags = ") << (updateTags ? QStringLiteral("true") : QStringLiteral("false"))
@@ -2537,6 +2567,8 @@ void NotebookModel::onUpdateNoteComplete(Note note, bool updateResources, bool u
 
 void NotebookModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onExpungeNoteComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onExpungeNoteComplete: note = ") << note
             << QStringLiteral("\nRequest id = ") << requestId);
 
@@ -2580,6 +2612,8 @@ void NotebookModel::onExpungeNoteComplete(Note note, QUuid requestId)
 
 void NotebookModel::onAddLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onAddLinkedNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onAddLinkedNotebookComplete: request id = ")
             << requestId << QStringLiteral(", linked notebook: ") << linkedNotebook);
     onLinkedNotebookAddedOrUpdated(linkedNotebook);
@@ -2587,6 +2621,8 @@ void NotebookModel::onAddLinkedNotebookComplete(LinkedNotebook linkedNotebook, Q
 
 void NotebookModel::onUpdateLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onUpdateLinkedNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onUpdateLinkedNotebookComplete: request id = ")
             << requestId << QStringLiteral(", linked notebook: ") << linkedNotebook);
     onLinkedNotebookAddedOrUpdated(linkedNotebook);
@@ -2594,6 +2630,8 @@ void NotebookModel::onUpdateLinkedNotebookComplete(LinkedNotebook linkedNotebook
 
 void NotebookModel::onExpungeLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onExpungeLinkedNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("NotebookModel::onExpungeLinkedNotebookComplete: request id = ")
             << requestId << QStringLiteral(", linked notebook: ") << linkedNotebook);
 
@@ -2659,6 +2697,8 @@ void NotebookModel::onListAllLinkedNotebooksComplete(size_t limit, size_t offset
                                                      QList<LinkedNotebook> foundLinkedNotebooks,
                                                      QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onListAllLinkedNotebooksComplete", requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -2695,6 +2735,8 @@ void NotebookModel::onListAllLinkedNotebooksFailed(size_t limit, size_t offset,
                                                    LocalStorageManager::OrderDirection::type orderDirection,
                                                    ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("NotebookModel::onListAllLinkedNotebooksFailed", requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -2709,6 +2751,27 @@ void NotebookModel::onListAllLinkedNotebooksFailed(size_t limit, size_t offset,
     Q_EMIT notifyError(errorDescription);
 }
 
+void NotebookModel::connectToLocalStorage(const NoteModel & noteModel, LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("NotebookModel::connectToLocalStorage"));
+    createConnections(noteModel, localStorageManagerAsync);
+}
+
+void NotebookModel::disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("NotebookModel::disconnectFromLocalStorage"));
+    QObject::disconnect(this, Q_NULLPTR, &localStorageManagerAsync, Q_NULLPTR);
+    QObject::disconnect(&localStorageManagerAsync, Q_NULLPTR, this, Q_NULLPTR);
+}
+
+bool NotebookModel::hasPendingRequests() const
+{
+    return !m_listNotebooksRequestId.isNull() || !m_listLinkedNotebooksRequestId.isNull() ||
+           !m_addNotebookRequestIds.isEmpty() || !m_updateNotebookRequestIds.isEmpty() ||
+           !m_expungeNotebookRequestIds.isEmpty() || !m_findNotebookToRestoreFailedUpdateRequestIds.isEmpty() ||
+           !m_findNotebookToPerformUpdateRequestIds.isEmpty() || !m_noteCountPerNotebookRequestIds.isEmpty();
+}
+
 void NotebookModel::createConnections(const NoteModel & noteModel, LocalStorageManagerAsync & localStorageManagerAsync)
 {
     QNTRACE(QStringLiteral("NotebookModel::createConnections"));
@@ -2818,6 +2881,7 @@ void NotebookModel::requestNotebooksList()
     m_listNotebooksRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list notebooks: offset = ") << m_listNotebooksOffset
             << QStringLiteral(", request id = ") << m_listNotebooksRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listNotebooksRequestId, "NotebookModel::listNotebooks");
     Q_EMIT listNotebooks(flags, NOTEBOOK_LIST_LIMIT, m_listNotebooksOffset, order, direction, QString(), m_listNotebooksRequestId);
 }
 
@@ -2855,6 +2919,7 @@ void NotebookModel::requestLinkedNotebooksList()
     m_listLinkedNotebooksRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list linked notebooks: offset = ") << m_listLinkedNotebooksOffset
             << QStringLiteral(", request id = ") << m_listLinkedNotebooksRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listLinkedNotebooksRequestId, "NotebookModel::listAllLinkedNotebooks");
     Q_EMIT listAllLinkedNotebooks(LINKED_NOTEBOOK_LIST_LIMIT, m_listLinkedNotebooksOffset, order, direction, m_listLinkedNotebooksRequestId);
 }
 
@@ -3082,6 +3147,7 @@ void NotebookModel::updateNotebookInLocalStorage(const NotebookItem & item)
             Q_UNUSED(m_findNotebookToPerformUpdateRequestIds.insert(requestId))
             Notebook dummy;
             dummy.setLocalUid(item.localUid());
+            QUENTIER_MODEL_REQUEST_SENT(requestId, "NotebookModel::findNotebook");
             Q_EMIT findNotebook(dummy, requestId);
             QNTRACE(QStringLiteral("Emitted the request to find the notebook: local uid = ") << item.localUid()
                     << QStringLiteral(", request id = ") << requestId);
@@ -3126,6 +3192,7 @@ void NotebookModel::updateNotebookInLocalStorage(const NotebookItem & item)
 
         QNTRACE(QStringLiteral("Emitting the request to add the notebook to local storage: id = ")
                 << requestId << QStringLiteral(", notebook = ") << notebook);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "NotebookModel::addNotebook");
         Q_EMIT addNotebook(notebook, requestId);
 
         Q_UNUSED(m_notebookItemsNotYetInLocalStorageUids.erase(notYetSavedItemIt))
@@ -3140,6 +3207,7 @@ void NotebookModel::updateNotebookInLocalStorage(const NotebookItem & item)
 
         QNTRACE(QStringLiteral("Emitting the request to update notebook in the local storage: id = ")
                 << requestId << QStringLiteral(", notebook = ") << notebook);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "NotebookModel::updateNotebook");
         Q_EMIT updateNotebook(notebook, requestId);
     }
 }
@@ -3159,6 +3227,7 @@ void NotebookModel::expungeNotebookFromLocalStorage(const QString & localUid)
     QNDEBUG(QStringLiteral("Emitting the request to expunge the notebook from local storage: "
                            "request id = ") << requestId
             << QStringLiteral(", local uid = ") << localUid);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "NotebookModel::expungeNotebook");
     Q_EMIT expungeNotebook(dummyNotebook, requestId);
 }
 
@@ -3694,16 +3763,38 @@ void NotebookModel::updateItemRowWithRespectToSorting(const NotebookModelItem &
         return;
     }
 
-    QModelIndex parentIndex = indexForItem(pParentItem);
-    beginRemoveRows(parentIndex, currentItemRow, currentItemRow);
-    Q_UNUSED(pParentItem->takeChild(currentItemRow))
-    endRemoveRows();
+    // The appropriate row is looked up among the item's siblings, as if the item was already taken from its parent
+    QList<const NotebookModelItem*> siblings = pParentItem->children();
+    siblings.removeAt(currentItemRow);
+
+    auto it = siblings.constEnd();
+    if (m_sortOrder == Qt::AscendingOrder) {
+        it = std::lower_bound(siblings.constBegin(), siblings.constEnd(), &modelItem, LessByName());
+    }
+    else {
+        it = std::lower_bound(siblings.constBegin(), siblings.constEnd(), &modelItem, GreaterByName());
+    }
 
-    int appropriateRow = rowForNewItem(*pParentItem, modelItem);
+    int appropriateRow = static_cast<int>(std::distance(siblings.constBegin(), it));
+    if (appropriateRow == currentItemRow) {
+        QNTRACE(QStringLiteral("The item is already at the appropriate row ") << currentItemRow);
+        return;
+    }
+
+    // The destination row for beginMoveRows is counted before the item is taken from its original row
+    int destinationRow = ((appropriateRow > currentItemRow) ? (appropriateRow + 1) : appropriateRow);
+
+    QModelIndex parentIndex = indexForItem(pParentItem);
+    bool res = beginMoveRows(parentIndex, currentItemRow, currentItemRow, parentIndex, destinationRow);
+    if (Q_UNLIKELY(!res)) {
+        QNWARNING(QStringLiteral("Internal error, can't move row within the notebook model for sorting purposes: from row ")
+                  << currentItemRow << QStringLiteral(" to row ") << appropriateRow);
+        return;
+    }
 
-    beginInsertRows(parentIndex, appropriateRow, appropriateRow);
+    Q_UNUSED(pParentItem->takeChild(currentItemRow))
     pParentItem->insertChild(appropriateRow, &modelItem);
-    endInsertRows();
+    endMoveRows();
 
     QNTRACE(QStringLiteral("Moved item from row ") << currentItemRow << QStringLiteral(" to row ") << appropriateRow
             << QStringLiteral("; item: ") << modelItem);
@@ -4244,7 +4335,7 @@ bool NotebookModel::updateNoteCountPerNotebookIndex(const NotebookItem & item, c
 
 bool NotebookModel::LessByName::operator()(const NotebookItem & lhs, const NotebookItem & rhs) const
 {
-    return (lhs.nameUpper().localeAwareCompare(rhs.nameUpper()) <= 0);
+    return (lhs.nameSortKey().compare(rhs.nameSortKey()) <= 0);
 }
 
 #define ITEM_PTR_LESS(lhs, rhs) \
@@ -4263,15 +4354,15 @@ bool NotebookModel::LessByName::operator()(const NotebookItem * lhs, const Noteb
     ITEM_PTR_LESS(lhs, rhs)
 }
 
-#define MODEL_ITEM_NAME(item, itemName) \
+#define MODEL_ITEM_NAME_SORT_KEY(item, pItemNameSortKey) \
     if ((item.type() == NotebookModelItem::Type::Notebook) && item.notebookItem()) { \
-        itemName = item.notebookItem()->nameUpper(); \
+        pItemNameSortKey = &(item.notebookItem()->nameSortKey()); \
     } \
     else if ((item.type() == NotebookModelItem::Type::Stack) && item.notebookStackItem()) { \
-        itemName = item.notebookStackItem()->name().toUpper(); \
+        pItemNameSortKey = &(item.notebookStackItem()->nameSortKey()); \
     } \
     else if ((item.type() == NotebookModelItem::Type::LinkedNotebook) && item.notebookLinkedNotebookItem()) { \
-        itemName = item.notebookLinkedNotebookItem()->username().toUpper(); \
+        pItemNameSortKey = &(item.notebookLinkedNotebookItem()->usernameSortKey()); \
     }
 
 bool NotebookModel::LessByName::operator()(const NotebookModelItem & lhs, const NotebookModelItem & rhs) const
@@ -4288,13 +4379,20 @@ bool NotebookModel::LessByName::operator()(const NotebookModelItem & lhs, const
         return true;
     }
 
-    QString lhsName;
-    MODEL_ITEM_NAME(lhs, lhsName)
+    const NameSortKey * pLhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(lhs, pLhsNameSortKey)
 
-    QString rhsName;
-    MODEL_ITEM_NAME(rhs, rhsName)
+    const NameSortKey * pRhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(rhs, pRhsNameSortKey)
+
+    if (!pLhsNameSortKey) {
+        return true;
+    }
+    else if (!pRhsNameSortKey) {
+        return false;
+    }
 
-    return (lhsName.localeAwareCompare(rhsName) <= 0);
+    return (pLhsNameSortKey->compare(*pRhsNameSortKey) <= 0);
 }
 
 bool NotebookModel::LessByName::operator()(const NotebookModelItem * lhs, const NotebookModelItem * rhs) const
@@ -4304,7 +4402,7 @@ bool NotebookModel::LessByName::operator()(const NotebookModelItem * lhs, const
 
 bool NotebookModel::LessByName::operator()(const NotebookStackItem & lhs, const NotebookStackItem & rhs) const
 {
-    return (lhs.name().toUpper().localeAwareCompare(rhs.name().toUpper()) <= 0);
+    return (lhs.nameSortKey().compare(rhs.nameSortKey()) <= 0);
 }
 
 bool NotebookModel::LessByName::operator()(const NotebookStackItem * lhs, const NotebookStackItem * rhs) const
@@ -4314,7 +4412,7 @@ bool NotebookModel::LessByName::operator()(const NotebookStackItem * lhs, const
 
 bool NotebookModel::LessByName::operator()(const NotebookLinkedNotebookRootItem & lhs, const NotebookLinkedNotebookRootItem & rhs) const
 {
-    return (lhs.username().toUpper().localeAwareCompare(rhs.username().toUpper()) <= 0);
+    return (lhs.usernameSortKey().compare(rhs.usernameSortKey()) <= 0);
 }
 
 bool NotebookModel::LessByName::operator()(const NotebookLinkedNotebookRootItem * lhs, const NotebookLinkedNotebookRootItem * rhs) const
@@ -4324,7 +4422,7 @@ bool NotebookModel::LessByName::operator()(const NotebookLinkedNotebookRootItem
 
 bool NotebookModel::GreaterByName::operator()(const NotebookItem & lhs, const NotebookItem & rhs) const
 {
-    return (lhs.nameUpper().localeAwareCompare(rhs.nameUpper()) > 0);
+    return (lhs.nameSortKey().compare(rhs.nameSortKey()) > 0);
 }
 
 #define ITEM_PTR_GREATER(lhs, rhs) \
@@ -4345,7 +4443,7 @@ bool NotebookModel::GreaterByName::operator()(const NotebookItem * lhs, const No
 
 bool NotebookModel::GreaterByName::operator()(const NotebookStackItem & lhs, const NotebookStackItem & rhs) const
 {
-    return (lhs.name().toUpper().localeAwareCompare(rhs.name().toUpper()) > 0);
+    return (lhs.nameSortKey().compare(rhs.nameSortKey()) > 0);
 }
 
 bool NotebookModel::GreaterByName::operator()(const NotebookStackItem * lhs, const NotebookStackItem * rhs) const
@@ -4355,7 +4453,7 @@ bool NotebookModel::GreaterByName::operator()(const NotebookStackItem * lhs, con
 
 bool NotebookModel::GreaterByName::operator()(const NotebookLinkedNotebookRootItem & lhs, const NotebookLinkedNotebookRootItem & rhs) const
 {
-    return (lhs.username().toUpper().localeAwareCompare(rhs.username().toUpper()) > 0);
+    return (lhs.usernameSortKey().compare(rhs.usernameSortKey()) > 0);
 }
 
 bool NotebookModel::GreaterByName::operator()(const NotebookLinkedNotebookRootItem * lhs, const NotebookLinkedNotebookRootItem * rhs) const
@@ -4377,13 +4475,20 @@ bool NotebookModel::GreaterByName::operator()(const NotebookModelItem & lhs, con
         return true;
     }
 
-    QString lhsName;
-    MODEL_ITEM_NAME(lhs, lhsName)
+    const NameSortKey * pLhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(lhs, pLhsNameSortKey)
 
-    QString rhsName;
-    MODEL_ITEM_NAME(rhs, rhsName)
+    const NameSortKey * pRhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(rhs, pRhsNameSortKey)
+
+    if (!pLhsNameSortKey) {
+        return false;
+    }
+    else if (!pRhsNameSortKey) {
+        return true;
+    }
 
-    return (lhsName.localeAwareCompare(rhsName) > 0);
+    return (pLhsNameSortKey->compare(*pRhsNameSortKey) > 0);
 }
 
 bool NotebookModel::GreaterByName::operator()(const NotebookModelItem * lhs, const NotebookModelItem * rhs) const
@@ -209,6 +209,22 @@ public:
      */
     bool allNotebooksListed() const;
 
+    /**
+     * @brief connectToLocalStorage, disconnectFromLocalStorage - the model kept alive while its account
+     * is not the current one must be disconnected from the local storage manager since the latter
+     * serves another account meanwhile; the model needs to be connected back once its account
+     * becomes the current one again
+     */
+    void connectToLocalStorage(const NoteModel & noteModel, LocalStorageManagerAsync & localStorageManagerAsync);
+    void disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync);
+
+    /**
+     * @return true if the model has sent some requests to the local storage manager and hasn't received
+     * the responses to them yet; the model disconnected from the local storage in this state would never
+     * receive these responses
+     */
+    bool hasPendingRequests() const;
+
     /**
      * @brief favoriteNotebook - marks the notebook pointed to by the index as favorited
      *
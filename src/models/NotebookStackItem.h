@@ -19,6 +19,7 @@
 #ifndef QUENTIER_MODELS_NOTEBOOK_STACK_ITEM_H
 #define QUENTIER_MODELS_NOTEBOOK_STACK_ITEM_H
 
+#include "NameSortKey.h"
 #include <quentier/utility/Printable.h>
 
 namespace quentier {
@@ -27,16 +28,21 @@ class NotebookStackItem: public Printable
 {
 public:
     NotebookStackItem(const QString & name = QString()) :
-        m_name(name)
+        m_name(name),
+        m_nameSortKey(name.toUpper())
     {}
 
     const QString & name() const { return m_name; }
-    void setName(const QString & name) { m_name = name; }
+    void setName(const QString & name) { m_name = name; m_nameSortKey = NameSortKey(name.toUpper()); }
+
+    // The collation key of the upper case name, to be used for sorting the stack items by name
+    const NameSortKey & nameSortKey() const { return m_nameSortKey; }
 
     virtual QTextStream & print(QTextStream & strm) const Q_DECL_OVERRIDE;
 
 private:
     QString     m_name;
+    NameSortKey m_nameSortKey;
 };
 
 } // namespace quentier
@@ -17,6 +17,7 @@
  */
 
 #include "SavedSearchModel.h"
+#include "ModelInstrumentation.h"
 #include "NewItemNameGenerator.hpp"
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/UidGenerator.h>
@@ -629,6 +630,7 @@ bool SavedSearchModel::removeRows(int row, int count, const QModelIndex & parent
         Q_UNUSED(m_expungeSavedSearchRequestIds.insert(requestId))
         QNTRACE(QStringLiteral("Emitting the request to expunge the saved search from the local storage: request id = ")
                 << requestId << QStringLiteral(", saved search local uid: ") << it->m_localUid);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "SavedSearchModel::expungeSavedSearch");
         Q_EMIT expungeSavedSearch(savedSearch, requestId);
     }
     Q_UNUSED(index.erase(index.begin() + row, index.begin() + row + count))
@@ -709,6 +711,8 @@ void SavedSearchModel::sort(int column, Qt::SortOrder order)
 
 void SavedSearchModel::onAddSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onAddSavedSearchComplete", requestId);
+
     QNDEBUG(QStringLiteral("SavedSearchModel::onAddSavedSearchComplete: ") << search << QStringLiteral("\nRequest id = ") << requestId);
 
     auto it = m_addSavedSearchRequestIds.find(requestId);
@@ -722,6 +726,8 @@ void SavedSearchModel::onAddSavedSearchComplete(SavedSearch search, QUuid reques
 
 void SavedSearchModel::onAddSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onAddSavedSearchFailed", requestId);
+
     auto it = m_addSavedSearchRequestIds.find(requestId);
     if (it == m_addSavedSearchRequestIds.end()) {
         return;
@@ -757,6 +763,8 @@ void SavedSearchModel::onAddSavedSearchFailed(SavedSearch search, ErrorString er
 
 void SavedSearchModel::onUpdateSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onUpdateSavedSearchComplete", requestId);
+
     QNDEBUG(QStringLiteral("SavedSearchModel::onUpdateSavedSearchComplete: ") << search << QStringLiteral("\nRequest id = ")
             << requestId);
 
@@ -771,6 +779,8 @@ void SavedSearchModel::onUpdateSavedSearchComplete(SavedSearch search, QUuid req
 
 void SavedSearchModel::onUpdateSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onUpdateSavedSearchFailed", requestId);
+
     auto it = m_updateSavedSearchRequestIds.find(requestId);
     if (it == m_updateSavedSearchRequestIds.end()) {
         return;
@@ -785,11 +795,14 @@ void SavedSearchModel::onUpdateSavedSearchFailed(SavedSearch search, ErrorString
     Q_UNUSED(m_findSavedSearchToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to find the saved search: local uid = ") << search.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "SavedSearchModel::findSavedSearch");
     Q_EMIT findSavedSearch(search, requestId);
 }
 
 void SavedSearchModel::onFindSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onFindSavedSearchComplete", requestId);
+
     auto restoreUpdateIt = m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findSavedSearchToPerformUpdateRequestIds.find(requestId);
 
@@ -820,6 +833,8 @@ void SavedSearchModel::onFindSavedSearchComplete(SavedSearch search, QUuid reque
 
 void SavedSearchModel::onFindSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onFindSavedSearchFailed", requestId);
+
     auto restoreUpdateIt = m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findSavedSearchToPerformUpdateRequestIds.find(requestId);
 
@@ -848,6 +863,8 @@ void SavedSearchModel::onListSavedSearchesComplete(LocalStorageManager::ListObje
                                                    LocalStorageManager::OrderDirection::type orderDirection,
                                                    QList<SavedSearch> foundSearches, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onListSavedSearchesComplete", requestId);
+
     if (requestId != m_listSavedSearchesRequestId) {
         return;
     }
@@ -880,6 +897,8 @@ void SavedSearchModel::onListSavedSearchesFailed(LocalStorageManager::ListObject
                                                  LocalStorageManager::OrderDirection::type orderDirection,
                                                  ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onListSavedSearchesFailed", requestId);
+
     if (requestId != m_listSavedSearchesRequestId) {
         return;
     }
@@ -895,6 +914,8 @@ void SavedSearchModel::onListSavedSearchesFailed(LocalStorageManager::ListObject
 
 void SavedSearchModel::onExpungeSavedSearchComplete(SavedSearch search, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onExpungeSavedSearchComplete", requestId);
+
     QNDEBUG(QStringLiteral("SavedSearchModel::onExpungeSavedSearchComplete: search = ") << search << QStringLiteral("\nRequest id = ")
             << requestId);
 
@@ -933,6 +954,8 @@ void SavedSearchModel::onExpungeSavedSearchComplete(SavedSearch search, QUuid re
 
 void SavedSearchModel::onExpungeSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("SavedSearchModel::onExpungeSavedSearchFailed", requestId);
+
     auto it = m_expungeSavedSearchRequestIds.find(requestId);
     if (it == m_expungeSavedSearchRequestIds.end()) {
         return;
@@ -946,6 +969,27 @@ void SavedSearchModel::onExpungeSavedSearchFailed(SavedSearch search, ErrorStrin
     onSavedSearchAddedOrUpdated(search);
 }
 
+void SavedSearchModel::connectToLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("SavedSearchModel::connectToLocalStorage"));
+    createConnections(localStorageManagerAsync);
+}
+
+void SavedSearchModel::disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("SavedSearchModel::disconnectFromLocalStorage"));
+    QObject::disconnect(this, Q_NULLPTR, &localStorageManagerAsync, Q_NULLPTR);
+    QObject::disconnect(&localStorageManagerAsync, Q_NULLPTR, this, Q_NULLPTR);
+}
+
+bool SavedSearchModel::hasPendingRequests() const
+{
+    return !m_listSavedSearchesRequestId.isNull() || !m_addSavedSearchRequestIds.isEmpty() ||
+           !m_updateSavedSearchRequestIds.isEmpty() || !m_expungeSavedSearchRequestIds.isEmpty() ||
+           !m_findSavedSearchToRestoreFailedUpdateRequestIds.isEmpty() ||
+           !m_findSavedSearchToPerformUpdateRequestIds.isEmpty();
+}
+
 void SavedSearchModel::createConnections(LocalStorageManagerAsync & localStorageManagerAsync)
 {
     QNDEBUG(QStringLiteral("SavedSearchModel::createConnections"));
@@ -1010,6 +1054,7 @@ void SavedSearchModel::requestSavedSearchesList()
     m_listSavedSearchesRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list saved searches: offset = ") << m_listSavedSearchesOffset
             << QStringLiteral(", request id = ") << m_listSavedSearchesRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listSavedSearchesRequestId, "SavedSearchModel::listSavedSearches");
     Q_EMIT listSavedSearches(flags, SAVED_SEARCH_LIST_LIMIT, m_listSavedSearchesOffset,
                              order, direction, m_listSavedSearchesRequestId);
 }
@@ -1250,6 +1295,7 @@ void SavedSearchModel::updateSavedSearchInLocalStorage(const SavedSearchModelIte
             Q_UNUSED(m_findSavedSearchToPerformUpdateRequestIds.insert(requestId))
                 SavedSearch dummy;
             dummy.setLocalUid(item.m_localUid);
+            QUENTIER_MODEL_REQUEST_SENT(requestId, "SavedSearchModel::findSavedSearch");
             Q_EMIT findSavedSearch(dummy, requestId);
             QNDEBUG(QStringLiteral("Emitted the request to find the saved search: local uid = ") << item.m_localUid
                     << QStringLiteral(", request id = ") << requestId);
@@ -1272,6 +1318,7 @@ void SavedSearchModel::updateSavedSearchInLocalStorage(const SavedSearchModelIte
     if (notYetSavedItemIt != m_savedSearchItemsNotYetInLocalStorageUids.end())
     {
         Q_UNUSED(m_addSavedSearchRequestIds.insert(requestId));
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "SavedSearchModel::addSavedSearch");
         Q_EMIT addSavedSearch(savedSearch, requestId);
 
         QNTRACE(QStringLiteral("Emitted the request to add the saved search to local storage: id = ") << requestId
@@ -1287,6 +1334,7 @@ void SavedSearchModel::updateSavedSearchInLocalStorage(const SavedSearchModelIte
         // remove its stale copy from the cache
         Q_UNUSED(m_cache.remove(savedSearch.localUid()))
 
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "SavedSearchModel::updateSavedSearch");
         Q_EMIT updateSavedSearch(savedSearch, requestId);
 
         QNTRACE(QStringLiteral("Emitted the request to update the saved search in the local storage: id = ") << requestId
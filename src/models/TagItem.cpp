@@ -34,6 +34,7 @@ TagItem::TagItem(const QString & localUid,
     m_guid(guid),
     m_linkedNotebookGuid(linkedNotebookGuid),
     m_name(name),
+    m_nameSortKey(name.toUpper()),
     m_parentLocalUid(parentLocalUid),
     m_parentGuid(parentGuid),
     m_isSynchronizable(isSynchronizable),
@@ -19,6 +19,7 @@
 #ifndef QUENTIER_MODELS_TAG_ITEM_H
 #define QUENTIER_MODELS_TAG_ITEM_H
 
+#include "NameSortKey.h"
 #include <quentier/utility/Printable.h>
 
 namespace quentier {
@@ -50,7 +51,10 @@ public:
     QString nameUpper() const { return m_name.toUpper(); }
 
     const QString & name() const { return m_name; }
-    void setName(const QString & name) { m_name = name; }
+    void setName(const QString & name) { m_name = name; m_nameSortKey = NameSortKey(nameUpper()); }
+
+    // The collation key of the upper case name, to be used for sorting the tag items by name
+    const NameSortKey & nameSortKey() const { return m_nameSortKey; }
 
     const QString & parentGuid() const { return m_parentGuid; }
     void setParentGuid(const QString & parentGuid) { m_parentGuid = parentGuid; }
@@ -77,6 +81,7 @@ private:
     QString     m_guid;
     QString     m_linkedNotebookGuid;
     QString     m_name;
+    NameSortKey m_nameSortKey;
     QString     m_parentLocalUid;
     QString     m_parentGuid;
     bool        m_isSynchronizable;
@@ -17,6 +17,7 @@
  */
 
 #include "TagModel.h"
+#include "ModelInstrumentation.h"
 #include "NewItemNameGenerator.hpp"
 #include <quentier/logging/QuentierLogger.h>
 #include <QByteArray>
@@ -875,6 +876,7 @@ bool TagModel::removeRows(int row, int count, const QModelIndex & parent)
 
         QUuid requestId = QUuid::createUuid();
         Q_UNUSED(m_expungeTagRequestIds.insert(requestId))
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::expungeTag");
         Q_EMIT expungeTag(tag, requestId);
         QNTRACE(QStringLiteral("Emitted the request to expunge the tag from the local storage: request id = ")
                 << requestId << QStringLiteral(", tag local uid: ") << pTagItem->localUid());
@@ -1199,6 +1201,8 @@ bool TagModel::dropMimeData(const QMimeData * pMimeData, Qt::DropAction action,
 
 void TagModel::onAddTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onAddTagComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onAddTagComplete: tag = ") << tag << QStringLiteral("\nRequest id = ") << requestId);
 
     auto it = m_addTagRequestIds.find(requestId);
@@ -1213,6 +1217,8 @@ void TagModel::onAddTagComplete(Tag tag, QUuid requestId)
 
 void TagModel::onAddTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onAddTagFailed", requestId);
+
     auto it = m_addTagRequestIds.find(requestId);
     if (it == m_addTagRequestIds.end()) {
         return;
@@ -1230,6 +1236,8 @@ void TagModel::onAddTagFailed(Tag tag, ErrorString errorDescription, QUuid reque
 
 void TagModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onUpdateTagComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onUpdateTagComplete: tag = ") << tag << QStringLiteral("\nRequest id = ") << requestId);
 
     auto it = m_updateTagRequestIds.find(requestId);
@@ -1245,6 +1253,8 @@ void TagModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 
 void TagModel::onUpdateTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onUpdateTagFailed", requestId);
+
     auto it = m_updateTagRequestIds.find(requestId);
     if (it == m_updateTagRequestIds.end()) {
         return;
@@ -1259,11 +1269,14 @@ void TagModel::onUpdateTagFailed(Tag tag, ErrorString errorDescription, QUuid re
     Q_UNUSED(m_findTagToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to find a tag: local uid = ") << tag.localUid()
             << QStringLiteral(", request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::findTag");
     Q_EMIT findTag(tag, requestId);
 }
 
 void TagModel::onFindTagComplete(Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onFindTagComplete", requestId);
+
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
     auto checkAfterErasureIt = m_findTagAfterNotelessTagsErasureRequestIds.find(requestId);
@@ -1301,6 +1314,8 @@ void TagModel::onFindTagComplete(Tag tag, QUuid requestId)
 
 void TagModel::onFindTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onFindTagFailed", requestId);
+
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
     auto checkAfterErasureIt = m_findTagAfterNotelessTagsErasureRequestIds.find(requestId);
@@ -1337,6 +1352,8 @@ void TagModel::onListTagsWithNoteLocalUidsComplete(LocalStorageManager::ListObje
                                                    QList<std::pair<Tag,QStringList> > foundTagsWithNoteLocalUids,
                                                    QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onListTagsWithNoteLocalUidsComplete", requestId);
+
     if (requestId != m_listTagsRequestId) {
         return;
     }
@@ -1391,6 +1408,8 @@ void TagModel::onListTagsWithNoteLocalUidsFailed(LocalStorageManager::ListObject
                                                  LocalStorageManager::OrderDirection::type orderDirection,
                                                  QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onListTagsWithNoteLocalUidsFailed", requestId);
+
     if (requestId != m_listTagsRequestId) {
         return;
     }
@@ -1408,6 +1427,8 @@ void TagModel::onListTagsWithNoteLocalUidsFailed(LocalStorageManager::ListObject
 
 void TagModel::onExpungeTagComplete(Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onExpungeTagComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onExpungeTagComplete: tag = ") << tag
             << QStringLiteral("\nExpunged child tag local uids: ") << expungedChildTagLocalUids.join(QStringLiteral(", "))
             << QStringLiteral(", request id = ") << requestId);
@@ -1425,6 +1446,8 @@ void TagModel::onExpungeTagComplete(Tag tag, QStringList expungedChildTagLocalUi
 
 void TagModel::onExpungeTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onExpungeTagFailed", requestId);
+
     auto it = m_expungeTagRequestIds.find(requestId);
     if (it == m_expungeTagRequestIds.end()) {
         return;
@@ -1440,6 +1463,8 @@ void TagModel::onExpungeTagFailed(Tag tag, ErrorString errorDescription, QUuid r
 
 void TagModel::onGetNoteCountPerTagComplete(int noteCount, Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onGetNoteCountPerTagComplete", requestId);
+
     auto it = m_noteCountPerTagRequestIds.find(requestId);
     if (it == m_noteCountPerTagRequestIds.end()) {
         return;
@@ -1501,6 +1526,8 @@ void TagModel::onGetNoteCountPerTagComplete(int noteCount, Tag tag, QUuid reques
 
 void TagModel::onGetNoteCountPerTagFailed(ErrorString errorDescription, Tag tag, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onGetNoteCountPerTagFailed", requestId);
+
     auto it = m_noteCountPerTagRequestIds.find(requestId);
     if (it == m_noteCountPerTagRequestIds.end()) {
         return;
@@ -1520,6 +1547,8 @@ void TagModel::onGetNoteCountPerTagFailed(ErrorString errorDescription, Tag tag,
 
 void TagModel::onGetNoteCountsPerAllTagsComplete(QHash<QString, int> noteCountsPerTagLocalUid, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onGetNoteCountsPerAllTagsComplete", requestId);
+
     if (requestId != m_noteCountsPerAllTagsRequestId) {
         return;
     }
@@ -1566,6 +1595,8 @@ void TagModel::onGetNoteCountsPerAllTagsComplete(QHash<QString, int> noteCountsP
 
 void TagModel::onGetNoteCountsPerAllTagsFailed(ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onGetNoteCountsPerAllTagsFailed", requestId);
+
     if (requestId != m_noteCountsPerAllTagsRequestId) {
         return;
     }
@@ -1584,6 +1615,8 @@ void TagModel::onGetNoteCountsPerAllTagsFailed(ErrorString errorDescription, QUu
 
 void TagModel::onExpungeNotelessTagsFromLinkedNotebooksComplete(QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onExpungeNotelessTagsFromLinkedNotebooksComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onExpungeNotelessTagsFromLinkedNotebooksComplete: request id = ") << requestId);
 
     TagDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
@@ -1604,12 +1637,15 @@ void TagModel::onExpungeNotelessTagsFromLinkedNotebooksComplete(QUuid requestId)
         tag.setLocalUid(item.localUid());
         QNTRACE(QStringLiteral("Emitting the request to find tag from linked notebook to check for its existence: ")
                 << item.localUid() << QStringLiteral(", request id = ") << requestId);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::findTag");
         Q_EMIT findTag(tag, requestId);
     }
 }
 
 void TagModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onFindNotebookComplete", requestId);
+
     auto it = m_findNotebookRequestForLinkedNotebookGuid.right.find(requestId);
     if (it == m_findNotebookRequestForLinkedNotebookGuid.right.end()) {
         return;
@@ -1625,6 +1661,8 @@ void TagModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 
 void TagModel::onFindNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onFindNotebookFailed", requestId);
+
     auto it = m_findNotebookRequestForLinkedNotebookGuid.right.find(requestId);
     if (it == m_findNotebookRequestForLinkedNotebookGuid.right.end()) {
         return;
@@ -1638,6 +1676,8 @@ void TagModel::onFindNotebookFailed(Notebook notebook, ErrorString errorDescript
 
 void TagModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onUpdateNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onUpdateNotebookComplete: local uid = ") << notebook.localUid());
     Q_UNUSED(requestId)
     updateRestrictionsFromNotebook(notebook);
@@ -1645,6 +1685,8 @@ void TagModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 
 void TagModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onExpungeNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onExpungeNotebookComplete: local uid = ") << notebook.localUid()
             << QStringLiteral(", linked notebook guid = ")
             << (notebook.hasLinkedNotebookGuid() ? notebook.linkedNotebookGuid() : QStringLiteral("<null>")));
@@ -1674,6 +1716,8 @@ void TagModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 
 void TagModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onAddNoteComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onAddNoteComplete: note = ") << note
             << QStringLiteral("\nRequest id = ") << requestId);
 
@@ -1707,6 +1751,8 @@ void TagModel::onAddNoteComplete(Note note, QUuid requestId)
 
 void TagModel::onUpdateNoteComplete(Note note, bool updateResources, bool updateTags, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onUpdateNoteComplete", requestId);
+
     if (!updateTags) {
         return;
     }
@@ -1778,6 +1824,8 @@ void TagModel::onUpdateNoteComplete(Note note, bool updateResources, bool update
 
 void TagModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onExpungeNoteComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onExpungeNoteComplete: note = ") << note
             << QStringLiteral("\nRequest id = ") << requestId);
 
@@ -1824,6 +1872,8 @@ void TagModel::onExpungeNoteComplete(Note note, QUuid requestId)
 
 void TagModel::onAddLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onAddLinkedNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onAddLinkedNotebookComplete: request id = ")
             << requestId << QStringLiteral(", linked notebook: ") << linkedNotebook);
     onLinkedNotebookAddedOrUpdated(linkedNotebook);
@@ -1831,6 +1881,8 @@ void TagModel::onAddLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUuid
 
 void TagModel::onUpdateLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onUpdateLinkedNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onUpdateLinkedNotebookComplete: request id = ")
             << requestId << QStringLiteral(", linked notebook: ") << linkedNotebook);
     onLinkedNotebookAddedOrUpdated(linkedNotebook);
@@ -1838,6 +1890,8 @@ void TagModel::onUpdateLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUu
 
 void TagModel::onExpungeLinkedNotebookComplete(LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onExpungeLinkedNotebookComplete", requestId);
+
     QNTRACE(QStringLiteral("TagModel::onExpungeLinkedNotebookComplete: request id = ")
             << requestId << QStringLiteral(", linked notebook: ") << linkedNotebook);
 
@@ -1899,6 +1953,8 @@ void TagModel::onListAllTagsPerNoteComplete(QList<Tag> foundTags, Note note,
                                             LocalStorageManager::OrderDirection::type orderDirection,
                                             QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onListAllTagsPerNoteComplete", requestId);
+
     auto it = m_listTagsPerNoteRequestIds.find(requestId);
     if (it == m_listTagsPerNoteRequestIds.end()) {
         return;
@@ -1921,6 +1977,8 @@ void TagModel::onListAllTagsPerNoteFailed(Note note, LocalStorageManager::ListOb
                                           LocalStorageManager::OrderDirection::type orderDirection,
                                           ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onListAllTagsPerNoteFailed", requestId);
+
     auto it = m_listTagsPerNoteRequestIds.find(requestId);
     if (it == m_listTagsPerNoteRequestIds.end()) {
         return;
@@ -1942,6 +2000,8 @@ void TagModel::onListAllLinkedNotebooksComplete(size_t limit, size_t offset,
                                                 QList<LinkedNotebook> foundLinkedNotebooks,
                                                 QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onListAllLinkedNotebooksComplete", requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -1978,6 +2038,8 @@ void TagModel::onListAllLinkedNotebooksFailed(size_t limit, size_t offset,
                                               LocalStorageManager::OrderDirection::type orderDirection,
                                               ErrorString errorDescription, QUuid requestId)
 {
+    QUENTIER_MODEL_HANDLER_TIMER("TagModel::onListAllLinkedNotebooksFailed", requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -1992,6 +2054,29 @@ void TagModel::onListAllLinkedNotebooksFailed(size_t limit, size_t offset,
     Q_EMIT notifyError(errorDescription);
 }
 
+void TagModel::connectToLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("TagModel::connectToLocalStorage"));
+    createConnections(localStorageManagerAsync);
+}
+
+void TagModel::disconnectFromLocalStorage(LocalStorageManagerAsync & localStorageManagerAsync)
+{
+    QNDEBUG(QStringLiteral("TagModel::disconnectFromLocalStorage"));
+    QObject::disconnect(this, Q_NULLPTR, &localStorageManagerAsync, Q_NULLPTR);
+    QObject::disconnect(&localStorageManagerAsync, Q_NULLPTR, this, Q_NULLPTR);
+}
+
+bool TagModel::hasPendingRequests() const
+{
+    return !m_listTagsRequestId.isNull() || !m_noteCountsPerAllTagsRequestId.isNull() ||
+           !m_listLinkedNotebooksRequestId.isNull() || !m_addTagRequestIds.isEmpty() ||
+           !m_updateTagRequestIds.isEmpty() || !m_expungeTagRequestIds.isEmpty() ||
+           !m_noteCountPerTagRequestIds.isEmpty() || !m_findTagToRestoreFailedUpdateRequestIds.isEmpty() ||
+           !m_findTagToPerformUpdateRequestIds.isEmpty() || !m_findTagAfterNotelessTagsErasureRequestIds.isEmpty() ||
+           !m_listTagsPerNoteRequestIds.isEmpty() || !m_findNotebookRequestForLinkedNotebookGuid.empty();
+}
+
 void TagModel::createConnections(LocalStorageManagerAsync & localStorageManagerAsync)
 {
     QNTRACE(QStringLiteral("TagModel::createConnections"));
@@ -2117,6 +2202,7 @@ void TagModel::requestTagsList()
     m_listTagsRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list tags: offset = ") << m_listTagsOffset << QStringLiteral(", request id = ")
             << m_listTagsRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listTagsRequestId, "TagModel::listTagsWithNoteLocalUids");
     Q_EMIT listTagsWithNoteLocalUids(flags, TAG_LIST_LIMIT, m_listTagsOffset, order, direction, QString(), m_listTagsRequestId);
 }
 
@@ -2137,6 +2223,7 @@ void TagModel::requestTagsPerNote(const Note & note)
     QUuid requestId = QUuid::createUuid();
     Q_UNUSED(m_listTagsPerNoteRequestIds.insert(requestId))
     QNTRACE(QStringLiteral("Emitting the request to list tags per note: request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::listAllTagsPerNote");
     Q_EMIT listAllTagsPerNote(note, LocalStorageManager::ListAll,
                               /* limit = */ 0, /* offset = */ 0, LocalStorageManager::ListTagsOrder::NoOrder,
                               LocalStorageManager::OrderDirection::Ascending, requestId);
@@ -2160,6 +2247,7 @@ void TagModel::requestLinkedNotebooksList()
     m_listLinkedNotebooksRequestId = QUuid::createUuid();
     QNTRACE(QStringLiteral("Emitting the request to list linked notebooks: offset = ") << m_listLinkedNotebooksOffset
             << QStringLiteral(", request id = ") << m_listLinkedNotebooksRequestId);
+    QUENTIER_MODEL_REQUEST_SENT(m_listLinkedNotebooksRequestId, "TagModel::listAllLinkedNotebooks");
     Q_EMIT listAllLinkedNotebooks(LINKED_NOTEBOOK_LIST_LIMIT, m_listLinkedNotebooksOffset, order, direction, m_listLinkedNotebooksRequestId);
 }
 
@@ -3777,15 +3865,38 @@ void TagModel::updateItemRowWithRespectToSorting(const TagModelItem & item)
         return;
     }
 
+    // The appropriate row is looked up among the item's siblings, as if the item was already taken from its parent
+    QList<const TagModelItem*> siblings = pParentItem->children();
+    siblings.removeAt(currentItemRow);
+
+    auto it = siblings.constEnd();
+    if (m_sortOrder == Qt::AscendingOrder) {
+        it = std::lower_bound(siblings.constBegin(), siblings.constEnd(), &item, LessByName());
+    }
+    else {
+        it = std::lower_bound(siblings.constBegin(), siblings.constEnd(), &item, GreaterByName());
+    }
+
+    int appropriateRow = static_cast<int>(std::distance(siblings.constBegin(), it));
+    if (appropriateRow == currentItemRow) {
+        QNTRACE(QStringLiteral("The item is already at the appropriate row ") << currentItemRow);
+        return;
+    }
+
+    // The destination row for beginMoveRows is counted before the item is taken from its original row
+    int destinationRow = ((appropriateRow > currentItemRow) ? (appropriateRow + 1) : appropriateRow);
+
     QModelIndex parentIndex = indexForItem(pParentItem);
-    beginRemoveRows(parentIndex, currentItemRow, currentItemRow);
-    Q_UNUSED(pParentItem->takeChild(currentItemRow))
-    endRemoveRows();
+    bool res = beginMoveRows(parentIndex, currentItemRow, currentItemRow, parentIndex, destinationRow);
+    if (Q_UNLIKELY(!res)) {
+        QNWARNING(QStringLiteral("Internal error, can't move row within the tag model for sorting purposes: from row ")
+                  << currentItemRow << QStringLiteral(" to row ") << appropriateRow);
+        return;
+    }
 
-    int appropriateRow = rowForNewItem(*pParentItem, item);
-    beginInsertRows(parentIndex, appropriateRow, appropriateRow);
+    Q_UNUSED(pParentItem->takeChild(currentItemRow))
     pParentItem->insertChild(appropriateRow, &item);
-    endInsertRows();
+    endMoveRows();
 
     QNTRACE(QStringLiteral("Moved item from row ") << currentItemRow << QStringLiteral(" to row ") << appropriateRow
             << QStringLiteral("; item: ") << item);
@@ -3826,6 +3937,7 @@ void TagModel::updateTagInLocalStorage(const TagItem & item)
             dummy.setLocalUid(item.localUid());
             QNDEBUG(QStringLiteral("Emitting the request to find tag: local uid = ") << item.localUid()
                     << QStringLiteral(", request id = ") << requestId);
+            QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::findTag");
             Q_EMIT findTag(dummy, requestId);
             return;
         }
@@ -3843,6 +3955,7 @@ void TagModel::updateTagInLocalStorage(const TagItem & item)
 
         QNTRACE(QStringLiteral("Emitting the request to add the tag to local storage: id = ") << requestId
                 << QStringLiteral(", tag: ") << tag);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::addTag");
         Q_EMIT addTag(tag, requestId);
 
         Q_UNUSED(m_tagItemsNotYetInLocalStorageUids.erase(notYetSavedItemIt))
@@ -3857,6 +3970,7 @@ void TagModel::updateTagInLocalStorage(const TagItem & item)
 
         QNTRACE(QStringLiteral("Emitting the request to update tag in the local storage: id = ") << requestId
                 << QStringLiteral(", tag: ") << tag);
+        QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::updateTag");
         Q_EMIT updateTag(tag, requestId);
     }
 }
@@ -4118,15 +4232,16 @@ void TagModel::checkAndFindLinkedNotebookRestrictions(const TagItem & tagItem)
     notebook.setLinkedNotebookGuid(linkedNotebookGuid);
     QNTRACE(QStringLiteral("Emitted the request to find notebook by linked notebook guid: ") << linkedNotebookGuid
             << QStringLiteral(", for the purpose of finding the tag restrictions; request id = ") << requestId);
+    QUENTIER_MODEL_REQUEST_SENT(requestId, "TagModel::findNotebook");
     Q_EMIT findNotebook(notebook, requestId);
 }
 
-#define MODEL_ITEM_NAME(item, itemName) \
+#define MODEL_ITEM_NAME_SORT_KEY(item, pItemNameSortKey) \
     if ((item.type() == TagModelItem::Type::Tag) && item.tagItem()) { \
-        itemName = item.tagItem()->nameUpper(); \
+        pItemNameSortKey = &(item.tagItem()->nameSortKey()); \
     } \
     else if ((item.type() == TagModelItem::Type::LinkedNotebook) && item.tagLinkedNotebookItem()) { \
-        itemName = item.tagLinkedNotebookItem()->username().toUpper(); \
+        pItemNameSortKey = &(item.tagLinkedNotebookItem()->usernameSortKey()); \
     }
 
 bool TagModel::LessByName::operator()(const TagModelItem & lhs, const TagModelItem & rhs) const
@@ -4143,13 +4258,20 @@ bool TagModel::LessByName::operator()(const TagModelItem & lhs, const TagModelIt
         return true;
     }
 
-    QString lhsName;
-    MODEL_ITEM_NAME(lhs, lhsName)
+    const NameSortKey * pLhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(lhs, pLhsNameSortKey)
 
-    QString rhsName;
-    MODEL_ITEM_NAME(rhs, rhsName)
+    const NameSortKey * pRhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(rhs, pRhsNameSortKey)
+
+    if (!pLhsNameSortKey) {
+        return true;
+    }
+    else if (!pRhsNameSortKey) {
+        return false;
+    }
 
-    return (lhsName.localeAwareCompare(rhsName) <= 0);
+    return (pLhsNameSortKey->compare(*pRhsNameSortKey) <= 0);
 }
 
 bool TagModel::LessByName::operator()(const TagModelItem * lhs, const TagModelItem * rhs) const
@@ -4179,13 +4301,20 @@ bool TagModel::GreaterByName::operator()(const TagModelItem & lhs, const TagMode
         return true;
     }
 
-    QString lhsName;
-    MODEL_ITEM_NAME(lhs, lhsName)
+    const NameSortKey * pLhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(lhs, pLhsNameSortKey)
+
+    const NameSortKey * pRhsNameSortKey = Q_NULLPTR;
+    MODEL_ITEM_NAME_SORT_KEY(rhs, pRhsNameSortKey)
 
-    QString rhsName;
-    MODEL_ITEM_NAME(rhs, rhsName)
+    if (!pLhsNameSortKey) {
+        return false;
+    }
+    else if (!pRhsNameSortKey) {
+        return true;
+    }
 
-    return (lhsName.localeAwareCompare(rhsName) > 0);
+    return (pLhsNameSortKey->compare(*pRhsNameSortKey) > 0);
 }
 
 bool TagModel::GreaterByName::operator()(const TagModelItem * lhs, const TagModelItem * rhs) const
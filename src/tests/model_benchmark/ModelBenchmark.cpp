@@ -0,0 +1,1090 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelBenchmark.h"
+#include "../../models/NoteModel.h"
+#include "../../models/NoteFilterModel.h"
+#include "../../models/TagModel.h"
+#include "../../models/NotebookModel.h"
+#include "../../models/SavedSearchModel.h"
+#include "../../models/FavoritesModel.h"
+#include "../../widgets/FilterByTagWidget.h"
+#include "../../widgets/FilterByNotebookWidget.h"
+#include "../../widgets/FilterBySavedSearchWidget.h"
+#include "../../NoteFiltersManager.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <QCoreApplication>
+#include <QSortFilterProxyModel>
+#include <QLineEdit>
+#include <QTextStream>
+#include <QTimer>
+#include <QFile>
+#include <QRegExp>
+#include <QVector>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+// The timeout for the model to list all of its items from the local storage
+#define MODEL_BENCHMARK_MAX_ALLOWED_MILLISECONDS (600000)
+
+// Bumped each time the layout of the JSON output changes in a way incompatible with the tools processing it
+#define MODEL_BENCHMARK_OUTPUT_FORMAT_VERSION (1)
+
+// The unit of measurements compared by the regression check
+#define MODEL_BENCHMARK_PER_EVENT_TIME_UNIT "ms/event"
+
+// The growth of per event time smaller than this is considered a noise even if it exceeds the allowed percentage:
+// the times of the cheapest events are close to the precision of the measurement
+#define MODEL_BENCHMARK_MIN_REGRESSION_MSEC (0.001)
+
+// The time per event spent in the GUI thread is the difference of two separately measured times per event,
+// so its relative noise is much higher than the one of either of them; it is reported but not checked
+// for regressions since the measurements it is derived from are checked anyway
+#define MODEL_BENCHMARK_GUI_THREAD_PER_EVENT_METRIC "mixed_storm_gui_thread_per_event"
+
+// The max number of events replayed with the local storage's signals blocked in order to estimate
+// the share of the local storage in the time per event of the mixed storm
+#define MODEL_BENCHMARK_MAX_CALIBRATION_STORM_SIZE (10000)
+
+namespace quentier {
+
+/**
+ * @return the resident set size of the current process in kilobytes or -1 if it can't be determined
+ */
+static qint64 residentMemoryKb()
+{
+#ifdef Q_OS_LINUX
+    QFile file(QStringLiteral("/proc/self/statm"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+
+    QList<QByteArray> fields = file.readAll().split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+
+    bool conversionResult = false;
+    qint64 numPages = fields[1].toLongLong(&conversionResult);
+    if (!conversionResult) {
+        return -1;
+    }
+
+    return numPages * static_cast<qint64>(sysconf(_SC_PAGESIZE)) / 1024;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @return the peak resident set size of the current process in kilobytes or -1 if it can't be determined
+ */
+static qint64 peakResidentMemoryKb()
+{
+#ifdef Q_OS_LINUX
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+
+    // The line looks like "VmHWM:     123456 kB"
+    QByteArray prefix("VmHWM:");
+    while(!file.atEnd())
+    {
+        QByteArray line = file.readLine();
+        if (!line.startsWith(prefix)) {
+            continue;
+        }
+
+        QList<QByteArray> fields = line.mid(prefix.size()).simplified().split(' ');
+        bool conversionResult = false;
+        qint64 peakResidentMemory = fields.value(0).toLongLong(&conversionResult);
+        return (conversionResult ? peakResidentMemory : -1);
+    }
+
+    return -1;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief resetPeakResidentMemory makes the peak resident set size of the current process equal to the current one
+ * @return true if the peak was reset, false otherwise (i.e. if the kernel doesn't support it)
+ */
+static bool resetPeakResidentMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile file(QStringLiteral("/proc/self/clear_refs"));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    return (file.write("5") == 1);
+#else
+    return false;
+#endif
+}
+
+static double elapsedMsec(const QElapsedTimer & timer)
+{
+    return static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+}
+
+static QString toJsonString(const QString & str)
+{
+    QString result;
+    result.reserve(str.size() + 2);
+    result += QChar::fromLatin1('"');
+
+    for(auto it = str.constBegin(), end = str.constEnd(); it != end; ++it)
+    {
+        const QChar & ch = *it;
+        if ((ch == QChar::fromLatin1('"')) || (ch == QChar::fromLatin1('\\'))) {
+            result += QChar::fromLatin1('\\');
+            result += ch;
+        }
+        else if (ch.unicode() < 0x20) {
+            result += QStringLiteral("\\u") + QString::number(ch.unicode(), 16).rightJustified(4, QChar::fromLatin1('0'));
+        }
+        else {
+            result += ch;
+        }
+    }
+
+    result += QChar::fromLatin1('"');
+    return result;
+}
+
+ModelBenchmark::ModelBenchmark(const SyntheticAccountParameters & parameters, const int stormSize,
+                               const int mixedStormSize, QObject * parent) :
+    QObject(parent),
+    m_parameters(parameters),
+    m_stormSize(stormSize),
+    m_mixedStormSize(mixedStormSize),
+    m_measurements(),
+    m_numAddedNotes(0),
+    m_numAddedTags(0),
+    m_pLocalStorageManagerAsync(),
+    m_noteCache(),
+    m_notebookCache(),
+    m_tagCache(),
+    m_savedSearchCache(),
+    m_pNoteModel(),
+    m_pTagModel(),
+    m_pNotebookModel(),
+    m_pSavedSearchModel(),
+    m_pFavoritesModel(),
+    m_pNoteFilterModel(),
+    m_pFilterByTagWidget(),
+    m_pFilterByNotebookWidget(),
+    m_pFilterBySavedSearchWidget(),
+    m_pSearchLineEdit(),
+    m_pNoteFiltersManager(),
+    m_pGenerator()
+{}
+
+ModelBenchmark::~ModelBenchmark()
+{}
+
+bool ModelBenchmark::run(ErrorString & errorDescription)
+{
+    QNINFO(QStringLiteral("ModelBenchmark::run: ") << m_parameters << QStringLiteral(", storm size = ") << m_stormSize
+           << QStringLiteral(", mixed storm size = ") << m_mixedStormSize);
+
+    m_measurements.clear();
+    m_numAddedNotes = 0;
+    m_numAddedTags = 0;
+
+    if (!setupLocalStorage(errorDescription)) {
+        return false;
+    }
+
+    if (!populateModels(errorDescription)) {
+        return false;
+    }
+
+    benchmarkSorting();
+    benchmarkFiltering();
+
+    if (!benchmarkEventStorms(errorDescription)) {
+        return false;
+    }
+
+    if (!benchmarkMixedEventStorm(errorDescription)) {
+        return false;
+    }
+
+    qint64 residentMemory = residentMemoryKb();
+    if (residentMemory >= 0) {
+        addMeasurement(QStringLiteral("Total"), QStringLiteral("resident_memory"),
+                       static_cast<double>(residentMemory), QStringLiteral("KiB"));
+    }
+
+    qint64 peakResidentMemory = peakResidentMemoryKb();
+    if (peakResidentMemory >= 0) {
+        addMeasurement(QStringLiteral("Total"), QStringLiteral("peak_resident_memory"),
+                       static_cast<double>(peakResidentMemory), QStringLiteral("KiB"));
+    }
+
+    return true;
+}
+
+ModelBenchmarkReport ModelBenchmark::report() const
+{
+    ModelBenchmarkReport report;
+    report.m_parameters = m_parameters;
+    report.m_stormSize = m_stormSize;
+    report.m_mixedStormSize = m_mixedStormSize;
+    report.m_measurements = m_measurements;
+    return report;
+}
+
+void ModelBenchmark::writeReportsAsJson(const QList<ModelBenchmarkReport> & reports, QTextStream & strm)
+{
+    strm << "{\n";
+    strm << "  \"format_version\": " << MODEL_BENCHMARK_OUTPUT_FORMAT_VERSION << ",\n";
+    strm << "  \"qt_version\": " << toJsonString(QString::fromUtf8(qVersion())) << ",\n";
+    strm << "  \"reports\": [";
+
+    for(int i = 0, numReports = reports.size(); i < numReports; ++i)
+    {
+        const ModelBenchmarkReport & report = reports[i];
+        const SyntheticAccountParameters & parameters = report.m_parameters;
+
+        strm << (i == 0 ? "\n" : ",\n");
+        strm << "    {\n";
+        strm << "      \"account\": {\n";
+        strm << "        \"name\": " << toJsonString(parameters.m_name) << ",\n";
+        strm << "        \"notebooks\": " << parameters.m_numNotebooks << ",\n";
+        strm << "        \"tags\": " << parameters.m_numTags << ",\n";
+        strm << "        \"tag_nesting_depth\": " << parameters.m_tagNestingDepth << ",\n";
+        strm << "        \"notes\": " << parameters.m_numNotes << ",\n";
+        strm << "        \"tags_per_note\": " << parameters.m_numTagsPerNote << ",\n";
+        strm << "        \"saved_searches\": " << parameters.m_numSavedSearches << ",\n";
+        strm << "        \"favorited_percent\": " << parameters.m_favoritedPercent << ",\n";
+        strm << "        \"storm_size\": " << report.m_stormSize << ",\n";
+        strm << "        \"mixed_storm_size\": " << report.m_mixedStormSize << "\n";
+        strm << "      },\n";
+        strm << "      \"measurements\": [";
+
+        for(int j = 0, numMeasurements = report.m_measurements.size(); j < numMeasurements; ++j)
+        {
+            const ModelBenchmarkMeasurement & measurement = report.m_measurements[j];
+            strm << (j == 0 ? "\n" : ",\n");
+            strm << "        { \"model\": " << toJsonString(measurement.m_model)
+                 << ", \"metric\": " << toJsonString(measurement.m_metric)
+                 << ", \"value\": " << QString::number(measurement.m_value, 'f', 3)
+                 << ", \"unit\": " << toJsonString(measurement.m_unit) << " }";
+        }
+
+        strm << "\n      ]\n";
+        strm << "    }";
+    }
+
+    strm << "\n  ]\n";
+    strm << "}\n";
+    strm.flush();
+}
+
+bool ModelBenchmark::readReportsFromJson(QTextStream & strm, QList<ModelBenchmarkReport> & reports,
+                                         ErrorString & errorDescription)
+{
+    reports.clear();
+
+    // The reports are read line by line relying on the layout produced by writeReportsAsJson
+    QRegExp formatVersionRegExp(QStringLiteral("^\\s*\"format_version\":\\s*(\\d+),?\\s*$"));
+    QRegExp accountNameRegExp(QStringLiteral("^\\s*\"name\":\\s*\"([^\"]*)\",?\\s*$"));
+    QRegExp measurementRegExp(QStringLiteral("\"model\":\\s*\"([^\"]*)\",\\s*\"metric\":\\s*\"([^\"]*)\",\\s*"
+                                             "\"value\":\\s*([-+0-9.eE]+),\\s*\"unit\":\\s*\"([^\"]*)\""));
+
+    int formatVersion = -1;
+    while(!strm.atEnd())
+    {
+        QString line = strm.readLine();
+
+        if (formatVersionRegExp.indexIn(line) >= 0) {
+            formatVersion = formatVersionRegExp.cap(1).toInt();
+            continue;
+        }
+
+        if (accountNameRegExp.indexIn(line) >= 0) {
+            ModelBenchmarkReport report;
+            report.m_parameters.m_name = accountNameRegExp.cap(1);
+            reports << report;
+            continue;
+        }
+
+        if (measurementRegExp.indexIn(line) < 0) {
+            continue;
+        }
+
+        bool conversionResult = false;
+        ModelBenchmarkMeasurement measurement;
+        measurement.m_model = measurementRegExp.cap(1);
+        measurement.m_metric = measurementRegExp.cap(2);
+        measurement.m_value = measurementRegExp.cap(3).toDouble(&conversionResult);
+        measurement.m_unit = measurementRegExp.cap(4);
+
+        if (Q_UNLIKELY(reports.isEmpty() || !conversionResult)) {
+            errorDescription.setBase(QStringLiteral("Malformed measurement within the benchmark report"));
+            errorDescription.details() = line.trimmed();
+            return false;
+        }
+
+        reports.last().m_measurements << measurement;
+    }
+
+    if (Q_UNLIKELY(formatVersion != MODEL_BENCHMARK_OUTPUT_FORMAT_VERSION)) {
+        errorDescription.setBase(QStringLiteral("Unsupported format version of the benchmark report"));
+        errorDescription.details() = QString::number(formatVersion);
+        return false;
+    }
+
+    if (Q_UNLIKELY(reports.isEmpty())) {
+        errorDescription.setBase(QStringLiteral("No reports were found within the benchmark output"));
+        return false;
+    }
+
+    return true;
+}
+
+QStringList ModelBenchmark::findPerEventCostRegressions(const QList<ModelBenchmarkReport> & baselineReports,
+                                                        const QList<ModelBenchmarkReport> & reports,
+                                                        const int maxRegressionPercent)
+{
+    QStringList regressions;
+
+    for(auto it = reports.constBegin(), end = reports.constEnd(); it != end; ++it)
+    {
+        const ModelBenchmarkReport & report = *it;
+
+        const ModelBenchmarkReport * pBaselineReport = Q_NULLPTR;
+        for(auto bit = baselineReports.constBegin(), bend = baselineReports.constEnd(); bit != bend; ++bit)
+        {
+            if (bit->m_parameters.m_name == report.m_parameters.m_name) {
+                pBaselineReport = &(*bit);
+                break;
+            }
+        }
+
+        if (!pBaselineReport) {
+            QNDEBUG(QStringLiteral("No baseline report for account ") << report.m_parameters.m_name);
+            continue;
+        }
+
+        for(auto mit = report.m_measurements.constBegin(), mend = report.m_measurements.constEnd(); mit != mend; ++mit)
+        {
+            const ModelBenchmarkMeasurement & measurement = *mit;
+            if (measurement.m_unit != QStringLiteral(MODEL_BENCHMARK_PER_EVENT_TIME_UNIT)) {
+                continue;
+            }
+
+            if (measurement.m_metric == QStringLiteral(MODEL_BENCHMARK_GUI_THREAD_PER_EVENT_METRIC)) {
+                continue;
+            }
+
+            const QList<ModelBenchmarkMeasurement> & baselineMeasurements = pBaselineReport->m_measurements;
+            for(auto bmit = baselineMeasurements.constBegin(), bmend = baselineMeasurements.constEnd(); bmit != bmend; ++bmit)
+            {
+                const ModelBenchmarkMeasurement & baselineMeasurement = *bmit;
+                if ((baselineMeasurement.m_model != measurement.m_model) ||
+                    (baselineMeasurement.m_metric != measurement.m_metric) ||
+                    (baselineMeasurement.m_unit != measurement.m_unit))
+                {
+                    continue;
+                }
+
+                double maxAllowedValue = baselineMeasurement.m_value * (100.0 + maxRegressionPercent) / 100.0;
+                if ((measurement.m_value > maxAllowedValue) &&
+                    (measurement.m_value - baselineMeasurement.m_value > MODEL_BENCHMARK_MIN_REGRESSION_MSEC))
+                {
+                    regressions << (report.m_parameters.m_name + QStringLiteral(": ") + measurement.m_model +
+                                    QStringLiteral(" ") + measurement.m_metric + QStringLiteral(": ") +
+                                    QString::number(baselineMeasurement.m_value, 'f', 4) + QStringLiteral(" -> ") +
+                                    QString::number(measurement.m_value, 'f', 4) + QStringLiteral(" ") +
+                                    measurement.m_unit);
+                }
+
+                break;
+            }
+        }
+    }
+
+    return regressions;
+}
+
+ModelBenchmarkReport ModelBenchmark::medianReport(const QList<ModelBenchmarkReport> & reports)
+{
+    if (reports.isEmpty()) {
+        return ModelBenchmarkReport();
+    }
+
+    // The measurements are taken in the same order by each run so the ones of the first report are used
+    // to enumerate them; the measurement missing from some of the reports gets the median of the rest
+    ModelBenchmarkReport result = reports.first();
+    for(auto mit = result.m_measurements.begin(), mend = result.m_measurements.end(); mit != mend; ++mit)
+    {
+        ModelBenchmarkMeasurement & measurement = *mit;
+
+        QVector<double> values;
+        values.reserve(reports.size());
+        for(auto rit = reports.constBegin(), rend = reports.constEnd(); rit != rend; ++rit)
+        {
+            const QList<ModelBenchmarkMeasurement> & measurements = rit->m_measurements;
+            for(auto it = measurements.constBegin(), end = measurements.constEnd(); it != end; ++it)
+            {
+                if ((it->m_model == measurement.m_model) && (it->m_metric == measurement.m_metric) &&
+                    (it->m_unit == measurement.m_unit))
+                {
+                    values << it->m_value;
+                    break;
+                }
+            }
+        }
+
+        std::sort(values.begin(), values.end());
+        int numValues = values.size();
+        measurement.m_value = ((numValues % 2 == 1)
+                               ? values[numValues / 2]
+                               : (values[numValues / 2 - 1] + values[numValues / 2]) / 2.0);
+    }
+
+    return result;
+}
+
+bool ModelBenchmark::setupLocalStorage(ErrorString & errorDescription)
+{
+    QNDEBUG(QStringLiteral("ModelBenchmark::setupLocalStorage"));
+
+    Account account(QStringLiteral("ModelBenchmark_") + m_parameters.m_name, Account::Type::Local);
+    m_pLocalStorageManagerAsync.reset(new LocalStorageManagerAsync(account, /* start from scratch = */ true,
+                                                                   /* override lock = */ false));
+    m_pLocalStorageManagerAsync->init();
+
+    m_pGenerator.reset(new SyntheticAccountGenerator(*m_pLocalStorageManagerAsync, m_parameters));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!m_pGenerator->generate(errorDescription)) {
+        return false;
+    }
+
+    addTimeMeasurement(QStringLiteral("LocalStorage"), QStringLiteral("generation"), timer);
+    return true;
+}
+
+bool ModelBenchmark::populateModels(ErrorString & errorDescription)
+{
+    QNDEBUG(QStringLiteral("ModelBenchmark::populateModels"));
+
+    const Account & account = m_pLocalStorageManagerAsync->account();
+
+    QElapsedTimer timer;
+    qint64 residentMemoryBefore = residentMemoryKb();
+    timer.start();
+
+    // The models might receive all the items from the local storage right within their constructors
+    // since the local storage lives in the same thread, hence the checks before waiting for the signals
+    m_pNoteModel.reset(new NoteModel(account, *m_pLocalStorageManagerAsync, m_noteCache, m_notebookCache));
+    if (!m_pNoteModel->allNotesListed())
+    {
+        EventLoopWithExitStatus loop;
+        QObject::connect(m_pNoteModel.data(), QNSIGNAL(NoteModel,notifyAllNotesListed),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
+        QObject::connect(m_pNoteModel.data(), QNSIGNAL(NoteModel,notifyError,ErrorString),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsFailureWithErrorString,ErrorString));
+        if (!waitForModel(loop, QStringLiteral("NoteModel"), errorDescription)) {
+            return false;
+        }
+    }
+
+    addPopulationMeasurements(QStringLiteral("NoteModel"), timer, residentMemoryBefore, m_pNoteModel->rowCount());
+
+    residentMemoryBefore = residentMemoryKb();
+    timer.restart();
+
+    m_pTagModel.reset(new TagModel(account, *m_pLocalStorageManagerAsync, m_tagCache));
+    if (!m_pTagModel->allTagsListed())
+    {
+        EventLoopWithExitStatus loop;
+        QObject::connect(m_pTagModel.data(), QNSIGNAL(TagModel,notifyAllTagsListed),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
+        QObject::connect(m_pTagModel.data(), QNSIGNAL(TagModel,notifyError,ErrorString),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsFailureWithErrorString,ErrorString));
+        if (!waitForModel(loop, QStringLiteral("TagModel"), errorDescription)) {
+            return false;
+        }
+    }
+
+    addPopulationMeasurements(QStringLiteral("TagModel"), timer, residentMemoryBefore, m_pTagModel->rowCount());
+
+    residentMemoryBefore = residentMemoryKb();
+    timer.restart();
+
+    m_pNotebookModel.reset(new NotebookModel(account, *m_pNoteModel, *m_pLocalStorageManagerAsync, m_notebookCache));
+    if (!m_pNotebookModel->allNotebooksListed())
+    {
+        EventLoopWithExitStatus loop;
+        QObject::connect(m_pNotebookModel.data(), QNSIGNAL(NotebookModel,notifyAllNotebooksListed),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
+        QObject::connect(m_pNotebookModel.data(), QNSIGNAL(NotebookModel,notifyError,ErrorString),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsFailureWithErrorString,ErrorString));
+        if (!waitForModel(loop, QStringLiteral("NotebookModel"), errorDescription)) {
+            return false;
+        }
+    }
+
+    addPopulationMeasurements(QStringLiteral("NotebookModel"), timer, residentMemoryBefore, m_pNotebookModel->rowCount());
+
+    residentMemoryBefore = residentMemoryKb();
+    timer.restart();
+
+    m_pSavedSearchModel.reset(new SavedSearchModel(account, *m_pLocalStorageManagerAsync, m_savedSearchCache));
+    if (!m_pSavedSearchModel->allSavedSearchesListed())
+    {
+        EventLoopWithExitStatus loop;
+        QObject::connect(m_pSavedSearchModel.data(), QNSIGNAL(SavedSearchModel,notifyAllSavedSearchesListed),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
+        QObject::connect(m_pSavedSearchModel.data(), QNSIGNAL(SavedSearchModel,notifyError,ErrorString),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsFailureWithErrorString,ErrorString));
+        if (!waitForModel(loop, QStringLiteral("SavedSearchModel"), errorDescription)) {
+            return false;
+        }
+    }
+
+    addPopulationMeasurements(QStringLiteral("SavedSearchModel"), timer, residentMemoryBefore,
+                              m_pSavedSearchModel->rowCount());
+
+    residentMemoryBefore = residentMemoryKb();
+    timer.restart();
+
+    m_pFavoritesModel.reset(new FavoritesModel(account, *m_pNoteModel, *m_pLocalStorageManagerAsync, m_noteCache,
+                                               m_notebookCache, m_tagCache, m_savedSearchCache));
+    if (!m_pFavoritesModel->allItemsListed())
+    {
+        EventLoopWithExitStatus loop;
+        QObject::connect(m_pFavoritesModel.data(), QNSIGNAL(FavoritesModel,notifyAllItemsListed),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
+        QObject::connect(m_pFavoritesModel.data(), QNSIGNAL(FavoritesModel,notifyError,ErrorString),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsFailureWithErrorString,ErrorString));
+        if (!waitForModel(loop, QStringLiteral("FavoritesModel"), errorDescription)) {
+            return false;
+        }
+    }
+
+    addPopulationMeasurements(QStringLiteral("FavoritesModel"), timer, residentMemoryBefore, m_pFavoritesModel->rowCount());
+    return true;
+}
+
+void ModelBenchmark::benchmarkSorting()
+{
+    QNDEBUG(QStringLiteral("ModelBenchmark::benchmarkSorting"));
+
+    QElapsedTimer timer;
+
+    // The note model can be sorted by most of its columns, the ones used in the note list are measured
+    timer.start();
+    m_pNoteModel->sort(NoteModel::Columns::Title, Qt::AscendingOrder);
+    addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("sort_by_title"), timer);
+
+    timer.restart();
+    m_pNoteModel->sort(NoteModel::Columns::Title, Qt::DescendingOrder);
+    addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("reverse_sort_by_title"), timer);
+
+    timer.restart();
+    m_pNoteModel->sort(NoteModel::Columns::ModificationTimestamp, Qt::DescendingOrder);
+    addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("sort_by_modification_time"), timer);
+
+    timer.restart();
+    m_pNoteModel->sort(NoteModel::Columns::Size, Qt::DescendingOrder);
+    addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("sort_by_size"), timer);
+
+    // Other models can only be sorted by name; as they are already sorted in the ascending order after
+    // the population, the descending order is measured first
+    timer.restart();
+    m_pTagModel->sort(TagModel::Columns::Name, Qt::DescendingOrder);
+    m_pTagModel->sort(TagModel::Columns::Name, Qt::AscendingOrder);
+    addTimeMeasurement(QStringLiteral("TagModel"), QStringLiteral("sort_by_name_both_orders"), timer);
+
+    timer.restart();
+    m_pNotebookModel->sort(NotebookModel::Columns::Name, Qt::DescendingOrder);
+    m_pNotebookModel->sort(NotebookModel::Columns::Name, Qt::AscendingOrder);
+    addTimeMeasurement(QStringLiteral("NotebookModel"), QStringLiteral("sort_by_name_both_orders"), timer);
+
+    timer.restart();
+    m_pSavedSearchModel->sort(SavedSearchModel::Columns::Name, Qt::DescendingOrder);
+    m_pSavedSearchModel->sort(SavedSearchModel::Columns::Name, Qt::AscendingOrder);
+    addTimeMeasurement(QStringLiteral("SavedSearchModel"), QStringLiteral("sort_by_name_both_orders"), timer);
+
+    timer.restart();
+    m_pFavoritesModel->sort(FavoritesModel::Columns::DisplayName, Qt::AscendingOrder);
+    m_pFavoritesModel->sort(FavoritesModel::Columns::DisplayName, Qt::DescendingOrder);
+    addTimeMeasurement(QStringLiteral("FavoritesModel"), QStringLiteral("sort_by_name_both_orders"), timer);
+
+    timer.restart();
+    m_pFavoritesModel->sort(FavoritesModel::Columns::NumNotesTargeted, Qt::DescendingOrder);
+    addTimeMeasurement(QStringLiteral("FavoritesModel"), QStringLiteral("sort_by_note_count"), timer);
+}
+
+void ModelBenchmark::benchmarkFiltering()
+{
+    QNDEBUG(QStringLiteral("ModelBenchmark::benchmarkFiltering"));
+
+    QElapsedTimer timer;
+
+    NoteFilterModel noteFilterModel;
+    timer.start();
+    noteFilterModel.setSourceModel(m_pNoteModel.data());
+    addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("filter_setup"), timer);
+
+    const QStringList & notebookLocalUids = m_pGenerator->notebookLocalUids();
+    if (!notebookLocalUids.isEmpty())
+    {
+        timer.restart();
+        noteFilterModel.setNotebookLocalUids(QStringList() << notebookLocalUids.first());
+        Q_UNUSED(noteFilterModel.rowCount())
+        addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("filter_by_notebook"), timer);
+    }
+
+    const QStringList & tagLocalUids = m_pGenerator->tagLocalUids();
+    if (!tagLocalUids.isEmpty())
+    {
+        timer.restart();
+        noteFilterModel.setTagLocalUids(QStringList() << tagLocalUids.first());
+        Q_UNUSED(noteFilterModel.rowCount())
+        addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("filter_by_notebook_and_tag"), timer);
+    }
+
+    const QStringList & noteLocalUids = m_pGenerator->noteLocalUids();
+    if (!noteLocalUids.isEmpty())
+    {
+        // Simulates the results of the note search: every tenth note matches the search query
+        QStringList foundNoteLocalUids;
+        foundNoteLocalUids.reserve(noteLocalUids.size() / 10 + 1);
+        for(int i = 0, size = noteLocalUids.size(); i < size; i += 10) {
+            foundNoteLocalUids << noteLocalUids[i];
+        }
+
+        timer.restart();
+        noteFilterModel.setNoteLocalUids(foundNoteLocalUids);
+        Q_UNUSED(noteFilterModel.rowCount())
+        addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("filter_by_note_local_uids"), timer);
+    }
+
+    timer.restart();
+    noteFilterModel.beginUpdateFilter();
+    noteFilterModel.clearNoteLocalUids();
+    noteFilterModel.setNotebookLocalUids(QStringList());
+    noteFilterModel.setTagLocalUids(QStringList());
+    noteFilterModel.endUpdateFilter();
+    Q_UNUSED(noteFilterModel.rowCount())
+    addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("filter_clear"), timer);
+
+    // The generated names contain hexadecimal keys so filtering by a single hexadecimal digit matches
+    // roughly a half of items
+    QString filterString = QStringLiteral("a");
+
+    QSortFilterProxyModel tagFilterModel;
+    tagFilterModel.setSourceModel(m_pTagModel.data());
+    tagFilterModel.setFilterKeyColumn(TagModel::Columns::Name);
+    timer.start();
+    tagFilterModel.setFilterFixedString(filterString);
+    Q_UNUSED(tagFilterModel.rowCount())
+    addTimeMeasurement(QStringLiteral("TagModel"), QStringLiteral("filter_by_name"), timer);
+
+    QSortFilterProxyModel notebookFilterModel;
+    notebookFilterModel.setSourceModel(m_pNotebookModel.data());
+    notebookFilterModel.setFilterKeyColumn(NotebookModel::Columns::Name);
+    timer.restart();
+    notebookFilterModel.setFilterFixedString(filterString);
+    Q_UNUSED(notebookFilterModel.rowCount())
+    addTimeMeasurement(QStringLiteral("NotebookModel"), QStringLiteral("filter_by_name"), timer);
+
+    QSortFilterProxyModel savedSearchFilterModel;
+    savedSearchFilterModel.setSourceModel(m_pSavedSearchModel.data());
+    savedSearchFilterModel.setFilterKeyColumn(SavedSearchModel::Columns::Name);
+    timer.restart();
+    savedSearchFilterModel.setFilterFixedString(filterString);
+    Q_UNUSED(savedSearchFilterModel.rowCount())
+    addTimeMeasurement(QStringLiteral("SavedSearchModel"), QStringLiteral("filter_by_name"), timer);
+
+    QSortFilterProxyModel favoritesFilterModel;
+    favoritesFilterModel.setSourceModel(m_pFavoritesModel.data());
+    favoritesFilterModel.setFilterKeyColumn(FavoritesModel::Columns::DisplayName);
+    timer.restart();
+    favoritesFilterModel.setFilterFixedString(filterString);
+    Q_UNUSED(favoritesFilterModel.rowCount())
+    addTimeMeasurement(QStringLiteral("FavoritesModel"), QStringLiteral("filter_by_name"), timer);
+}
+
+bool ModelBenchmark::benchmarkEventStorms(ErrorString & errorDescription)
+{
+    QNDEBUG(QStringLiteral("ModelBenchmark::benchmarkEventStorms"));
+
+    // The storms are simulated by the requests sent to the local storage directly, the same way the sync does it;
+    // all the models observe the results of these requests, the measurement is attributed to the model
+    // which is primarily affected by the particular kind of change. The posted events are processed
+    // before the measurement is taken so that the deferred work done by the models is accounted for too
+    QElapsedTimer timer;
+
+    int numNotes = std::min(m_stormSize, m_pGenerator->noteLocalUids().size());
+    timer.start();
+    for(int i = 0; i < numNotes; ++i)
+    {
+        Note note = m_pGenerator->note(i);
+        note.setTitle(note.title() + QStringLiteral(" (updated)"));
+        note.setModificationTimestamp(note.modificationTimestamp() + 1000);
+        m_pLocalStorageManagerAsync->onUpdateNoteRequest(note, /* update resources = */ false,
+                                                         /* update tags = */ false, QUuid::createUuid());
+    }
+    QCoreApplication::processEvents();
+    addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("note_update_storm"), timer);
+    addPerEventTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("note_update_storm_per_event"),
+                               timer.nsecsElapsed(), numNotes);
+
+    if (!m_pGenerator->notebookLocalUids().isEmpty())
+    {
+        timer.restart();
+        for(int i = 0; i < m_stormSize; ++i) {
+            Note note = m_pGenerator->makeNewNote(m_pGenerator->noteLocalUids().size() + m_numAddedNotes);
+            ++m_numAddedNotes;
+            m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid::createUuid());
+        }
+        QCoreApplication::processEvents();
+        addTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("note_addition_storm"), timer);
+        addPerEventTimeMeasurement(QStringLiteral("NoteModel"), QStringLiteral("note_addition_storm_per_event"),
+                                   timer.nsecsElapsed(), m_stormSize);
+    }
+
+    int numTags = std::min(m_stormSize, m_pGenerator->tagLocalUids().size());
+    timer.restart();
+    for(int i = 0; i < numTags; ++i)
+    {
+        Tag tag = m_pGenerator->tag(i);
+        tag.setName(tag.name() + QStringLiteral(" (renamed)"));
+        m_pLocalStorageManagerAsync->onUpdateTagRequest(tag, QUuid::createUuid());
+    }
+    QCoreApplication::processEvents();
+    addTimeMeasurement(QStringLiteral("TagModel"), QStringLiteral("tag_rename_storm"), timer);
+    addPerEventTimeMeasurement(QStringLiteral("TagModel"), QStringLiteral("tag_rename_storm_per_event"),
+                               timer.nsecsElapsed(), numTags);
+
+    int numNotebooks = std::min(m_stormSize, m_pGenerator->notebookLocalUids().size());
+    timer.restart();
+    for(int i = 0; i < numNotebooks; ++i)
+    {
+        Notebook notebook = m_pGenerator->notebook(i);
+        notebook.setName(notebook.name() + QStringLiteral(" (renamed)"));
+        m_pLocalStorageManagerAsync->onUpdateNotebookRequest(notebook, QUuid::createUuid());
+    }
+    QCoreApplication::processEvents();
+    addTimeMeasurement(QStringLiteral("NotebookModel"), QStringLiteral("notebook_rename_storm"), timer);
+    addPerEventTimeMeasurement(QStringLiteral("NotebookModel"), QStringLiteral("notebook_rename_storm_per_event"),
+                               timer.nsecsElapsed(), numNotebooks);
+
+    int numSavedSearches = std::min(m_stormSize, m_pGenerator->savedSearchLocalUids().size());
+    timer.restart();
+    for(int i = 0; i < numSavedSearches; ++i)
+    {
+        SavedSearch search = m_pGenerator->savedSearch(i);
+        search.setName(search.name() + QStringLiteral(" (renamed)"));
+        m_pLocalStorageManagerAsync->onUpdateSavedSearchRequest(search, QUuid::createUuid());
+    }
+    QCoreApplication::processEvents();
+    addTimeMeasurement(QStringLiteral("SavedSearchModel"), QStringLiteral("saved_search_rename_storm"), timer);
+    addPerEventTimeMeasurement(QStringLiteral("SavedSearchModel"), QStringLiteral("saved_search_rename_storm_per_event"),
+                               timer.nsecsElapsed(), numSavedSearches);
+
+    // The storms must not leave the models broken: all the updated and added items must still be there
+    int expectedNumNotes = m_pGenerator->noteLocalUids().size() + m_numAddedNotes;
+    if (Q_UNLIKELY(m_pNoteModel->rowCount() != expectedNumNotes)) {
+        errorDescription.setBase(QStringLiteral("Unexpected number of notes within the note model after the event storms"));
+        errorDescription.details() = QString::number(m_pNoteModel->rowCount()) + QStringLiteral(" instead of ") +
+                                     QString::number(expectedNumNotes);
+        return false;
+    }
+
+    return true;
+}
+
+bool ModelBenchmark::benchmarkMixedEventStorm(ErrorString & errorDescription)
+{
+    QNDEBUG(QStringLiteral("ModelBenchmark::benchmarkMixedEventStorm"));
+
+    if (m_mixedStormSize <= 0) {
+        QNDEBUG(QStringLiteral("The mixed storm is disabled"));
+        return true;
+    }
+
+    if (!setupNoteFiltersManager(errorDescription)) {
+        return false;
+    }
+
+    // Let the deferred work left after the previous storms be done before the measurement
+    QCoreApplication::processEvents();
+
+    QVector<qint64> eventDurations;
+    eventDurations.reserve(m_mixedStormSize);
+
+    bool peakResidentMemoryReset = resetPeakResidentMemory();
+    qint64 residentMemoryBefore = residentMemoryKb();
+
+    // Each event is followed by the processing of posted events, the same way each queued signal from
+    // the local storage's thread is delivered to the GUI thread by the event loop
+    QElapsedTimer stormTimer;
+    QElapsedTimer eventTimer;
+    stormTimer.start();
+    for(int i = 0; i < m_mixedStormSize; ++i)
+    {
+        eventTimer.start();
+        sendMixedStormEvent(i);
+        QCoreApplication::processEvents();
+        eventDurations << eventTimer.nsecsElapsed();
+    }
+    qint64 stormNsecs = stormTimer.nsecsElapsed();
+
+    addMeasurement(QStringLiteral("Total"), QStringLiteral("mixed_storm_events"),
+                   static_cast<double>(m_mixedStormSize), QStringLiteral("events"));
+    addPerEventTimeMeasurement(QStringLiteral("Total"), QStringLiteral("mixed_storm_per_event"),
+                               stormNsecs, m_mixedStormSize);
+
+    std::sort(eventDurations.begin(), eventDurations.end());
+    int percentileIndex = std::min(eventDurations.size() * 99 / 100, eventDurations.size() - 1);
+    addMeasurement(QStringLiteral("Total"), QStringLiteral("mixed_storm_event_99th_percentile"),
+                   static_cast<double>(eventDurations[percentileIndex]) / 1.0e6, QStringLiteral("ms"));
+    addMeasurement(QStringLiteral("Total"), QStringLiteral("mixed_storm_event_max"),
+                   static_cast<double>(eventDurations.last()) / 1.0e6, QStringLiteral("ms"));
+
+    // Without the reset the peak might have been reached before the storm, during the models' population
+    qint64 peakResidentMemoryAfter = peakResidentMemoryKb();
+    if (peakResidentMemoryReset && (residentMemoryBefore >= 0) && (peakResidentMemoryAfter >= 0)) {
+        addMeasurement(QStringLiteral("Total"), QStringLiteral("mixed_storm_peak_resident_memory_growth"),
+                       static_cast<double>(peakResidentMemoryAfter - residentMemoryBefore), QStringLiteral("KiB"));
+    }
+
+    // The storm must not leave the models broken: all the added notes and tags must be there
+    int expectedNumNotes = m_pGenerator->noteLocalUids().size() + m_numAddedNotes;
+    if (Q_UNLIKELY(m_pNoteModel->rowCount() != expectedNumNotes)) {
+        errorDescription.setBase(QStringLiteral("Unexpected number of notes within the note model after the mixed event storm"));
+        errorDescription.details() = QString::number(m_pNoteModel->rowCount()) + QStringLiteral(" instead of ") +
+                                     QString::number(expectedNumNotes);
+        return false;
+    }
+
+    if (m_numAddedTags > 0)
+    {
+        Tag lastAddedTag = m_pGenerator->makeNewTag(m_parameters.m_numTags + m_numAddedTags - 1);
+        QModelIndex lastAddedTagIndex = m_pTagModel->indexForTagName(lastAddedTag.name());
+        if (Q_UNLIKELY(!lastAddedTagIndex.isValid())) {
+            errorDescription.setBase(QStringLiteral("The tag added by the mixed event storm is not within the tag model"));
+            errorDescription.details() = lastAddedTag.name();
+            return false;
+        }
+    }
+
+    // Replay the part of the same storm with nobody observing the changes; the difference between the times
+    // per event is the time spent in the GUI thread. The items added during this replay never make it
+    // into the models, so it must be the last thing done to the local storage by the benchmark
+    int calibrationStormSize = std::min(m_mixedStormSize, MODEL_BENCHMARK_MAX_CALIBRATION_STORM_SIZE);
+    bool signalsWereBlocked = m_pLocalStorageManagerAsync->blockSignals(true);
+    stormTimer.restart();
+    for(int i = 0; i < calibrationStormSize; ++i) {
+        sendMixedStormEvent(m_mixedStormSize + i);
+        QCoreApplication::processEvents();
+    }
+    qint64 calibrationStormNsecs = stormTimer.nsecsElapsed();
+    Q_UNUSED(m_pLocalStorageManagerAsync->blockSignals(signalsWereBlocked))
+
+    addPerEventTimeMeasurement(QStringLiteral("LocalStorage"), QStringLiteral("mixed_storm_per_event"),
+                               calibrationStormNsecs, calibrationStormSize);
+
+    double stormNsecsPerEvent = static_cast<double>(stormNsecs) / m_mixedStormSize;
+    double calibrationStormNsecsPerEvent = static_cast<double>(calibrationStormNsecs) / calibrationStormSize;
+    double guiThreadNsecsPerEvent = std::max(stormNsecsPerEvent - calibrationStormNsecsPerEvent, 0.0);
+    addMeasurement(QStringLiteral("Total"), QStringLiteral(MODEL_BENCHMARK_GUI_THREAD_PER_EVENT_METRIC),
+                   guiThreadNsecsPerEvent / 1.0e6, QStringLiteral(MODEL_BENCHMARK_PER_EVENT_TIME_UNIT));
+
+    return true;
+}
+
+bool ModelBenchmark::setupNoteFiltersManager(ErrorString & errorDescription)
+{
+    QNDEBUG(QStringLiteral("ModelBenchmark::setupNoteFiltersManager"));
+
+    const Account & account = m_pLocalStorageManagerAsync->account();
+
+    // The filter widgets are set up the same way MainWindow does it but are never shown
+    m_pNoteFilterModel.reset(new NoteFilterModel);
+    m_pNoteFilterModel->setSourceModel(m_pNoteModel.data());
+
+    m_pFilterByTagWidget.reset(new FilterByTagWidget);
+    m_pFilterByTagWidget->setLocalStorageManager(*m_pLocalStorageManagerAsync);
+    m_pFilterByTagWidget->switchAccount(account, m_pTagModel.data());
+
+    m_pFilterByNotebookWidget.reset(new FilterByNotebookWidget);
+    m_pFilterByNotebookWidget->setLocalStorageManager(*m_pLocalStorageManagerAsync);
+    m_pFilterByNotebookWidget->switchAccount(account, m_pNotebookModel.data());
+
+    m_pFilterBySavedSearchWidget.reset(new FilterBySavedSearchWidget);
+    m_pFilterBySavedSearchWidget->switchAccount(account, m_pSavedSearchModel.data());
+
+    m_pSearchLineEdit.reset(new QLineEdit);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_pNoteFiltersManager.reset(new NoteFiltersManager(account, *m_pFilterByTagWidget, *m_pFilterByNotebookWidget,
+                                                       *m_pNoteFilterModel, *m_pFilterBySavedSearchWidget,
+                                                       *m_pSearchLineEdit, *m_pLocalStorageManagerAsync));
+    QObject::connect(m_pNoteFiltersManager.data(), QNSIGNAL(NoteFiltersManager,savedSearchNoteCountChanged,QString,int),
+                     m_pFavoritesModel.data(), QNSLOT(FavoritesModel,setSavedSearchNoteCount,QString,int));
+
+    if (!m_pNoteFiltersManager->isReady())
+    {
+        EventLoopWithExitStatus loop;
+        QObject::connect(m_pNoteFiltersManager.data(), QNSIGNAL(NoteFiltersManager,ready),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
+        QObject::connect(m_pNoteFiltersManager.data(), QNSIGNAL(NoteFiltersManager,notifyError,ErrorString),
+                         &loop, QNSLOT(EventLoopWithExitStatus,exitAsFailureWithErrorString,ErrorString));
+        if (!waitForModel(loop, QStringLiteral("NoteFiltersManager"), errorDescription)) {
+            return false;
+        }
+    }
+
+    addTimeMeasurement(QStringLiteral("NoteFiltersManager"), QStringLiteral("setup"), timer);
+    return true;
+}
+
+void ModelBenchmark::sendMixedStormEvent(const int eventIndex)
+{
+    const QStringList & notebookLocalUids = m_pGenerator->notebookLocalUids();
+    const QStringList & noteLocalUids = m_pGenerator->noteLocalUids();
+
+    // The composition of the storm, per ten events, resembles the full sync: mostly the updates and additions
+    // of notes interleaved with the additions of tags and the updates of notebooks
+    int kind = eventIndex % 10;
+    if (notebookLocalUids.isEmpty()) {
+        kind = 8;
+    }
+    else if ((kind < 5) && noteLocalUids.isEmpty()) {
+        kind = 5;
+    }
+
+    // The suffix is unique for each event so that each update actually changes the object
+    QString suffix = QStringLiteral(" (synced #") + QString::number(eventIndex) + QStringLiteral(")");
+
+    if (kind < 5)
+    {
+        int index = (eventIndex / 2) % noteLocalUids.size();
+        Note note = m_pGenerator->note(index);
+        note.setTitle(note.title() + suffix);
+        note.setModificationTimestamp(note.modificationTimestamp() + static_cast<qint64>(eventIndex + 1) * 1000);
+        m_pLocalStorageManagerAsync->onUpdateNoteRequest(note, /* update resources = */ false,
+                                                         /* update tags = */ false, QUuid::createUuid());
+    }
+    else if (kind < 8)
+    {
+        Note note = m_pGenerator->makeNewNote(noteLocalUids.size() + m_numAddedNotes);
+        ++m_numAddedNotes;
+        m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid::createUuid());
+    }
+    else if (kind == 8)
+    {
+        Tag tag = m_pGenerator->makeNewTag(m_parameters.m_numTags + m_numAddedTags);
+        ++m_numAddedTags;
+        m_pLocalStorageManagerAsync->onAddTagRequest(tag, QUuid::createUuid());
+    }
+    else
+    {
+        Notebook notebook = m_pGenerator->notebook((eventIndex / 10) % notebookLocalUids.size());
+        notebook.setName(notebook.name() + suffix);
+        m_pLocalStorageManagerAsync->onUpdateNotebookRequest(notebook, QUuid::createUuid());
+    }
+}
+
+bool ModelBenchmark::waitForModel(EventLoopWithExitStatus & loop, const QString & modelName, ErrorString & errorDescription)
+{
+    QTimer timer;
+    timer.setInterval(MODEL_BENCHMARK_MAX_ALLOWED_MILLISECONDS);
+    timer.setSingleShot(true);
+    QObject::connect(&timer, QNSIGNAL(QTimer,timeout), &loop, QNSLOT(EventLoopWithExitStatus,exitAsTimeout));
+    timer.start();
+
+    int res = loop.exec();
+    if (res == EventLoopWithExitStatus::ExitStatus::Success) {
+        return true;
+    }
+
+    if (res == EventLoopWithExitStatus::ExitStatus::Timeout) {
+        errorDescription.setBase(QStringLiteral("The model failed to list all of its items in time"));
+    }
+    else {
+        errorDescription = loop.errorDescription();
+    }
+
+    errorDescription.details() = modelName;
+    return false;
+}
+
+void ModelBenchmark::addMeasurement(const QString & model, const QString & metric, const double value, const QString & unit)
+{
+    QNDEBUG(model << QStringLiteral(": ") << metric << QStringLiteral(" = ") << value << QStringLiteral(" ") << unit);
+
+    ModelBenchmarkMeasurement measurement;
+    measurement.m_model = model;
+    measurement.m_metric = metric;
+    measurement.m_value = value;
+    measurement.m_unit = unit;
+    m_measurements << measurement;
+}
+
+void ModelBenchmark::addPopulationMeasurements(const QString & model, const QElapsedTimer & timer,
+                                               const qint64 residentMemoryBefore, const int numRows)
+{
+    addTimeMeasurement(model, QStringLiteral("population"), timer);
+    addMeasurement(model, QStringLiteral("top_level_rows"), static_cast<double>(numRows), QStringLiteral("rows"));
+
+    qint64 residentMemoryAfter = residentMemoryKb();
+    if ((residentMemoryBefore >= 0) && (residentMemoryAfter >= 0)) {
+        addMeasurement(model, QStringLiteral("resident_memory_growth"),
+                       static_cast<double>(residentMemoryAfter - residentMemoryBefore), QStringLiteral("KiB"));
+    }
+}
+
+void ModelBenchmark::addTimeMeasurement(const QString & model, const QString & metric, const QElapsedTimer & timer)
+{
+    addMeasurement(model, metric, elapsedMsec(timer), QStringLiteral("ms"));
+}
+
+void ModelBenchmark::addPerEventTimeMeasurement(const QString & model, const QString & metric, const qint64 nsecsElapsed,
+                                                const int numEvents)
+{
+    if (numEvents <= 0) {
+        return;
+    }
+
+    addMeasurement(model, metric, static_cast<double>(nsecsElapsed) / 1.0e6 / numEvents,
+                   QStringLiteral(MODEL_BENCHMARK_PER_EVENT_TIME_UNIT));
+}
+
+} // namespace quentier
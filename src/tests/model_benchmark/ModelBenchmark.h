@@ -0,0 +1,203 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_TESTS_MODEL_BENCHMARK_MODEL_BENCHMARK_H
+#define QUENTIER_TESTS_MODEL_BENCHMARK_MODEL_BENCHMARK_H
+
+#include "SyntheticAccountGenerator.h"
+#include "../../models/NoteCache.h"
+#include "../../models/NotebookCache.h"
+#include "../../models/TagCache.h"
+#include "../../models/SavedSearchCache.h"
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/utility/EventLoopWithExitStatus.h>
+#include <QObject>
+#include <QScopedPointer>
+#include <QElapsedTimer>
+#include <QList>
+
+QT_FORWARD_DECLARE_CLASS(QTextStream)
+QT_FORWARD_DECLARE_CLASS(QLineEdit)
+
+namespace quentier {
+
+QT_FORWARD_DECLARE_CLASS(NoteModel)
+QT_FORWARD_DECLARE_CLASS(TagModel)
+QT_FORWARD_DECLARE_CLASS(NotebookModel)
+QT_FORWARD_DECLARE_CLASS(SavedSearchModel)
+QT_FORWARD_DECLARE_CLASS(FavoritesModel)
+QT_FORWARD_DECLARE_CLASS(NoteFilterModel)
+QT_FORWARD_DECLARE_CLASS(FilterByTagWidget)
+QT_FORWARD_DECLARE_CLASS(FilterByNotebookWidget)
+QT_FORWARD_DECLARE_CLASS(FilterBySavedSearchWidget)
+QT_FORWARD_DECLARE_CLASS(NoteFiltersManager)
+
+struct ModelBenchmarkMeasurement
+{
+    ModelBenchmarkMeasurement() :
+        m_model(),
+        m_metric(),
+        m_value(0.0),
+        m_unit()
+    {}
+
+    QString     m_model;
+    QString     m_metric;
+    double      m_value;
+    QString     m_unit;
+};
+
+struct ModelBenchmarkReport
+{
+    ModelBenchmarkReport() :
+        m_parameters(),
+        m_stormSize(0),
+        m_mixedStormSize(0),
+        m_measurements()
+    {}
+
+    SyntheticAccountParameters          m_parameters;
+    int                                 m_stormSize;
+    int                                 m_mixedStormSize;
+    QList<ModelBenchmarkMeasurement>    m_measurements;
+};
+
+/**
+ * @brief The ModelBenchmark class measures the performance of models on the synthetic local account
+ *
+ * For each model it measures:
+ * - population time, from the model's construction until it reports all items are listed
+ * - resident memory growth caused by the model's population (on Linux only)
+ * - sort time, for each column the model supports sorting by, in both directions
+ * - filter time, through NoteFilterModel for the note model and through QSortFilterProxyModel for other models
+ * - the time to process the storm of local storage events such as the one produced by the sync:
+ *   updates of all kinds of objects and additions of new notes, both in total and per event
+ *
+ * In the end the mixed storm resembling the full sync is replayed with all the models and NoteFiltersManager
+ * attached: note additions and updates interleaved with tag additions and notebook updates. For this storm
+ * the benchmark reports the time per event along with its 99th percentile and maximum, the peak resident memory
+ * growth (on Linux only) and the time per event spent in the GUI thread. The latter is estimated as the difference
+ * with the time per event of the same storm replayed with the local storage's signals blocked, i.e. with nobody
+ * observing the changes, since in the application the local storage lives in its own thread.
+ *
+ * All the work is done within the calling thread, including the local storage requests, so the measured times
+ * include both the local storage and the models; the time spent in the models alone can be obtained
+ * by enabling ModelInstrumentation for the benchmark run.
+ *
+ * The reports written by the benchmark can be read back and compared with the reports of another run
+ * in order to find out whether the per event cost of processing the storms has grown.
+ */
+class ModelBenchmark: public QObject
+{
+    Q_OBJECT
+public:
+    explicit ModelBenchmark(const SyntheticAccountParameters & parameters, const int stormSize,
+                            const int mixedStormSize, QObject * parent = Q_NULLPTR);
+    virtual ~ModelBenchmark();
+
+    bool run(ErrorString & errorDescription);
+
+    ModelBenchmarkReport report() const;
+
+    static void writeReportsAsJson(const QList<ModelBenchmarkReport> & reports, QTextStream & strm);
+
+    /**
+     * @brief readReportsFromJson reads the reports previously written by writeReportsAsJson; only the accounts'
+     * names and the measurements are read back
+     */
+    static bool readReportsFromJson(QTextStream & strm, QList<ModelBenchmarkReport> & reports,
+                                    ErrorString & errorDescription);
+
+    /**
+     * @brief findPerEventCostRegressions compares the per event times of the reports with the ones of the baseline
+     * reports for the same accounts; the time per event spent in the GUI thread is not compared since it is derived
+     * from the other compared times and is too noisy on its own
+     * @return the descriptions of measurements which have grown by more than the allowed percentage
+     */
+    static QStringList findPerEventCostRegressions(const QList<ModelBenchmarkReport> & baselineReports,
+                                                   const QList<ModelBenchmarkReport> & reports,
+                                                   const int maxRegressionPercent);
+
+    /**
+     * @brief medianReport combines the reports of several runs of the benchmark for the same account into the single
+     * report holding the median value of each measurement
+     */
+    static ModelBenchmarkReport medianReport(const QList<ModelBenchmarkReport> & reports);
+
+private:
+    bool setupLocalStorage(ErrorString & errorDescription);
+    bool populateModels(ErrorString & errorDescription);
+    void benchmarkSorting();
+    void benchmarkFiltering();
+    bool benchmarkEventStorms(ErrorString & errorDescription);
+    bool benchmarkMixedEventStorm(ErrorString & errorDescription);
+
+    bool setupNoteFiltersManager(ErrorString & errorDescription);
+    void sendMixedStormEvent(const int eventIndex);
+
+    bool waitForModel(EventLoopWithExitStatus & loop, const QString & modelName, ErrorString & errorDescription);
+
+    void addMeasurement(const QString & model, const QString & metric, const double value, const QString & unit);
+    void addPopulationMeasurements(const QString & model, const QElapsedTimer & timer,
+                                   const qint64 residentMemoryBefore, const int numRows);
+    void addTimeMeasurement(const QString & model, const QString & metric, const QElapsedTimer & timer);
+    void addPerEventTimeMeasurement(const QString & model, const QString & metric, const qint64 nsecsElapsed,
+                                    const int numEvents);
+
+private:
+    Q_DISABLE_COPY(ModelBenchmark)
+
+private:
+    SyntheticAccountParameters                  m_parameters;
+    int                                         m_stormSize;
+    int                                         m_mixedStormSize;
+    QList<ModelBenchmarkMeasurement>            m_measurements;
+
+    // The numbers of notes and tags added to the local storage by the storms so far
+    int                                         m_numAddedNotes;
+    int                                         m_numAddedTags;
+
+    // NOTE: the order of members matters: the models need to be destroyed before the local storage
+    // and the caches, the models referencing the note model need to be destroyed before it,
+    // the note filters manager and the filter widgets need to be destroyed before the models
+    QScopedPointer<LocalStorageManagerAsync>    m_pLocalStorageManagerAsync;
+
+    NoteCache                                   m_noteCache;
+    NotebookCache                               m_notebookCache;
+    TagCache                                    m_tagCache;
+    SavedSearchCache                            m_savedSearchCache;
+
+    QScopedPointer<NoteModel>                   m_pNoteModel;
+    QScopedPointer<TagModel>                    m_pTagModel;
+    QScopedPointer<NotebookModel>               m_pNotebookModel;
+    QScopedPointer<SavedSearchModel>            m_pSavedSearchModel;
+    QScopedPointer<FavoritesModel>              m_pFavoritesModel;
+
+    QScopedPointer<NoteFilterModel>             m_pNoteFilterModel;
+    QScopedPointer<FilterByTagWidget>           m_pFilterByTagWidget;
+    QScopedPointer<FilterByNotebookWidget>      m_pFilterByNotebookWidget;
+    QScopedPointer<FilterBySavedSearchWidget>   m_pFilterBySavedSearchWidget;
+    QScopedPointer<QLineEdit>                   m_pSearchLineEdit;
+    QScopedPointer<NoteFiltersManager>          m_pNoteFiltersManager;
+
+    QScopedPointer<SyntheticAccountGenerator>   m_pGenerator;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_TESTS_MODEL_BENCHMARK_MODEL_BENCHMARK_H
@@ -0,0 +1,418 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SearchAsYouTypeBenchmark.h"
+#include "../../NoteSearchQueryRunner.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <QThread>
+#include <QTimer>
+#include <QTimerEvent>
+
+// The timeout for the replay of the whole typed string
+#define SEARCH_AS_YOU_TYPE_BENCHMARK_MAX_ALLOWED_MILLISECONDS (600000)
+
+namespace quentier {
+
+static double elapsedMsec(const QElapsedTimer & timer)
+{
+    return static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+}
+
+SearchAsYouTypeBenchmark::SearchAsYouTypeBenchmark(const SyntheticAccountParameters & parameters,
+                                                   const QString & typedString, const int keystrokeIntervalMsec,
+                                                   QObject * parent) :
+    QObject(parent),
+    m_parameters(parameters),
+    m_typedString(typedString),
+    m_keystrokeIntervalMsec(keystrokeIntervalMsec),
+    m_measurements(),
+    m_pLocalStorageManagerAsync(Q_NULLPTR),
+    m_pLocalStorageManagerThread(Q_NULLPTR),
+    m_pRunner(Q_NULLPTR),
+    m_mode(Mode::EveryKeystroke),
+    m_typedPrefixes(),
+    m_numTypedPrefixes(0),
+    m_latestRequestId(),
+    m_keystrokeTimer()
+{}
+
+SearchAsYouTypeBenchmark::~SearchAsYouTypeBenchmark()
+{
+    teardownLocalStorage();
+}
+
+bool SearchAsYouTypeBenchmark::run(ErrorString & errorDescription)
+{
+    QNINFO(QStringLiteral("SearchAsYouTypeBenchmark::run: ") << m_parameters << QStringLiteral(", typed string = ")
+           << m_typedString << QStringLiteral(", keystroke interval = ") << m_keystrokeIntervalMsec);
+
+    m_measurements.clear();
+
+    if (!setupLocalStorage(errorDescription)) {
+        return false;
+    }
+
+    // The first replay warms up the database's caches which would otherwise favour the mode replayed first
+    if (!replay(Mode::EveryKeystroke, /* record = */ false, errorDescription)) {
+        return false;
+    }
+
+    if (!replay(Mode::EveryKeystroke, /* record = */ true, errorDescription)) {
+        return false;
+    }
+
+    if (!replay(Mode::Coalesced, /* record = */ true, errorDescription)) {
+        return false;
+    }
+
+    teardownLocalStorage();
+    return true;
+}
+
+ModelBenchmarkReport SearchAsYouTypeBenchmark::report() const
+{
+    ModelBenchmarkReport report;
+    report.m_parameters = m_parameters;
+    report.m_measurements = m_measurements;
+    return report;
+}
+
+void SearchAsYouTypeBenchmark::onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids,
+                                                                           NoteSearchQuery noteSearchQuery,
+                                                                           QUuid requestId)
+{
+    Q_UNUSED(noteSearchQuery)
+
+    if (m_mode != Mode::EveryKeystroke) {
+        return;
+    }
+
+    onResultsReceived(requestId, noteLocalUids.size());
+}
+
+void SearchAsYouTypeBenchmark::onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuery noteSearchQuery,
+                                                                        ErrorString errorDescription,
+                                                                        QUuid requestId)
+{
+    Q_UNUSED(noteSearchQuery)
+
+    if ((m_mode != Mode::EveryKeystroke) || (requestId != m_latestRequestId)) {
+        return;
+    }
+
+    Q_EMIT replayFailed(errorDescription);
+}
+
+void SearchAsYouTypeBenchmark::onRunnerQueryCompleted(QStringList noteLocalUids, NoteSearchQuery noteSearchQuery,
+                                                      QUuid requestId)
+{
+    Q_UNUSED(noteSearchQuery)
+
+    if (m_mode != Mode::Coalesced) {
+        return;
+    }
+
+    onResultsReceived(requestId, noteLocalUids.size());
+}
+
+void SearchAsYouTypeBenchmark::onRunnerQueryFailed(NoteSearchQuery noteSearchQuery, ErrorString errorDescription,
+                                                   QUuid requestId)
+{
+    Q_UNUSED(noteSearchQuery)
+
+    if ((m_mode != Mode::Coalesced) || (requestId != m_latestRequestId)) {
+        return;
+    }
+
+    Q_EMIT replayFailed(errorDescription);
+}
+
+void SearchAsYouTypeBenchmark::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_keystrokeTimer.timerId()) {
+        typeNextPrefix();
+        return;
+    }
+
+    QObject::timerEvent(pEvent);
+}
+
+bool SearchAsYouTypeBenchmark::setupLocalStorage(ErrorString & errorDescription)
+{
+    QNDEBUG(QStringLiteral("SearchAsYouTypeBenchmark::setupLocalStorage"));
+
+    Account account(QStringLiteral("SearchAsYouTypeBenchmark_") + m_parameters.m_name, Account::Type::Local);
+    m_pLocalStorageManagerAsync = new LocalStorageManagerAsync(account, /* start from scratch = */ true,
+                                                               /* override lock = */ false);
+    m_pLocalStorageManagerAsync->init();
+
+    // The account is generated while the local storage still lives in the same thread so that each request
+    // is processed synchronously
+    {
+        SyntheticAccountGenerator generator(*m_pLocalStorageManagerAsync, m_parameters);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        if (!generator.generate(errorDescription)) {
+            return false;
+        }
+
+        ModelBenchmarkMeasurement measurement;
+        measurement.m_model = QStringLiteral("LocalStorage");
+        measurement.m_metric = QStringLiteral("generation");
+        measurement.m_value = elapsedMsec(timer);
+        measurement.m_unit = QStringLiteral("ms");
+        m_measurements << measurement;
+
+        // By default type the title of the note from the middle of the account, the first word
+        // of the title matches all the notes
+        if (m_typedString.isEmpty() && (m_parameters.m_numNotes > 0)) {
+            m_typedString = generator.note(m_parameters.m_numNotes / 2).title().section(QStringLiteral(" "), 0, 1);
+        }
+    }
+
+    if (m_typedString.isEmpty()) {
+        errorDescription.setBase(QStringLiteral("Nothing to type: no typed string specified and no notes generated"));
+        return false;
+    }
+
+    m_pLocalStorageManagerThread = new QThread;
+    m_pLocalStorageManagerThread->start();
+    m_pLocalStorageManagerAsync->moveToThread(m_pLocalStorageManagerThread);
+
+    QObject::connect(this, QNSIGNAL(SearchAsYouTypeBenchmark,findNoteLocalUidsWithSearchQuery,NoteSearchQuery,QUuid),
+                     m_pLocalStorageManagerAsync,
+                     QNSLOT(LocalStorageManagerAsync,onFindNoteLocalUidsWithSearchQuery,NoteSearchQuery,QUuid));
+    QObject::connect(m_pLocalStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,findNoteLocalUidsWithSearchQueryComplete,QStringList,NoteSearchQuery,QUuid),
+                     this, QNSLOT(SearchAsYouTypeBenchmark,onFindNoteLocalUidsWithSearchQueryCompleted,QStringList,NoteSearchQuery,QUuid));
+    QObject::connect(m_pLocalStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,findNoteLocalUidsWithSearchQueryFailed,NoteSearchQuery,ErrorString,QUuid),
+                     this, QNSLOT(SearchAsYouTypeBenchmark,onFindNoteLocalUidsWithSearchQueryFailed,NoteSearchQuery,ErrorString,QUuid));
+
+    m_pRunner = new NoteSearchQueryRunner(*m_pLocalStorageManagerAsync, this);
+    QObject::connect(m_pRunner, QNSIGNAL(NoteSearchQueryRunner,finished,QStringList,NoteSearchQuery,QUuid),
+                     this, QNSLOT(SearchAsYouTypeBenchmark,onRunnerQueryCompleted,QStringList,NoteSearchQuery,QUuid));
+    QObject::connect(m_pRunner, QNSIGNAL(NoteSearchQueryRunner,failed,NoteSearchQuery,ErrorString,QUuid),
+                     this, QNSLOT(SearchAsYouTypeBenchmark,onRunnerQueryFailed,NoteSearchQuery,ErrorString,QUuid));
+
+    return true;
+}
+
+void SearchAsYouTypeBenchmark::teardownLocalStorage()
+{
+    delete m_pRunner;
+    m_pRunner = Q_NULLPTR;
+
+    if (!m_pLocalStorageManagerThread) {
+        delete m_pLocalStorageManagerAsync;
+        m_pLocalStorageManagerAsync = Q_NULLPTR;
+        return;
+    }
+
+    // The local storage lives in its own thread by now so it needs to be deleted there
+    QObject::connect(m_pLocalStorageManagerThread, QNSIGNAL(QThread,finished),
+                     m_pLocalStorageManagerAsync, QNSLOT(LocalStorageManagerAsync,deleteLater));
+    m_pLocalStorageManagerThread->quit();
+    m_pLocalStorageManagerThread->wait();
+
+    delete m_pLocalStorageManagerThread;
+    m_pLocalStorageManagerThread = Q_NULLPTR;
+    m_pLocalStorageManagerAsync = Q_NULLPTR;
+}
+
+bool SearchAsYouTypeBenchmark::replay(const Mode::type mode, const bool record, ErrorString & errorDescription)
+{
+    QString modeName = ((mode == Mode::Coalesced) ? QStringLiteral("coalesced") : QStringLiteral("every_keystroke"));
+    QNDEBUG(QStringLiteral("SearchAsYouTypeBenchmark::replay: ") << modeName);
+
+    m_mode = mode;
+    m_typedPrefixes.clear();
+    m_typedPrefixes.reserve(m_typedString.size());
+
+    QString previousTrimmedPrefix;
+    for(int i = 1, size = m_typedString.size(); i <= size; ++i)
+    {
+        TypedPrefix typedPrefix;
+        typedPrefix.m_prefix = m_typedString.left(i);
+
+        // Typing the whitespace doesn't change the query
+        QString trimmedPrefix = typedPrefix.m_prefix.trimmed();
+        if (trimmedPrefix.isEmpty() || (trimmedPrefix == previousTrimmedPrefix)) {
+            continue;
+        }
+
+        previousTrimmedPrefix = trimmedPrefix;
+
+        ErrorString error;
+        if (!typedPrefix.m_query.setQueryString(typedPrefix.m_prefix, error)) {
+            QNDEBUG(QStringLiteral("Skipping the prefix which doesn't form a valid query: ") << typedPrefix.m_prefix);
+            continue;
+        }
+
+        m_typedPrefixes << typedPrefix;
+    }
+
+    if (m_typedPrefixes.isEmpty()) {
+        errorDescription.setBase(QStringLiteral("None of the typed string's prefixes forms a valid search query"));
+        errorDescription.details() = m_typedString;
+        return false;
+    }
+
+    m_numTypedPrefixes = 0;
+    m_latestRequestId = QUuid();
+
+    EventLoopWithExitStatus loop;
+    QObject::connect(this, QNSIGNAL(SearchAsYouTypeBenchmark,replayFinished),
+                     &loop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
+    QObject::connect(this, QNSIGNAL(SearchAsYouTypeBenchmark,replayFailed,ErrorString),
+                     &loop, QNSLOT(EventLoopWithExitStatus,exitAsFailureWithErrorString,ErrorString));
+
+    QTimer timeoutTimer;
+    timeoutTimer.setInterval(SEARCH_AS_YOU_TYPE_BENCHMARK_MAX_ALLOWED_MILLISECONDS);
+    timeoutTimer.setSingleShot(true);
+    QObject::connect(&timeoutTimer, QNSIGNAL(QTimer,timeout), &loop, QNSLOT(EventLoopWithExitStatus,exitAsTimeout));
+    timeoutTimer.start();
+
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    typeNextPrefix();
+    if (m_numTypedPrefixes < m_typedPrefixes.size()) {
+        m_keystrokeTimer.start(m_keystrokeIntervalMsec, this);
+    }
+
+    int res = loop.exec();
+    m_keystrokeTimer.stop();
+
+    if (res != EventLoopWithExitStatus::ExitStatus::Success)
+    {
+        if (res == EventLoopWithExitStatus::ExitStatus::Timeout) {
+            errorDescription.setBase(QStringLiteral("The results for the whole typed string were not received in time"));
+        }
+        else {
+            errorDescription = loop.errorDescription();
+        }
+
+        errorDescription.details() = modeName;
+        return false;
+    }
+
+    if (!record) {
+        return true;
+    }
+
+    QString model = QStringLiteral("SearchAsYouType");
+    for(auto it = m_typedPrefixes.constBegin(), end = m_typedPrefixes.constEnd(); it != end; ++it)
+    {
+        const TypedPrefix & typedPrefix = *it;
+
+        ModelBenchmarkMeasurement measurement;
+        measurement.m_model = model;
+        measurement.m_metric = modeName + QStringLiteral("/time_to_first_result/") + typedPrefix.m_prefix;
+        measurement.m_value = typedPrefix.m_timeToFirstResultMsec;
+        measurement.m_unit = QStringLiteral("ms");
+        m_measurements << measurement;
+
+        // The results for the prefix are not received at all if the prefix is superseded before its query completes
+        if (typedPrefix.m_numResults >= 0) {
+            measurement.m_metric = modeName + QStringLiteral("/results/") + typedPrefix.m_prefix;
+            measurement.m_value = static_cast<double>(typedPrefix.m_numResults);
+            measurement.m_unit = QStringLiteral("notes");
+            m_measurements << measurement;
+        }
+    }
+
+    ModelBenchmarkMeasurement measurement;
+    measurement.m_model = model;
+    measurement.m_metric = modeName + QStringLiteral("/total");
+    measurement.m_value = elapsedMsec(totalTimer);
+    measurement.m_unit = QStringLiteral("ms");
+    m_measurements << measurement;
+
+    return true;
+}
+
+void SearchAsYouTypeBenchmark::typeNextPrefix()
+{
+    if (m_numTypedPrefixes >= m_typedPrefixes.size()) {
+        m_keystrokeTimer.stop();
+        return;
+    }
+
+    TypedPrefix & typedPrefix = m_typedPrefixes[m_numTypedPrefixes];
+    ++m_numTypedPrefixes;
+
+    typedPrefix.m_timer.start();
+
+    if (m_mode == Mode::Coalesced) {
+        typedPrefix.m_requestId = m_pRunner->run(typedPrefix.m_query);
+    }
+    else {
+        typedPrefix.m_requestId = QUuid::createUuid();
+        Q_EMIT findNoteLocalUidsWithSearchQuery(typedPrefix.m_query, typedPrefix.m_requestId);
+    }
+
+    m_latestRequestId = typedPrefix.m_requestId;
+
+    if (m_numTypedPrefixes >= m_typedPrefixes.size()) {
+        m_keystrokeTimer.stop();
+    }
+}
+
+void SearchAsYouTypeBenchmark::onResultsReceived(const QUuid & requestId, const int numResults)
+{
+    // The results of superseded requests are ignored just like the app ignores them
+    if (requestId != m_latestRequestId) {
+        return;
+    }
+
+    int index = m_numTypedPrefixes - 1;
+    for(; index >= 0; --index)
+    {
+        if (m_typedPrefixes[index].m_requestId == requestId) {
+            break;
+        }
+    }
+
+    if (Q_UNLIKELY(index < 0)) {
+        return;
+    }
+
+    m_typedPrefixes[index].m_numResults = numResults;
+
+    // The results for the longer prefix are the first results for all the shorter prefixes still waiting for them
+    for(int i = 0; i <= index; ++i)
+    {
+        TypedPrefix & typedPrefix = m_typedPrefixes[i];
+        if (typedPrefix.m_timeToFirstResultMsec < 0.0) {
+            typedPrefix.m_timeToFirstResultMsec = elapsedMsec(typedPrefix.m_timer);
+        }
+    }
+
+    if (index == (m_typedPrefixes.size() - 1)) {
+        Q_EMIT replayFinished();
+    }
+}
+
+} // namespace quentier
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_TESTS_MODEL_BENCHMARK_SEARCH_AS_YOU_TYPE_BENCHMARK_H
+#define QUENTIER_TESTS_MODEL_BENCHMARK_SEARCH_AS_YOU_TYPE_BENCHMARK_H
+
+#include "ModelBenchmark.h"
+#include <quentier/local_storage/NoteSearchQuery.h>
+#include <QBasicTimer>
+#include <QVector>
+
+QT_FORWARD_DECLARE_CLASS(QThread)
+
+namespace quentier {
+
+QT_FORWARD_DECLARE_CLASS(NoteSearchQueryRunner)
+
+/**
+ * @brief The SearchAsYouTypeBenchmark class replays the typing of the search string against the synthetic account
+ * and measures for each typed prefix the time to the first result: the time since the prefix was typed until
+ * the note local uids for this prefix or a longer one are received
+ *
+ * The local storage lives in its own thread like in the app. After the warm-up replay the typing is replayed twice:
+ * - "every_keystroke": each prefix is sent to the local storage right away, the results of the superseded
+ *   requests are ignored, which is what the app would do without NoteSearchQueryRunner
+ * - "coalesced": each prefix is run through NoteSearchQueryRunner, so the superseded prefixes which haven't
+ *   started yet are never run
+ *
+ * The prefixes which don't form a valid search query are skipped just like the app skips them while the user
+ * is typing.
+ */
+class SearchAsYouTypeBenchmark: public QObject
+{
+    Q_OBJECT
+public:
+    explicit SearchAsYouTypeBenchmark(const SyntheticAccountParameters & parameters, const QString & typedString,
+                                      const int keystrokeIntervalMsec, QObject * parent = Q_NULLPTR);
+    virtual ~SearchAsYouTypeBenchmark();
+
+    bool run(ErrorString & errorDescription);
+
+    ModelBenchmarkReport report() const;
+
+Q_SIGNALS:
+    void replayFinished();
+    void replayFailed(ErrorString errorDescription);
+
+    // private signals
+    void findNoteLocalUidsWithSearchQuery(NoteSearchQuery noteSearchQuery, QUuid requestId);
+
+private Q_SLOTS:
+    void onFindNoteLocalUidsWithSearchQueryCompleted(QStringList noteLocalUids, NoteSearchQuery noteSearchQuery,
+                                                     QUuid requestId);
+    void onFindNoteLocalUidsWithSearchQueryFailed(NoteSearchQuery noteSearchQuery, ErrorString errorDescription,
+                                                  QUuid requestId);
+
+    void onRunnerQueryCompleted(QStringList noteLocalUids, NoteSearchQuery noteSearchQuery, QUuid requestId);
+    void onRunnerQueryFailed(NoteSearchQuery noteSearchQuery, ErrorString errorDescription, QUuid requestId);
+
+private:
+    virtual void timerEvent(QTimerEvent * pEvent) Q_DECL_OVERRIDE;
+
+private:
+    struct Mode
+    {
+        enum type {
+            EveryKeystroke = 0,
+            Coalesced
+        };
+    };
+
+    struct TypedPrefix
+    {
+        TypedPrefix() :
+            m_prefix(),
+            m_query(),
+            m_requestId(),
+            m_timer(),
+            m_timeToFirstResultMsec(-1.0),
+            m_numResults(-1)
+        {}
+
+        QString             m_prefix;
+        NoteSearchQuery     m_query;
+        QUuid               m_requestId;
+        QElapsedTimer       m_timer;
+        double              m_timeToFirstResultMsec;
+        int                 m_numResults;
+    };
+
+    bool setupLocalStorage(ErrorString & errorDescription);
+    void teardownLocalStorage();
+
+    bool replay(const Mode::type mode, const bool record, ErrorString & errorDescription);
+    void typeNextPrefix();
+    void onResultsReceived(const QUuid & requestId, const int numResults);
+
+private:
+    Q_DISABLE_COPY(SearchAsYouTypeBenchmark)
+
+private:
+    SyntheticAccountParameters          m_parameters;
+    QString                             m_typedString;
+    int                                 m_keystrokeIntervalMsec;
+    QList<ModelBenchmarkMeasurement>    m_measurements;
+
+    LocalStorageManagerAsync *          m_pLocalStorageManagerAsync;
+    QThread *                           m_pLocalStorageManagerThread;
+    NoteSearchQueryRunner *             m_pRunner;
+
+    Mode::type                          m_mode;
+    QVector<TypedPrefix>                m_typedPrefixes;
+    int                                 m_numTypedPrefixes;
+    QUuid                               m_latestRequestId;
+    QBasicTimer                         m_keystrokeTimer;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_TESTS_MODEL_BENCHMARK_SEARCH_AS_YOU_TYPE_BENCHMARK_H
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SyntheticAccountGenerator.h"
+#include <quentier/logging/QuentierLogger.h>
+#include <quentier/utility/UidGenerator.h>
+#include <QDateTime>
+#include <algorithm>
+
+namespace quentier {
+
+// Scrambles the index of the generated object so that the alphabetical order of generated names
+// has nothing to do with the order in which the objects were generated
+static QString scrambledKey(const int index)
+{
+    quint32 hash = static_cast<quint32>(index) * 2654435761u;
+    return QString::number(hash, 16).rightJustified(8, QChar::fromLatin1('0'));
+}
+
+static bool isFavorited(const int index, const int favoritedPercent)
+{
+    quint32 hash = static_cast<quint32>(index) * 2246822519u;
+    return static_cast<int>((hash >> 16) % 100) < favoritedPercent;
+}
+
+SyntheticAccountParameters::SyntheticAccountParameters() :
+    m_name(QStringLiteral("custom")),
+    m_numNotebooks(10),
+    m_numTags(50),
+    m_tagNestingDepth(3),
+    m_numNotes(1000),
+    m_numTagsPerNote(2),
+    m_numSavedSearches(10),
+    m_favoritedPercent(5)
+{}
+
+QTextStream & SyntheticAccountParameters::print(QTextStream & strm) const
+{
+    strm << QStringLiteral("SyntheticAccountParameters: name = ") << m_name
+         << QStringLiteral(", notebooks = ") << m_numNotebooks
+         << QStringLiteral(", tags = ") << m_numTags
+         << QStringLiteral(", tag nesting depth = ") << m_tagNestingDepth
+         << QStringLiteral(", notes = ") << m_numNotes
+         << QStringLiteral(", tags per note = ") << m_numTagsPerNote
+         << QStringLiteral(", saved searches = ") << m_numSavedSearches
+         << QStringLiteral(", favorited percent = ") << m_favoritedPercent;
+    return strm;
+}
+
+SyntheticAccountGenerator::SyntheticAccountGenerator(LocalStorageManagerAsync & localStorageManagerAsync,
+                                                     const SyntheticAccountParameters & parameters,
+                                                     QObject * parent) :
+    QObject(parent),
+    m_localStorageManagerAsync(localStorageManagerAsync),
+    m_parameters(parameters),
+    m_notebookLocalUids(),
+    m_tagLocalUids(),
+    m_noteLocalUids(),
+    m_savedSearchLocalUids(),
+    m_baseTimestamp(QDateTime::currentMSecsSinceEpoch()),
+    m_requestIds(),
+    m_firstError(),
+    m_failed(false)
+{
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,addNotebookFailed,Notebook,ErrorString,QUuid),
+                     this, QNSLOT(SyntheticAccountGenerator,onAddNotebookFailed,Notebook,ErrorString,QUuid));
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,addTagFailed,Tag,ErrorString,QUuid),
+                     this, QNSLOT(SyntheticAccountGenerator,onAddTagFailed,Tag,ErrorString,QUuid));
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,addNoteFailed,Note,ErrorString,QUuid),
+                     this, QNSLOT(SyntheticAccountGenerator,onAddNoteFailed,Note,ErrorString,QUuid));
+    QObject::connect(&m_localStorageManagerAsync, QNSIGNAL(LocalStorageManagerAsync,addSavedSearchFailed,SavedSearch,ErrorString,QUuid),
+                     this, QNSLOT(SyntheticAccountGenerator,onAddSavedSearchFailed,SavedSearch,ErrorString,QUuid));
+}
+
+bool SyntheticAccountGenerator::generate(ErrorString & errorDescription)
+{
+    QNDEBUG(QStringLiteral("SyntheticAccountGenerator::generate: ") << m_parameters);
+
+    if (Q_UNLIKELY((m_parameters.m_numNotes > 0) && (m_parameters.m_numNotebooks <= 0))) {
+        errorDescription.setBase(QStringLiteral("Can't generate notes without notebooks"));
+        return false;
+    }
+
+    m_notebookLocalUids.clear();
+    m_tagLocalUids.clear();
+    m_noteLocalUids.clear();
+    m_savedSearchLocalUids.clear();
+
+    for(int i = 0; i < m_parameters.m_numNotebooks; ++i) {
+        m_notebookLocalUids << UidGenerator::Generate();
+    }
+
+    for(int i = 0; i < m_parameters.m_numTags; ++i) {
+        m_tagLocalUids << UidGenerator::Generate();
+    }
+
+    for(int i = 0; i < m_parameters.m_numNotes; ++i) {
+        m_noteLocalUids << UidGenerator::Generate();
+    }
+
+    for(int i = 0; i < m_parameters.m_numSavedSearches; ++i) {
+        m_savedSearchLocalUids << UidGenerator::Generate();
+    }
+
+    for(int i = 0; i < m_parameters.m_numNotebooks; ++i)
+    {
+        m_localStorageManagerAsync.onAddNotebookRequest(notebook(i), nextRequestId());
+        if (!checkFailure(errorDescription)) {
+            return false;
+        }
+    }
+
+    // Parent tags always precede their children so that the local storage can find the parent of each added tag
+    for(int i = 0; i < m_parameters.m_numTags; ++i)
+    {
+        m_localStorageManagerAsync.onAddTagRequest(tag(i), nextRequestId());
+        if (!checkFailure(errorDescription)) {
+            return false;
+        }
+    }
+
+    for(int i = 0; i < m_parameters.m_numNotes; ++i)
+    {
+        m_localStorageManagerAsync.onAddNoteRequest(note(i), nextRequestId());
+        if (!checkFailure(errorDescription)) {
+            return false;
+        }
+    }
+
+    for(int i = 0; i < m_parameters.m_numSavedSearches; ++i)
+    {
+        m_localStorageManagerAsync.onAddSavedSearchRequest(savedSearch(i), nextRequestId());
+        if (!checkFailure(errorDescription)) {
+            return false;
+        }
+    }
+
+    m_requestIds.clear();
+    return true;
+}
+
+Notebook SyntheticAccountGenerator::notebook(const int index) const
+{
+    Notebook notebook;
+    notebook.setLocalUid(m_notebookLocalUids.value(index));
+    notebook.setName(QStringLiteral("Notebook ") + scrambledKey(index) + QStringLiteral(" #") + QString::number(index));
+    notebook.setLocal(true);
+    notebook.setDirty(false);
+    notebook.setFavorited(isFavorited(index, m_parameters.m_favoritedPercent));
+    return notebook;
+}
+
+Tag SyntheticAccountGenerator::tag(const int index) const
+{
+    Tag tag;
+    tag.setLocalUid(m_tagLocalUids.value(index));
+    tag.setName(QStringLiteral("Tag ") + scrambledKey(index) + QStringLiteral(" #") + QString::number(index));
+    tag.setLocal(true);
+    tag.setDirty(false);
+    tag.setFavorited(isFavorited(index, m_parameters.m_favoritedPercent));
+
+    // Tags form the parent-child chains of the configured length
+    int depth = std::max(m_parameters.m_tagNestingDepth, 1);
+    if ((index % depth) != 0) {
+        tag.setParentLocalUid(m_tagLocalUids.value(index - 1));
+    }
+
+    return tag;
+}
+
+Note SyntheticAccountGenerator::note(const int index) const
+{
+    Note note = makeNewNote(index);
+    note.setLocalUid(m_noteLocalUids.value(index));
+
+    int numTags = std::min(m_parameters.m_numTagsPerNote, m_parameters.m_numTags);
+    if (numTags > 0)
+    {
+        // The step between the tags of a single note guarantees these tags are distinct
+        int step = std::max(m_parameters.m_numTags / numTags, 1);
+
+        QStringList tagLocalUids;
+        tagLocalUids.reserve(numTags);
+        for(int i = 0; i < numTags; ++i) {
+            tagLocalUids << m_tagLocalUids.value((index + i * step) % m_parameters.m_numTags);
+        }
+
+        note.setTagLocalUids(tagLocalUids);
+    }
+
+    return note;
+}
+
+SavedSearch SyntheticAccountGenerator::savedSearch(const int index) const
+{
+    SavedSearch search;
+    search.setLocalUid(m_savedSearchLocalUids.value(index));
+    search.setName(QStringLiteral("Saved search ") + scrambledKey(index) + QStringLiteral(" #") + QString::number(index));
+    search.setQuery(QStringLiteral("intitle:") + scrambledKey(index).left(2));
+    search.setLocal(true);
+    search.setDirty(false);
+    search.setFavorited(isFavorited(index, m_parameters.m_favoritedPercent));
+    return search;
+}
+
+Note SyntheticAccountGenerator::makeNewNote(const int index) const
+{
+    QString title = QStringLiteral("Note ") + scrambledKey(index) + QStringLiteral(" #") + QString::number(index);
+
+    Note note;
+    note.setTitle(title);
+    note.setContent(QStringLiteral("<en-note><div>") + title + QStringLiteral("</div></en-note>"));
+    note.setCreationTimestamp(m_baseTimestamp - static_cast<qint64>(index) * 60000);
+    note.setModificationTimestamp(note.creationTimestamp() + static_cast<qint64>(scrambledKey(index).left(3).toInt(Q_NULLPTR, 16)) * 1000);
+    note.setLocal(true);
+    note.setDirty(false);
+    note.setFavorited(isFavorited(index, m_parameters.m_favoritedPercent));
+
+    if (!m_notebookLocalUids.isEmpty()) {
+        note.setNotebookLocalUid(m_notebookLocalUids.value(index % m_notebookLocalUids.size()));
+    }
+
+    return note;
+}
+
+Tag SyntheticAccountGenerator::makeNewTag(const int index) const
+{
+    Tag tag;
+    tag.setName(QStringLiteral("Tag ") + scrambledKey(index) + QStringLiteral(" #") + QString::number(index));
+    tag.setLocal(true);
+    tag.setDirty(false);
+    tag.setFavorited(isFavorited(index, m_parameters.m_favoritedPercent));
+    return tag;
+}
+
+void SyntheticAccountGenerator::onAddNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId)
+{
+    Q_UNUSED(notebook)
+    onRequestFailed(requestId, errorDescription);
+}
+
+void SyntheticAccountGenerator::onAddTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
+{
+    Q_UNUSED(tag)
+    onRequestFailed(requestId, errorDescription);
+}
+
+void SyntheticAccountGenerator::onAddNoteFailed(Note note, ErrorString errorDescription, QUuid requestId)
+{
+    Q_UNUSED(note)
+    onRequestFailed(requestId, errorDescription);
+}
+
+void SyntheticAccountGenerator::onAddSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId)
+{
+    Q_UNUSED(search)
+    onRequestFailed(requestId, errorDescription);
+}
+
+QUuid SyntheticAccountGenerator::nextRequestId()
+{
+    QUuid requestId = QUuid::createUuid();
+    Q_UNUSED(m_requestIds.insert(requestId))
+    return requestId;
+}
+
+bool SyntheticAccountGenerator::checkFailure(ErrorString & errorDescription) const
+{
+    if (!m_failed) {
+        return true;
+    }
+
+    errorDescription = m_firstError;
+    return false;
+}
+
+void SyntheticAccountGenerator::onRequestFailed(const QUuid & requestId, const ErrorString & errorDescription)
+{
+    if (!m_requestIds.contains(requestId) || m_failed) {
+        return;
+    }
+
+    QNWARNING(QStringLiteral("Failed to add the synthetic object to the local storage: ") << errorDescription);
+
+    m_firstError = errorDescription;
+    m_failed = true;
+}
+
+} // namespace quentier
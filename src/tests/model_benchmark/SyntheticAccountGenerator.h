@@ -0,0 +1,136 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_TESTS_MODEL_BENCHMARK_SYNTHETIC_ACCOUNT_GENERATOR_H
+#define QUENTIER_TESTS_MODEL_BENCHMARK_SYNTHETIC_ACCOUNT_GENERATOR_H
+
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/types/ErrorString.h>
+#include <quentier/utility/Printable.h>
+#include <QObject>
+#include <QStringList>
+#include <QSet>
+#include <QUuid>
+
+namespace quentier {
+
+/**
+ * @brief The SyntheticAccountParameters struct describes the contents of the synthetic account
+ * to be generated for the model benchmark
+ */
+struct SyntheticAccountParameters: public Printable
+{
+    SyntheticAccountParameters();
+
+    virtual QTextStream & print(QTextStream & strm) const Q_DECL_OVERRIDE;
+
+    QString     m_name;
+    int         m_numNotebooks;
+    int         m_numTags;
+
+    // The max number of tags within a single parent-child chain; 1 means all tags are top level ones
+    int         m_tagNestingDepth;
+
+    int         m_numNotes;
+    int         m_numTagsPerNote;
+    int         m_numSavedSearches;
+
+    // The percentage of notes, notebooks, tags and saved searches marked as favorited
+    int         m_favoritedPercent;
+};
+
+/**
+ * @brief The SyntheticAccountGenerator class fills the local storage with the deterministically generated
+ * notebooks, tags, notes and saved searches described by SyntheticAccountParameters
+ *
+ * The generator is meant to be used with LocalStorageManagerAsync living in the same thread so that each request
+ * is processed synchronously; the objects are generated such that sorting them by name or title doesn't match
+ * the order of their creation.
+ */
+class SyntheticAccountGenerator: public QObject
+{
+    Q_OBJECT
+public:
+    explicit SyntheticAccountGenerator(LocalStorageManagerAsync & localStorageManagerAsync,
+                                       const SyntheticAccountParameters & parameters,
+                                       QObject * parent = Q_NULLPTR);
+
+    bool generate(ErrorString & errorDescription);
+
+    const SyntheticAccountParameters & parameters() const { return m_parameters; }
+
+    const QStringList & notebookLocalUids() const { return m_notebookLocalUids; }
+    const QStringList & tagLocalUids() const { return m_tagLocalUids; }
+    const QStringList & noteLocalUids() const { return m_noteLocalUids; }
+    const QStringList & savedSearchLocalUids() const { return m_savedSearchLocalUids; }
+
+    /**
+     * The methods below re-create the generated objects by their indices; the objects can be modified
+     * and passed to the local storage update requests in order to simulate the changes coming from the sync
+     */
+    Notebook notebook(const int index) const;
+    Tag tag(const int index) const;
+    Note note(const int index) const;
+    SavedSearch savedSearch(const int index) const;
+
+    /**
+     * @brief makeNewNote creates the note which is not yet within the local storage, in one of the generated notebooks
+     */
+    Note makeNewNote(const int index) const;
+
+    /**
+     * @brief makeNewTag creates the top level tag which is not yet within the local storage; the index should
+     * not be less than the number of generated tags so that the tag's name doesn't clash with the generated ones
+     */
+    Tag makeNewTag(const int index) const;
+
+private Q_SLOTS:
+    void onAddNotebookFailed(Notebook notebook, ErrorString errorDescription, QUuid requestId);
+    void onAddTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId);
+    void onAddNoteFailed(Note note, ErrorString errorDescription, QUuid requestId);
+    void onAddSavedSearchFailed(SavedSearch search, ErrorString errorDescription, QUuid requestId);
+
+private:
+    QUuid nextRequestId();
+    bool checkFailure(ErrorString & errorDescription) const;
+    void onRequestFailed(const QUuid & requestId, const ErrorString & errorDescription);
+
+private:
+    Q_DISABLE_COPY(SyntheticAccountGenerator)
+
+private:
+    LocalStorageManagerAsync &      m_localStorageManagerAsync;
+    SyntheticAccountParameters      m_parameters;
+
+    QStringList                     m_notebookLocalUids;
+    QStringList                     m_tagLocalUids;
+    QStringList                     m_noteLocalUids;
+    QStringList                     m_savedSearchLocalUids;
+
+    // All the timestamps of generated notes are derived from this one so that the notes re-created by their indices
+    // are identical to the ones put into the local storage
+    qint64                          m_baseTimestamp;
+
+    QSet<QUuid>                     m_requestIds;
+    ErrorString                     m_firstError;
+    bool                            m_failed;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_TESTS_MODEL_BENCHMARK_SYNTHETIC_ACCOUNT_GENERATOR_H
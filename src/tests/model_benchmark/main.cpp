@@ -0,0 +1,353 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelBenchmark.h"
+#include "SearchAsYouTypeBenchmark.h"
+#include "../../models/ModelInstrumentation.h"
+#include <quentier/utility/Utility.h>
+#include <QApplication>
+#include <QStringList>
+#include <QTextStream>
+#include <QFile>
+#include <QDebug>
+#include <cstdio>
+
+#define DEFAULT_STORM_SIZE (1000)
+
+// The full sync of a big account produces tens of thousands of local storage events
+#define DEFAULT_MIXED_STORM_SIZE (50000)
+
+#define DEFAULT_MAX_REGRESSION_PERCENT (10)
+
+// The single run's times might be off by more than the allowed regression percentage because of the noise
+// (i.e. other processes competing for the CPU), so when checking against the baseline the benchmark is repeated
+// and the medians of the measurements are compared
+#define DEFAULT_REPETITIONS_WITH_BASELINE (3)
+
+// The exit code signaling the per event cost has grown compared to the baseline, as opposed to the benchmark failure
+#define REGRESSION_EXIT_CODE (2)
+#define DEFAULT_KEYSTROKE_INTERVAL_MSEC (120)
+
+using namespace quentier;
+
+static bool parseIntOption(const QString & arg, const QString & optionName, int & value)
+{
+    QString prefix = optionName + QStringLiteral("=");
+    if (!arg.startsWith(prefix)) {
+        return false;
+    }
+
+    bool conversionResult = false;
+    int parsedValue = arg.mid(prefix.size()).toInt(&conversionResult);
+    if (!conversionResult || (parsedValue < 0)) {
+        return false;
+    }
+
+    value = parsedValue;
+    return true;
+}
+
+static bool parseStringOption(const QString & arg, const QString & optionName, QString & value)
+{
+    QString prefix = optionName + QStringLiteral("=");
+    if (!arg.startsWith(prefix)) {
+        return false;
+    }
+
+    value = arg.mid(prefix.size());
+    return !value.isEmpty();
+}
+
+static bool presetParameters(const QString & preset, SyntheticAccountParameters & parameters)
+{
+    parameters.m_name = preset;
+
+    if (preset == QStringLiteral("small")) {
+        parameters.m_numNotebooks = 5;
+        parameters.m_numTags = 20;
+        parameters.m_tagNestingDepth = 2;
+        parameters.m_numNotes = 500;
+        parameters.m_numTagsPerNote = 2;
+        parameters.m_numSavedSearches = 5;
+        return true;
+    }
+
+    if (preset == QStringLiteral("medium")) {
+        parameters.m_numNotebooks = 30;
+        parameters.m_numTags = 300;
+        parameters.m_tagNestingDepth = 4;
+        parameters.m_numNotes = 5000;
+        parameters.m_numTagsPerNote = 3;
+        parameters.m_numSavedSearches = 30;
+        return true;
+    }
+
+    if (preset == QStringLiteral("large")) {
+        parameters.m_numNotebooks = 200;
+        parameters.m_numTags = 2000;
+        parameters.m_tagNestingDepth = 6;
+        parameters.m_numNotes = 50000;
+        parameters.m_numTagsPerNote = 4;
+        parameters.m_numSavedSearches = 100;
+        return true;
+    }
+
+    // The account for the search as you type benchmark: lots of notes, the rest doesn't matter much
+    if (preset == QStringLiteral("search")) {
+        parameters.m_numNotebooks = 20;
+        parameters.m_numTags = 200;
+        parameters.m_tagNestingDepth = 2;
+        parameters.m_numNotes = 100000;
+        parameters.m_numTagsPerNote = 2;
+        parameters.m_numSavedSearches = 0;
+        return true;
+    }
+
+    return (preset == QStringLiteral("custom"));
+}
+
+static void printUsage(const char * programName)
+{
+    qWarning() << "Usage:" << programName << "[--presets=<comma separated list of small, medium, large, search, custom>]"
+               << "[--notebooks=<number>] [--tags=<number>] [--tag-depth=<number>] [--notes=<number>]"
+               << "[--tags-per-note=<number>] [--saved-searches=<number>] [--favorited-percent=<number>]"
+               << "[--storm-size=<number>] [--mixed-storm-size=<number>] [--output=<json file>] [--instrumentation]"
+               << "[--repetitions=<number>] [--baseline=<json file> [--max-regression-percent=<number>]]"
+               << "[--search-as-you-type [--typed-string=<text>] [--keystroke-interval=<msec>]]";
+    qWarning() << "The explicitly specified numbers override the ones from each preset; the default presets are small and medium"
+               << "for the model benchmark and search for the search as you type benchmark";
+    qWarning() << "The mixed storm replaying the full sync is skipped if its size is 0; the benchmark can run headless"
+               << "with QT_QPA_PLATFORM=offscreen";
+    qWarning() << "The benchmark is run the specified number of times for each account and the median of each"
+               << "measurement is reported; by default it is run once or" << DEFAULT_REPETITIONS_WITH_BASELINE
+               << "times with the baseline";
+    qWarning() << "With the baseline, which is the output of the previous run, the benchmark exits with code"
+               << REGRESSION_EXIT_CODE << "if any median per event time has grown by more than the allowed percentage"
+               << "(" << DEFAULT_MAX_REGRESSION_PERCENT << "by default)";
+}
+
+int main(int argc, char * argv[])
+{
+    QApplication app(argc, argv);
+    quentier::initializeLibquentier();
+
+    QStringList args = app.arguments();
+
+    QString presets;
+    QString outputFilePath;
+    int stormSize = DEFAULT_STORM_SIZE;
+    int mixedStormSize = DEFAULT_MIXED_STORM_SIZE;
+    bool instrumentation = false;
+
+    QString baselineFilePath;
+    int maxRegressionPercent = DEFAULT_MAX_REGRESSION_PERCENT;
+
+    // -1 means the default number of repetitions
+    int repetitions = -1;
+
+    bool searchAsYouType = false;
+    QString typedString;
+    int keystrokeIntervalMsec = DEFAULT_KEYSTROKE_INTERVAL_MSEC;
+
+    // The overrides of preset parameters, -1 means no override
+    int numNotebooks = -1;
+    int numTags = -1;
+    int tagNestingDepth = -1;
+    int numNotes = -1;
+    int numTagsPerNote = -1;
+    int numSavedSearches = -1;
+    int favoritedPercent = -1;
+
+    for(int i = 1, size = args.size(); i < size; ++i)
+    {
+        const QString & arg = args[i];
+        if (arg == QStringLiteral("--instrumentation")) {
+            instrumentation = true;
+            continue;
+        }
+
+        if (arg == QStringLiteral("--search-as-you-type")) {
+            searchAsYouType = true;
+            continue;
+        }
+
+        if (parseStringOption(arg, QStringLiteral("--presets"), presets) ||
+            parseStringOption(arg, QStringLiteral("--output"), outputFilePath) ||
+            parseIntOption(arg, QStringLiteral("--storm-size"), stormSize) ||
+            parseIntOption(arg, QStringLiteral("--mixed-storm-size"), mixedStormSize) ||
+            parseStringOption(arg, QStringLiteral("--baseline"), baselineFilePath) ||
+            parseIntOption(arg, QStringLiteral("--max-regression-percent"), maxRegressionPercent) ||
+            parseIntOption(arg, QStringLiteral("--repetitions"), repetitions) ||
+            parseStringOption(arg, QStringLiteral("--typed-string"), typedString) ||
+            parseIntOption(arg, QStringLiteral("--keystroke-interval"), keystrokeIntervalMsec) ||
+            parseIntOption(arg, QStringLiteral("--notebooks"), numNotebooks) ||
+            parseIntOption(arg, QStringLiteral("--tags"), numTags) ||
+            parseIntOption(arg, QStringLiteral("--tag-depth"), tagNestingDepth) ||
+            parseIntOption(arg, QStringLiteral("--notes"), numNotes) ||
+            parseIntOption(arg, QStringLiteral("--tags-per-note"), numTagsPerNote) ||
+            parseIntOption(arg, QStringLiteral("--saved-searches"), numSavedSearches) ||
+            parseIntOption(arg, QStringLiteral("--favorited-percent"), favoritedPercent))
+        {
+            continue;
+        }
+
+        qWarning() << "Unrecognized or invalid argument:" << arg;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (repetitions == 0) {
+        qWarning() << "The number of repetitions must be positive";
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (repetitions < 0) {
+        repetitions = (baselineFilePath.isEmpty() ? 1 : DEFAULT_REPETITIONS_WITH_BASELINE);
+    }
+
+    if (presets.isEmpty()) {
+        presets = (searchAsYouType ? QStringLiteral("search") : QStringLiteral("small,medium"));
+    }
+
+    QList<SyntheticAccountParameters> accounts;
+    QStringList presetNames = presets.split(QStringLiteral(","), QString::SkipEmptyParts);
+    for(auto it = presetNames.constBegin(), end = presetNames.constEnd(); it != end; ++it)
+    {
+        SyntheticAccountParameters parameters;
+        if (!presetParameters(it->trimmed(), parameters)) {
+            qWarning() << "Unknown preset:" << *it;
+            printUsage(argv[0]);
+            return 1;
+        }
+
+#define APPLY_OVERRIDE(override, field) \
+        if (override >= 0) { \
+            parameters.field = override; \
+        }
+
+        APPLY_OVERRIDE(numNotebooks, m_numNotebooks)
+        APPLY_OVERRIDE(numTags, m_numTags)
+        APPLY_OVERRIDE(tagNestingDepth, m_tagNestingDepth)
+        APPLY_OVERRIDE(numNotes, m_numNotes)
+        APPLY_OVERRIDE(numTagsPerNote, m_numTagsPerNote)
+        APPLY_OVERRIDE(numSavedSearches, m_numSavedSearches)
+        APPLY_OVERRIDE(favoritedPercent, m_favoritedPercent)
+
+#undef APPLY_OVERRIDE
+
+        accounts << parameters;
+    }
+
+    // The baseline is read before running the benchmark so that the long run isn't wasted because of a wrong path
+    QList<ModelBenchmarkReport> baselineReports;
+    if (!baselineFilePath.isEmpty())
+    {
+        QFile baselineFile(baselineFilePath);
+        if (!baselineFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qWarning() << "Can't open the baseline file for reading:" << baselineFilePath;
+            return 1;
+        }
+
+        ErrorString errorDescription;
+        QTextStream baselineStrm(&baselineFile);
+        if (!ModelBenchmark::readReportsFromJson(baselineStrm, baselineReports, errorDescription)) {
+            qWarning() << "Can't read the baseline file" << baselineFilePath << ":" << errorDescription.nonLocalizedString();
+            return 1;
+        }
+    }
+
+    if (instrumentation) {
+        ModelInstrumentation::setEnabled(true);
+    }
+
+    QList<ModelBenchmarkReport> reports;
+    for(auto it = accounts.constBegin(), end = accounts.constEnd(); it != end; ++it)
+    {
+        QList<ModelBenchmarkReport> repetitionReports;
+        for(int repetition = 0; repetition < repetitions; ++repetition)
+        {
+            if (searchAsYouType)
+            {
+                ErrorString errorDescription;
+                SearchAsYouTypeBenchmark benchmark(*it, typedString, keystrokeIntervalMsec);
+                if (!benchmark.run(errorDescription)) {
+                    qWarning() << "Search as you type benchmark failed for account" << it->m_name << ":"
+                               << errorDescription.nonLocalizedString();
+                    return 1;
+                }
+
+                repetitionReports << benchmark.report();
+                continue;
+            }
+
+            ErrorString errorDescription;
+            ModelBenchmark benchmark(*it, stormSize, mixedStormSize);
+            if (!benchmark.run(errorDescription)) {
+                qWarning() << "Model benchmark failed for account" << it->m_name << ":" << errorDescription.nonLocalizedString();
+                return 1;
+            }
+
+            repetitionReports << benchmark.report();
+
+            if (instrumentation) {
+                QTextStream errorStrm(stderr);
+                errorStrm << QStringLiteral("Model instrumentation report for account ") << it->m_name
+                          << QStringLiteral(", run ") << (repetition + 1) << QStringLiteral(" of ") << repetitions
+                          << QStringLiteral(":\n") << ModelInstrumentation::report() << QStringLiteral("\n");
+                ModelInstrumentation::reset();
+            }
+        }
+
+        reports << ModelBenchmark::medianReport(repetitionReports);
+    }
+
+    if (outputFilePath.isEmpty())
+    {
+        QTextStream strm(stdout);
+        ModelBenchmark::writeReportsAsJson(reports, strm);
+    }
+    else
+    {
+        QFile outputFile(outputFilePath);
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            qWarning() << "Can't open the output file for writing:" << outputFilePath;
+            return 1;
+        }
+
+        QTextStream strm(&outputFile);
+        ModelBenchmark::writeReportsAsJson(reports, strm);
+    }
+
+    if (baselineReports.isEmpty()) {
+        return 0;
+    }
+
+    QStringList regressions = ModelBenchmark::findPerEventCostRegressions(baselineReports, reports,
+                                                                          maxRegressionPercent);
+    if (regressions.isEmpty()) {
+        return 0;
+    }
+
+    qWarning() << "The per event cost has grown by more than" << maxRegressionPercent << "percent compared to the baseline:";
+    for(auto it = regressions.constBegin(), end = regressions.constEnd(); it != end; ++it) {
+        qWarning() << qPrintable(*it);
+    }
+
+    return REGRESSION_EXIT_CODE;
+}
@@ -381,17 +381,55 @@ void FavoritesModelTestHelper::launchTest()
             FAIL(QStringLiteral("Can't get the valid favorites model index for display name column"));
         }
 
-        res = model->setData(secondNotebookIndex, m_secondNotebook.name() + QStringLiteral("_modified"), Qt::EditRole);
+        // The persistent indexes should keep pointing to the same items after the renamed item is moved
+        // to the row appropriate for its new display name: the new name sorts the item before all the other items
+        QPersistentModelIndex persistentSecondNotebookIndex(secondNotebookIndex);
+        QPersistentModelIndex persistentFirstNoteIndex(model->indexForLocalUid(m_firstNote.localUid()));
+        int secondNotebookRowBeforeRename = persistentSecondNotebookIndex.row();
+        int firstNoteRowBeforeRename = persistentFirstNoteIndex.row();
+
+        QString newDisplayName = QStringLiteral("A ") + m_secondNotebook.name() + QStringLiteral("_modified");
+        res = model->setData(secondNotebookIndex, newDisplayName, Qt::EditRole);
         if (!res) {
             FAIL(QStringLiteral("Can't change the display name of the favorites model item"));
         }
 
+        if (!persistentSecondNotebookIndex.isValid() || !persistentFirstNoteIndex.isValid()) {
+            FAIL(QStringLiteral("Persistent favorites model indexes became invalid after changing the display name of the item"));
+        }
+
+        if ((persistentSecondNotebookIndex.row() == secondNotebookRowBeforeRename) ||
+            (persistentSecondNotebookIndex.row() != 0))
+        {
+            FAIL(QStringLiteral("The favorites model item wasn't moved to the row appropriate for its new display name: "
+                                "row before rename = ") << secondNotebookRowBeforeRename
+                 << QStringLiteral(", row after rename = ") << persistentSecondNotebookIndex.row());
+        }
+
+        if (persistentFirstNoteIndex.row() != firstNoteRowBeforeRename + 1) {
+            FAIL(QStringLiteral("The persistent index of another favorites model item wasn't shifted after the renamed item "
+                                "was moved before it: row before rename = ") << firstNoteRowBeforeRename
+                 << QStringLiteral(", row after rename = ") << persistentFirstNoteIndex.row());
+        }
+
+        const FavoritesModelItem * pSecondNotebookItem = model->itemAtRow(persistentSecondNotebookIndex.row());
+        if (!pSecondNotebookItem || (pSecondNotebookItem->localUid() != m_secondNotebook.localUid())) {
+            FAIL(QStringLiteral("Persistent favorites model index doesn't point to the renamed item anymore"));
+        }
+
+        const FavoritesModelItem * pFirstNoteItem = model->itemAtRow(persistentFirstNoteIndex.row());
+        if (!pFirstNoteItem || (pFirstNoteItem->localUid() != m_firstNote.localUid())) {
+            FAIL(QStringLiteral("Persistent favorites model index doesn't point to the same item after the renamed item was moved"));
+        }
+
+        secondNotebookIndex = persistentSecondNotebookIndex;
+
         data = model->data(secondNotebookIndex, Qt::EditRole);
         if (data.isNull()) {
             FAIL(QStringLiteral("Null data was returned by the favorites model while expected to get the display name of the item"));
         }
 
-        if (data.toString() != m_secondNotebook.name() + QStringLiteral("_modified")) {
+        if (data.toString() != newDisplayName) {
             FAIL(QStringLiteral("The name of the item appears to have not changed after setData in favorites model even though the method returned true"));
         }
 
@@ -6,6 +6,7 @@
 #include "NotebookModelTestHelper.h"
 #include "NoteModelTestHelper.h"
 #include "FavoritesModelTestHelper.h"
+#include "../../SyncProgressTracker.h"
 #include <quentier/exception/IQuentierException.h>
 #include <quentier/utility/SysInfo.h>
 #include <quentier/utility/EventLoopWithExitStatus.h>
@@ -297,6 +298,126 @@ void ModelTester::testTagModelItemSerialization()
     QVERIFY2(restoredItem.tagItem() == &item, qnPrintable("Wrong pointer to the tag item"));
 }
 
+namespace {
+
+// The sync progress tracker with the time controlled by the test instead of the real clock
+class SyncProgressTrackerWithManualClock: public quentier::SyncProgressTracker
+{
+public:
+    SyncProgressTrackerWithManualClock() :
+        quentier::SyncProgressTracker(),
+        m_currentMsec(0)
+    {}
+
+    void advance(const qint64 msec) { m_currentMsec += msec; }
+
+protected:
+    virtual qint64 currentMsec() const Q_DECL_OVERRIDE { return m_currentMsec; }
+
+private:
+    qint64  m_currentMsec;
+};
+
+} // namespace
+
+void ModelTester::testSyncProgressTracker()
+{
+    SyncProgressTrackerWithManualClock tracker;
+    QVERIFY2(tracker.isEmpty(), qnPrintable("The sync progress tracker is not empty right after its creation"));
+    QVERIFY2(tracker.toString().isEmpty(), qnPrintable("The empty sync progress tracker is rendered into non-empty text"));
+
+    // No rate and no time remaining are shown until the stage runs long enough to measure the rate
+    tracker.setItemsProgress(QStringLiteral("Downloading notes"), 10, 100);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading notes: 10 of 100"));
+
+    tracker.advance(500);
+    tracker.setItemsProgress(QStringLiteral("Downloading notes"), 15, 100);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading notes: 15 of 100"));
+
+    // The rate is measured since the start of the stage: 20 items in 2 seconds
+    tracker.advance(1500);
+    tracker.setItemsProgress(QStringLiteral("Downloading notes"), 30, 100);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading notes: 30 of 100, 10.0 per second, about 0:07 left"));
+
+    // The stage with another description starts measuring the rate from scratch
+    tracker.setItemsProgress(QStringLiteral("Downloading attachments"), 5, 50);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading attachments: 5 of 50"));
+
+    tracker.advance(4000);
+    tracker.setItemsProgress(QStringLiteral("Downloading attachments"), 15, 50);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading attachments: 15 of 50, 2.5 per second, about 0:14 left"));
+
+    // With only the percentage known, the time remaining is extrapolated from the time elapsed since the start
+    // of the stage; switching from items progress to percentage progress starts the new stage even if the stage
+    // description is the same
+    tracker.setPercentageProgress(QStringLiteral("Downloading attachments"), 10.0);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading attachments: 10.0%"));
+
+    tracker.advance(3000);
+    tracker.setPercentageProgress(QStringLiteral("Downloading attachments"), 50.0);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading attachments: 50.0%, about 0:03 left"));
+
+    tracker.setPercentageProgress(QStringLiteral("Downloading sync chunks"), 0.0);
+    tracker.advance(100000);
+    tracker.setPercentageProgress(QStringLiteral("Downloading sync chunks"), 2.5);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading sync chunks: 2.5%, about 1:05:00 left"));
+
+    // The percentage is bounded by 100
+    tracker.setPercentageProgress(QStringLiteral("Downloading sync chunks"), 120.0);
+    QCOMPARE(tracker.toString(), QStringLiteral("Downloading sync chunks: 100.0%, about 0:00 left"));
+
+    tracker.clear();
+    QVERIFY2(tracker.isEmpty(), qnPrintable("The sync progress tracker is not empty after clearing"));
+    QVERIFY2(tracker.toString().isEmpty(), qnPrintable("The cleared sync progress tracker is rendered into non-empty text"));
+
+    // The first update after a quiet period is rendered right away, the further updates within the rendering
+    // interval are coalesced into the single rendering at the end of the interval
+    const int renderingIntervalMsec = quentier::SyncProgressTracker::renderingIntervalMsec();
+    QVERIFY2(renderingIntervalMsec > 10, qnPrintable("Unexpectedly short sync progress rendering interval"));
+
+    int numRenderings = 0;
+    int numUpdates = 0;
+    const int stepMsec = 10;
+    const int durationMsec = 100 * renderingIntervalMsec;
+    for(int elapsedMsec = 0; elapsedMsec < durationMsec; elapsedMsec += stepMsec)
+    {
+        tracker.setItemsProgress(QStringLiteral("Downloading notes"), numUpdates, durationMsec / stepMsec);
+        ++numUpdates;
+
+        if (tracker.checkRenderingNow()) {
+            ++numRenderings;
+        }
+
+        tracker.advance(stepMsec);
+
+        // The end of the rendering interval
+        if (((elapsedMsec + stepMsec) % renderingIntervalMsec == 0) && tracker.takePendingRendering()) {
+            ++numRenderings;
+        }
+    }
+
+    QVERIFY2(numRenderings <= durationMsec / renderingIntervalMsec + 1,
+             qnPrintable(QStringLiteral("The sync progress was rendered too often: ") + QString::number(numRenderings) +
+                         QStringLiteral(" renderings of ") + QString::number(numUpdates) + QStringLiteral(" updates")));
+    QVERIFY2(numRenderings >= durationMsec / renderingIntervalMsec,
+             qnPrintable(QStringLiteral("The sync progress was rendered too rarely: ") + QString::number(numRenderings) +
+                         QStringLiteral(" renderings of ") + QString::number(numUpdates) + QStringLiteral(" updates")));
+    QVERIFY2(!tracker.hasPendingRendering(), qnPrintable("The last sync progress update was never rendered"));
+
+    // The rendering is not postponed if nothing was rendered within the last rendering interval
+    tracker.advance(renderingIntervalMsec);
+    tracker.setItemsProgress(QStringLiteral("Downloading notes"), numUpdates, numUpdates);
+    QVERIFY2(tracker.checkRenderingNow(), qnPrintable("The sync progress update after a quiet period was not rendered right away"));
+    QVERIFY2(!tracker.takePendingRendering(), qnPrintable("The sync progress rendered right away is still pending for rendering"));
+
+    // The progress superseded by another message is not rendered at the end of the interval
+    tracker.advance(stepMsec);
+    QVERIFY2(!tracker.checkRenderingNow(), qnPrintable("The sync progress update within the rendering interval was not postponed"));
+    QVERIFY2(tracker.hasPendingRendering(), qnPrintable("The postponed sync progress update is not pending for rendering"));
+    tracker.cancelPendingRendering();
+    QVERIFY2(!tracker.takePendingRendering(), qnPrintable("The cancelled sync progress rendering is still pending"));
+}
+
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
@@ -36,6 +36,7 @@ private Q_SLOTS:
     void testNoteModel();
     void testFavoritesModel();
     void testTagModelItemSerialization();
+    void testSyncProgressTracker();
 
 private:
     quentier::LocalStorageManagerAsync *    m_pLocalStorageManagerAsync;
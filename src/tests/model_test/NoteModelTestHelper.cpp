@@ -298,18 +298,60 @@ void NoteModelTestHelper::launchTest()
             FAIL(QStringLiteral("The synchronizable state appears to have changed after setData in note model even though the method returned false"));
         }
 
-        // Should be able to change the title
+        // Should be able to change the title; with the model sorted by title, the persistent indexes should keep
+        // pointing to the same items after the item is moved to the row appropriate for its new title
+        model->sort(NoteModel::Columns::Title, Qt::AscendingOrder);
+
+        firstIndex = model->indexForLocalUid(firstNote.localUid());
+        if (!firstIndex.isValid()) {
+            FAIL(QStringLiteral("Can't get the valid note model item index for local uid after sorting the model by title"));
+        }
+
         firstIndex = model->index(firstIndex.row(), NoteModel::Columns::Title, QModelIndex());
         if (!firstIndex.isValid()) {
             FAIL(QStringLiteral("Can't get the valid note model item index for title column"));
         }
 
-        QString newTitle = QStringLiteral("First note (modified)");
+        QPersistentModelIndex persistentFirstIndex(firstIndex);
+        QPersistentModelIndex persistentFifthIndex(model->indexForLocalUid(fifthNote.localUid()));
+        int firstRowBeforeTitleChange = persistentFirstIndex.row();
+        int fifthRowBeforeTitleChange = persistentFifthIndex.row();
+
+        // The new title sorts the item before all the other items
+        QString newTitle = QStringLiteral("A first note (modified)");
         res = model->setData(firstIndex, newTitle, Qt::EditRole);
         if (!res) {
             FAIL(QStringLiteral("Can't change the title of note model item"));
         }
 
+        if (!persistentFirstIndex.isValid() || !persistentFifthIndex.isValid()) {
+            FAIL(QStringLiteral("Persistent note model indexes became invalid after changing the title of the note model item"));
+        }
+
+        if ((persistentFirstIndex.row() == firstRowBeforeTitleChange) || (persistentFirstIndex.row() != 0)) {
+            FAIL(QStringLiteral("The note model item wasn't moved to the row appropriate for its new title: row before "
+                                "title change = ") << firstRowBeforeTitleChange
+                 << QStringLiteral(", row after title change = ") << persistentFirstIndex.row());
+        }
+
+        if (persistentFifthIndex.row() != fifthRowBeforeTitleChange + 1) {
+            FAIL(QStringLiteral("The persistent index of another note model item wasn't shifted after the item with "
+                                "changed title was moved before it: row before title change = ") << fifthRowBeforeTitleChange
+                 << QStringLiteral(", row after title change = ") << persistentFifthIndex.row());
+        }
+
+        const NoteModelItem * pFirstItem = model->itemForIndex(persistentFirstIndex);
+        if (!pFirstItem || (pFirstItem->localUid() != firstNote.localUid())) {
+            FAIL(QStringLiteral("Persistent note model index doesn't point to the item with changed title anymore"));
+        }
+
+        const NoteModelItem * pFifthItem = model->itemForIndex(persistentFifthIndex);
+        if (!pFifthItem || (pFifthItem->localUid() != fifthNote.localUid())) {
+            FAIL(QStringLiteral("Persistent note model index doesn't point to the same item after another item was moved"));
+        }
+
+        firstIndex = persistentFirstIndex;
+
         data = model->data(firstIndex, Qt::EditRole);
         if (data.isNull()) {
             FAIL(QStringLiteral("Null data was returned by the note model while expected to get the note item's title"));
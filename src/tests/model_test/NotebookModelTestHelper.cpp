@@ -295,12 +295,48 @@ void NotebookModelTestHelper::test()
             FAIL(QStringLiteral("Can't get the valid notebook model item index for name column"));
         }
 
-        QString newName = QStringLiteral("Second (name modified)");
+        // The persistent indexes should keep pointing to the same items after the renamed item is moved
+        // to the row appropriate for its new name: the new name sorts the item before all of its siblings
+        // within the stack
+        QPersistentModelIndex persistentSecondIndex(secondIndex);
+        QPersistentModelIndex persistentFourthIndex(model->indexForLocalUid(fourth.localUid()));
+        int secondRowBeforeRename = persistentSecondIndex.row();
+        int fourthRowBeforeRename = persistentFourthIndex.row();
+
+        QString newName = QStringLiteral("A second");
         res = model->setData(secondIndex, QVariant(newName), Qt::EditRole);
         if (!res) {
             FAIL(QStringLiteral("Can't change the name of the notebook model item"));
         }
 
+        if (!persistentSecondIndex.isValid() || !persistentFourthIndex.isValid()) {
+            FAIL(QStringLiteral("Persistent notebook model indexes became invalid after changing the name of the notebook model item"));
+        }
+
+        if ((persistentSecondIndex.row() == secondRowBeforeRename) || (persistentSecondIndex.row() != 0)) {
+            FAIL(QStringLiteral("The renamed notebook model item wasn't moved to the row appropriate for its new name: "
+                                "row before rename = ") << secondRowBeforeRename
+                 << QStringLiteral(", row after rename = ") << persistentSecondIndex.row());
+        }
+
+        if (persistentSecondIndex.parent() != secondParentIndex) {
+            FAIL(QStringLiteral("The renamed notebook model item was moved out of its stack"));
+        }
+
+        if (persistentFourthIndex.row() != fourthRowBeforeRename + 1) {
+            FAIL(QStringLiteral("The persistent index of the sibling notebook model item wasn't shifted after the renamed item "
+                                "was moved before it: row before rename = ") << fourthRowBeforeRename
+                 << QStringLiteral(", row after rename = ") << persistentFourthIndex.row());
+        }
+
+        const NotebookModelItem * pSecondModelItem = model->itemForIndex(persistentSecondIndex);
+        const NotebookItem * pSecondNotebookItem = (pSecondModelItem ? pSecondModelItem->notebookItem() : Q_NULLPTR);
+        if (!pSecondNotebookItem || (pSecondNotebookItem->localUid() != second.localUid())) {
+            FAIL(QStringLiteral("Persistent notebook model index doesn't point to the renamed notebook item anymore"));
+        }
+
+        secondIndex = persistentSecondIndex;
+
         data = model->data(secondIndex, Qt::EditRole);
         if (data.isNull()) {
             FAIL(QStringLiteral("Null data was returned by the notebook model while expected to get the name of the tag item"));
@@ -300,12 +300,46 @@ void TagModelTestHelper::test()
             FAIL(QStringLiteral("Can't get the valid tag item model index for name column"));
         }
 
-        QString newName = QStringLiteral("Second (name modified)");
+        // The persistent indexes should keep pointing to the same items after the renamed item is moved
+        // to the row appropriate for its new name: the new name sorts the item before all of its siblings
+        QPersistentModelIndex persistentSecondIndex(secondIndex);
+        QPersistentModelIndex persistentFirstIndex(model->indexForLocalUid(first.localUid()));
+        int secondRowBeforeRename = persistentSecondIndex.row();
+        int firstRowBeforeRename = persistentFirstIndex.row();
+
+        QString newName = QStringLiteral("A second");
         res = model->setData(secondIndex, QVariant(newName), Qt::EditRole);
         if (!res) {
             FAIL(QStringLiteral("Can't change the name of the tag model item"));
         }
 
+        if (!persistentSecondIndex.isValid() || !persistentFirstIndex.isValid()) {
+            FAIL(QStringLiteral("Persistent tag model indexes became invalid after changing the name of the tag model item"));
+        }
+
+        if ((persistentSecondIndex.row() == secondRowBeforeRename) || (persistentSecondIndex.row() != 0)) {
+            FAIL(QStringLiteral("The renamed tag model item wasn't moved to the row appropriate for its new name: row before rename = ")
+                 << secondRowBeforeRename << QStringLiteral(", row after rename = ") << persistentSecondIndex.row());
+        }
+
+        if (persistentFirstIndex.row() != firstRowBeforeRename + 1) {
+            FAIL(QStringLiteral("The persistent index of the sibling tag model item wasn't shifted after the renamed item "
+                                "was moved before it: row before rename = ") << firstRowBeforeRename
+                 << QStringLiteral(", row after rename = ") << persistentFirstIndex.row());
+        }
+
+        const TagModelItem * pSecondModelItem = model->itemForIndex(persistentSecondIndex);
+        if (!pSecondModelItem || !pSecondModelItem->tagItem() || (pSecondModelItem->tagItem()->localUid() != second.localUid())) {
+            FAIL(QStringLiteral("Persistent tag model index doesn't point to the renamed tag item anymore"));
+        }
+
+        const TagModelItem * pFirstModelItem = model->itemForIndex(persistentFirstIndex);
+        if (!pFirstModelItem || !pFirstModelItem->tagItem() || (pFirstModelItem->tagItem()->localUid() != first.localUid())) {
+            FAIL(QStringLiteral("Persistent tag model index doesn't point to the same tag item after the renamed item was moved"));
+        }
+
+        secondIndex = persistentSecondIndex;
+
         data = model->data(secondIndex, Qt::EditRole);
         if (data.isNull()) {
             FAIL(QStringLiteral("Null data was returned by the tag model while expected to get the name of the tag item"));
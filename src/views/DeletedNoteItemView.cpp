@@ -96,6 +96,52 @@ void DeletedNoteItemView::showCurrentlySelectedNoteInfo()
     Q_EMIT deletedNoteInfoRequested(pItem->localUid());
 }
 
+void DeletedNoteItemView::emptyTrash()
+{
+    QNDEBUG(QStringLiteral("DeletedNoteItemView::emptyTrash"));
+
+    NoteModel * pNoteModel = qobject_cast<NoteModel*>(model());
+    if (Q_UNLIKELY(!pNoteModel)) {
+        QNDEBUG(QStringLiteral("Non-note model is used"));
+        return;
+    }
+
+    QStringList noteLocalUids;
+    for(int row = 0, numRows = pNoteModel->rowCount(); row < numRows; ++row)
+    {
+        const NoteModelItem * pItem = pNoteModel->itemAtRow(row);
+        if (pItem && pItem->guid().isEmpty()) {
+            noteLocalUids << pItem->localUid();
+        }
+    }
+
+    if (noteLocalUids.isEmpty()) {
+        QNDEBUG(QStringLiteral("No deleted notes which can be deleted permanently"));
+        return;
+    }
+
+    int confirm = warningMessageBox(this, tr("Confirm emptying the trash"),
+                                    tr("Are you sure you want to delete permanently all the deleted notes?"),
+                                    tr("Note that this action is not reversible, you won't be able to restore "
+                                       "the permanently deleted notes"), QMessageBox::Ok | QMessageBox::No);
+    if (confirm != QMessageBox::Ok) {
+        QNDEBUG(QStringLiteral("Emptying the trash was not confirmed"));
+        return;
+    }
+
+    // The bulk expunging removes all the notes from the model at once instead of a row at a time
+    bool res = pNoteModel->expungeNotes(noteLocalUids);
+    if (res) {
+        QNDEBUG(QStringLiteral("Successfully removed ") << noteLocalUids.size()
+                << QStringLiteral(" notes completely from the model"));
+        return;
+    }
+
+    Q_UNUSED(internalErrorMessageBox(this, tr("The note model refused to delete the notes permanently; "
+                                              "Check the status bar for message from the note model "
+                                              "explaining why the action was not successful")));
+}
+
 void DeletedNoteItemView::onRestoreNoteAction()
 {
     QNDEBUG(QStringLiteral("DeletedNoteItemView::onRestoreNoteAction"));
@@ -179,6 +225,12 @@ void DeletedNoteItemView::onShowDeletedNoteInfoAction()
     Q_EMIT deletedNoteInfoRequested(itemLocalUid);
 }
 
+void DeletedNoteItemView::onEmptyTrashAction()
+{
+    QNDEBUG(QStringLiteral("DeletedNoteItemView::onEmptyTrashAction"));
+    emptyTrash();
+}
+
 void DeletedNoteItemView::restoreNote(const QModelIndex & index, NoteModel & model)
 {
     if (Q_UNLIKELY(!index.isValid())) {
@@ -282,6 +334,11 @@ void DeletedNoteItemView::contextMenuEvent(QContextMenuEvent * pEvent)
     ADD_CONTEXT_MENU_ACTION(tr("Info") + QStringLiteral("..."), m_pDeletedNoteItemContextMenu,
                             onShowDeletedNoteInfoAction, pItem->localUid(), true);
 
+    m_pDeletedNoteItemContextMenu->addSeparator();
+
+    ADD_CONTEXT_MENU_ACTION(tr("Empty trash"), m_pDeletedNoteItemContextMenu,
+                            onEmptyTrashAction, QVariant(), true);
+
     m_pDeletedNoteItemContextMenu->show();
     m_pDeletedNoteItemContextMenu->exec(pEvent->globalPos());
 }
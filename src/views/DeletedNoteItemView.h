@@ -23,6 +23,12 @@ public:
     void deleteCurrentlySelectedNotePermanently();
     void showCurrentlySelectedNoteInfo();
 
+    /**
+     * @brief emptyTrash - deletes permanently all the deleted notes which have never been synchronized
+     * (the synchronized ones can only be expunged through the web client)
+     */
+    void emptyTrash();
+
 Q_SIGNALS:
     void deletedNoteInfoRequested(QString deletedNoteLocalUid);
     void notifyError(ErrorString error);
@@ -31,6 +37,7 @@ private Q_SLOTS:
     void onRestoreNoteAction();
     void onDeleteNotePermanentlyAction();
     void onShowDeletedNoteInfoAction();
+    void onEmptyTrashAction();
 
 private:
     void restoreNote(const QModelIndex & index, NoteModel & model);
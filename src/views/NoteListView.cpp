@@ -18,18 +18,24 @@
 
 #include "NoteListView.h"
 #include "NotebookItemView.h"
+#include "TagItemView.h"
 #include "../models/NoteFilterModel.h"
 #include "../models/NoteModel.h"
 #include "../models/NotebookModel.h"
 #include "../models/NotebookItem.h"
+#include "../models/TagModel.h"
 #include <quentier/logging/QuentierLogger.h>
 #include <QContextMenuEvent>
+#include <QInputDialog>
 #include <QItemSelectionModel>
 #include <QMenu>
 #include <QMouseEvent>
 #include <QTimer>
 #include <iterator>
 
+// The number of notes before and after the current one reported via adjacentNotesChanged signal
+#define NUM_ADJACENT_NOTES_TO_REPORT (2)
+
 #define REPORT_ERROR(error) \
     { \
         ErrorString errorDescription(error); \
@@ -43,6 +49,7 @@ NoteListView::NoteListView(QWidget * parent) :
     QListView(parent),
     m_pNoteItemContextMenu(Q_NULLPTR),
     m_pNotebookItemView(Q_NULLPTR),
+    m_pTagItemView(Q_NULLPTR),
     m_shouldSelectFirstNoteOnNextNoteAddition(false),
     m_currentAccount(),
     m_lastCurrentNoteLocalUid()
@@ -54,6 +61,12 @@ void NoteListView::setNotebookItemView(NotebookItemView * pNotebookItemView)
     m_pNotebookItemView = pNotebookItemView;
 }
 
+void NoteListView::setTagItemView(TagItemView * pTagItemView)
+{
+    QNTRACE(QStringLiteral("NoteListView::setTagItemView"));
+    m_pTagItemView = pTagItemView;
+}
+
 void NoteListView::setAutoSelectNoteOnNextAddition()
 {
     QNTRACE(QStringLiteral("NoteListView::setAutoSelectNoteOnNextAddition"));
@@ -471,6 +484,130 @@ void NoteListView::onExportSeveralNotesToEnexAction()
     Q_EMIT enexExportRequested(noteLocalUids);
 }
 
+void NoteListView::onDeleteSeveralNotesAction()
+{
+    QNDEBUG(QStringLiteral("NoteListView::onDeleteSeveralNotesAction"));
+
+    NoteFilterModel * pNoteFilterModel = noteFilterModel();
+    NoteModel * pNoteModel = noteModel(pNoteFilterModel);
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QStringList noteLocalUids = actionDataStringList();
+    if (Q_UNLIKELY(noteLocalUids.isEmpty())) {
+        REPORT_ERROR(QT_TR_NOOP("Can't delete notes: internal error, the list of local uids of notes to be deleted is empty"));
+        return;
+    }
+
+    // NOTE: the model reports the reason of the failure on its own
+    Q_UNUSED(pNoteModel->deleteNotes(noteLocalUids))
+}
+
+void NoteListView::onMoveSeveralNotesToOtherNotebookAction()
+{
+    QNDEBUG(QStringLiteral("NoteListView::onMoveSeveralNotesToOtherNotebookAction"));
+
+    // The first item of the action data is the name of the target notebook, the rest are the local uids of notes
+    QStringList actionData = actionDataStringList();
+    if (actionData.size() < 2) {
+        REPORT_ERROR(QT_TR_NOOP("Can't move notes to another notebook: internal error, wrong action data"));
+        return;
+    }
+
+    NoteFilterModel * pNoteFilterModel = noteFilterModel();
+    NoteModel * pNoteModel = noteModel(pNoteFilterModel);
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QString notebookName = actionData.takeFirst();
+    pNoteModel->moveNotesToNotebook(actionData, notebookName);
+}
+
+void NoteListView::onAddTagToSeveralNotesAction()
+{
+    QNDEBUG(QStringLiteral("NoteListView::onAddTagToSeveralNotesAction"));
+
+    NoteFilterModel * pNoteFilterModel = noteFilterModel();
+    NoteModel * pNoteModel = noteModel(pNoteFilterModel);
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QStringList noteLocalUids = actionDataStringList();
+    if (Q_UNLIKELY(noteLocalUids.isEmpty())) {
+        REPORT_ERROR(QT_TR_NOOP("Can't add tag to notes: internal error, the list of local uids of notes is empty"));
+        return;
+    }
+
+    const TagModel * pTagModel = (m_pTagItemView ? qobject_cast<const TagModel*>(m_pTagItemView->model()) : Q_NULLPTR);
+    if (Q_UNLIKELY(!pTagModel)) {
+        REPORT_ERROR(QT_TR_NOOP("Can't add tag to notes: internal error, no tag model is set to the tag view"));
+        return;
+    }
+
+    // Only the tags from user's own account can be assigned to the notes from user's own notebooks
+    QStringList tagNames = pTagModel->tagNames(QStringLiteral(""));
+    if (tagNames.isEmpty()) {
+        QNDEBUG(QStringLiteral("There are no tags to add to notes"));
+        return;
+    }
+
+    bool ok = false;
+    QString tagName = QInputDialog::getItem(this, tr("Add tag"), tr("Tag to add to the selected notes") + QStringLiteral(":"),
+                                            tagNames, 0, /* editable = */ false, &ok);
+    if (!ok || tagName.isEmpty()) {
+        QNDEBUG(QStringLiteral("No tag was chosen"));
+        return;
+    }
+
+    QString tagLocalUid = pTagModel->localUidForItemName(tagName, /* linked notebook guid = */ QString());
+    if (Q_UNLIKELY(tagLocalUid.isEmpty())) {
+        REPORT_ERROR(QT_TR_NOOP("Can't add tag to notes: internal error, can't find the local uid of the chosen tag"));
+        return;
+    }
+
+    // NOTE: the model reports the reason of the failure on its own
+    Q_UNUSED(pNoteModel->addTagToNotes(noteLocalUids, tagLocalUid))
+}
+
+void NoteListView::onFavoriteSeveralNotesAction()
+{
+    QNDEBUG(QStringLiteral("NoteListView::onFavoriteSeveralNotesAction"));
+
+    NoteFilterModel * pNoteFilterModel = noteFilterModel();
+    NoteModel * pNoteModel = noteModel(pNoteFilterModel);
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QStringList noteLocalUids = actionDataStringList();
+    if (noteLocalUids.isEmpty()) {
+        return;
+    }
+
+    pNoteModel->favoriteNotes(noteLocalUids);
+}
+
+void NoteListView::onUnfavoriteSeveralNotesAction()
+{
+    QNDEBUG(QStringLiteral("NoteListView::onUnfavoriteSeveralNotesAction"));
+
+    NoteFilterModel * pNoteFilterModel = noteFilterModel();
+    NoteModel * pNoteModel = noteModel(pNoteFilterModel);
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QStringList noteLocalUids = actionDataStringList();
+    if (noteLocalUids.isEmpty()) {
+        return;
+    }
+
+    pNoteModel->unfavoriteNotes(noteLocalUids);
+}
+
 void NoteListView::onSelectFirstNoteEvent()
 {
     QNDEBUG(QStringLiteral("NoteListView::onSelectFirstNoteEvent"));
@@ -767,6 +904,70 @@ void NoteListView::showMultipleNotesContextMenu(const QPoint & globalPos, const
     delete m_pNoteItemContextMenu;
     m_pNoteItemContextMenu = new QMenu(this);
 
+    // The actions below go through the bulk methods of the note model which either apply the change
+    // to all the selected notes or reject the whole batch
+
+    ADD_CONTEXT_MENU_ACTION(tr("Delete"), m_pNoteItemContextMenu,
+                            onDeleteSeveralNotesAction, noteLocalUids, true);
+
+    const NotebookModel * pNotebookModel = (m_pNotebookItemView
+                                            ? qobject_cast<const NotebookModel*>(m_pNotebookItemView->model())
+                                            : Q_NULLPTR);
+    if (pNotebookModel)
+    {
+        QStringList notebookNames = pNotebookModel->notebookNames(NotebookModel::NotebookFilters(NotebookModel::NotebookFilter::CanCreateNotes));
+        if (!notebookNames.isEmpty())
+        {
+            QMenu * pTargetNotebooksSubMenu = m_pNoteItemContextMenu->addMenu(tr("Move to notebook"));
+            for(auto it = notebookNames.constBegin(), end = notebookNames.constEnd(); it != end; ++it)
+            {
+                QStringList data;
+                data.reserve(noteLocalUids.size() + 1);
+                data << *it;
+                data << noteLocalUids;
+                ADD_CONTEXT_MENU_ACTION(*it, pTargetNotebooksSubMenu, onMoveSeveralNotesToOtherNotebookAction,
+                                        data, true);
+            }
+        }
+    }
+
+    ADD_CONTEXT_MENU_ACTION(tr("Add tag") + QStringLiteral("..."), m_pNoteItemContextMenu,
+                            onAddTagToSeveralNotesAction, noteLocalUids, (m_pTagItemView != Q_NULLPTR));
+
+    bool hasFavoritedNotes = false;
+    bool hasNotFavoritedNotes = false;
+
+    NoteModel * pNoteModel = noteModel(noteFilterModel());
+    if (pNoteModel)
+    {
+        for(auto it = noteLocalUids.constBegin(), end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            const NoteModelItem * pItem = pNoteModel->itemForLocalUid(*it);
+            if (Q_UNLIKELY(!pItem)) {
+                continue;
+            }
+
+            if (pItem->isFavorited()) {
+                hasFavoritedNotes = true;
+            }
+            else {
+                hasNotFavoritedNotes = true;
+            }
+        }
+    }
+
+    if (hasNotFavoritedNotes) {
+        ADD_CONTEXT_MENU_ACTION(tr("Favorite"), m_pNoteItemContextMenu,
+                                onFavoriteSeveralNotesAction, noteLocalUids, true);
+    }
+
+    if (hasFavoritedNotes) {
+        ADD_CONTEXT_MENU_ACTION(tr("Unfavorite"), m_pNoteItemContextMenu,
+                                onUnfavoriteSeveralNotesAction, noteLocalUids, true);
+    }
+
+    m_pNoteItemContextMenu->addSeparator();
+
     ADD_CONTEXT_MENU_ACTION(tr("Export to enex") + QStringLiteral("..."), m_pNoteItemContextMenu,
                             onExportSeveralNotesToEnexAction, noteLocalUids, true);
 
@@ -802,6 +1003,30 @@ void NoteListView::currentChanged(const QModelIndex & current,
     QNTRACE(QStringLiteral("Updated the last current note local uid to ") << pItem->localUid());
 
     Q_EMIT currentNoteChanged(pItem->localUid());
+
+    QStringList adjacentNoteLocalUids;
+    adjacentNoteLocalUids.reserve(2 * NUM_ADJACENT_NOTES_TO_REPORT);
+
+    int numRows = pNoteFilterModel->rowCount(current.parent());
+    for(int distance = 1; distance <= NUM_ADJACENT_NOTES_TO_REPORT; ++distance)
+    {
+        // The note next to the current one goes first since moving down the list is the most common case
+        int rows[2] = { current.row() + distance, current.row() - distance };
+        for(int i = 0; i < 2; ++i)
+        {
+            if ((rows[i] < 0) || (rows[i] >= numRows)) {
+                continue;
+            }
+
+            QModelIndex adjacentIndex = pNoteFilterModel->index(rows[i], current.column(), current.parent());
+            const NoteModelItem * pAdjacentItem = pNoteModel->itemForIndex(pNoteFilterModel->mapToSource(adjacentIndex));
+            if (pAdjacentItem) {
+                adjacentNoteLocalUids << pAdjacentItem->localUid();
+            }
+        }
+    }
+
+    Q_EMIT adjacentNotesChanged(adjacentNoteLocalUids);
 }
 
 void NoteListView::mousePressEvent(QMouseEvent * pEvent)
@@ -29,6 +29,7 @@ QT_FORWARD_DECLARE_CLASS(QMenu)
 namespace quentier {
 
 QT_FORWARD_DECLARE_CLASS(NotebookItemView)
+QT_FORWARD_DECLARE_CLASS(TagItemView)
 QT_FORWARD_DECLARE_CLASS(NotebookItem)
 QT_FORWARD_DECLARE_CLASS(NoteModel)
 QT_FORWARD_DECLARE_CLASS(NoteFilterModel)
@@ -44,6 +45,7 @@ public:
     explicit NoteListView(QWidget * parent = Q_NULLPTR);
 
     void setNotebookItemView(NotebookItemView * pNotebookItemView);
+    void setTagItemView(TagItemView * pTagItemView);
 
     /**
      * After this method is called, NoteListView would automatically select the first note of the model
@@ -74,6 +76,12 @@ Q_SIGNALS:
     void notifyError(ErrorString errorDescription);
     void currentNoteChanged(QString noteLocalUid);
 
+    /**
+     * @brief adjacentNotesChanged - emitted along with currentNoteChanged
+     * @param noteLocalUids - local uids of notes displayed next to the current one, the closest ones first
+     */
+    void adjacentNotesChanged(QStringList noteLocalUids);
+
     void newNoteCreationRequested();
     void editNoteDialogRequested(QString noteLocalUid);
     void noteInfoDialogRequested(QString noteLocalUid);
@@ -142,6 +150,12 @@ protected Q_SLOTS:
     void onExportSingleNoteToEnexAction();
     void onExportSeveralNotesToEnexAction();
 
+    void onDeleteSeveralNotesAction();
+    void onMoveSeveralNotesToOtherNotebookAction();
+    void onAddTagToSeveralNotesAction();
+    void onFavoriteSeveralNotesAction();
+    void onUnfavoriteSeveralNotesAction();
+
     void onSelectFirstNoteEvent();
     void onTrySetLastCurrentNoteByLocalUidEvent();
 
@@ -197,6 +211,7 @@ private:
 protected:
     QMenu *             m_pNoteItemContextMenu;
     NotebookItemView *  m_pNotebookItemView;
+    TagItemView *       m_pTagItemView;
     bool                m_shouldSelectFirstNoteOnNextNoteAddition;
 
     Account             m_currentAccount;
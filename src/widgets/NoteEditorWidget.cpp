@@ -41,7 +41,6 @@ using quentier::NoteTagsWidget;
 #include <quentier/local_storage/LocalStorageManagerAsync.h>
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/types/Resource.h>
-#include <quentier/utility/EventLoopWithExitStatus.h>
 #include <quentier/utility/ApplicationSettings.h>
 #include <quentier/utility/FileIOProcessorAsync.h>
 #include <quentier/utility/MessageBox.h>
@@ -86,6 +85,8 @@ NoteEditorWidget::NoteEditorWidget(const Account & account, LocalStorageManagerA
     m_currentAccount(account),
     m_pUndoStack(pUndoStack),
     m_pConvertToNoteDeadlineTimer(Q_NULLPTR),
+    m_noteLocalUidBeingSaved(),
+    m_noteSaveRequestId(),
     m_findCurrentNoteRequestId(),
     m_findCurrentNotebookRequestId(),
     m_updateNoteRequestIds(),
@@ -102,7 +103,8 @@ NoteEditorWidget::NoteEditorWidget(const Account & account, LocalStorageManagerA
     m_noteHasBeenModified(false),
     m_noteTitleIsEdited(false),
     m_noteTitleHasBeenEdited(false),
-    m_isNewNote(false)
+    m_isNewNote(false),
+    m_closeWhenNoteSaved(false)
 {
     m_pUi->setupUi(this);
 
@@ -304,26 +306,31 @@ bool NoteEditorWidget::isSpellCheckEnabled() const
     return m_pUi->noteEditor->spellCheckEnabled();
 }
 
-NoteEditorWidget::NoteSaveStatus::type NoteEditorWidget::checkAndSaveModifiedNote(ErrorString & errorDescription)
+bool NoteEditorWidget::checkAndSaveModifiedNote()
 {
     QNDEBUG(QStringLiteral("NoteEditorWidget::checkAndSaveModifiedNote"));
 
+    if (isSavingNote()) {
+        QNDEBUG(QStringLiteral("The note is already being saved"));
+        return true;
+    }
+
     if (m_pCurrentNote.isNull()) {
         QNDEBUG(QStringLiteral("No note is set to the editor"));
-        return NoteSaveStatus::Ok;
+        return false;
     }
 
     if (m_pCurrentNote->hasDeletionTimestamp()) {
         QNDEBUG(QStringLiteral("The note is deleted which means it just got deleted and the editor is closing => "
                                "there is no need to save whatever is left in the editor for this note"));
-        return NoteSaveStatus::Ok;
+        return false;
     }
 
     bool noteContentModified = m_pUi->noteEditor->isModified();
 
     if (!m_noteTitleIsEdited && !noteContentModified) {
         QNDEBUG(QStringLiteral("Note is not modified, nothing to save"));
-        return NoteSaveStatus::Ok;
+        return false;
     }
 
     bool noteTitleUpdated = false;
@@ -358,67 +365,56 @@ NoteEditorWidget::NoteSaveStatus::type NoteEditorWidget::checkAndSaveModifiedNot
         attributes.noteTitleQuality.clear();
     }
 
-    if (noteContentModified || noteTitleUpdated)
-    {
-        ApplicationSettings appSettings;
-        appSettings.beginGroup(NOTE_EDITOR_SETTINGS_GROUP_NAME);
-        QVariant editorConvertToNoteTimeoutData = appSettings.value(CONVERT_TO_NOTE_TIMEOUT_SETTINGS_KEY);
-        appSettings.endGroup();
+    if (!noteContentModified && !noteTitleUpdated) {
+        QNDEBUG(QStringLiteral("Neither the note's content nor its title need saving"));
+        return false;
+    }
 
-        bool conversionResult = false;
-        int editorConvertToNoteTimeout = editorConvertToNoteTimeoutData.toInt(&conversionResult);
-        if (Q_UNLIKELY(!conversionResult)) {
-            QNDEBUG(QStringLiteral("Can't read the timeout for note editor to note conversion from the application settings, "
-                                   "fallback to the default value of ") << DEFAULT_EDITOR_CONVERT_TO_NOTE_TIMEOUT
-                    << QStringLiteral(" milliseconds"));
-            editorConvertToNoteTimeout = DEFAULT_EDITOR_CONVERT_TO_NOTE_TIMEOUT;
-        }
-        else {
-            editorConvertToNoteTimeout = std::max(editorConvertToNoteTimeout, 100);
-        }
+    ApplicationSettings appSettings;
+    appSettings.beginGroup(NOTE_EDITOR_SETTINGS_GROUP_NAME);
+    QVariant editorConvertToNoteTimeoutData = appSettings.value(CONVERT_TO_NOTE_TIMEOUT_SETTINGS_KEY);
+    appSettings.endGroup();
 
-        if (m_pConvertToNoteDeadlineTimer) {
-            m_pConvertToNoteDeadlineTimer->deleteLater();
-        }
+    bool conversionResult = false;
+    int editorConvertToNoteTimeout = editorConvertToNoteTimeoutData.toInt(&conversionResult);
+    if (Q_UNLIKELY(!conversionResult)) {
+        QNDEBUG(QStringLiteral("Can't read the timeout for note editor to note conversion from the application settings, "
+                               "fallback to the default value of ") << DEFAULT_EDITOR_CONVERT_TO_NOTE_TIMEOUT
+                << QStringLiteral(" milliseconds"));
+        editorConvertToNoteTimeout = DEFAULT_EDITOR_CONVERT_TO_NOTE_TIMEOUT;
+    }
+    else {
+        editorConvertToNoteTimeout = std::max(editorConvertToNoteTimeout, 100);
+    }
 
+    // The deadline no longer blocks anything, it just guarantees the caller is notified of the save's completion
+    // even if the conversion never finishes
+    if (!m_pConvertToNoteDeadlineTimer) {
         m_pConvertToNoteDeadlineTimer = new QTimer(this);
         m_pConvertToNoteDeadlineTimer->setSingleShot(true);
-
-        EventLoopWithExitStatus eventLoop;
         QObject::connect(m_pConvertToNoteDeadlineTimer, QNSIGNAL(QTimer,timeout),
-                         &eventLoop, QNSLOT(EventLoopWithExitStatus,exitAsTimeout));
-        QObject::connect(this, QNSIGNAL(NoteEditorWidget,noteSavedInLocalStorage),
-                         &eventLoop, QNSLOT(EventLoopWithExitStatus,exitAsSuccess));
-        QObject::connect(this, QNSIGNAL(NoteEditorWidget,noteSaveInLocalStorageFailed),
-                         &eventLoop, QNSLOT(EventLoopWithExitStatus,exitAsFailure));
-        QObject::connect(this, QNSIGNAL(NoteEditorWidget,conversionToNoteFailed),
-                         &eventLoop, QNSLOT(EventLoopWithExitStatus,exitAsFailure));
-
-        m_pConvertToNoteDeadlineTimer->start(editorConvertToNoteTimeout);
-
-        if (noteContentModified) {
-            QTimer::singleShot(0, m_pUi->noteEditor, SLOT(convertToNote()));
-        }
-        else {
-            QTimer::singleShot(0, this, SLOT(updateNoteInLocalStorage()));
-        }
+                         this, QNSLOT(NoteEditorWidget,onNoteSaveDeadlineTimeout));
+    }
 
-        int result = eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+    m_noteLocalUidBeingSaved = m_pCurrentNote->localUid();
+    m_noteSaveRequestId = QUuid();
+    m_pConvertToNoteDeadlineTimer->start(editorConvertToNoteTimeout);
 
-        if (result == EventLoopWithExitStatus::ExitStatus::Failure) {
-            errorDescription.setBase(QT_TR_NOOP("Failed to convert the editor contents to note"));
-            QNWARNING(errorDescription);
-            return NoteSaveStatus::Failed;
-        }
-        else if (result == EventLoopWithExitStatus::ExitStatus::Timeout) {
-            errorDescription.setBase(QT_TR_NOOP("The conversion of note editor contents "
-                                                "to note failed to finish in time"));
-            QNWARNING(errorDescription);
-            return NoteSaveStatus::Timeout;
-        }
+    // NOTE: the saving is started from the event loop so that noteSaveFinished is never emitted before
+    // the caller gets a chance to connect to it
+    if (noteContentModified) {
+        QTimer::singleShot(0, m_pUi->noteEditor, SLOT(convertToNote()));
     }
+    else {
+        QTimer::singleShot(0, this, SLOT(updateNoteInLocalStorage()));
+    }
+
+    return true;
+}
 
-    return NoteSaveStatus::Ok;
+bool NoteEditorWidget::isSavingNote() const
+{
+    return !m_noteLocalUidBeingSaved.isEmpty();
 }
 
 bool NoteEditorWidget::isSeparateWindow() const
@@ -696,11 +692,17 @@ void NoteEditorWidget::closeEvent(QCloseEvent * pEvent)
         return;
     }
 
-    ErrorString errorDescription;
-    NoteSaveStatus::type status = checkAndSaveModifiedNote(errorDescription);
-    QNDEBUG(QStringLiteral("Check and save modified note, status: ") << status
-            << QStringLiteral(", error description: ") << errorDescription);
+    // The widget is deleted on close so it is kept alive, although hidden, until its note is saved;
+    // once that happens, the widget closes itself once again
+    if (isSavingNote() || (!m_closeWhenNoteSaved && checkAndSaveModifiedNote())) {
+        QNDEBUG(QStringLiteral("Postponing the close of note editor widget until the note is saved"));
+        m_closeWhenNoteSaved = true;
+        hide();
+        pEvent->ignore();
+        return;
+    }
 
+    m_closeWhenNoteSaved = false;
     pEvent->accept();
 }
 
@@ -1120,9 +1122,14 @@ void NoteEditorWidget::onUpdateNoteComplete(Note note, bool updateResources, boo
             << QStringLiteral(", update tags = ") << (updateTags ? QStringLiteral("true") : QStringLiteral("false")));
 
     auto it = m_updateNoteRequestIds.find(requestId);
-    if (it != m_updateNoteRequestIds.end()) {
+    if (it != m_updateNoteRequestIds.end())
+    {
         Q_UNUSED(m_updateNoteRequestIds.erase(it))
-        Q_EMIT noteSavedInLocalStorage();
+
+        if (isSavingNote() && (requestId == m_noteSaveRequestId)) {
+            finishNoteSave(NoteSaveStatus::Ok, ErrorString());
+        }
+
         return;
     }
 
@@ -1249,7 +1256,9 @@ void NoteEditorWidget::onUpdateNoteFailed(Note note, bool updateResources, bool
     Q_EMIT notifyError(error);
     // NOTE: not clearing out the unsaved stuff because it may be of value to the user
 
-    Q_EMIT noteSaveInLocalStorageFailed();
+    if (isSavingNote() && (requestId == m_noteSaveRequestId)) {
+        finishNoteSave(NoteSaveStatus::Failed, error);
+    }
 }
 
 void NoteEditorWidget::onFindNoteComplete(Note note, bool withResourceMetadata, bool withResourceBinaryData, QUuid requestId)
@@ -1587,7 +1596,13 @@ void NoteEditorWidget::onEditorNoteUpdateFailed(ErrorString error)
     QNDEBUG(QStringLiteral("NoteEditorWidget::onEditorNoteUpdateFailed: ") << error);
     Q_EMIT notifyError(error);
 
-    Q_EMIT conversionToNoteFailed();
+    if (isSavingNote()) {
+        ErrorString errorDescription(QT_TR_NOOP("Failed to convert the editor contents to note"));
+        errorDescription.appendBase(error.base());
+        errorDescription.appendBase(error.additionalBases());
+        errorDescription.details() = error.details();
+        finishNoteSave(NoteSaveStatus::Failed, errorDescription);
+    }
 }
 
 void NoteEditorWidget::onEditorInAppLinkPasteRequested(QString url, QString userId, QString shardId, QString noteGuid)
@@ -2139,11 +2154,26 @@ void NoteEditorWidget::updateNoteInLocalStorage()
 
     QUuid requestId = QUuid::createUuid();
     Q_UNUSED(m_updateNoteRequestIds.insert(requestId))
+
+    // The saving started by checkAndSaveModifiedNote is finished by the latest update request sent while it lasts
+    // as that request contains the latest state of the note
+    if (isSavingNote()) {
+        m_noteSaveRequestId = requestId;
+    }
+
     QNTRACE(QStringLiteral("Emitting the request to update note: request id = ") << requestId
             << QStringLiteral(", note = ") << *m_pCurrentNote);
     Q_EMIT updateNote(*m_pCurrentNote, /* update resources = */ true, /* update tags = */ false, requestId);
 }
 
+void NoteEditorWidget::onNoteSaveDeadlineTimeout()
+{
+    QNDEBUG(QStringLiteral("NoteEditorWidget::onNoteSaveDeadlineTimeout"));
+
+    finishNoteSave(NoteSaveStatus::Timeout,
+                   ErrorString(QT_TR_NOOP("The conversion of note editor contents to note failed to finish in time")));
+}
+
 void NoteEditorWidget::onPrintNoteButtonPressed()
 {
     QNDEBUG(QStringLiteral("NoteEditorWidget::onPrintNoteButtonPressed"));
@@ -2375,6 +2405,11 @@ void NoteEditorWidget::clear()
 {
     QNDEBUG(QStringLiteral("NoteEditorWidget::clear: note ") << (m_pCurrentNote ? m_pCurrentNote->localUid() : QStringLiteral("<null>")));
 
+    if (isSavingNote()) {
+        finishNoteSave(NoteSaveStatus::Failed,
+                       ErrorString(QT_TR_NOOP("The note editor was cleared before the note was saved")));
+    }
+
     m_pCurrentNote.reset(Q_NULLPTR);
     m_pCurrentNotebook.reset(Q_NULLPTR);
     m_pUi->noteEditor->clear();
@@ -2782,6 +2817,36 @@ void NoteEditorWidget::removeSurrondingApostrophes(QString & str) const
     }
 }
 
+void NoteEditorWidget::finishNoteSave(const NoteSaveStatus::type status, const ErrorString & errorDescription)
+{
+    if (!isSavingNote()) {
+        return;
+    }
+
+    QNDEBUG(QStringLiteral("NoteEditorWidget::finishNoteSave: note local uid = ") << m_noteLocalUidBeingSaved
+            << QStringLiteral(", status = ") << status << QStringLiteral(", error description: ") << errorDescription);
+
+    QString noteLocalUid = m_noteLocalUidBeingSaved;
+    m_noteLocalUidBeingSaved.clear();
+    m_noteSaveRequestId = QUuid();
+
+    if (m_pConvertToNoteDeadlineTimer) {
+        m_pConvertToNoteDeadlineTimer->stop();
+    }
+
+    if (status != NoteSaveStatus::Ok) {
+        QNWARNING(QStringLiteral("Failed to save note ") << noteLocalUid << QStringLiteral(": ") << errorDescription);
+    }
+
+    Q_EMIT noteSaveFinished(noteLocalUid, status, errorDescription);
+
+    if (m_closeWhenNoteSaved) {
+        // Not closing right away since the widget is deleted on close while the receivers of the signal
+        // might still be using it
+        QTimer::singleShot(0, this, SLOT(close()));
+    }
+}
+
 QTextStream & NoteEditorWidget::NoteLinkInfo::print(QTextStream & strm) const
 {
     strm << QStringLiteral("User id = ") << m_userId << QStringLiteral(", shard id = ") << m_shardId
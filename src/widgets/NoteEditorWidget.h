@@ -177,12 +177,17 @@ public:
     /**
      * @brief checkAndSaveModifiedNote - if the note editor has some note set and
      * it also contains some modifications to the content of the note which are
-     * not saved yet, this method attempts to save these synchronously
-     * @param errorDescription - contains the textual description of the error
-     * if the method wasn't able to save the note
-     * @return the result of the attempt to save the note synchronously
+     * not saved yet, this method starts saving these asynchronously; the method
+     * returns immediately, the result of saving is reported by noteSaveFinished signal
+     * @return true if the note is being saved, either since this call or since one of the previous ones,
+     * false if there was nothing to save; noteSaveFinished signal is emitted only in the former case
      */
-    NoteSaveStatus::type checkAndSaveModifiedNote(ErrorString & errorDescription);
+    bool checkAndSaveModifiedNote();
+
+    /**
+     * @return true if the saving started by checkAndSaveModifiedNote has not finished yet, false otherwise
+     */
+    bool isSavingNote() const;
 
     /**
      * @brief isSeparateWindow
@@ -270,15 +275,22 @@ Q_SIGNALS:
      */
     void inAppNoteLinkClicked(QString userId, QString shardId, QString noteGuid);
 
+    /**
+     * @brief noteSaveFinished signal is emitted when the saving started by checkAndSaveModifiedNote is finished,
+     * successfully or not; the signal is emitted even if the widget is cleared before that but not if it is
+     * destroyed before that, the ones waiting for the save need to watch the widget's destroyed signal for that
+     * @param noteLocalUid - the local uid of the note which was being saved
+     * @param status - the result of saving the note
+     * @param errorDescription - the textual description of the error if the note could not be saved
+     */
+    void noteSaveFinished(QString noteLocalUid, NoteEditorWidget::NoteSaveStatus::type status,
+                          ErrorString errorDescription);
+
 // private signals
     void updateNote(Note note, bool updateResources, bool updateTags, QUuid requestId);
     void findNote(Note note, bool withResourceMetadata, bool withResourceBinaryData, QUuid requestId);
     void findNotebook(Notebook notebook, QUuid requestId);
 
-    void noteSavedInLocalStorage();
-    void noteSaveInLocalStorageFailed();
-    void conversionToNoteFailed();
-
     void insertInAppNoteLink(const QString & userId, const QString & shardId, const QString & noteGuid, const QString & linkText);
 
 public Q_SLOTS:
@@ -416,6 +428,8 @@ private Q_SLOTS:
     // Helper slot called from QTimer::singleShot
     void updateNoteInLocalStorage();
 
+    void onNoteSaveDeadlineTimeout();
+
     // Slots for print/export buttons
     void onPrintNoteButtonPressed();
     void onExportNoteToPdfButtonPressed();
@@ -444,6 +458,8 @@ private:
 
     void removeSurrondingApostrophes(QString & str) const;
 
+    void finishNoteSave(const NoteSaveStatus::type status, const ErrorString & errorDescription);
+
 private:
     Ui::NoteEditorWidget *      m_pUi;
     NoteCache &                 m_noteCache;
@@ -470,6 +486,12 @@ private:
 
     QTimer *                    m_pConvertToNoteDeadlineTimer;
 
+    // The local uid of the note being saved by checkAndSaveModifiedNote, empty if no saving is in progress
+    QString                     m_noteLocalUidBeingSaved;
+
+    // The id of the update request which completion finishes the saving of the note
+    QUuid                       m_noteSaveRequestId;
+
     QUuid                       m_findCurrentNoteRequestId;
     QUuid                       m_findCurrentNotebookRequestId;
     QSet<QUuid>                 m_updateNoteRequestIds;
@@ -507,6 +529,9 @@ private:
     bool                        m_noteTitleHasBeenEdited;
 
     bool                        m_isNewNote;
+
+    // Set when the attempt to close the widget is postponed until its note is saved
+    bool                        m_closeWhenNoteSaved;
 };
 
 } // namespace quentier
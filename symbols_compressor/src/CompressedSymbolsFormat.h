@@ -0,0 +1,59 @@
+/*
+ * Copyright 2018 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_SYMBOLS_COMPRESSOR_COMPRESSED_SYMBOLS_FORMAT_H
+#define QUENTIER_SYMBOLS_COMPRESSOR_COMPRESSED_SYMBOLS_FORMAT_H
+
+#include <QtGlobal>
+
+/**
+ * The layout of the compressed symbols file produced by the symbols compressor and consumed by the crash handler.
+ * All numbers are stored in big endian byte order (the default one for QDataStream).
+ *
+ * header:  8 bytes of magic, quint32 format version, quint32 uncompressed size of a block
+ * blocks:  the sequence of blocks, each one compressed independently from the others by qCompress
+ * index:   for each block: quint64 offset of the block within the file, quint32 compressed size,
+ *          quint32 uncompressed size
+ * trailer: quint64 offset of the index within the file, quint32 number of blocks, 8 bytes of magic
+ *
+ * The index is written after the blocks so that the compressor doesn't need to know the number of blocks
+ * in advance; the reader locates it through the fixed size trailer. Files not starting with the magic bytes
+ * are treated as the legacy format i.e. the whole symbols file compressed by a single qCompress call.
+ */
+
+#define COMPRESSED_SYMBOLS_FORMAT_MAGIC "QNSYMCB1"
+#define COMPRESSED_SYMBOLS_FORMAT_MAGIC_SIZE (8)
+#define COMPRESSED_SYMBOLS_FORMAT_VERSION (1)
+#define COMPRESSED_SYMBOLS_FORMAT_HEADER_SIZE (COMPRESSED_SYMBOLS_FORMAT_MAGIC_SIZE + 8)
+#define COMPRESSED_SYMBOLS_FORMAT_INDEX_ENTRY_SIZE (16)
+#define COMPRESSED_SYMBOLS_FORMAT_TRAILER_SIZE (12 + COMPRESSED_SYMBOLS_FORMAT_MAGIC_SIZE)
+
+struct CompressedSymbolsBlockInfo
+{
+    CompressedSymbolsBlockInfo() :
+        m_offset(0),
+        m_compressedSize(0),
+        m_uncompressedSize(0)
+    {}
+
+    quint64     m_offset;
+    quint32     m_compressedSize;
+    quint32     m_uncompressedSize;
+};
+
+#endif // QUENTIER_SYMBOLS_COMPRESSOR_COMPRESSED_SYMBOLS_FORMAT_H
@@ -16,12 +16,58 @@
  * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "CompressedSymbolsFormat.h"
 #include <QByteArray>
 #include <QCoreApplication>
 #include <QStringList>
 #include <QFile>
 #include <QFileInfo>
+#include <QDataStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QElapsedTimer>
+#include <QVector>
 #include <QDebug>
+#include <algorithm>
+
+#define DEFAULT_BLOCK_SIZE (4 * 1024 * 1024)
+#define COMPRESSION_LEVEL (9)
+
+class BlockCompressor: public QRunnable
+{
+public:
+    BlockCompressor(const QByteArray & input, QByteArray * pOutput) :
+        m_input(input),
+        m_pOutput(pOutput)
+    {}
+
+    virtual void run()
+    {
+        *m_pOutput = qCompress(m_input, COMPRESSION_LEVEL);
+    }
+
+private:
+    QByteArray      m_input;
+    QByteArray *    m_pOutput;
+};
+
+bool parseIntOption(const QString & arg, const QString & optionName, int & value)
+{
+    QString prefix = optionName + QString::fromUtf8("=");
+    if (!arg.startsWith(prefix)) {
+        return false;
+    }
+
+    bool conversionResult = false;
+    int parsedValue = arg.mid(prefix.size()).toInt(&conversionResult);
+    if (!conversionResult || (parsedValue <= 0)) {
+        return false;
+    }
+
+    value = parsedValue;
+    return true;
+}
 
 int main(int argc, char * argv[])
 {
@@ -30,11 +76,30 @@ int main(int argc, char * argv[])
 
     if (args.size() < 2) {
         qWarning() << QString::fromUtf8("Usage: ") << argv[0] << QString::fromUtf8(" ")
-                   << QString::fromUtf8("<symbols file location>") << QString::fromUtf8(", args: ")
-                   << QString::number(args.size());
+                   << QString::fromUtf8("<symbols file location> [--block-size=<bytes>] [--threads=<number>]")
+                   << QString::fromUtf8(", args: ") << QString::number(args.size());
+        return 1;
+    }
+
+    int blockSize = DEFAULT_BLOCK_SIZE;
+    int numThreads = QThread::idealThreadCount();
+    for(int i = 2, size = args.size(); i < size; ++i)
+    {
+        const QString & arg = args[i];
+        if (parseIntOption(arg, QString::fromUtf8("--block-size"), blockSize) ||
+            parseIntOption(arg, QString::fromUtf8("--threads"), numThreads))
+        {
+            continue;
+        }
+
+        qWarning() << QString::fromUtf8("Unrecognized or invalid argument: ") << arg;
         return 1;
     }
 
+    if (numThreads <= 0) {
+        numThreads = 1;
+    }
+
     QFile symbolsFile(args[1]);
     bool res = symbolsFile.open(QIODevice::ReadOnly);
     if (!res) {
@@ -42,11 +107,6 @@ int main(int argc, char * argv[])
         return 1;
     }
 
-    QByteArray fileContents = symbolsFile.readAll();
-    symbolsFile.close();
-
-    fileContents = qCompress(fileContents, 9);
-
     QFileInfo symbolsFileInfo(args[1]);
     QFile compressedSymbolsFile(symbolsFileInfo.absolutePath() + QString::fromUtf8("/") +
                                 symbolsFileInfo.fileName() + QString::fromUtf8(".compressed"));
@@ -56,8 +116,91 @@ int main(int argc, char * argv[])
         return 1;
     }
 
-    compressedSymbolsFile.write(fileContents);
+    QElapsedTimer timer;
+    timer.start();
+
+    QDataStream strm(&compressedSymbolsFile);
+    strm.writeRawData(COMPRESSED_SYMBOLS_FORMAT_MAGIC, COMPRESSED_SYMBOLS_FORMAT_MAGIC_SIZE);
+    strm << quint32(COMPRESSED_SYMBOLS_FORMAT_VERSION);
+    strm << quint32(blockSize);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(numThreads);
+
+    // Blocks are read and compressed in batches of a limited size so that the memory consumption
+    // stays bounded regardless of the size of the symbols file
+    const int batchSize = numThreads * 2;
+
+    QVector<CompressedSymbolsBlockInfo> index;
+    QVector<QByteArray> uncompressedBlocks(batchSize);
+    QVector<QByteArray> compressedBlocks(batchSize);
+
+    quint64 offset = COMPRESSED_SYMBOLS_FORMAT_HEADER_SIZE;
+    qint64 totalUncompressedSize = 0;
+    bool reachedEnd = false;
+    while(!reachedEnd)
+    {
+        int numBlocks = 0;
+        for(; numBlocks < batchSize; ++numBlocks)
+        {
+            uncompressedBlocks[numBlocks] = symbolsFile.read(blockSize);
+            if (uncompressedBlocks[numBlocks].isEmpty()) {
+                reachedEnd = true;
+                break;
+            }
+
+            totalUncompressedSize += uncompressedBlocks[numBlocks].size();
+            threadPool.start(new BlockCompressor(uncompressedBlocks[numBlocks], &compressedBlocks[numBlocks]));
+        }
+
+        threadPool.waitForDone();
+
+        for(int i = 0; i < numBlocks; ++i)
+        {
+            const QByteArray & compressedBlock = compressedBlocks[i];
+
+            CompressedSymbolsBlockInfo blockInfo;
+            blockInfo.m_offset = offset;
+            blockInfo.m_compressedSize = static_cast<quint32>(compressedBlock.size());
+            blockInfo.m_uncompressedSize = static_cast<quint32>(uncompressedBlocks[i].size());
+            index << blockInfo;
+
+            if (strm.writeRawData(compressedBlock.constData(), compressedBlock.size()) != compressedBlock.size()) {
+                qWarning() << QString::fromUtf8("Failed to write the compressed block to the compressed symbols file");
+                return 1;
+            }
+
+            offset += blockInfo.m_compressedSize;
+            uncompressedBlocks[i].clear();
+            compressedBlocks[i].clear();
+        }
+    }
+
+    symbolsFile.close();
+
+    for(auto it = index.constBegin(), end = index.constEnd(); it != end; ++it) {
+        strm << it->m_offset << it->m_compressedSize << it->m_uncompressedSize;
+    }
+
+    strm << offset;
+    strm << quint32(index.size());
+    strm.writeRawData(COMPRESSED_SYMBOLS_FORMAT_MAGIC, COMPRESSED_SYMBOLS_FORMAT_MAGIC_SIZE);
+
+    if (strm.status() != QDataStream::Ok) {
+        qWarning() << QString::fromUtf8("Failed to write the compressed symbols file");
+        return 1;
+    }
+
     compressedSymbolsFile.close();
 
+    qint64 elapsedMsec = std::max(timer.elapsed(), qint64(1));
+    double uncompressedMegabytes = static_cast<double>(totalUncompressedSize) / (1024.0 * 1024.0);
+    double compressedMegabytes = static_cast<double>(compressedSymbolsFile.size()) / (1024.0 * 1024.0);
+    qDebug() << QString::fromUtf8("Compressed") << symbolsFileInfo.fileName() << QString::fromUtf8(":")
+             << uncompressedMegabytes << QString::fromUtf8("MB ->") << compressedMegabytes << QString::fromUtf8("MB in")
+             << index.size() << QString::fromUtf8("blocks,") << elapsedMsec << QString::fromUtf8("ms,")
+             << (uncompressedMegabytes * 1000.0 / static_cast<double>(elapsedMsec)) << QString::fromUtf8("MB/s using")
+             << numThreads << QString::fromUtf8("threads");
+
     return 0;
 }